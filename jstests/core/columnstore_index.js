@@ -0,0 +1,83 @@
+/**
+ * Tests that a "columnstore" index can be built and that it answers unfiltered projections by
+ * reassembling the projected fields from its columns instead of fetching the documents.
+ *
+ * Cannot implicitly shard accessed collections, because shard filtering requires the shard key,
+ * which the columns may not provide. Does not support stepdowns because the test issues getMores.
+ *
+ * @tags: [assumes_unsharded_collection, does_not_support_stepdowns]
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For arrayEq.
+load("jstests/libs/analyze_plan.js");         // For getPlanStages.
+
+const coll = db.columnstore_index;
+coll.drop();
+
+for (let i = 0; i < 50; ++i) {
+    assert.commandWorked(coll.insert(
+        {_id: i, a: i, b: {c: "str" + i, d: i * 2}, e: {big: "x".repeat(100)}, f: [i, i + 1]}));
+}
+
+// Invalid specifications are rejected.
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {sparse: true}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {unique: true}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(
+    coll.createIndex({a: "columnstore"}, {partialFilterExpression: {a: {$gt: 0}}}),
+    ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore", b: 1}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore", "a.b": "columnstore"}),
+                             ErrorCodes.CannotCreateIndex);
+
+assert.commandWorked(
+    coll.createIndex({_id: "columnstore", a: "columnstore", b: "columnstore", f: "columnstore"}));
+assert.commandWorked(coll.validate({full: true}));
+
+// Runs 'query' and 'proj' and checks whether the columnstore index was used, and that the results
+// match those of a collection scan.
+function assertColumnScan(proj, sort, shouldUseColumnScan) {
+    const explain = coll.find({}, proj).sort(sort).explain("executionStats");
+    const columnScans = getPlanStages(explain.queryPlanner.winningPlan, "COLUMN_SCAN");
+    assert.eq(columnScans.length, shouldUseColumnScan ? 1 : 0, tojson(explain));
+    if (shouldUseColumnScan) {
+        assert.eq(explain.executionStats.totalDocsExamined, 0, tojson(explain));
+    }
+
+    const results = coll.find({}, proj).sort(sort).toArray();
+    const expected = coll.find({}, proj).sort(sort).hint({$natural: 1}).toArray();
+    assert(arrayEq(results, expected), tojson({results: results, expected: expected}));
+}
+
+assertColumnScan({a: 1}, {}, true);
+assertColumnScan({a: 1, _id: 0}, {}, true);
+assertColumnScan({"b.c": 1, _id: 0}, {}, true);
+assertColumnScan({a: 1, b: 1, _id: 0}, {a: -1}, true);
+assertColumnScan({f: 1, _id: 0}, {}, true);
+
+// 'e' is not stored in any column.
+assertColumnScan({a: 1, e: 1}, {}, false);
+assertColumnScan({a: 1, _id: 0}, {e: 1}, false);
+
+// Queries with a predicate, or without a projection, need the full documents.
+assert.eq(0,
+          getPlanStages(coll.find({a: 1}, {a: 1}).explain().queryPlanner.winningPlan, "COLUMN_SCAN")
+              .length);
+assert.eq(0, getPlanStages(coll.find().explain().queryPlanner.winningPlan, "COLUMN_SCAN").length);
+
+// Writes keep the columns up to date.
+assert.commandWorked(coll.update({_id: 3}, {$set: {a: "updated", "b.c": null}}));
+assert.commandWorked(coll.remove({_id: 4}));
+assert.commandWorked(coll.insert({_id: 100, b: {d: 1}}));
+assertColumnScan({a: 1, "b.c": 1}, {}, true);
+assert.commandWorked(coll.validate({full: true}));
+
+// Once a projected path traverses an array the index can no longer be used.
+assert.commandWorked(coll.insert({_id: 101, a: 1, b: [{c: 1}, {c: 2}]}));
+assertColumnScan({a: 1, "b.c": 1}, {}, false);
+assert.commandWorked(coll.validate({full: true}));
+})();
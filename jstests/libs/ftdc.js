@@ -63,6 +63,10 @@ function verifyCommonFTDCParameters(adminDb, isEnabled) {
     assert.eq(getparam("diagnosticDataCollectionFileSizeMB"), 10);
     assert.eq(getparam("diagnosticDataCollectionSamplesPerChunk"), 300);
     assert.eq(getparam("diagnosticDataCollectionSamplesPerInterimUpdate"), 10);
+    assert.eq(getparam("diagnosticDataCollectionBlockCompressor"), "zlib");
+    assert.eq(getparam("diagnosticDataCollectionHighResolutionEnabled"), false);
+    assert.eq(getparam("diagnosticDataCollectionHighResolutionPeriodMillis"), 100);
+    assert.eq(getparam("diagnosticDataCollectionHighResolutionDirectorySizeMB"), 100);
 
     function setparam(obj) {
         var ret = adminDb.runCommand(Object.extend({setParameter: 1}, obj));
@@ -79,12 +83,25 @@ function verifyCommonFTDCParameters(adminDb, isEnabled) {
     assert.commandWorked(setparam({"diagnosticDataCollectionFileSizeMB": 1}));
     assert.commandWorked(setparam({"diagnosticDataCollectionSamplesPerChunk": 2}));
     assert.commandWorked(setparam({"diagnosticDataCollectionSamplesPerInterimUpdate": 2}));
+    assert.commandWorked(setparam({"diagnosticDataCollectionBlockCompressor": "zstd"}));
+    assert.eq(getparam("diagnosticDataCollectionBlockCompressor"), "zstd");
+    assert.commandWorked(setparam({"diagnosticDataCollectionHighResolutionEnabled": true}));
+    assert.commandWorked(setparam({"diagnosticDataCollectionHighResolutionPeriodMillis": 10}));
+    assert.commandWorked(setparam({"diagnosticDataCollectionHighResolutionDirectorySizeMB": 10}));
 
     // Negative tests - set values below minimums
     assert.commandFailed(setparam({"diagnosticDataCollectionPeriodMillis": 1}));
     assert.commandFailed(setparam({"diagnosticDataCollectionDirectorySizeMB": 1}));
     assert.commandFailed(setparam({"diagnosticDataCollectionSamplesPerChunk": 1}));
     assert.commandFailed(setparam({"diagnosticDataCollectionSamplesPerInterimUpdate": 1}));
+    assert.commandFailed(setparam({"diagnosticDataCollectionHighResolutionPeriodMillis": 1}));
+    assert.commandFailed(setparam({"diagnosticDataCollectionHighResolutionDirectorySizeMB": 1}));
+
+    // Negative tests - set values above maximums
+    assert.commandFailed(setparam({"diagnosticDataCollectionHighResolutionPeriodMillis": 1001}));
+
+    // Negative test - set an unknown compressor
+    assert.commandFailed(setparam({"diagnosticDataCollectionBlockCompressor": "snappy"}));
 
     // Negative test - set file size bigger then directory size
     assert.commandWorked(setparam({"diagnosticDataCollectionDirectorySizeMB": 10}));
@@ -101,4 +118,8 @@ function verifyCommonFTDCParameters(adminDb, isEnabled) {
     assert.commandWorked(setparam({"diagnosticDataCollectionPeriodMillis": 1000}));
     assert.commandWorked(setparam({"diagnosticDataCollectionSamplesPerChunk": 300}));
     assert.commandWorked(setparam({"diagnosticDataCollectionSamplesPerInterimUpdate": 10}));
+    assert.commandWorked(setparam({"diagnosticDataCollectionBlockCompressor": "zlib"}));
+    assert.commandWorked(setparam({"diagnosticDataCollectionHighResolutionEnabled": false}));
+    assert.commandWorked(setparam({"diagnosticDataCollectionHighResolutionPeriodMillis": 100}));
+    assert.commandWorked(setparam({"diagnosticDataCollectionHighResolutionDirectorySizeMB": 100}));
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+/**
+ * Tests that change streams with {fullDocument: "updateLookup"} return the post-image produced by
+ * each update event when the post-image cache is enabled, and fall back to looking up the current
+ * version of the document when it is disabled.
+ * @tags: [requires_replication, requires_majority_read_concern, uses_change_streams]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({
+    nodes: 1,
+    nodeOptions: {setParameter: {internalChangeStreamPostImageCacheSizeBytes: 1024 * 1024}}
+});
+rst.startSet();
+rst.initiate();
+
+const db = rst.getPrimary().getDB(jsTestName());
+const coll = db.coll;
+assert.commandWorked(coll.insert({_id: 0, version: 0}));
+
+function updateVersions(stream) {
+    for (let version = 1; version <= 3; ++version) {
+        assert.commandWorked(coll.update({_id: 0}, {$set: {version: version}}));
+    }
+    const versions = [];
+    while (versions.length < 3) {
+        assert.soon(() => stream.hasNext());
+        const event = stream.next();
+        assert.eq("update", event.operationType, event);
+        versions.push(event.fullDocument.version);
+    }
+    stream.close();
+    return versions;
+}
+
+// Every event carries the document as it was right after its own update.
+assert.eq([1, 2, 3], updateVersions(coll.watch([], {fullDocument: "updateLookup"})));
+
+// Without the cache, each event carries the current version of the document.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalChangeStreamPostImageCacheSizeBytes: 0}));
+assert.commandWorked(coll.update({_id: 0}, {$set: {version: 0}}));
+const stream = coll.watch([], {fullDocument: "updateLookup"});
+assert.eq([3, 3, 3], updateVersions(stream));
+
+rst.stopSet();
+}());
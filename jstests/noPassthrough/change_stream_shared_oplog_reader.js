@@ -0,0 +1,79 @@
+/**
+ * Tests that change streams sharing one scan of the oplog see the same events as change streams
+ * which scan the oplog on their own, including when they resume from an earlier point.
+ * @tags: [requires_replication, requires_majority_read_concern, uses_change_streams]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest(
+    {nodes: 1, nodeOptions: {setParameter: {internalChangeStreamUseSharedOplogReader: true}}});
+rst.startSet();
+rst.initiate();
+
+const db = rst.getPrimary().getDB(jsTestName());
+const otherDB = db.getSiblingDB(jsTestName() + "_other");
+assert.commandWorked(db.createCollection("a"));
+assert.commandWorked(db.createCollection("b"));
+assert.commandWorked(otherDB.createCollection("c"));
+
+function nextEvents(cursor, count) {
+    const events = [];
+    while (events.length < count) {
+        assert.soon(() => cursor.hasNext());
+        const event = cursor.next();
+        events.push({op: event.operationType, ns: event.ns.coll, id: event.documentKey._id});
+    }
+    return events;
+}
+
+const collStreams = [];
+for (let i = 0; i < 10; ++i) {
+    collStreams.push(db.a.watch());
+}
+const otherCollStream = db.b.watch();
+const dbStream = db.watch();
+const clusterStream = db.getMongo().watch();
+
+assert.commandWorked(db.a.insert({_id: 1}));
+assert.commandWorked(db.b.insert({_id: 2}));
+assert.commandWorked(otherDB.c.insert({_id: 3}));
+assert.commandWorked(db.a.update({_id: 1}, {$set: {x: 1}}));
+assert.commandWorked(db.b.remove({_id: 2}));
+
+const collEvents = [{op: "insert", ns: "a", id: 1}, {op: "update", ns: "a", id: 1}];
+for (let stream of collStreams) {
+    assert.eq(collEvents, nextEvents(stream, 2));
+}
+assert.eq([{op: "insert", ns: "b", id: 2}, {op: "delete", ns: "b", id: 2}],
+          nextEvents(otherCollStream, 2));
+assert.eq([
+    {op: "insert", ns: "a", id: 1},
+    {op: "insert", ns: "b", id: 2},
+    {op: "update", ns: "a", id: 1},
+    {op: "delete", ns: "b", id: 2}
+],
+          nextEvents(dbStream, 4));
+assert.eq(5, nextEvents(clusterStream, 5).length);
+
+// A stream resuming from an event the shared scan has already read catches up on its own.
+const resumed = db.a.watch([], {resumeAfter: collStreams[0].getResumeToken()});
+assert.commandWorked(db.a.insert({_id: 4}));
+assert.eq([{op: "insert", ns: "a", id: 4}], nextEvents(resumed, 1));
+assert.eq([{op: "insert", ns: "a", id: 4}], nextEvents(collStreams[1], 1));
+
+// Events from a transaction reach the streams of every collection it wrote to.
+const session = db.getMongo().startSession();
+const sessionDB = session.getDatabase(db.getName());
+session.startTransaction({readConcern: {level: "snapshot"}, writeConcern: {w: "majority"}});
+assert.commandWorked(sessionDB.a.insert({_id: 5}));
+assert.commandWorked(sessionDB.b.insert({_id: 6}));
+assert.commandWorked(session.commitTransaction_forTesting());
+assert.eq([{op: "insert", ns: "a", id: 5}], nextEvents(collStreams[2], 1));
+assert.eq([{op: "insert", ns: "b", id: 6}], nextEvents(otherCollStream, 1));
+
+for (let stream of collStreams.concat([otherCollStream, dbStream, clusterStream, resumed])) {
+    stream.close();
+}
+rst.stopSet();
+}());
@@ -0,0 +1,58 @@
+/**
+ * Tests that projections and $expr produce the same results whether or not their expressions are
+ * compiled.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB(jsTestName());
+const coll = db.coll;
+
+const docs = [
+    {_id: 0, a: 1, b: 2},
+    {_id: 1, a: NumberInt(2147483647), b: NumberInt(1)},
+    {_id: 2, a: NumberLong("9223372036854775807"), b: 1},
+    {_id: 3, a: 1.5, b: -4},
+    {_id: 4, a: NumberDecimal("1.1"), b: 2},
+    {_id: 5, a: null, b: 2},
+    {_id: 6, a: 0, b: 0},
+    {_id: 7},
+];
+assert.commandWorked(coll.insert(docs));
+
+const pipeline = [
+    {$match: {$expr: {$or: [{$gt: [{$add: ["$a", "$b"]}, 2]}, {$eq: ["$b", 0]}]}}},
+    {
+        $addFields: {
+            sum: {$add: ["$a", "$b", 1]},
+            product: {$multiply: ["$a", "$b"]},
+            difference: {$subtract: ["$a", "$b"]},
+            ratio: {$cond: [{$eq: ["$b", 0]}, null, {$divide: ["$a", "$b"]}]},
+            twice: {$add: [{$multiply: ["$a", "$b"]}, {$multiply: ["$a", "$b"]}]},
+            order: {$cmp: ["$a", "$b"]},
+        }
+    },
+    {$sort: {_id: 1}},
+];
+
+function runWithCompilation(enabled) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryEnableExpressionCompilation: enabled}));
+    return coll.aggregate(pipeline).toArray();
+}
+
+const interpreted = runWithCompilation(false);
+const compiled = runWithCompilation(true);
+assert.neq(0, interpreted.length);
+assert.eq(interpreted, compiled);
+
+// Errors are raised the same way, and operands the interpreter skips are not evaluated.
+const failing = [{$project: {r: {$divide: [1, "$b"]}}}];
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: coll.getName(), pipeline: failing, cursor: {}}), 16608);
+const guarded = [{$project: {r: {$add: ["$missing", {$divide: [1, "$b"]}]}}}, {$sort: {_id: 1}}];
+assert.eq(coll.aggregate(guarded).toArray(), docs.map((doc) => ({_id: doc._id, r: null})));
+
+MongoRunner.stopMongod(conn);
+}());
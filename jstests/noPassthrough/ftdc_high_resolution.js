@@ -0,0 +1,43 @@
+/**
+ * Test that the high resolution FTDC collectors write zstd compressed metrics files to their own
+ * subdirectory, alongside the regular collection.
+ */
+load('jstests/libs/ftdc.js');
+
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        diagnosticDataCollectionHighResolutionEnabled: true,
+        diagnosticDataCollectionHighResolutionPeriodMillis: 10,
+        diagnosticDataCollectionBlockCompressor: "zstd",
+    }
+});
+const adminDb = conn.getDB("admin");
+
+// The regular collection is unaffected
+verifyGetDiagnosticData(adminDb);
+
+const highResolutionDir = conn.dbpath + "/diagnostic.data/highResolution";
+
+function metricsFiles() {
+    let files = [];
+    try {
+        files = listFiles(highResolutionDir);
+    } catch (e) {
+        // The directory is created with the first high resolution sample
+    }
+    return files.filter(file => !file.isDirectory && file.baseName.startsWith("metrics."));
+}
+
+assert.soon(() => metricsFiles().length > 0,
+            "no high resolution metrics file in " + highResolutionDir);
+
+// Turning high resolution collection off at runtime stops it, and regular collection keeps going
+assert.commandWorked(
+    adminDb.runCommand({setParameter: 1, diagnosticDataCollectionHighResolutionEnabled: false}));
+verifyGetDiagnosticData(adminDb);
+
+MongoRunner.stopMongod(conn);
+})();
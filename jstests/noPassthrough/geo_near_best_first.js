@@ -0,0 +1,135 @@
+/**
+ * Tests that a 2dsphere geoNear search returns the same documents, at the same distances, whether
+ * it covers successive annuli or visits index cells in order of distance, and with or without the
+ * geoNear covering cache.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage.
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB(jsTestName());
+const coll = db.coll;
+
+// A deterministic pseudo-random sequence in [0, 1).
+let seed = 12345;
+function random() {
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+    return seed / 2147483648;
+}
+
+const docs = [];
+for (let i = 0; i < 1500; ++i) {
+    // Most points are clustered, with the rest spread sparsely over the whole Earth.
+    const loc = i % 5 === 0 ? [random() * 360 - 180, random() * 170 - 85]
+                            : [10 + random() * 2, 20 + random() * 2];
+    docs.push({_id: i, loc: {type: "Point", coordinates: loc}, tag: i % 4});
+}
+for (let i = 0; i < 50; ++i) {
+    const x = random() * 40 - 20;
+    const y = random() * 40 - 20;
+    docs.push({
+        _id: "line" + i,
+        loc: {type: "LineString", coordinates: [[x, y], [x + 1, y + 0.5]]},
+        tag: i % 4
+    });
+    docs.push({
+        _id: "polygon" + i,
+        loc: {
+            type: "Polygon",
+            coordinates: [[[x, y], [x + 0.5, y], [x + 0.5, y + 0.5], [x, y + 0.5], [x, y]]]
+        },
+        tag: i % 4
+    });
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({loc: "2dsphere", tag: 1}));
+
+const queries = [
+    {near: [11, 21], limit: 50},
+    {near: [11, 21], limit: 1000},
+    {near: [-100, 40], limit: 20},
+    {near: [0, 0], maxDistance: 2000 * 1000, limit: 2000},
+    {near: [11, 21], minDistance: 50 * 1000, maxDistance: 3000 * 1000, limit: 2000},
+    {near: [11, 21], query: {tag: 2}, limit: 100},
+    {near: [179.9, -60], query: {tag: {$in: [1, 3]}}, limit: 30},
+];
+
+function runQuery(query) {
+    const geoNear = {
+        near: {type: "Point", coordinates: query.near},
+        distanceField: "dist",
+        spherical: true,
+        key: "loc",
+    };
+    if (query.query) {
+        geoNear.query = query.query;
+    }
+    if (query.minDistance !== undefined) {
+        geoNear.minDistance = query.minDistance;
+    }
+    if (query.maxDistance !== undefined) {
+        geoNear.maxDistance = query.maxDistance;
+    }
+    return coll.aggregate([{$geoNear: geoNear}, {$limit: query.limit}, {$project: {dist: 1}}])
+        .toArray();
+}
+
+function setParameters(bestFirst, cacheSize) {
+    assert.commandWorked(db.adminCommand({
+        setParameter: 1,
+        internalQueryS2GeoNearBestFirst: bestFirst,
+        internalQueryS2GeoNearCoveringCacheSize: cacheSize
+    }));
+}
+
+function assertSameResults(expected, actual, query) {
+    const msg = tojson(query);
+    assert.eq(expected.length, actual.length, msg);
+    for (let i = 0; i < expected.length; ++i) {
+        assert.close(expected[i].dist, actual[i].dist, msg);
+    }
+    assert.sameMembers(expected.map(doc => doc._id), actual.map(doc => doc._id), msg);
+}
+
+for (let query of queries) {
+    setParameters(false, 0);
+    const expected = runQuery(query);
+    assert.gt(expected.length, 0, tojson(query));
+
+    for (let [bestFirst, cacheSize] of [[true, 0], [false, 100], [true, 100]]) {
+        setParameters(bestFirst, cacheSize);
+        assertSameResults(expected, runQuery(query), query);
+        // The second run may reuse the coverings cached by the first.
+        assertSameResults(expected, runQuery(query), query);
+    }
+}
+
+function explainNear(near, maxDistance) {
+    const nearSphere = {
+        $geometry: {type: "Point", coordinates: near},
+        $maxDistance: maxDistance,
+    };
+    return coll.find({loc: {$nearSphere: nearSphere}}).explain("executionStats");
+}
+
+// The explain output shows whether the search is best-first.
+setParameters(true, 0);
+let nearStage = getPlanStage(explainNear([11, 21], 100 * 1000), "GEO_NEAR_2DSPHERE");
+assert.eq(true, nearStage.bestFirst, tojson(nearStage));
+
+setParameters(false, 0);
+nearStage = getPlanStage(explainNear([11, 21], 100 * 1000), "GEO_NEAR_2DSPHERE");
+assert(!nearStage.hasOwnProperty("bestFirst"), tojson(nearStage));
+
+// A repeated fixed-radius query reuses the cached coverings of its annuli.
+for (let bestFirst of [false, true]) {
+    setParameters(bestFirst, 100);
+    explainNear([-50, -30], 500 * 1000);
+    nearStage = getPlanStage(explainNear([-50, -30], 500 * 1000), "GEO_NEAR_2DSPHERE");
+    assert.gt(nearStage.coveringCacheHits, 0, tojson(nearStage));
+}
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,68 @@
+/**
+ * Tests that a getMore carrying a '$_sortKeyThreshold', as sent by mongos for a sorted find with a
+ * limit, ends its batch at the first result sorting after the threshold, and that the cursor
+ * resumes right after that result.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+
+const testDB = conn.getDB("getmore_sort_key_threshold");
+const coll = testDB.test;
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 10; ++i) {
+    bulk.insert({_id: i, a: i});
+}
+assert.commandWorked(bulk.execute());
+
+function findSorted() {
+    // Ask for the sort key the way mongos does, so that the results carry it.
+    const res = assert.commandWorked(testDB.runCommand({
+        find: coll.getName(),
+        sort: {a: 1},
+        projection: {_id: 0, a: 1, $sortKey: {$meta: "sortKey"}},
+        batchSize: 2
+    }));
+    assert.eq([0, 1], res.cursor.firstBatch.map(doc => doc.a));
+    return res.cursor.id;
+}
+
+function getMore(cursorId, extra) {
+    return assert.commandWorked(testDB.runCommand(
+        Object.assign({getMore: cursorId, collection: coll.getName(), batchSize: 100}, extra)));
+}
+
+// The batch ends with the first result sorting after the threshold, and the cursor stays open.
+let cursorId = findSorted();
+let res = getMore(cursorId, {$_sortKeyThreshold: {key: {"": 4}, pattern: {a: 1}}});
+assert.eq([2, 3, 4, 5], res.cursor.nextBatch.map(doc => doc.a));
+assert.neq(0, res.cursor.id);
+
+// The next getMore picks up right after the last returned result.
+res = getMore(cursorId, {});
+assert.eq([6, 7, 8, 9], res.cursor.nextBatch.map(doc => doc.a));
+assert.eq(0, res.cursor.id);
+
+// A threshold which no result passes does not shorten the batch.
+cursorId = findSorted();
+res = getMore(cursorId, {$_sortKeyThreshold: {key: {"": 100}, pattern: {a: 1}}});
+assert.eq([2, 3, 4, 5, 6, 7, 8, 9], res.cursor.nextBatch.map(doc => doc.a));
+assert.eq(0, res.cursor.id);
+
+// The threshold follows the direction of the sort pattern.
+res = assert.commandWorked(testDB.runCommand({
+    find: coll.getName(),
+    sort: {a: -1},
+    projection: {_id: 0, a: 1, $sortKey: {$meta: "sortKey"}},
+    batchSize: 1
+}));
+assert.eq([9], res.cursor.firstBatch.map(doc => doc.a));
+res = getMore(res.cursor.id, {$_sortKeyThreshold: {key: {"": 7}, pattern: {a: -1}}});
+assert.eq([8, 7, 6], res.cursor.nextBatch.map(doc => doc.a));
+assert.neq(0, res.cursor.id);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,85 @@
+/**
+ * Tests that batched inserts leave every index with the same keys, and report the same errors,
+ * whether the keys of a batch are inserted document by document or in key order.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 1});
+rst.startSet();
+rst.initiate();
+
+const db = rst.getPrimary().getDB(jsTestName());
+
+// 'query' is a predicate which lets the planner use the index when it is hinted. A partial index
+// needs one within its filter, and a wildcard index one on a path it covers.
+const indexes = [
+    {key: {a: 1}},
+    {key: {b: -1, a: 1}},
+    {key: {"c.d": 1}},
+    {key: {u: 1}, options: {unique: true}},
+    {key: {e: 1}, options: {partialFilterExpression: {f: {$gt: 0}}}, query: {f: {$gt: 0}}},
+    {key: {"w.$**": 1}, query: {"w.x": {$gte: 0}}},
+];
+
+function makeDocs(start, count) {
+    const docs = [];
+    for (let i = start; i < start + count; ++i) {
+        docs.push({
+            _id: i,
+            a: (i * 7919) % 101,
+            b: "b" + (i % 13),
+            c: i % 3 === 0 ? [{d: i}, {d: -i}] : {d: i},
+            u: i,
+            e: i % 5,
+            f: i % 2,
+            w: {x: i, y: [i % 4, "s" + i]},
+        });
+    }
+    return docs;
+}
+
+function runInserts(inKeyOrder) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalInsertIndexKeysInKeyOrder: inKeyOrder}));
+
+    const coll = db["coll_" + inKeyOrder];
+    coll.drop();
+    for (let spec of indexes) {
+        assert.commandWorked(coll.createIndex(spec.key, spec.options || {}));
+    }
+
+    assert.commandWorked(coll.insert(makeDocs(0, 500)));
+
+    // A batch with a duplicate on the unique index fails only the offending document.
+    const docs = makeDocs(500, 50);
+    docs[20].u = 3;
+    const res = coll.insert(docs, {ordered: false});
+    assert.eq(1, res.getWriteErrors().length, tojson(res));
+    assert.eq(20, res.getWriteErrors()[0].index, tojson(res));
+    assert.eq(ErrorCodes.DuplicateKey, res.getWriteErrors()[0].code, tojson(res));
+
+    const validateRes = coll.validate({full: true});
+    assert(validateRes.valid, tojson(validateRes));
+    return coll;
+}
+
+const documentOrder = runInserts(false);
+const keyOrder = runInserts(true);
+
+assert.eq(documentOrder.find().sort({_id: 1}).toArray(),
+          keyOrder.find().sort({_id: 1}).toArray());
+for (let spec of indexes) {
+    const query = spec.query || {};
+    assert.eq(documentOrder.find(query).hint(spec.key).returnKey().toArray(),
+              keyOrder.find(query).hint(spec.key).returnKey().toArray(),
+              tojson(spec.key));
+    assert.eq(documentOrder.find(query).hint(spec.key).explain().queryPlanner.winningPlan,
+              keyOrder.find(query).hint(spec.key).explain().queryPlanner.winningPlan,
+              tojson(spec.key));
+}
+
+rst.stopSet();
+}());
@@ -0,0 +1,52 @@
+/**
+ * Tests that collection scans and fetches return the same documents whether or not their filters
+ * are compiled.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB(jsTestName());
+const coll = db.coll;
+
+assert.commandWorked(coll.insert([
+    {_id: 0, a: 1, b: 2, c: 3},
+    {_id: 1, c: 3, b: 2, a: 1},
+    {_id: 2, a: 1, b: 3},
+    {_id: 3, a: null, b: 2},
+    {_id: 4, b: 2},
+    {_id: 5, a: [1, 5], b: [2]},
+    {_id: 6, a: [], b: 2},
+    {_id: 7, a: {b: 1}, b: 2},
+    {_id: 8, a: [{b: 1}, {b: 4}], b: 2, c: "x"},
+]));
+assert.commandWorked(coll.createIndex({c: 1}));
+
+const filters = [
+    {a: 1, b: 2},
+    {a: {$gte: 1, $lt: 6}, b: {$ne: 3}},
+    {a: null, b: 2},
+    {"a.b": {$gt: 3}, b: 2},
+    {a: {$elemMatch: {b: 1}}, b: 2},
+    {$or: [{a: 1}, {b: 3}]},
+    {a: {$not: {$gt: 2}}, b: 2},
+    {b: 2, $expr: {$eq: ["$a", 1]}},
+    {c: {$exists: true}, a: 1, b: 2},
+];
+
+function runWithCompilation(enabled) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryEnableMatchExpressionCompilation: enabled}));
+    return filters.map((filter) => ({
+                           collScan: coll.find(filter).hint({$natural: 1}).sort({_id: 1}).toArray(),
+                           fetch: coll.find(filter).hint({c: 1}).sort({_id: 1}).toArray(),
+                       }));
+}
+
+const interpreted = runWithCompilation(false);
+const compiled = runWithCompilation(true);
+assert.eq(interpreted, compiled);
+assert.neq(0, interpreted[0].collScan.length);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,81 @@
+/**
+ * Tests that aggregations whose first $group or $sort runs on several workers return the same
+ * results as aggregations run by a single thread.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalQueryAggParallelBufferSizeBytes: 4 * 1024}});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const db = conn.getDB("test");
+const coll = db.parallel_aggregation;
+coll.drop();
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 2000; ++i) {
+    bulk.insert({_id: i, a: i % 17, b: (i * 7919) % 1000, str: "value" + (i % 31)});
+}
+assert.commandWorked(bulk.execute());
+
+const pipelines = [
+    [{$group: {_id: "$a", count: {$sum: 1}, total: {$sum: "$b"}}}, {$sort: {_id: 1}}],
+    [{$match: {b: {$gte: 100}}}, {$group: {_id: {a: "$a", str: "$str"}, max: {$max: "$b"}}},
+     {$sort: {_id: 1}}],
+    [{$project: {b: 1, a: 1}}, {$sort: {b: 1, _id: 1}}],
+    [{$sort: {b: -1, _id: 1}}, {$limit: 25}],
+    [{$addFields: {c: {$mod: ["$b", 3]}}}, {$sort: {c: 1, _id: -1}}, {$skip: 10}, {$limit: 500}],
+    // A constant group key leaves the pipeline serial.
+    [{$group: {_id: null, count: {$sum: 1}}}],
+];
+
+function runPipelines(batchSize) {
+    return pipelines.map(pipeline => coll.aggregate(pipeline, {cursor: {batchSize: batchSize}})
+                                         .toArray());
+}
+
+function setParallelism(parallelism) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryAggParallelism: parallelism}));
+}
+
+setParallelism(1);
+const expected = runPipelines(1000);
+
+for (let parallelism of [2, 4, 8]) {
+    setParallelism(parallelism);
+    for (let batchSize of [3, 1000]) {
+        assert.eq(
+            expected, runPipelines(batchSize), {parallelism: parallelism, batchSize: batchSize});
+    }
+}
+
+// The workers and the merging stage see the same $$NOW.
+setParallelism(4);
+const nowResults =
+    coll.aggregate([
+            {$group: {_id: "$a", now: {$max: "$$NOW"}}},
+            {$project: {sameNow: {$eq: ["$now", "$$NOW"]}}}
+        ])
+        .toArray();
+assert.eq(17, nowResults.length, nowResults);
+assert(nowResults.every(doc => doc.sameNow), nowResults);
+
+// The plan summary of a parallel aggregation is that of the collection scan feeding its workers.
+assert.commandWorked(db.setProfilingLevel(2));
+coll.aggregate([{$sort: {b: 1, _id: 1}}], {comment: "parallel_plan_summary"}).toArray();
+assert.commandWorked(db.setProfilingLevel(0));
+const profileEntry = db.system.profile.findOne({"command.comment": "parallel_plan_summary"});
+assert.neq(null, profileEntry);
+assert.eq("COLLSCAN", profileEntry.planSummary, profileEntry);
+assert(profileEntry.hasSortStage, profileEntry);
+
+// Errors raised on a worker are reported to the client.
+setParallelism(4);
+assert.commandWorked(coll.insert({_id: 5000, a: 1, b: "not a number"}));
+assert.throws(() => coll.aggregate([{$group: {_id: "$a", total: {$sum: {$add: ["$b", 1]}}}}])
+                        .toArray());
+
+MongoRunner.stopMongod(conn);
+}());
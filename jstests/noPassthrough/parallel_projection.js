@@ -0,0 +1,80 @@
+/**
+ * Tests that find projections computed by several threads return the same results, in the same
+ * order, as projections computed by the thread running the query.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryProjectionParallelBatchSize: 7}});
+assert.neq(null, conn, "mongod was unable to start up");
+
+const db = conn.getDB("test");
+const coll = db.parallel_projection;
+coll.drop();
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 500; ++i) {
+    bulk.insert({
+        _id: i,
+        a: i % 13,
+        arr: [{x: i, y: -i}, {x: i + 1, y: i % 5}, {x: i + 2, y: 0}],
+        str: "value" + i
+    });
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({a: 1, str: 1}));
+
+const queries = [
+    {filter: {}, projection: {arr: {$slice: [1, 1]}, str: 1}, sort: {_id: 1}},
+    {filter: {a: {$gte: 3}}, projection: {arr: {$elemMatch: {y: 0}}}, sort: {_id: -1}},
+    {filter: {"arr.x": {$gt: 250}}, projection: {"arr.$": 1}, sort: {_id: 1}},
+    {
+        filter: {},
+        projection: {
+            _id: 0,
+            total: {
+                $let: {vars: {first: {$arrayElemAt: ["$arr", 0]}}, in: {$add: ["$$first.x", 1]}}
+            },
+            doubled: {$map: {input: "$arr", as: "elem", in: {$multiply: ["$$elem.x", 2]}}}
+        },
+        sort: {_id: 1}
+    },
+    {filter: {a: 4}, projection: {_id: 0, a: 1, str: {$concat: ["$str", "!"]}}, sort: {str: 1}},
+];
+
+function runQueries(batchSize) {
+    return queries.map(query => coll.find(query.filter, query.projection)
+                                    .sort(query.sort)
+                                    .batchSize(batchSize)
+                                    .toArray());
+}
+
+function setParallelism(parallelism) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryProjectionParallelism: parallelism}));
+}
+
+setParallelism(1);
+const expected = runQueries(1000);
+
+for (let parallelism of [2, 4, 16]) {
+    setParallelism(parallelism);
+    for (let batchSize of [3, 101, 1000]) {
+        assert.eq(
+            expected, runQueries(batchSize), {parallelism: parallelism, batchSize: batchSize});
+    }
+}
+
+// Projections which need the OperationContext, like $$NOW, are evaluated by the query's thread
+// alone. Every result still sees the same value.
+const nowResults = coll.find({}, {_id: 0, now: "$$NOW"}).batchSize(101).toArray();
+assert.eq(500, nowResults.length);
+assert.eq(1, new Set(nowResults.map(doc => doc.now.getTime())).size, nowResults);
+
+// Errors raised while projecting on a worker thread are reported to the client.
+setParallelism(4);
+assert.commandWorked(coll.insert({_id: 1000, a: 4, str: 7}));
+assert.throws(() => coll.find({a: 4}, {str: {$concat: ["$str", "!"]}}).toArray());
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,65 @@
+/**
+ * Tests that a compound index can answer a predicate on a trailing field by skip-scanning over the
+ * distinct values of its leading field, and that the results match a collection scan. Skip scans
+ * are off by default and are enabled with internalQueryPlannerGenerateSkipScans.
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For arrayEq.
+load("jstests/libs/analyze_plan.js");         // For getPlanStage.
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryPlannerGenerateSkipScans: true}});
+const db = conn.getDB(jsTestName());
+const coll = db.skip_scan;
+coll.drop();
+
+const tenants = ["t1", "t2", "t3", "t4"];
+const docs = [];
+for (let i = 0; i < 400; ++i) {
+    docs.push({_id: i, tenant: tenants[i % tenants.length], b: i, c: i % 7});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({tenant: 1, b: 1}));
+
+function assertSkipScanResults(query) {
+    const explain = coll.find(query).hint({tenant: 1, b: 1}).explain("executionStats");
+    const ixscan = getPlanStage(explain.executionStats.executionStages, "IXSCAN");
+    assert.neq(null, ixscan, tojson(explain));
+    assert.eq(ixscan.indexBounds.tenant, ["[MinKey, MaxKey]"], tojson(explain));
+
+    const expected = coll.find(query).hint({$natural: 1}).toArray();
+    const actual = coll.find(query).hint({tenant: 1, b: 1}).toArray();
+    assert(arrayEq(expected, actual), tojson({expected: expected, actual: actual}));
+
+    // The scan should jump between tenants rather than examining every key.
+    assert.lt(ixscan.keysExamined, 400, tojson(explain));
+    return ixscan;
+}
+
+let ixscan = assertSkipScanResults({b: 200});
+assert.lte(ixscan.keysExamined, 2 * tenants.length + 1, tojson(ixscan));
+
+// Every predicate on the trailing field contributes to its bounds.
+ixscan = assertSkipScanResults({b: {$gte: 100, $lt: 110}});
+assert.eq(ixscan.indexBounds.b, ["[100, 110)"], tojson(ixscan));
+assertSkipScanResults({b: {$in: [5, 50, 500]}});
+assertSkipScanResults({b: {$gt: 390}, c: 3});
+
+// Without a hint the skip scan competes with, and here beats, a collection scan.
+const explain = coll.find({b: 17}).explain();
+assert.neq(null, getPlanStage(explain.queryPlanner.winningPlan, "IXSCAN"), tojson(explain));
+
+// Documents with a missing trailing field are indexed as null.
+assert.commandWorked(coll.insert({_id: 1000, tenant: "t1"}));
+assertSkipScanResults({b: null});
+
+// With the knob off, an unhinted query on the trailing field is a collection scan again.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryPlannerGenerateSkipScans: false}));
+coll.getPlanCache().clear();
+const explainOff = coll.find({b: 18}).explain();
+assert.eq(null, getPlanStage(explainOff.queryPlanner.winningPlan, "IXSCAN"), tojson(explainOff));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,92 @@
+/**
+ * Tests that a $text query sorted by text score with a limit returns the same top-scoring
+ * documents, with the same scores, whether or not the TEXT_OR stage stops reading postings early.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage.
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB(jsTestName());
+const coll = db.coll;
+
+const words = ["apple", "banana", "cherry", "date", "elder", "fig", "grape"];
+const docs = [];
+for (let i = 0; i < 500; ++i) {
+    const tokens = [];
+    for (let j = 0; j < words.length; ++j) {
+        for (let n = 0; n < (i * (j + 3)) % (j + 4); ++n) {
+            tokens.push(words[j]);
+        }
+    }
+    tokens.push("filler" + (i % 17));
+    docs.push({_id: i, title: words[i % words.length], body: tokens.join(" "), tag: i % 3});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(
+    coll.createIndex({tag: 1, title: "text", body: "text"}, {weights: {title: 3}}));
+
+const queries = [
+    {filter: {$text: {$search: "apple"}, tag: 1}, limit: 5},
+    {filter: {$text: {$search: "apple banana"}, tag: 0}, limit: 10},
+    {filter: {$text: {$search: "cherry date elder fig"}, tag: 2}, limit: 3, skip: 2},
+    {filter: {$text: {$search: "grape filler3"}, tag: 1}, limit: 50},
+    {filter: {$text: {$search: "nonexistent apple"}, tag: 0}, limit: 1},
+];
+
+function runQuery(query) {
+    let cursor = coll.find(query.filter, {score: {$meta: "textScore"}})
+                     .sort({score: {$meta: "textScore"}})
+                     .limit(query.limit);
+    if (query.skip) {
+        cursor = cursor.skip(query.skip);
+    }
+    return cursor.toArray();
+}
+
+function setTopK(enabled) {
+    assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryEnableTextTopK: enabled}));
+}
+
+for (const query of queries) {
+    setTopK(false);
+    const expected = runQuery(query);
+    const allScores = {};
+    coll.find(query.filter, {score: {$meta: "textScore"}}).forEach((doc) => {
+        allScores[doc._id] = doc.score;
+    });
+
+    setTopK(true);
+    const actual = runQuery(query);
+
+    // Documents with equal scores may be returned in either order, so compare the scores, and check
+    // that each document returned has the score it has without a limit.
+    assert.eq(expected.map((doc) => doc.score), actual.map((doc) => doc.score), tojson(query));
+    for (const doc of actual) {
+        assert.eq(allScores[doc._id], doc.score, tojson(query));
+    }
+
+    // Only the top documents are fetched.
+    const explain = coll.find(query.filter, {score: {$meta: "textScore"}})
+                        .sort({score: {$meta: "textScore"}})
+                        .limit(query.limit + (query.skip || 0))
+                        .explain("executionStats");
+    const textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+    assert.neq(null, textOr, tojson(explain));
+    assert.eq(query.limit + (query.skip || 0), textOr.topK, tojson(textOr));
+    assert.lte(textOr.docsExamined, textOr.topK, tojson(textOr));
+}
+
+// Queries whose results the TEXT_MATCH stage may filter are not limited.
+setTopK(true);
+const negated =
+    coll.find({$text: {$search: "apple -banana"}, tag: 0}, {score: {$meta: "textScore"}})
+        .sort({score: {$meta: "textScore"}})
+        .limit(3)
+        .explain("executionStats");
+const textOr = getPlanStage(negated.executionStats.executionStages, "TEXT_OR");
+assert.eq(undefined, textOr.topK, tojson(textOr));
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,94 @@
+/**
+ * Tests that operator-style updates leave every index with the same keys whether or not they skip
+ * updating the indexes which do not include any of the modified paths.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB(jsTestName());
+
+const indexes = [
+    {key: {a: 1}},
+    {key: {b: 1, a: 1}},
+    {key: {"c.d": 1}},
+    {key: {e: 1}, partialFilterExpression: {f: {$gt: 0}}},
+    {key: {"w.$**": 1}},
+    {key: {t: "text"}},
+];
+
+const updates = [
+    [{}, {$set: {b: 5}}],
+    [{_id: {$lt: 10}}, {$inc: {"c.d": 1}}],
+    [{"c.0": {$exists: true}}, {$set: {"c.0.d": 7}}],
+    [{"c.0": {$exists: true}}, {$set: {"c.5.d": 1}}],
+    [{_id: {$mod: [3, 0]}}, {$set: {f: 1}}],
+    [{_id: {$mod: [4, 0]}}, {$set: {language: "spanish"}}],
+    [{_id: {$mod: [5, 0]}}, {$set: {"sub.language": "french"}}],
+    [{_id: {$mod: [2, 0]}}, {$rename: {g: "a"}}],
+    [{_id: {$mod: [7, 0]}}, {$unset: {b: 1}}],
+    [{}, {$push: {arr: 1}}],
+    [{}, {$set: {"w.x": 3, unindexed: 4}}],
+    [{}, {$inc: {counter: 1}}],
+];
+
+function runUpdates(skipUnaffectedIndexes) {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalQueryUpdateSkipUnaffectedIndexes: skipUnaffectedIndexes}));
+
+    const coll = db["coll_" + skipUnaffectedIndexes];
+    coll.drop();
+    for (let spec of indexes) {
+        const options = spec.partialFilterExpression
+            ? {partialFilterExpression: spec.partialFilterExpression}
+            : {};
+        assert.commandWorked(coll.createIndex(spec.key, options));
+    }
+
+    const docs = [];
+    for (let i = 0; i < 40; ++i) {
+        docs.push({
+            _id: i,
+            a: i % 6,
+            c: i % 2 === 0 ? {d: i} : [{d: i}, {d: i + 1}],
+            e: i,
+            g: "g" + i,
+            w: {x: i, y: [i]},
+            t: "the quick brown fox jumps " + i,
+            sub: {t: "el rapido zorro", language: "spanish"},
+        });
+    }
+    assert.commandWorked(coll.insert(docs));
+
+    for (let [query, update] of updates) {
+        assert.commandWorked(coll.update(query, update, {multi: true}));
+    }
+
+    const validateRes = coll.validate({full: true});
+    assert(validateRes.valid, tojson(validateRes));
+    return coll;
+}
+
+const withoutSkipping = runUpdates(false);
+const withSkipping = runUpdates(true);
+
+assert.eq(withoutSkipping.find().sort({_id: 1}).toArray(),
+          withSkipping.find().sort({_id: 1}).toArray());
+for (let spec of indexes) {
+    if (spec.key.t === "text") {
+        continue;
+    }
+    let query = spec.partialFilterExpression || {};
+    assert.eq(withoutSkipping.find(query).hint(spec.key).returnKey().toArray(),
+              withSkipping.find(query).hint(spec.key).returnKey().toArray(),
+              tojson(spec.key));
+}
+for (let term of ["quick", "rapido", "zorro"]) {
+    const query = {$text: {$search: term}};
+    assert.eq(withoutSkipping.find(query, {_id: 1}).sort({_id: 1}).toArray(),
+              withSkipping.find(query, {_id: 1}).sort({_id: 1}).toArray(),
+              term);
+}
+
+MongoRunner.stopMongod(conn);
+}());
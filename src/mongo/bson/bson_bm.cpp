@@ -31,7 +31,10 @@
 
 #include <benchmark/benchmark.h>
 
+#include "mongo/bson/bson_validate.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
+#include "mongo/bson/oid.h"
 
 namespace mongo {
 
@@ -63,7 +66,138 @@ void BM_arrayLookup(benchmark::State& state) {
     state.SetItemsProcessed(totalLen);
 }
 
+/**
+ * Builds a document resembling an order in an e-commerce application, with a nested customer,
+ * an array of line items, and 'numItems' line items.
+ */
+BSONObj buildOrderDocument(int numItems) {
+    BSONObjBuilder builder;
+    builder.append("_id", OID::gen());
+    builder.append("status", "shipped");
+    builder.append("createdAt", Date_t::fromMillisSinceEpoch(1'580'000'000'000));
+    builder.append("total", 1234.56);
+    {
+        BSONObjBuilder customer(builder.subobjStart("customer"));
+        customer.append("name", "Jane Customer");
+        customer.append("email", "jane.customer@example.com");
+        BSONObjBuilder address(customer.subobjStart("address"));
+        address.append("street", "1600 Example Avenue");
+        address.append("city", "Springfield");
+        address.append("postalCode", "12345");
+    }
+    {
+        BSONArrayBuilder items(builder.subarrayStart("items"));
+        for (int i = 0; i < numItems; ++i) {
+            BSONObjBuilder item(items.subobjStart());
+            item.append("sku", "SKU-" + std::to_string(100'000 + i));
+            item.append("quantity", i % 5 + 1);
+            item.append("unitPrice", 9.99 + i);
+            item.append("giftWrapped", i % 7 == 0);
+        }
+    }
+    builder.append("notes", std::string(200, 'n'));
+    return builder.obj();
+}
+
+/**
+ * Builds a document of 'numFields' top-level numeric fields with names like those of a metrics
+ * sample.
+ */
+BSONObj buildMetricsDocument(int numFields) {
+    BSONObjBuilder builder;
+    builder.append("_id", OID::gen());
+    for (int i = 0; i < numFields; ++i) {
+        builder.append("metric_" + std::to_string(i), static_cast<long long>(i) * 1'000);
+    }
+    return builder.obj();
+}
+
+void runValidateBenchmark(benchmark::State& state, const BSONObj& obj) {
+    size_t totalBytes = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest).isOK());
+        totalBytes += obj.objsize();
+    }
+    state.SetBytesProcessed(totalBytes);
+}
+
+void BM_validateOrder(benchmark::State& state) {
+    runValidateBenchmark(state, buildOrderDocument(state.range(0)));
+}
+
+void BM_validateMetrics(benchmark::State& state) {
+    runValidateBenchmark(state, buildMetricsDocument(state.range(0)));
+}
+
+void BM_validateLongStrings(benchmark::State& state) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < 10; ++i) {
+        builder.append("field_with_a_long_descriptive_name_" + std::to_string(i),
+                       std::string(state.range(0), 's'));
+    }
+    runValidateBenchmark(state, builder.obj());
+}
+
+void runFromJsonBenchmark(benchmark::State& state, const BSONObj& obj, JsonStringFormat format) {
+    const std::string json = obj.jsonString(format);
+    size_t totalBytes = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(fromjson(json));
+        totalBytes += json.size();
+    }
+    state.SetBytesProcessed(totalBytes);
+}
+
+void runJsonStringBenchmark(benchmark::State& state, const BSONObj& obj, JsonStringFormat format) {
+    size_t totalBytes = 0;
+    for (auto _ : state) {
+        std::string json = obj.jsonString(format);
+        totalBytes += json.size();
+        benchmark::DoNotOptimize(json);
+    }
+    state.SetBytesProcessed(totalBytes);
+}
+
+void BM_fromjsonOrder(benchmark::State& state) {
+    runFromJsonBenchmark(state, buildOrderDocument(state.range(0)), Strict);
+}
+
+void BM_fromjsonOrderCanonical(benchmark::State& state) {
+    runFromJsonBenchmark(state, buildOrderDocument(state.range(0)), ExtendedCanonical);
+}
+
+void BM_fromjsonMetrics(benchmark::State& state) {
+    runFromJsonBenchmark(state, buildMetricsDocument(state.range(0)), Strict);
+}
+
+void BM_jsonStringOrder(benchmark::State& state) {
+    runJsonStringBenchmark(state, buildOrderDocument(state.range(0)), Strict);
+}
+
+void BM_jsonStringOrderCanonical(benchmark::State& state) {
+    runJsonStringBenchmark(state, buildOrderDocument(state.range(0)), ExtendedCanonical);
+}
+
+void BM_jsonStringOrderRelaxed(benchmark::State& state) {
+    runJsonStringBenchmark(state, buildOrderDocument(state.range(0)), ExtendedRelaxed);
+}
+
+void BM_jsonStringMetrics(benchmark::State& state) {
+    runJsonStringBenchmark(state, buildMetricsDocument(state.range(0)), Strict);
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
+BENCHMARK(BM_validateOrder)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_validateMetrics)->Arg(10)->Arg(100)->Arg(1'000);
+BENCHMARK(BM_validateLongStrings)->Arg(10)->Arg(1'000)->Arg(100'000);
+BENCHMARK(BM_fromjsonOrder)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_fromjsonOrderCanonical)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_fromjsonMetrics)->Arg(10)->Arg(100)->Arg(1'000);
+BENCHMARK(BM_jsonStringOrder)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_jsonStringOrderCanonical)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_jsonStringOrderRelaxed)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_jsonStringMetrics)->Arg(10)->Arg(100)->Arg(1'000);
 
 }  // namespace mongo
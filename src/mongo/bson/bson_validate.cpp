@@ -27,21 +27,72 @@
  *    it in the license file.
  */
 
+#include <array>
 #include <cstring>
 #include <limits>
 #include <vector>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "mongo/base/data_view.h"
 #include "mongo/bson/bson_depth.h"
 #include "mongo/bson/bson_validate.h"
 #include "mongo/bson/oid.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/platform/bits.h"
 #include "mongo/platform/decimal128.h"
 
 namespace mongo {
 
 namespace {
 
+/**
+ * Returns a pointer to the first NUL byte among the 'len' bytes at 'data', or nullptr if there is
+ * none. Field names are usually shorter than 16 bytes, so the first 16 bytes are compared inline
+ * with SSE2 rather than through a call to memchr, which handles the rest.
+ */
+const char* findNul(const char* data, uint64_t len) {
+#if defined(__SSE2__)
+    if (len >= 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_setzero_si128()));
+        if (mask != 0) {
+            return data + countTrailingZeros64(mask);
+        }
+        data += 16;
+        len -= 16;
+    }
+#endif
+    return static_cast<const char*>(memchr(data, 0, len));
+}
+
+/**
+ * Sizes of the values of the BSON types whose values are a fixed number of bytes which need no
+ * checking, indexed by type byte. Other types have a size of -1.
+ */
+constexpr std::array<int8_t, 256> makeFixedValueSizes() {
+    std::array<int8_t, 256> sizes{};
+    for (auto& size : sizes) {
+        size = -1;
+    }
+    sizes[static_cast<uint8_t>(MinKey)] = 0;
+    sizes[static_cast<uint8_t>(MaxKey)] = 0;
+    sizes[static_cast<uint8_t>(jstNULL)] = 0;
+    sizes[static_cast<uint8_t>(Undefined)] = 0;
+    sizes[static_cast<uint8_t>(jstOID)] = OID::kOIDSize;
+    sizes[static_cast<uint8_t>(NumberInt)] = sizeof(int32_t);
+    sizes[static_cast<uint8_t>(NumberDouble)] = sizeof(int64_t);
+    sizes[static_cast<uint8_t>(NumberLong)] = sizeof(int64_t);
+    sizes[static_cast<uint8_t>(bsonTimestamp)] = sizeof(int64_t);
+    sizes[static_cast<uint8_t>(Date)] = sizeof(int64_t);
+    sizes[static_cast<uint8_t>(NumberDecimal)] = sizeof(Decimal128::Value);
+    return sizes;
+}
+
+constexpr std::array<int8_t, 256> kFixedValueSizes = makeFixedValueSizes();
+
 /**
  * Creates a status with InvalidBSON code and adds information about _id if available.
  * WARNING: only pass in a non-EOO idElem if it has been fully validated already!
@@ -90,10 +141,10 @@ public:
      * reading, if it exists. Otherwise, it should be empty.
      */
     Status readCString(StringData elemName, StringData* out) {
-        const void* x = memchr(_buffer + _position, 0, _maxLength - _position);
+        const char* x = findNul(_buffer + _position, _maxLength - _position);
         if (!x)
             return makeError("no end of c-string", _idElem, elemName);
-        uint64_t len = static_cast<uint64_t>(static_cast<const char*>(x) - (_buffer + _position));
+        uint64_t len = static_cast<uint64_t>(x - (_buffer + _position));
 
         StringData data(_buffer + _position, len);
         _position += len + 1;
@@ -119,18 +170,16 @@ public:
             return makeError("invalid bson", _idElem, elemName);
         }
 
+        // Check the bounds of the whole string, including its terminating NUL, at once.
+        if (_position + sz > _maxLength)
+            return makeError("invalid bson", _idElem, elemName);
+
         if (out) {
             *out = StringData(_buffer + _position, sz);
         }
 
-        if (!skip(sz - 1))
-            return makeError("invalid bson", _idElem, elemName);
-
-        char c;
-        if (!readNumber<char>(&c))
-            return makeError("invalid bson", _idElem, elemName);
-
-        if (c != 0)
+        _position += sz;
+        if (_buffer[_position - 1] != 0)
             return makeError("not null terminated string", _idElem, elemName);
 
         return Status::OK();
@@ -220,23 +269,18 @@ Status validateElementInfo(Buffer* buffer,
     if (!status.isOK())
         return status;
 
-    switch (type) {
-        case MinKey:
-        case MaxKey:
-        case jstNULL:
-        case Undefined:
-            return Status::OK();
-
-        case jstOID:
-            if (!buffer->skip(OID::kOIDSize))
-                return makeError("invalid bson", idElem, *elemName);
-            return Status::OK();
-
-        case NumberInt:
-            if (!buffer->skip(sizeof(int32_t)))
-                return makeError("invalid bson", idElem, *elemName);
-            return Status::OK();
+    // Most elements have a value of a fixed size, which only needs a bounds check.
+    const int fixedValueSize = kFixedValueSizes[static_cast<uint8_t>(type)];
+    if (fixedValueSize == 0)
+        return Status::OK();
+    if (fixedValueSize > 0) {
+        if (!buffer->skip(fixedValueSize))
+            return makeError(
+                type == NumberDecimal ? "Invalid bson" : "invalid bson", idElem, *elemName);
+        return Status::OK();
+    }
 
+    switch (type) {
         case Bool:
             uint8_t val;
             if (!buffer->readNumber(&val))
@@ -245,19 +289,6 @@ Status validateElementInfo(Buffer* buffer,
                 return makeError("invalid boolean value", idElem, *elemName);
             return Status::OK();
 
-        case NumberDouble:
-        case NumberLong:
-        case bsonTimestamp:
-        case Date:
-            if (!buffer->skip(sizeof(int64_t)))
-                return makeError("invalid bson", idElem, *elemName);
-            return Status::OK();
-
-        case NumberDecimal:
-            if (!buffer->skip(sizeof(Decimal128::Value)))
-                return makeError("Invalid bson", idElem, *elemName);
-            return Status::OK();
-
         case DBRef:
             status = buffer->readUTF8String(*elemName, nullptr);
             if (!status.isOK())
@@ -359,5 +359,51 @@ TEST(BSONValidateFast, InvalidType) {
     ASSERT_THROWS_CODE(obj.woCompare(BSON("A" << 1)), DBException, 10320);
 }
 
+TEST(BSONValidateFast, FieldNamesOfAnyLength) {
+    // Field names end on either side of the first 16 bytes scanned for their terminating NUL.
+    for (size_t len = 0; len < 40; ++len) {
+        const std::string fieldName(len, 'f');
+        const BSONObj obj = BSON(fieldName << 1 << "next" << fieldName);
+        ASSERT_OK(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+
+        // Without its NUL, the field name runs past the end of the buffer.
+        BufBuilder bb;
+        bb.appendNum(0);
+        bb.appendChar(NumberInt);
+        bb.appendStr(fieldName, /*withNUL*/ false);
+        DataView(bb.buf()).write(tagLittleEndian(bb.len()));
+        const Status status = validateBSON(bb.buf(), bb.len(), BSONVersion::kLatest);
+        ASSERT_NOT_OK(status);
+        ASSERT_EQUALS(status.reason(), "no end of c-string in object with unknown _id");
+    }
+}
+
+TEST(BSONValidateFast, FixedSizeValuesPastEndOfBuffer) {
+    const BSONObj obj = BSON("_id" << 1 << "d" << 1.5 << "n" << Decimal128("1.5"));
+    ASSERT_OK(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+
+    // Cut the buffer short within the value of each element after _id.
+    const int doubleEnd = obj.objsize() - 1 - obj["n"].size();
+    Status status = validateBSON(obj.objdata(), doubleEnd - 1, BSONVersion::kLatest);
+    ASSERT_NOT_OK(status);
+    ASSERT_EQUALS(status.reason(),
+                  "invalid bson in element with field name 'd' in object with _id: 1");
+
+    status = validateBSON(obj.objdata(), obj.objsize() - 2, BSONVersion::kLatest);
+    ASSERT_NOT_OK(status);
+    ASSERT_EQUALS(status.reason(),
+                  "Invalid bson in element with field name 'n' in object with _id: 1");
+}
+
+TEST(BSONValidateFast, StringPastEndOfBuffer) {
+    const BSONObj obj = BSON("s"
+                             << "abcdef");
+    ASSERT_OK(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+
+    Status status = validateBSON(obj.objdata(), obj.objsize() - 2, BSONVersion::kLatest);
+    ASSERT_NOT_OK(status);
+    ASSERT_EQUALS(status.reason(),
+                  "invalid bson in element with field name 's' in object with unknown _id");
+}
 
 }  // namespace
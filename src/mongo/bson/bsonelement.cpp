@@ -31,8 +31,11 @@
 
 #include "mongo/bson/bsonelement.h"
 
+#include <algorithm>
 #include <boost/functional/hash.hpp>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <fmt/format.h>
 
 #include "mongo/base/compare_numbers.h"
@@ -48,6 +51,7 @@
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 #include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
 #include "mongo/util/uuid.h"
 
 #if !defined(__has_feature)
@@ -69,20 +73,56 @@ string BSONElement::jsonString(JsonStringFormat format, bool includeFieldNames,
     return s.str();
 }
 
+namespace {
+
+/**
+ * Writes the finite double 'd' with the fewest significant digits, up to 17, which parse back to
+ * the same value, and with a decimal point or exponent so that it reads back as a double.
+ */
+void writeExtendedJsonDouble(double d, std::stringstream& s) {
+    char buffer[32];
+    for (int precision = 15; precision <= 17; ++precision) {
+        snprintf(buffer, sizeof(buffer), "%.*g", precision, d);
+        if (precision == 17 || strtod(buffer, nullptr) == d) {
+            break;
+        }
+    }
+    s << buffer;
+    if (!strpbrk(buffer, ".e")) {
+        s << ".0";
+    }
+}
+
+}  // namespace
+
 void BSONElement::jsonStringStream(JsonStringFormat format,
                                    bool includeFieldNames,
                                    int pretty,
                                    std::stringstream& s) const {
-    if (includeFieldNames)
-        s << '"' << str::escape(fieldName()) << "\" : ";
+    const bool extended = format == ExtendedCanonical || format == ExtendedRelaxed;
+    if (includeFieldNames) {
+        s << '"';
+        str::escape(s, fieldNameStringData());
+        s << "\" : ";
+    }
     switch (type()) {
-        case mongo::String:
         case Symbol:
-            s << '"' << str::escape(string(valuestr(), valuestrsize() - 1)) << '"';
+            if (extended) {
+                s << "{ \"$symbol\" : \"";
+                str::escape(s, StringData(valuestr(), valuestrsize() - 1));
+                s << "\" }";
+                break;
+            }
+        case mongo::String:
+            s << '"';
+            str::escape(s, StringData(valuestr(), valuestrsize() - 1));
+            s << '"';
             break;
         case NumberLong:
             if (format == TenGen) {
                 s << "NumberLong(" << _numberLong() << ")";
+            } else if (format == ExtendedRelaxed) {
+                s << _numberLong();
             } else {
                 s << "{ \"$numberLong\" : \"" << _numberLong() << "\" }";
             }
@@ -92,9 +132,34 @@ void BSONElement::jsonStringStream(JsonStringFormat format,
                 s << "NumberInt(" << _numberInt() << ")";
                 break;
             }
+            if (format == ExtendedCanonical) {
+                s << "{ \"$numberInt\" : \"" << _numberInt() << "\" }";
+                break;
+            }
+            if (format == ExtendedRelaxed) {
+                s << _numberInt();
+                break;
+            }
         case NumberDouble:
-            if (number() >= -std::numeric_limits<double>::max() &&
-                number() <= std::numeric_limits<double>::max()) {
+            if (extended) {
+                // Extended JSON represents every double exactly, and non-finite ones as strings.
+                const double d = number();
+                const bool finite = std::isfinite(d);
+                if (format == ExtendedCanonical || !finite) {
+                    s << "{ \"$numberDouble\" : \"";
+                }
+                if (std::isnan(d)) {
+                    s << "NaN";
+                } else if (std::isinf(d)) {
+                    s << (d > 0 ? "Infinity" : "-Infinity");
+                } else {
+                    writeExtendedJsonDouble(d, s);
+                }
+                if (format == ExtendedCanonical || !finite) {
+                    s << "\" }";
+                }
+            } else if (number() >= -std::numeric_limits<double>::max() &&
+                       number() <= std::numeric_limits<double>::max()) {
                 auto origPrecision = s.precision();
                 auto guard = makeGuard([&s, origPrecision]() { s.precision(origPrecision); });
                 s.precision(16);
@@ -140,7 +205,7 @@ void BSONElement::jsonStringStream(JsonStringFormat format,
             s << "null";
             break;
         case Undefined:
-            if (format == Strict) {
+            if (format != TenGen) {
                 s << "{ \"$undefined\" : true }";
             } else {
                 s << "undefined";
@@ -185,6 +250,13 @@ void BSONElement::jsonStringStream(JsonStringFormat format,
             break;
         }
         case DBRef: {
+            if (extended) {
+                s << "{ \"$dbPointer\" : { \"$ref\" : \"";
+                str::escape(s, StringData(valuestr(), valuestrsize() - 1));
+                s << "\", \"$id\" : { \"$oid\" : \""
+                  << mongo::OID::from(valuestr() + valuestrsize()) << "\" } } }";
+                break;
+            }
             if (format == TenGen)
                 s << "Dbref( ";
             else
@@ -217,7 +289,7 @@ void BSONElement::jsonStringStream(JsonStringFormat format,
             const int len = reader.readAndAdvance<LittleEndian<int>>();
             BinDataType type = static_cast<BinDataType>(reader.readAndAdvance<uint8_t>());
 
-            s << "{ \"$binary\" : \"";
+            s << (extended ? "{ \"$binary\" : { \"base64\" : \"" : "{ \"$binary\" : \"");
             base64::encode(s, reader.view(), len);
 
             auto origFill = s.fill();
@@ -231,15 +303,26 @@ void BSONElement::jsonStringStream(JsonStringFormat format,
 
             s.setf(std::ios_base::hex, std::ios_base::basefield);
 
-            s << "\", \"$type\" : \"";
+            s << (extended ? "\", \"subType\" : \"" : "\", \"$type\" : \"");
             s.width(2);
             s.fill('0');
             s << type;
-            s << "\" }";
+            s << (extended ? "\" } }" : "\" }");
             break;
         }
         case mongo::Date:
-            if (format == Strict) {
+            if (extended) {
+                Date_t d = date();
+                s << "{ \"$date\" : ";
+                if (format == ExtendedRelaxed && d.isFormattable()) {
+                    s << '"';
+                    outputDateAsISOStringUTC(s, d);
+                    s << '"';
+                } else {
+                    s << "{ \"$numberLong\" : \"" << d.toMillisSinceEpoch() << "\" }";
+                }
+                s << " }";
+            } else if (format == Strict) {
                 Date_t d = date();
                 s << "{ \"$date\" : ";
                 // The two cases in which we cannot convert Date_t::millis to an ISO Date string are
@@ -278,7 +361,14 @@ void BSONElement::jsonStringStream(JsonStringFormat format,
             }
             break;
         case RegEx:
-            if (format == Strict) {
+            if (extended) {
+                // Extended JSON lists the options in alphabetical order.
+                std::string flags(regexFlags());
+                std::sort(flags.begin(), flags.end());
+                s << "{ \"$regularExpression\" : { \"pattern\" : \"";
+                str::escape(s, regex());
+                s << "\", \"options\" : \"" << flags << "\" } }";
+            } else if (format == Strict) {
                 s << "{ \"$regex\" : \"" << str::escape(regex());
                 s << "\", \"$options\" : \"" << regexFlags() << "\" }";
             } else {
@@ -300,6 +390,14 @@ void BSONElement::jsonStringStream(JsonStringFormat format,
 
         case CodeWScope: {
             BSONObj scope = codeWScopeObject();
+            if (extended) {
+                s << "{ \"$code\" : \"";
+                str::escape(s, _asCode());
+                s << "\", \"$scope\" : ";
+                scope.jsonStringStream(format, pretty, false, s);
+                s << " }";
+                break;
+            }
             if (!scope.isEmpty()) {
                 s << "{ \"$code\" : \"" << str::escape(_asCode()) << "\" , "
                   << "\"$scope\" : " << scope.jsonString() << " }";
@@ -308,6 +406,12 @@ void BSONElement::jsonStringStream(JsonStringFormat format,
         }
 
         case Code:
+            if (extended) {
+                s << "{ \"$code\" : \"";
+                str::escape(s, _asCode());
+                s << "\" }";
+                break;
+            }
             s << "\"" << str::escape(_asCode()) << "\"";
             break;
 
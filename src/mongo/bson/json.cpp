@@ -34,8 +34,13 @@
 #include <cstdint>
 #include <fmt/format.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "mongo/base/parse_number.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/platform/bits.h"
 #include "mongo/platform/decimal128.h"
 #include "mongo/platform/strtoll.h"
 #include "mongo/util/base64.h"
@@ -70,8 +75,8 @@ enum {
     ID_RESERVE_SIZE = 64,
     PAT_RESERVE_SIZE = 4096,
     OPT_RESERVE_SIZE = 64,
-    FIELD_RESERVE_SIZE = 4096,
-    STRINGVAL_RESERVE_SIZE = 4096,
+    FIELD_RESERVE_SIZE = 64,
+    STRINGVAL_RESERVE_SIZE = 64,
     BINDATA_RESERVE_SIZE = 4096,
     BINDATATYPE_RESERVE_SIZE = 4096,
     NS_RESERVE_SIZE = 64,
@@ -81,6 +86,43 @@ enum {
     DATE_RESERVE_SIZE = 64
 };
 
+namespace {
+
+/**
+ * Returns a pointer to the first character in [begin, end) which is 'quote', a backslash or a
+ * control character, or 'end' if there is none. Every other character of a quoted string is
+ * copied unchanged, so runs of them can be copied at once. Compares 16 characters at a time with
+ * SSE2 where available.
+ */
+const char* findSpecialStringChar(const char* begin, const char* end, char quote) {
+    const char* p = begin;
+#if defined(__SSE2__)
+    const __m128i quotes = _mm_set1_epi8(quote);
+    const __m128i backslashes = _mm_set1_epi8('\\');
+    const __m128i maxControl = _mm_set1_epi8(0x1F);
+    for (; end - p >= 16; p += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        // An unsigned byte is at most 0x1F exactly when its minimum with 0x1F is itself.
+        const __m128i special =
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quotes),
+                                      _mm_cmpeq_epi8(chunk, backslashes)),
+                         _mm_cmpeq_epi8(_mm_min_epu8(chunk, maxControl), chunk));
+        const int mask = _mm_movemask_epi8(special);
+        if (mask != 0) {
+            return p + countTrailingZeros64(mask);
+        }
+    }
+#endif
+    for (; p < end; ++p) {
+        if (*p == quote || *p == '\\' || (0x00 <= *p && *p <= 0x1F)) {
+            break;
+        }
+    }
+    return p;
+}
+
+}  // namespace
+
 static const char *LBRACE = "{", *RBRACE = "}", *LBRACKET = "[", *RBRACKET = "]", *LPAREN = "(",
                   *RPAREN = ")", *COLON = ":", *COMMA = ",", *FORWARDSLASH = "/",
                   *SINGLEQUOTE = "'", *DOUBLEQUOTE = "\"";
@@ -100,6 +142,25 @@ Status JParse::parseError(StringData msg) {
 
 Status JParse::value(StringData fieldName, BSONObjBuilder& builder) {
     MONGO_JSON_DEBUG("fieldName: " << fieldName);
+
+    // No keyword starts with a digit, a sign, a decimal point or a quote, so numbers and strings,
+    // the most common values, need not be compared against each keyword first.
+    const char next = peekChar();
+    if ((next >= '0' && next <= '9') || next == '.' || next == '+' ||
+        (next == '-' && !peekToken("-Infinity"))) {
+        return number(fieldName, builder);
+    }
+    if (next == '"' || next == '\'') {
+        std::string valueString;
+        valueString.reserve(STRINGVAL_RESERVE_SIZE);
+        Status ret = quotedString(&valueString);
+        if (ret != Status::OK()) {
+            return ret;
+        }
+        builder.append(fieldName, valueString);
+        return Status::OK();
+    }
+
     if (peekToken(LBRACE)) {
         Status ret = object(fieldName, builder);
         if (ret != Status::OK()) {
@@ -285,6 +346,54 @@ Status JParse::object(StringData fieldName, BSONObjBuilder& builder, bool subObj
         if (ret != Status::OK()) {
             return ret;
         }
+    } else if (firstField == "$numberInt") {
+        if (!subObject) {
+            return parseError("Reserved field name in base object: $numberInt");
+        }
+        Status ret = numberIntObject(fieldName, builder);
+        if (ret != Status::OK()) {
+            return ret;
+        }
+    } else if (firstField == "$numberDouble") {
+        if (!subObject) {
+            return parseError("Reserved field name in base object: $numberDouble");
+        }
+        Status ret = numberDoubleObject(fieldName, builder);
+        if (ret != Status::OK()) {
+            return ret;
+        }
+    } else if (firstField == "$regularExpression") {
+        if (!subObject) {
+            return parseError("Reserved field name in base object: $regularExpression");
+        }
+        Status ret = regularExpressionObject(fieldName, builder);
+        if (ret != Status::OK()) {
+            return ret;
+        }
+    } else if (firstField == "$dbPointer") {
+        if (!subObject) {
+            return parseError("Reserved field name in base object: $dbPointer");
+        }
+        Status ret = dbPointerObject(fieldName, builder);
+        if (ret != Status::OK()) {
+            return ret;
+        }
+    } else if (firstField == "$symbol") {
+        if (!subObject) {
+            return parseError("Reserved field name in base object: $symbol");
+        }
+        Status ret = symbolObject(fieldName, builder);
+        if (ret != Status::OK()) {
+            return ret;
+        }
+    } else if (firstField == "$code") {
+        if (!subObject) {
+            return parseError("Reserved field name in base object: $code");
+        }
+        Status ret = codeObject(fieldName, builder);
+        if (ret != Status::OK()) {
+            return ret;
+        }
     } else if (firstField == "$minKey") {
         if (!subObject) {
             return parseError("Reserved field name in base object: $minKey");
@@ -365,6 +474,18 @@ Status JParse::binaryObject(StringData fieldName, BSONObjBuilder& builder) {
     if (!readToken(COLON)) {
         return parseError("Expected ':'");
     }
+
+    // Extended JSON v2 nests the data and its type in an object.
+    const bool isNested = readToken(LBRACE);
+    if (isNested) {
+        if (!readField("base64")) {
+            return parseError("Expected first field name: \"base64\", in \"$binary\" object");
+        }
+        if (!readToken(COLON)) {
+            return parseError("Expected ':'");
+        }
+    }
+
     std::string binDataString;
     binDataString.reserve(BINDATA_RESERVE_SIZE);
     Status dataRet = quotedString(&binDataString);
@@ -382,7 +503,12 @@ Status JParse::binaryObject(StringData fieldName, BSONObjBuilder& builder) {
         return parseError("Expected ','");
     }
 
-    if (!readField("$type")) {
+    if (isNested) {
+        if (!readField("subType")) {
+            return parseError(
+                "Expected second field name: \"subType\", in \"$binary\" object");
+        }
+    } else if (!readField("$type")) {
         return parseError("Expected second field name: \"$type\", in \"$binary\" object");
     }
     if (!readToken(COLON)) {
@@ -394,6 +520,15 @@ Status JParse::binaryObject(StringData fieldName, BSONObjBuilder& builder) {
     if (typeRet != Status::OK()) {
         return typeRet;
     }
+    if (isNested) {
+        if (!readToken(RBRACE)) {
+            return parseError("Expecting '}'");
+        }
+        // Extended JSON v2 allows a single hex digit for the subtype.
+        if (binDataType.size() == 1) {
+            binDataType.insert(binDataType.begin(), '0');
+        }
+    }
     if ((binDataType.size() != 2) || !isHexString(binDataType)) {
         return parseError(
             "Argument of $type in $bindata object must be a hex string representation of a single "
@@ -667,6 +802,199 @@ Status JParse::numberDecimalObject(StringData fieldName, BSONObjBuilder& builder
     return Status::OK();
 }
 
+Status JParse::numberIntObject(StringData fieldName, BSONObjBuilder& builder) {
+    if (!readToken(COLON)) {
+        return parseError("Expecting ':'");
+    }
+    std::string numberIntString;
+    numberIntString.reserve(NUMBERLONG_RESERVE_SIZE);
+    Status ret = quotedString(&numberIntString);
+    if (!ret.isOK()) {
+        return ret;
+    }
+
+    int numberInt;
+    ret = NumberParser{}(numberIntString, &numberInt);
+    if (!ret.isOK()) {
+        return ret;
+    }
+
+    builder.append(fieldName, numberInt);
+    return Status::OK();
+}
+
+Status JParse::numberDoubleObject(StringData fieldName, BSONObjBuilder& builder) {
+    if (!readToken(COLON)) {
+        return parseError("Expecting ':'");
+    }
+    // The number is a quoted string so that it may also be Infinity, -Infinity or NaN
+    std::string numberDoubleString;
+    numberDoubleString.reserve(NUMBERLONG_RESERVE_SIZE);
+    Status ret = quotedString(&numberDoubleString);
+    if (!ret.isOK()) {
+        return ret;
+    }
+
+    double numberDouble;
+    if (numberDoubleString == "Infinity") {
+        numberDouble = std::numeric_limits<double>::infinity();
+    } else if (numberDoubleString == "-Infinity") {
+        numberDouble = -std::numeric_limits<double>::infinity();
+    } else if (numberDoubleString == "NaN") {
+        numberDouble = std::numeric_limits<double>::quiet_NaN();
+    } else {
+        ret = NumberParser{}(numberDoubleString, &numberDouble);
+        if (!ret.isOK()) {
+            return ret;
+        }
+    }
+
+    builder.append(fieldName, numberDouble);
+    return Status::OK();
+}
+
+Status JParse::regularExpressionObject(StringData fieldName, BSONObjBuilder& builder) {
+    if (!readToken(COLON)) {
+        return parseError("Expecting ':'");
+    }
+    if (!readToken(LBRACE)) {
+        return parseError("Expecting '{'");
+    }
+    if (!readField("pattern")) {
+        return parseError("Expected field name: \"pattern\" in \"$regularExpression\" object");
+    }
+    if (!readToken(COLON)) {
+        return parseError("Expecting ':'");
+    }
+    std::string pat;
+    pat.reserve(PAT_RESERVE_SIZE);
+    Status ret = quotedString(&pat);
+    if (ret != Status::OK()) {
+        return ret;
+    }
+    if (!readToken(COMMA)) {
+        return parseError("Expecting ','");
+    }
+    if (!readField("options")) {
+        return parseError("Expected field name: \"options\" in \"$regularExpression\" object");
+    }
+    if (!readToken(COLON)) {
+        return parseError("Expecting ':'");
+    }
+    std::string opt;
+    opt.reserve(OPT_RESERVE_SIZE);
+    ret = quotedString(&opt);
+    if (ret != Status::OK()) {
+        return ret;
+    }
+    Status optCheckRet = regexOptCheck(opt);
+    if (optCheckRet != Status::OK()) {
+        return optCheckRet;
+    }
+    if (!readToken(RBRACE)) {
+        return parseError("Expecting '}'");
+    }
+    builder.appendRegex(fieldName, pat, opt);
+    return Status::OK();
+}
+
+Status JParse::dbPointerObject(StringData fieldName, BSONObjBuilder& builder) {
+    if (!readToken(COLON)) {
+        return parseError("Expecting ':'");
+    }
+    if (!readToken(LBRACE)) {
+        return parseError("Expecting '{'");
+    }
+    if (!readField("$ref")) {
+        return parseError("Expected field name: \"$ref\" in \"$dbPointer\" object");
+    }
+    if (!readToken(COLON)) {
+        return parseError("Expecting ':'");
+    }
+    std::string ns;
+    ns.reserve(NS_RESERVE_SIZE);
+    Status ret = quotedString(&ns);
+    if (ret != Status::OK()) {
+        return ret;
+    }
+    if (!readToken(COMMA)) {
+        return parseError("Expecting ','");
+    }
+    if (!readField("$id")) {
+        return parseError("Expected field name: \"$id\" in \"$dbPointer\" object");
+    }
+    if (!readToken(COLON)) {
+        return parseError("Expecting ':'");
+    }
+    if (!readToken(LBRACE) || !readField("$oid")) {
+        return parseError("Expecting {\"$oid\" : ...} as \"$id\" of \"$dbPointer\" object");
+    }
+    if (!readToken(COLON)) {
+        return parseError("Expecting ':'");
+    }
+    std::string id;
+    id.reserve(ID_RESERVE_SIZE);
+    ret = quotedString(&id);
+    if (ret != Status::OK()) {
+        return ret;
+    }
+    if (id.size() != 24) {
+        return parseError("Expecting 24 hex digits: " + id);
+    }
+    if (!isHexString(id)) {
+        return parseError("Expecting hex digits: " + id);
+    }
+    if (!readToken(RBRACE) || !readToken(RBRACE)) {
+        return parseError("Expecting '}'");
+    }
+    builder.appendDBRef(fieldName, ns, OID(id));
+    return Status::OK();
+}
+
+Status JParse::symbolObject(StringData fieldName, BSONObjBuilder& builder) {
+    if (!readToken(COLON)) {
+        return parseError("Expecting ':'");
+    }
+    std::string symbol;
+    symbol.reserve(STRINGVAL_RESERVE_SIZE);
+    Status ret = quotedString(&symbol);
+    if (ret != Status::OK()) {
+        return ret;
+    }
+    builder.appendSymbol(fieldName, symbol);
+    return Status::OK();
+}
+
+Status JParse::codeObject(StringData fieldName, BSONObjBuilder& builder) {
+    if (!readToken(COLON)) {
+        return parseError("Expecting ':'");
+    }
+    std::string code;
+    code.reserve(STRINGVAL_RESERVE_SIZE);
+    Status ret = quotedString(&code);
+    if (ret != Status::OK()) {
+        return ret;
+    }
+    if (!readToken(COMMA)) {
+        builder.appendCode(fieldName, code);
+        return Status::OK();
+    }
+
+    if (!readField("$scope")) {
+        return parseError("Expected field name: \"$scope\" in \"$code\" object");
+    }
+    if (!readToken(COLON)) {
+        return parseError("Expecting ':'");
+    }
+    BSONObjBuilder scopeBuilder;
+    ret = object("UNUSED", scopeBuilder, false);
+    if (ret != Status::OK()) {
+        return ret;
+    }
+    builder.appendCodeWScope(fieldName, code, scopeBuilder.obj());
+    return Status::OK();
+}
+
 Status JParse::minKeyObject(StringData fieldName, BSONObjBuilder& builder) {
     if (!readToken(COLON)) {
         return parseError("Expecting ':'");
@@ -1065,9 +1393,20 @@ Status JParse::chars(std::string* result, const char* terminalSet, const char* a
     if (_input >= _input_end) {
         return parseError("Unexpected end of input");
     }
+    // Inside a quoted string, copy each run of characters which need no unescaping at once.
+    const bool isQuoted =
+        allowedSet == nullptr && terminalSet[0] != '\0' && terminalSet[1] == '\0';
     const char* q = _input;
     while (q < _input_end && !match(*q, terminalSet)) {
         MONGO_JSON_DEBUG("q: " << q);
+        if (isQuoted) {
+            const char* runEnd = findSpecialStringChar(q, _input_end, terminalSet[0]);
+            result->append(q, runEnd - q);
+            q = runEnd;
+            if (q >= _input_end || match(*q, terminalSet)) {
+                break;
+            }
+        }
         if (allowedSet != nullptr) {
             if (!match(*q, allowedSet)) {
                 _input = q;
@@ -1175,6 +1514,14 @@ std::string JParse::encodeUTF8(unsigned char first, unsigned char second) const
     return oss.str();
 }
 
+char JParse::peekChar() const {
+    const char* check = _input;
+    while (check < _input_end && isspace(*reinterpret_cast<const unsigned char*>(check))) {
+        ++check;
+    }
+    return check < _input_end ? *check : '\0';
+}
+
 inline bool JParse::peekToken(const char* token) {
     return readTokenImpl(token, false);
 }
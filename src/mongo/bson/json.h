@@ -157,6 +157,12 @@ private:
      *   | UNDEFINEDOBJECT
      *   | NUMBERLONGOBJECT
      *   | NUMBERDECIMALOBJECT
+     *   | NUMBERINTOBJECT
+     *   | NUMBERDOUBLEOBJECT
+     *   | REGULAREXPRESSIONOBJECT
+     *   | DBPOINTEROBJECT
+     *   | SYMBOLOBJECT
+     *   | CODEOBJECT
      *   | MINKEYOBJECT
      *   | MAXKEYOBJECT
      *
@@ -181,6 +187,10 @@ private:
      *     { FIELD("$binary") : <base64 representation of a binary std::string>,
      *          FIELD("$type") : <hexadecimal representation of a single byte
      *              indicating the data type> }
+     *   | { FIELD("$binary") : {
+     *         FIELD("base64") : <base64 representation of a binary std::string>,
+     *         FIELD("subType") : <hexadecimal representation of a single byte
+     *             indicating the data type> } }
      */
     Status binaryObject(StringData fieldName, BSONObjBuilder&);
 
@@ -235,6 +245,48 @@ private:
      */
     Status numberDecimalObject(StringData fieldName, BSONObjBuilder&);
 
+    /*
+     * NUMBERINTOBJECT :
+     *     { FIELD("$numberInt") : "<number>" }
+     */
+    Status numberIntObject(StringData fieldName, BSONObjBuilder&);
+
+    /*
+     * NUMBERDOUBLEOBJECT :
+     *     { FIELD("$numberDouble") : "<number>" }
+     *   | { FIELD("$numberDouble") : "Infinity" | "-Infinity" | "NaN" }
+     */
+    Status numberDoubleObject(StringData fieldName, BSONObjBuilder&);
+
+    /*
+     * REGULAREXPRESSIONOBJECT :
+     *     { FIELD("$regularExpression") : {
+     *         FIELD("pattern") : <string representing body of regex>,
+     *         FIELD("options") : <string representing regex options> } }
+     */
+    Status regularExpressionObject(StringData fieldName, BSONObjBuilder&);
+
+    /*
+     * DBPOINTEROBJECT :
+     *     { FIELD("$dbPointer") : {
+     *         FIELD("$ref") : <string representing collection name>,
+     *         FIELD("$id") : OIDOBJECT } }
+     */
+    Status dbPointerObject(StringData fieldName, BSONObjBuilder&);
+
+    /*
+     * SYMBOLOBJECT :
+     *     { FIELD("$symbol") : <string> }
+     */
+    Status symbolObject(StringData fieldName, BSONObjBuilder&);
+
+    /*
+     * CODEOBJECT :
+     *     { FIELD("$code") : <string> }
+     *   | { FIELD("$code") : <string>, FIELD("$scope") : OBJECT }
+     */
+    Status codeObject(StringData fieldName, BSONObjBuilder&);
+
     /*
      * MINKEYOBJECT :
      *     { FIELD("$minKey") : 1 }
@@ -422,6 +474,13 @@ private:
      */
     std::string encodeUTF8(unsigned char first, unsigned char second) const;
 
+    /**
+     * @return the next non whitespace character in our buffer, or the
+     * null character if we reach the end of our buffer.  Does not update
+     * the pointer to our buffer.
+     */
+    char peekChar() const;
+
     /**
      * @return true if the given token matches the next non whitespace
      * sequence in our buffer, and false if the token doesn't match or
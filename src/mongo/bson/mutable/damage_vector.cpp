@@ -0,0 +1,140 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/mutable/damage_vector.h"
+
+#include <cstring>
+
+#include "mongo/base/data_view.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+namespace mutablebson {
+namespace {
+
+// Applying a damage event costs about as much as copying this many more bytes.
+constexpr size_t kDamageEventOverhead = 16;
+
+class DamageCalculator {
+public:
+    DamageCalculator(const char* newBase, size_t maxDamageBytes, DamageVector* damages)
+        : _newBase(newBase), _maxDamageBytes(maxDamageBytes), _damages(damages) {}
+
+    /**
+     * Adds the damage events which change the BSON object at 'oldObj' into the one at 'newObj'.
+     * Every damage event before them must leave the target identical to the new object up to
+     * 'newObj'. Returns false if the damage events exceed the budget.
+     */
+    bool diffObjects(const char* oldObj, const char* newObj) {
+        const int32_t oldSize = ConstDataView(oldObj).read<LittleEndian<int32_t>>();
+        const int32_t newSize = ConstDataView(newObj).read<LittleEndian<int32_t>>();
+        if (oldSize == newSize && std::memcmp(oldObj, newObj, oldSize) == 0) {
+            return true;
+        }
+
+        if (oldSize != newSize && !addDamage(oldObj, sizeof(int32_t), newObj, sizeof(int32_t))) {
+            return false;
+        }
+
+        // Compare the elements of both objects pairwise for as long as their field names match.
+        const char* oldPos = oldObj + sizeof(int32_t);
+        const char* newPos = newObj + sizeof(int32_t);
+        const char* const oldEnd = oldObj + oldSize - 1;
+        const char* const newEnd = newObj + newSize - 1;
+        while (oldPos < oldEnd && newPos < newEnd) {
+            BSONElement oldElem(oldPos);
+            BSONElement newElem(newPos);
+            if (oldElem.fieldNameStringData() != newElem.fieldNameStringData()) {
+                break;
+            }
+
+            const int oldElemSize = oldElem.size();
+            const int newElemSize = newElem.size();
+            if (oldElemSize != newElemSize || std::memcmp(oldPos, newPos, oldElemSize) != 0) {
+                const bool isContainer = oldElem.type() == Object || oldElem.type() == Array;
+                if (isContainer && oldElem.type() == newElem.type()) {
+                    if (!diffObjects(oldElem.value(), newElem.value())) {
+                        return false;
+                    }
+                } else if (!addDamage(oldPos, oldElemSize, newPos, newElemSize)) {
+                    return false;
+                }
+            }
+
+            oldPos += oldElemSize;
+            newPos += newElemSize;
+        }
+
+        // Replace any remaining elements, which were added, removed or renamed, as a whole.
+        if (oldPos != oldEnd || newPos != newEnd) {
+            return addDamage(oldPos, oldEnd - oldPos, newPos, newEnd - newPos);
+        }
+        return true;
+    }
+
+private:
+    bool addDamage(const char* oldData, size_t oldSize, const char* newData, size_t newSize) {
+        _damageBytes += newSize + kDamageEventOverhead;
+        if (_damageBytes > _maxDamageBytes) {
+            return false;
+        }
+
+        // The target is identical to the new object up to this point, so the offset of the
+        // damaged region in the target is its offset in the new object.
+        DamageEvent damage;
+        damage.sourceOffset = newData - _newBase;
+        damage.targetOffset = newData - _newBase;
+        damage.size = newSize;
+        damage.targetSize = oldSize;
+        _damages->push_back(damage);
+        return true;
+    }
+
+    const char* const _newBase;
+    const size_t _maxDamageBytes;
+    DamageVector* const _damages;
+
+    size_t _damageBytes = 0;
+};
+
+}  // namespace
+
+bool computeDamages(const BSONObj& oldObj,
+                    const BSONObj& newObj,
+                    size_t maxDamageBytes,
+                    DamageVector* damages) {
+    DamageCalculator calculator(newObj.objdata(), maxDamageBytes, damages);
+    return calculator.diffObjects(oldObj.objdata(), newObj.objdata());
+}
+
+}  // namespace mutablebson
+}  // namespace mongo
@@ -30,15 +30,24 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 namespace mongo {
+
+class BSONObj;
+
 namespace mutablebson {
 
-// A damage event represents a change of size 'size' byte at starting at offset
-// 'target_offset' in some target buffer, with the replacement data being 'size' bytes of
-// data from the 'source' offset. The base addresses against which these offsets are to be
-// applied are not captured here.
+// A damage event represents a change of 'targetSize' bytes starting at offset 'targetOffset' in
+// some target buffer, with the replacement data being 'size' bytes of data from the 'source'
+// offset. The base addresses against which these offsets are to be applied are not captured
+// here.
+//
+// Most damage events overwrite bytes in place, so 'size' and 'targetSize' are equal. A damage
+// event whose sizes differ splices the source data into the target, shifting the rest of the
+// target. The damage events in a vector are applied in order, so the target offset of each one
+// is relative to the buffer as changed by the damage events before it.
 struct DamageEvent {
     typedef uint32_t OffsetSizeType;
 
@@ -50,9 +59,55 @@ struct DamageEvent {
 
     // Size of the damage region.
     size_t size;
+
+    // Size of the region of the target replaced by the damage region.
+    size_t targetSize;
 };
 
 typedef std::vector<DamageEvent> DamageVector;
 
+/**
+ * Returns true if applying 'damages' may change the size of the target buffer.
+ */
+inline bool damagesChangeSize(const DamageVector& damages) {
+    for (const auto& damage : damages) {
+        if (damage.size != damage.targetSize) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns the result of applying 'damages', with source data from 'source', to the 'size' bytes
+ * at 'target'.
+ */
+inline std::string applyDamages(const char* target,
+                                size_t size,
+                                const char* source,
+                                const DamageVector& damages) {
+    std::string result(target, size);
+    for (const auto& damage : damages) {
+        result.replace(
+            damage.targetOffset, damage.targetSize, source + damage.sourceOffset, damage.size);
+    }
+    return result;
+}
+
+/**
+ * Computes damage events which change 'oldObj' into 'newObj', with source data from 'newObj', and
+ * appends them to 'damages'. Unchanged elements are skipped and changed embedded objects and
+ * arrays are compared element by element, so that an update which changes the size of a few
+ * elements only replaces those elements.
+ *
+ * Returns false, leaving 'damages' in an unspecified state, if the damage events would copy more
+ * than 'maxDamageBytes' bytes. Each damage event counts for a few bytes more than its size, to
+ * favor fewer, larger damage events.
+ */
+bool computeDamages(const BSONObj& oldObj,
+                    const BSONObj& newObj,
+                    size_t maxDamageBytes,
+                    DamageVector* damages);
+
 }  // namespace mutablebson
 }  // namespace mongo
@@ -0,0 +1,110 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/mutable/damage_vector.h"
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/json.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using mongo::BSONObj;
+using mongo::fromjson;
+using namespace mongo::mutablebson;
+
+// Computes the damages from 'oldObj' to 'newObj', checks that applying them to 'oldObj' yields
+// 'newObj', and returns them.
+DamageVector checkDamages(const BSONObj& oldObj, const BSONObj& newObj) {
+    DamageVector damages;
+    ASSERT_TRUE(computeDamages(oldObj, newObj, newObj.objsize(), &damages));
+    const std::string result =
+        applyDamages(oldObj.objdata(), oldObj.objsize(), newObj.objdata(), damages);
+    ASSERT_EQUALS(std::string(newObj.objdata(), newObj.objsize()), result);
+    return damages;
+}
+
+TEST(ComputeDamages, IdenticalObjectsHaveNoDamages) {
+    const BSONObj obj = fromjson("{a: 1, b: {c: 'x'}}");
+    ASSERT_TRUE(checkDamages(obj, obj.copy()).empty());
+}
+
+TEST(ComputeDamages, SameSizeChangeIsInPlace) {
+    const auto damages = checkDamages(fromjson("{a: 1, b: 2}"), fromjson("{a: 1, b: 3}"));
+    ASSERT_EQUALS(1U, damages.size());
+    ASSERT_FALSE(damagesChangeSize(damages));
+}
+
+TEST(ComputeDamages, NumericPromotionReplacesOneElement) {
+    const BSONObj oldObj = BSON("a" << 1 << "b" << 2);
+    const BSONObj newObj = BSON("a" << 1 << "b" << 2LL);
+    const auto damages = checkDamages(oldObj, newObj);
+
+    // The object size and the promoted element.
+    ASSERT_EQUALS(2U, damages.size());
+    ASSERT_TRUE(damagesChangeSize(damages));
+}
+
+TEST(ComputeDamages, StringOfDifferentLength) {
+    checkDamages(fromjson("{a: 'abc', b: 'def', c: 1}"), fromjson("{a: 'abc', b: 'de', c: 1}"));
+    checkDamages(fromjson("{a: 'abc', b: 'def', c: 1}"),
+                 fromjson("{a: 'abc', b: 'defghi', c: 1}"));
+}
+
+TEST(ComputeDamages, PushToNestedArray) {
+    const auto damages = checkDamages(fromjson("{a: {b: [1, 2]}, c: 'xyz'}"),
+                                      fromjson("{a: {b: [1, 2, 3]}, c: 'xyz'}"));
+
+    // The sizes of the document, 'a' and 'b', and the appended element.
+    ASSERT_EQUALS(4U, damages.size());
+}
+
+TEST(ComputeDamages, AddedRemovedAndRenamedFields) {
+    checkDamages(fromjson("{a: 1}"), fromjson("{a: 1, b: 2}"));
+    checkDamages(fromjson("{a: 1, b: 2}"), fromjson("{a: 1}"));
+    checkDamages(fromjson("{a: 1, b: 2, c: 3}"), fromjson("{a: 1, d: 2, c: 3}"));
+    checkDamages(fromjson("{a: 1}"), fromjson("{}"));
+}
+
+TEST(ComputeDamages, ChangedType) {
+    checkDamages(fromjson("{a: {b: 1}, c: 2}"), fromjson("{a: [1], c: 2}"));
+    checkDamages(fromjson("{a: 'x', c: 2}"), fromjson("{a: {b: 'x'}, c: 2}"));
+}
+
+TEST(ComputeDamages, FailsWhenOverBudget) {
+    const BSONObj oldObj = fromjson("{a: 'abc', b: 1}");
+    const BSONObj newObj = fromjson("{a: 'abcdefghijklmnopqrstuvwxyz', b: 1}");
+    DamageVector damages;
+    ASSERT_FALSE(computeDamages(oldObj, newObj, 8, &damages));
+}
+
+}  // namespace
@@ -261,6 +261,10 @@ enum JsonStringFormat {
     /** 10gen format, which is close to JS format.  This form is understandable by
         javascript running inside the Mongo server via $where, mr, etc... */
     TenGen,
+    /** canonical Extended JSON v2, which preserves the type of every value */
+    ExtendedCanonical,
+    /** relaxed Extended JSON v2, which writes numbers and most dates as plain JSON values */
+    ExtendedRelaxed,
 };
 
 inline bool operator==(const OID& lhs, const OID& rhs) {
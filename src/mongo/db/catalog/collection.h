@@ -62,6 +62,7 @@ class IndexCatalog;
 class IndexCatalogEntry;
 class IndexDescriptor;
 class DatabaseImpl;
+class FieldRefSetWithStorage;
 class MatchExpression;
 class OpDebug;
 class OperationContext;
@@ -93,6 +94,10 @@ struct CollectionUpdateArgs {
     bool fromMigrate = false;
 
     StoreDocOption storeDocOption = StoreDocOption::None;
+
+    // When set, contains every path at which the updated document may differ from the document
+    // before modifiers were applied. Indexes on none of these paths are not updated.
+    const FieldRefSetWithStorage* modifiedPaths = nullptr;
 };
 
 /**
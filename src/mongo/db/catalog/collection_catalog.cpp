@@ -44,6 +44,13 @@ namespace {
 const ServiceContext::Decoration<CollectionCatalog> getCatalog =
     ServiceContext::declareDecoration<CollectionCatalog>();
 
+// Snapshot versions are unique across all catalogs, so that a thread's cached snapshot can never be
+// mistaken for the current snapshot of another catalog.
+AtomicWord<uint64_t> nextSnapshotVersion{1};
+
+// The snapshot this thread last read from any catalog.
+thread_local std::shared_ptr<const CollectionCatalog::Snapshot> cachedSnapshot;
+
 class FinishDropCollectionChange : public RecoveryUnit::Change {
 public:
     FinishDropCollectionChange(CollectionCatalog* catalog,
@@ -67,26 +74,22 @@ private:
 
 }  // namespace
 
-CollectionCatalog::iterator::iterator(StringData dbName,
-                                      uint64_t genNum,
-                                      const CollectionCatalog& catalog)
-    : _dbName(dbName), _genNum(genNum), _catalog(&catalog) {
+CollectionCatalog::iterator::iterator(StringData dbName, const CollectionCatalog& catalog)
+    : _dbName(dbName), _snapshot(catalog.getSnapshot()), _catalog(&catalog) {
     auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
 
-    stdx::lock_guard<Latch> lock(_catalog->_catalogLock);
-    _mapIter = _catalog->_orderedCollections.lower_bound(std::make_pair(_dbName, minUuid));
+    _mapIter = _snapshot->_orderedCollections.lower_bound(std::make_pair(_dbName, minUuid));
 
-    if (_mapIter != _catalog->_orderedCollections.end() && _mapIter->first.first == _dbName) {
+    if (!_exhausted()) {
         _uuid = _mapIter->first.second;
     }
 }
 
-CollectionCatalog::iterator::iterator(
-    std::map<std::pair<std::string, CollectionUUID>, Collection*>::const_iterator mapIter)
-    : _mapIter(mapIter) {}
-
 CollectionCatalog::iterator::value_type CollectionCatalog::iterator::operator*() {
-    stdx::lock_guard<Latch> lock(_catalog->_catalogLock);
+    if (!_uuid) {
+        return _nullCollection;
+    }
+
     _repositionIfNeeded();
     if (_exhausted()) {
         return _nullCollection;
@@ -100,7 +103,9 @@ boost::optional<CollectionUUID> CollectionCatalog::iterator::uuid() {
 }
 
 CollectionCatalog::iterator CollectionCatalog::iterator::operator++() {
-    stdx::lock_guard<Latch> lock(_catalog->_catalogLock);
+    if (!_uuid) {
+        return *this;
+    }
 
     if (!_repositionIfNeeded()) {
         _mapIter++;  // If the position was not updated, increment iterator to next element.
@@ -109,7 +114,7 @@ CollectionCatalog::iterator CollectionCatalog::iterator::operator++() {
     if (_exhausted()) {
         // If the iterator is at the end of the map or now points to an entry that does not
         // correspond to the correct database.
-        _mapIter = _catalog->_orderedCollections.end();
+        _mapIter = _snapshot->_orderedCollections.end();
         _uuid = boost::none;
         return *this;
     }
@@ -125,12 +130,6 @@ CollectionCatalog::iterator CollectionCatalog::iterator::operator++(int) {
 }
 
 bool CollectionCatalog::iterator::operator==(const iterator& other) {
-    stdx::lock_guard<Latch> lock(_catalog->_catalogLock);
-
-    if (other._mapIter == _catalog->_orderedCollections.end()) {
-        return _uuid == boost::none;
-    }
-
     return _uuid == other._uuid;
 }
 
@@ -139,13 +138,13 @@ bool CollectionCatalog::iterator::operator!=(const iterator& other) {
 }
 
 bool CollectionCatalog::iterator::_repositionIfNeeded() {
-    if (_genNum == _catalog->_generationNumber) {
+    if (_snapshot->version() == _catalog->_currentSnapshot().version()) {
         return false;
     }
 
-    _genNum = _catalog->_generationNumber;
-    // If the map has been modified, find the entry the iterator was on, or the one right after it.
-    _mapIter = _catalog->_orderedCollections.lower_bound(std::make_pair(_dbName, *_uuid));
+    _snapshot = _catalog->getSnapshot();
+    // If the catalog has changed, find the entry the iterator was on, or the one right after it.
+    _mapIter = _snapshot->_orderedCollections.lower_bound(std::make_pair(_dbName, *_uuid));
 
     if (_exhausted()) {
         return true;
@@ -160,7 +159,107 @@ bool CollectionCatalog::iterator::_repositionIfNeeded() {
 }
 
 bool CollectionCatalog::iterator::_exhausted() {
-    return _mapIter == _catalog->_orderedCollections.end() || _mapIter->first.first != _dbName;
+    return _mapIter == _snapshot->_orderedCollections.end() || _mapIter->first.first != _dbName;
+}
+
+Collection* CollectionCatalog::Snapshot::lookupCollectionByUUID(CollectionUUID uuid) const {
+    auto foundIt = _entries.find(uuid);
+    return foundIt == _entries.end() ? nullptr : foundIt->second.collection;
+}
+
+Collection* CollectionCatalog::Snapshot::lookupCollectionByNamespace(
+    const NamespaceString& nss) const {
+    auto it = _collections.find(nss);
+    return it == _collections.end() ? nullptr : it->second;
+}
+
+boost::optional<NamespaceString> CollectionCatalog::Snapshot::lookupNSSByUUID(
+    CollectionUUID uuid) const {
+    auto foundIt = _entries.find(uuid);
+    if (foundIt != _entries.end()) {
+        const NamespaceString& ns = foundIt->second.nss;
+        invariant(!ns.isEmpty());
+        return ns;
+    }
+
+    // Only in the case that the catalog is closed and a UUID is currently unknown, resolve it
+    // using the pre-close state. This ensures that any tasks reloading the catalog can see their
+    // own updates.
+    if (_shadowCatalog) {
+        auto shadowIt = _shadowCatalog->find(uuid);
+        if (shadowIt != _shadowCatalog->end())
+            return shadowIt->second;
+    }
+    return boost::none;
+}
+
+boost::optional<CollectionUUID> CollectionCatalog::Snapshot::lookupUUIDByNSS(
+    const NamespaceString& nss) const {
+    auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
+    auto it = _orderedCollections.lower_bound(std::make_pair(nss.db().toString(), minUuid));
+
+    // The entry 'it' points to is valid if it's not at the end of _orderedCollections and the
+    // entry's database is the same as dbName.
+    while (it != _orderedCollections.end() && it->first.first == nss.db()) {
+        if (_entries.at(it->first.second).nss == nss) {
+            return it->first.second;
+        }
+        ++it;
+    }
+    return boost::none;
+}
+
+std::vector<CollectionUUID> CollectionCatalog::Snapshot::getAllCollectionUUIDsFromDb(
+    StringData dbName) const {
+    auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
+    auto it = _orderedCollections.lower_bound(std::make_pair(dbName.toString(), minUuid));
+
+    std::vector<CollectionUUID> ret;
+    while (it != _orderedCollections.end() && it->first.first == dbName) {
+        ret.push_back(it->first.second);
+        ++it;
+    }
+    return ret;
+}
+
+std::vector<NamespaceString> CollectionCatalog::Snapshot::getAllCollectionNamesFromDb(
+    StringData dbName) const {
+    auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
+
+    std::vector<NamespaceString> ret;
+    for (auto it = _orderedCollections.lower_bound(std::make_pair(dbName.toString(), minUuid));
+         it != _orderedCollections.end() && it->first.first == dbName;
+         ++it) {
+        ret.push_back(_entries.at(it->first.second).nss);
+    }
+    return ret;
+}
+
+std::vector<std::string> CollectionCatalog::Snapshot::getAllDbNames() const {
+    std::vector<std::string> ret;
+    auto maxUuid = UUID::parse("FFFFFFFF-FFFF-FFFF-FFFF-FFFFFFFFFFFF").getValue();
+    auto iter = _orderedCollections.upper_bound(std::make_pair("", maxUuid));
+    while (iter != _orderedCollections.end()) {
+        auto dbName = iter->first.first;
+        ret.push_back(dbName);
+        iter = _orderedCollections.upper_bound(std::make_pair(dbName, maxUuid));
+    }
+    return ret;
+}
+
+CollectionCatalog::BatchedPublish::BatchedPublish(CollectionCatalog& catalog)
+    : _catalog(catalog) {
+    stdx::lock_guard<Latch> lock(_catalog._catalogLock);
+    invariant(!_catalog._batching);
+    _catalog._batching = true;
+}
+
+CollectionCatalog::BatchedPublish::~BatchedPublish() {
+    stdx::lock_guard<Latch> lock(_catalog._catalogLock);
+    _catalog._batching = false;
+    if (_catalog._batchedSnapshot) {
+        _catalog._publishSnapshot(lock, std::move(_catalog._batchedSnapshot));
+    }
 }
 
 CollectionCatalog& CollectionCatalog::get(ServiceContext* svcCtx) {
@@ -170,25 +269,83 @@ CollectionCatalog& CollectionCatalog::get(OperationContext* opCtx) {
     return getCatalog(opCtx->getServiceContext());
 }
 
+CollectionCatalog::CollectionCatalog() {
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->_version = nextSnapshotVersion.fetchAndAdd(1);
+    _snapshotVersion.store(snapshot->_version);
+    _snapshot = std::move(snapshot);
+}
+
+std::shared_ptr<const CollectionCatalog::Snapshot> CollectionCatalog::getSnapshot() const {
+    _currentSnapshot();
+    return cachedSnapshot;
+}
+
+const CollectionCatalog::Snapshot& CollectionCatalog::_currentSnapshot() const {
+    if (!cachedSnapshot || cachedSnapshot->version() != _snapshotVersion.load()) {
+        stdx::lock_guard<Latch> lock(_snapshotMutex);
+        cachedSnapshot = _snapshot;
+    }
+    return *cachedSnapshot;
+}
+
+const CollectionCatalog::Snapshot& CollectionCatalog::_latestSnapshot(WithLock) const {
+    return _batchedSnapshot ? *_batchedSnapshot : *_snapshot;
+}
+
+std::shared_ptr<CollectionCatalog::Snapshot> CollectionCatalog::_writableSnapshot(WithLock) {
+    if (_batchedSnapshot) {
+        return _batchedSnapshot;
+    }
+    return std::make_shared<Snapshot>(*_snapshot);
+}
+
+void CollectionCatalog::_publishSnapshot(WithLock, std::shared_ptr<Snapshot> snapshot) {
+    if (_batching) {
+        _batchedSnapshot = std::move(snapshot);
+        return;
+    }
+
+    snapshot->_version = nextSnapshotVersion.fetchAndAdd(1);
+    const auto version = snapshot->_version;
+    {
+        stdx::lock_guard<Latch> lock(_snapshotMutex);
+        _snapshot = std::move(snapshot);
+    }
+    _snapshotVersion.store(version);
+}
+
+void CollectionCatalog::_publishRename(WithLock lk,
+                                       Collection* coll,
+                                       const NamespaceString& fromCollection,
+                                       const NamespaceString& toCollection) {
+    auto snapshot = _writableSnapshot(lk);
+
+    auto uuid = snapshot->lookupUUIDByNSS(fromCollection);
+    invariant(uuid);
+    auto& entry = snapshot->_entries.at(*uuid);
+    invariant(entry.collection == coll);
+    entry.nss = toCollection;
+
+    snapshot->_collections[toCollection] = snapshot->_collections[fromCollection];
+    snapshot->_collections.erase(fromCollection);
+
+    _publishSnapshot(lk, std::move(snapshot));
+}
+
 void CollectionCatalog::setCollectionNamespace(OperationContext* opCtx,
                                                Collection* coll,
                                                const NamespaceString& fromCollection,
                                                const NamespaceString& toCollection) {
-    // Rather than maintain, in addition to the UUID -> Collection* mapping, an auxiliary
-    // data structure with the UUID -> namespace mapping, the CollectionCatalog relies on
-    // Collection::ns() to provide UUID to namespace lookup. In addition, the CollectionCatalog
-    // does not require callers to hold locks.
-    //
-    // This means that Collection::ns() may be called while only '_catalogLock' (and no lock
-    // manager locks) are held. The purpose of this function is ensure that we write to the
-    // Collection's namespace string under '_catalogLock'.
+    // The CollectionCatalog does not require callers to hold locks, so Collection::ns() may be
+    // called while no lock manager locks are held. The purpose of this function is ensure that we
+    // write to the Collection's namespace string under '_catalogLock', and that the snapshot
+    // published with the new namespace is consistent with it.
     invariant(coll);
     stdx::lock_guard<Latch> lock(_catalogLock);
 
     coll->setNs(toCollection);
-
-    _collections[toCollection] = _collections[fromCollection];
-    _collections.erase(fromCollection);
+    _publishRename(lock, coll, fromCollection, toCollection);
 
     ResourceId oldRid = ResourceId(RESOURCE_COLLECTION, fromCollection.ns());
     ResourceId newRid = ResourceId(RESOURCE_COLLECTION, toCollection.ns());
@@ -198,10 +355,8 @@ void CollectionCatalog::setCollectionNamespace(OperationContext* opCtx,
 
     opCtx->recoveryUnit()->onRollback([this, coll, fromCollection, toCollection] {
         stdx::lock_guard<Latch> lock(_catalogLock);
-        coll->setNs(std::move(fromCollection));
-
-        _collections[fromCollection] = _collections[toCollection];
-        _collections.erase(toCollection);
+        coll->setNs(fromCollection);
+        _publishRename(lock, coll, toCollection, fromCollection);
 
         ResourceId oldRid = ResourceId(RESOURCE_COLLECTION, fromCollection.ns());
         ResourceId newRid = ResourceId(RESOURCE_COLLECTION, toCollection.ns());
@@ -220,22 +375,29 @@ void CollectionCatalog::onCloseDatabase(OperationContext* opCtx, std::string dbN
 void CollectionCatalog::onCloseCatalog(OperationContext* opCtx) {
     invariant(opCtx->lockState()->isW());
     stdx::lock_guard<Latch> lock(_catalogLock);
-    invariant(!_shadowCatalog);
-    _shadowCatalog.emplace();
-    for (auto& entry : _catalog)
-        _shadowCatalog->insert({entry.first, entry.second->ns()});
+    invariant(!_latestSnapshot(lock)._shadowCatalog);
+
+    auto shadowCatalog = std::make_shared<ShadowCatalogMap>();
+    for (auto& entry : _latestSnapshot(lock)._entries)
+        shadowCatalog->insert({entry.first, entry.second.nss});
+
+    auto snapshot = _writableSnapshot(lock);
+    snapshot->_shadowCatalog = std::move(shadowCatalog);
+    _publishSnapshot(lock, std::move(snapshot));
 }
 
 void CollectionCatalog::onOpenCatalog(OperationContext* opCtx) {
     invariant(opCtx->lockState()->isW());
     stdx::lock_guard<Latch> lock(_catalogLock);
-    invariant(_shadowCatalog);
-    _shadowCatalog.reset();
+    invariant(_latestSnapshot(lock)._shadowCatalog);
+
+    auto snapshot = _writableSnapshot(lock);
+    snapshot->_shadowCatalog.reset();
+    _publishSnapshot(lock, std::move(snapshot));
 }
 
 Collection* CollectionCatalog::lookupCollectionByUUID(CollectionUUID uuid) const {
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    return _lookupCollectionByUUID(lock, uuid);
+    return getSnapshot()->lookupCollectionByUUID(uuid);
 }
 
 Collection* CollectionCatalog::_lookupCollectionByUUID(WithLock, CollectionUUID uuid) const {
@@ -244,46 +406,16 @@ Collection* CollectionCatalog::_lookupCollectionByUUID(WithLock, CollectionUUID
 }
 
 Collection* CollectionCatalog::lookupCollectionByNamespace(const NamespaceString& nss) const {
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto it = _collections.find(nss);
-    return it == _collections.end() ? nullptr : it->second;
+    return getSnapshot()->lookupCollectionByNamespace(nss);
 }
 
 boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(CollectionUUID uuid) const {
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto foundIt = _catalog.find(uuid);
-    if (foundIt != _catalog.end()) {
-        NamespaceString ns = foundIt->second->ns();
-        invariant(!ns.isEmpty());
-        return ns;
-    }
-
-    // Only in the case that the catalog is closed and a UUID is currently unknown, resolve it
-    // using the pre-close state. This ensures that any tasks reloading the catalog can see their
-    // own updates.
-    if (_shadowCatalog) {
-        auto shadowIt = _shadowCatalog->find(uuid);
-        if (shadowIt != _shadowCatalog->end())
-            return shadowIt->second;
-    }
-    return boost::none;
+    return getSnapshot()->lookupNSSByUUID(uuid);
 }
 
 boost::optional<CollectionUUID> CollectionCatalog::lookupUUIDByNSS(
     const NamespaceString& nss) const {
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
-    auto it = _orderedCollections.lower_bound(std::make_pair(nss.db().toString(), minUuid));
-
-    // The entry _mapIter points to is valid if it's not at the end of _orderedCollections and
-    // the entry's database is the same as dbName.
-    while (it != _orderedCollections.end() && it->first.first == nss.db()) {
-        if (it->second->ns() == nss) {
-            return it->first.second;
-        }
-        ++it;
-    }
-    return boost::none;
+    return getSnapshot()->lookupUUIDByNSS(nss);
 }
 
 NamespaceString CollectionCatalog::resolveNamespaceStringOrUUID(NamespaceStringOrUUID nsOrUUID) {
@@ -324,45 +456,18 @@ bool CollectionCatalog::checkIfCollectionSatisfiable(CollectionUUID uuid,
 
 std::vector<CollectionUUID> CollectionCatalog::getAllCollectionUUIDsFromDb(
     StringData dbName) const {
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
-    auto it = _orderedCollections.lower_bound(std::make_pair(dbName.toString(), minUuid));
-
-    std::vector<CollectionUUID> ret;
-    while (it != _orderedCollections.end() && it->first.first == dbName) {
-        ret.push_back(it->first.second);
-        ++it;
-    }
-    return ret;
+    return getSnapshot()->getAllCollectionUUIDsFromDb(dbName);
 }
 
 std::vector<NamespaceString> CollectionCatalog::getAllCollectionNamesFromDb(
     OperationContext* opCtx, StringData dbName) const {
     invariant(opCtx->lockState()->isDbLockedForMode(dbName, MODE_S));
 
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
-
-    std::vector<NamespaceString> ret;
-    for (auto it = _orderedCollections.lower_bound(std::make_pair(dbName.toString(), minUuid));
-         it != _orderedCollections.end() && it->first.first == dbName;
-         ++it) {
-        ret.push_back(it->second->ns());
-    }
-    return ret;
+    return getSnapshot()->getAllCollectionNamesFromDb(dbName);
 }
 
 std::vector<std::string> CollectionCatalog::getAllDbNames() const {
-    std::vector<std::string> ret;
-    stdx::lock_guard<Latch> lock(_catalogLock);
-    auto maxUuid = UUID::parse("FFFFFFFF-FFFF-FFFF-FFFF-FFFFFFFFFFFF").getValue();
-    auto iter = _orderedCollections.upper_bound(std::make_pair("", maxUuid));
-    while (iter != _orderedCollections.end()) {
-        auto dbName = iter->first.first;
-        ret.push_back(dbName);
-        iter = _orderedCollections.upper_bound(std::make_pair(dbName, maxUuid));
-    }
-    return ret;
+    return getSnapshot()->getAllDbNames();
 }
 
 void CollectionCatalog::registerCollection(CollectionUUID uuid, std::unique_ptr<Collection> coll) {
@@ -373,15 +478,20 @@ void CollectionCatalog::registerCollection(CollectionUUID uuid, std::unique_ptr<
     auto ns = coll->ns();
     auto dbName = ns.db().toString();
     auto dbIdPair = std::make_pair(dbName, uuid);
+    auto snapshot = _writableSnapshot(lock);
 
     // Make sure no entry related to this uuid.
     invariant(_catalog.find(uuid) == _catalog.end());
-    invariant(_collections.find(ns) == _collections.end());
-    invariant(_orderedCollections.find(dbIdPair) == _orderedCollections.end());
+    invariant(snapshot->_collections.find(ns) == snapshot->_collections.end());
+    invariant(snapshot->_orderedCollections.find(dbIdPair) ==
+              snapshot->_orderedCollections.end());
 
+    Collection* collection = coll.get();
     _catalog[uuid] = std::move(coll);
-    _collections[ns] = _catalog[uuid].get();
-    _orderedCollections[dbIdPair] = _catalog[uuid].get();
+    snapshot->_entries[uuid] = {collection, ns};
+    snapshot->_collections[ns] = collection;
+    snapshot->_orderedCollections[dbIdPair] = collection;
+    _publishSnapshot(lock, std::move(snapshot));
 
     auto dbRid = ResourceId(RESOURCE_DATABASE, dbName);
     addResource(dbRid, dbName);
@@ -399,24 +509,26 @@ std::unique_ptr<Collection> CollectionCatalog::deregisterCollection(CollectionUU
     auto ns = coll->ns();
     auto dbName = ns.db().toString();
     auto dbIdPair = std::make_pair(dbName, uuid);
+    auto snapshot = _writableSnapshot(lock);
 
     LOG(1) << "Deregistering collection " << ns << " with UUID " << uuid;
 
     // Make sure collection object exists.
-    invariant(_collections.find(ns) != _collections.end());
-    invariant(_orderedCollections.find(dbIdPair) != _orderedCollections.end());
+    invariant(snapshot->_collections.find(ns) != snapshot->_collections.end());
+    invariant(snapshot->_orderedCollections.find(dbIdPair) !=
+              snapshot->_orderedCollections.end());
 
-    _orderedCollections.erase(dbIdPair);
-    _collections.erase(ns);
+    snapshot->_orderedCollections.erase(dbIdPair);
+    snapshot->_collections.erase(ns);
+    snapshot->_entries.erase(uuid);
     _catalog.erase(uuid);
 
+    // Iterators notice the new snapshot and reposition themselves past the erased element.
+    _publishSnapshot(lock, std::move(snapshot));
+
     auto collRid = ResourceId(RESOURCE_COLLECTION, ns.ns());
     removeResource(collRid, ns.ns());
 
-    // Removal from an ordered map will invalidate iterators and potentially references to the
-    // references to the erased element.
-    _generationNumber++;
-
     return coll;
 }
 
@@ -429,33 +541,34 @@ void CollectionCatalog::deregisterAllCollections() {
     stdx::lock_guard<Latch> lock(_catalogLock);
 
     LOG(0) << "Deregistering all the collections";
+
+    // Publish the empty catalog before destroying the collections, so that new lookups no longer
+    // find them.
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->_shadowCatalog = _latestSnapshot(lock)._shadowCatalog;
+    _publishSnapshot(lock, std::move(snapshot));
+
     for (auto& entry : _catalog) {
         auto uuid = entry.first;
         auto ns = entry.second->ns();
-        auto dbName = ns.db().toString();
-        auto dbIdPair = std::make_pair(dbName, uuid);
 
         LOG(1) << "Deregistering collection " << ns << " with UUID " << uuid;
 
         entry.second.reset();
     }
 
-    _collections.clear();
-    _orderedCollections.clear();
     _catalog.clear();
 
     stdx::lock_guard<Latch> resourceLock(_resourceLock);
     _resourceInformation.clear();
-
-    _generationNumber++;
 }
 
 CollectionCatalog::iterator CollectionCatalog::begin(StringData db) const {
-    return iterator(db, _generationNumber, *this);
+    return iterator(db, *this);
 }
 
 CollectionCatalog::iterator CollectionCatalog::end() const {
-    return iterator(_orderedCollections.end());
+    return iterator();
 }
 
 boost::optional<std::string> CollectionCatalog::lookupResourceName(const ResourceId& rid) {
@@ -31,10 +31,13 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/uuid.h"
 
@@ -53,16 +56,100 @@ class CollectionCatalog {
 
     friend class iterator;
 
+    using OrderedCollectionMap = std::map<std::pair<std::string, CollectionUUID>, Collection*>;
+    using NamespaceCollectionMap = mongo::stdx::unordered_map<NamespaceString, Collection*>;
+    using ShadowCatalogMap =
+        mongo::stdx::unordered_map<CollectionUUID, NamespaceString, CollectionUUID::Hash>;
+
 public:
     using CollectionInfoFn = std::function<bool(const Collection* collection)>;
 
+    /**
+     * An immutable view of the registered collections and their namespaces at one point in time.
+     *
+     * The catalog publishes a new snapshot each time a collection is registered, deregistered or
+     * renamed, so lookups in a snapshot need no locks. An operation which holds on to a snapshot
+     * sees the same catalog for as long as it does. As for the catalog's own lookups, the caller
+     * must hold the locks needed to keep a returned Collection pointer valid.
+     */
+    class Snapshot {
+    public:
+        /**
+         * Increases each time the catalog publishes a new snapshot. Versions are drawn from a
+         * process-wide counter, so no two snapshots of any catalogs share one.
+         */
+        uint64_t version() const {
+            return _version;
+        }
+
+        /**
+         * See CollectionCatalog::lookupCollectionByUUID.
+         */
+        Collection* lookupCollectionByUUID(CollectionUUID uuid) const;
+
+        /**
+         * See CollectionCatalog::lookupCollectionByNamespace.
+         */
+        Collection* lookupCollectionByNamespace(const NamespaceString& nss) const;
+
+        /**
+         * See CollectionCatalog::lookupNSSByUUID.
+         */
+        boost::optional<NamespaceString> lookupNSSByUUID(CollectionUUID uuid) const;
+
+        /**
+         * See CollectionCatalog::lookupUUIDByNSS.
+         */
+        boost::optional<CollectionUUID> lookupUUIDByNSS(const NamespaceString& nss) const;
+
+        /**
+         * See CollectionCatalog::getAllCollectionUUIDsFromDb.
+         */
+        std::vector<CollectionUUID> getAllCollectionUUIDsFromDb(StringData dbName) const;
+
+        /**
+         * Returns the namespaces of all collections in 'dbName'. The result is not sorted.
+         */
+        std::vector<NamespaceString> getAllCollectionNamesFromDb(StringData dbName) const;
+
+        /**
+         * See CollectionCatalog::getAllDbNames.
+         */
+        std::vector<std::string> getAllDbNames() const;
+
+    private:
+        friend class CollectionCatalog;
+
+        struct Entry {
+            Collection* collection;
+            NamespaceString nss;
+        };
+
+        uint64_t _version = 0;
+
+        mongo::stdx::unordered_map<CollectionUUID, Entry, CollectionUUID::Hash> _entries;
+        OrderedCollectionMap _orderedCollections;  // Ordered by <dbName, collUUID> pair
+        NamespaceCollectionMap _collections;
+
+        /**
+         * When present, indicates that the catalog is in closed state, and contains a map from
+         * UUID to pre-close NSS. Shared by the snapshots published while the catalog is closed.
+         * See also onCloseCatalog.
+         */
+        std::shared_ptr<const ShadowCatalogMap> _shadowCatalog;
+    };
+
     class iterator {
     public:
         using value_type = Collection*;
 
-        iterator(StringData dbName, uint64_t genNum, const CollectionCatalog& catalog);
-        iterator(
-            std::map<std::pair<std::string, CollectionUUID>, Collection*>::const_iterator mapIter);
+        iterator(StringData dbName, const CollectionCatalog& catalog);
+
+        /**
+         * Constructs the iterator which is past the end of every database.
+         */
+        iterator() = default;
+
         value_type operator*();
         iterator operator++();
         iterator operator++(int);
@@ -77,10 +164,10 @@ public:
 
     private:
         /**
-         * Check if _mapIter has been invalidated due to a change in the _orderedCollections map. If
-         * it has, restart iteration through a call to lower_bound. If the element that the iterator
-         * is currently pointing to has been deleted, the iterator will be repositioned to the
-         * element that follows it.
+         * Check if the catalog has published a new snapshot since _snapshot was taken. If it has,
+         * restart iteration in the new snapshot through a call to lower_bound. If the element that
+         * the iterator is currently pointing to has been deleted, the iterator will be repositioned
+         * to the element that follows it.
          *
          * Returns true if iterator got repositioned.
          */
@@ -89,15 +176,41 @@ public:
 
         std::string _dbName;
         boost::optional<CollectionUUID> _uuid;
-        uint64_t _genNum;
-        std::map<std::pair<std::string, CollectionUUID>, Collection*>::const_iterator _mapIter;
-        const CollectionCatalog* _catalog;
+        std::shared_ptr<const Snapshot> _snapshot;
+        OrderedCollectionMap::const_iterator _mapIter;
+        const CollectionCatalog* _catalog = nullptr;
         static constexpr Collection* _nullCollection = nullptr;
     };
 
+    /**
+     * While an instance is alive, changes to the catalog are applied to one unpublished snapshot
+     * instead of each publishing a copy of the whole catalog. The snapshot is published when the
+     * instance is destroyed, so lookups do not see the changes until then.
+     *
+     * Only for callers which make many changes while no other operation can use the catalog, such
+     * as loading the catalog under the global exclusive lock.
+     */
+    class BatchedPublish {
+        BatchedPublish(const BatchedPublish&) = delete;
+        BatchedPublish& operator=(const BatchedPublish&) = delete;
+
+    public:
+        explicit BatchedPublish(CollectionCatalog& catalog);
+        ~BatchedPublish();
+
+    private:
+        CollectionCatalog& _catalog;
+    };
+
     static CollectionCatalog& get(ServiceContext* svcCtx);
     static CollectionCatalog& get(OperationContext* opCtx);
-    CollectionCatalog() = default;
+    CollectionCatalog();
+
+    /**
+     * Returns the catalog's current snapshot. Lookups in the snapshot do not see changes made to
+     * the catalog after it is returned.
+     */
+    std::shared_ptr<const Snapshot> getSnapshot() const;
 
     /**
      * This function is responsible for safely setting the namespace string inside 'coll' to the
@@ -249,30 +362,63 @@ private:
 
     Collection* _lookupCollectionByUUID(WithLock, CollectionUUID uuid) const;
 
-    const std::vector<CollectionUUID>& _getOrdering_inlock(const StringData& db,
-                                                           const stdx::lock_guard<Latch>&);
-    mutable mongo::Mutex _catalogLock;
+    /**
+     * Returns the current snapshot. The calling thread caches it, and as long as the catalog does
+     * not publish a newer one, returns it again without any locking or reference counting. The
+     * reference is only valid until the thread's next lookup in any catalog.
+     */
+    const Snapshot& _currentSnapshot() const;
+
+    /**
+     * Returns the latest state of the catalog, including changes not yet published by a
+     * BatchedPublish.
+     */
+    const Snapshot& _latestSnapshot(WithLock) const;
+
+    /**
+     * Returns a snapshot for a change to the catalog to modify and then pass to _publishSnapshot:
+     * a copy of the current snapshot, or the unpublished one of a BatchedPublish.
+     */
+    std::shared_ptr<Snapshot> _writableSnapshot(WithLock);
+
+    /**
+     * Makes 'snapshot' the catalog's current snapshot, or keeps it unpublished until the end of a
+     * BatchedPublish.
+     */
+    void _publishSnapshot(WithLock, std::shared_ptr<Snapshot> snapshot);
 
     /**
-     * When present, indicates that the catalog is in closed state, and contains a map from UUID
-     * to pre-close NSS. See also onCloseCatalog.
+     * Publishes a snapshot in which 'coll' is registered under 'toCollection' instead of
+     * 'fromCollection'.
      */
-    boost::optional<
-        mongo::stdx::unordered_map<CollectionUUID, NamespaceString, CollectionUUID::Hash>>
-        _shadowCatalog;
+    void _publishRename(WithLock,
+                        Collection* coll,
+                        const NamespaceString& fromCollection,
+                        const NamespaceString& toCollection);
+
+    // Serializes changes to the catalog, and protects _catalog. Lookups use the current snapshot
+    // instead.
+    mutable mongo::Mutex _catalogLock;
 
     using CollectionCatalogMap = mongo::stdx::
         unordered_map<CollectionUUID, std::unique_ptr<Collection>, CollectionUUID::Hash>;
-    using OrderedCollectionMap = std::map<std::pair<std::string, CollectionUUID>, Collection*>;
-    using NamespaceCollectionMap = mongo::stdx::unordered_map<NamespaceString, Collection*>;
     CollectionCatalogMap _catalog;
-    OrderedCollectionMap _orderedCollections;  // Ordered by <dbName, collUUID> pair
-    NamespaceCollectionMap _collections;
 
-    /**
-     * Generation number to track changes to the catalog that could invalidate iterators.
-     */
-    uint64_t _generationNumber;
+    // Protects _snapshot against concurrent lookups. Writers, which hold _catalogLock, may read
+    // _snapshot without it. Only held to copy or replace the pointer.
+    mutable Mutex _snapshotMutex = MONGO_MAKE_LATCH("CollectionCatalog::_snapshotMutex");
+
+    // The current snapshot. Replaced, but never modified, by changes to the catalog.
+    std::shared_ptr<const Snapshot> _snapshot;
+
+    // The version of _snapshot. Lookups read it without locking to tell whether the snapshot they
+    // cached is still current.
+    AtomicWord<uint64_t> _snapshotVersion;
+
+    // Set while a BatchedPublish is alive. Holds its changes once there are any. Protected by
+    // _catalogLock.
+    bool _batching = false;
+    std::shared_ptr<Snapshot> _batchedSnapshot;
 
     // Protects _resourceInformation.
     mutable Mutex _resourceLock = MONGO_MAKE_LATCH("CollectionCatalog::_resourceLock");
@@ -37,6 +37,7 @@
 #include "mongo/db/concurrency/lock_manager_defs.h"
 #include "mongo/db/operation_context_noop.h"
 #include "mongo/db/storage/durable_catalog.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 
@@ -571,6 +572,107 @@ TEST_F(CollectionCatalogTest, LookupNSSByUUIDForClosedCatalogReturnsFreshestNSS)
     ASSERT_EQUALS(*catalog.lookupNSSByUUID(colUUID), newNss);
 }
 
+TEST_F(CollectionCatalogTest, SnapshotIsUnchangedByRegisterAndDeregister) {
+    auto before = catalog.getSnapshot();
+
+    NamespaceString newNss(nss.db(), "newcol");
+    auto newUUID = CollectionUUID::gen();
+    auto newCollUnique = std::make_unique<CollectionMock>(newNss);
+    auto newCol = newCollUnique.get();
+    catalog.registerCollection(newUUID, std::move(newCollUnique));
+
+    auto afterRegister = catalog.getSnapshot();
+    ASSERT_GT(afterRegister->version(), before->version());
+    ASSERT(before->lookupCollectionByUUID(newUUID) == nullptr);
+    ASSERT(before->lookupCollectionByNamespace(newNss) == nullptr);
+    ASSERT_EQUALS(before->getAllCollectionUUIDsFromDb(nss.db()).size(), 1U);
+    ASSERT_EQUALS(afterRegister->lookupCollectionByUUID(newUUID), newCol);
+    ASSERT_EQUALS(afterRegister->lookupCollectionByNamespace(newNss), newCol);
+    ASSERT_EQUALS(afterRegister->getAllCollectionUUIDsFromDb(nss.db()).size(), 2U);
+
+    auto deregistered = catalog.deregisterCollection(colUUID);
+    auto afterDeregister = catalog.getSnapshot();
+    ASSERT_GT(afterDeregister->version(), afterRegister->version());
+    ASSERT_EQUALS(afterRegister->lookupCollectionByUUID(colUUID), col);
+    ASSERT_EQUALS(*afterRegister->lookupUUIDByNSS(nss), colUUID);
+    ASSERT(afterDeregister->lookupCollectionByUUID(colUUID) == nullptr);
+    ASSERT(afterDeregister->lookupUUIDByNSS(nss) == boost::none);
+    ASSERT(catalog.lookupCollectionByUUID(colUUID) == nullptr);
+}
+
+TEST_F(CollectionCatalogTest, SnapshotIsUnchangedByRename) {
+    auto before = catalog.getSnapshot();
+
+    NamespaceString newNss(nss.db(), "newcol");
+    catalog.setCollectionNamespace(&opCtx, col, nss, newNss);
+
+    ASSERT_EQUALS(*before->lookupNSSByUUID(colUUID), nss);
+    ASSERT_EQUALS(before->lookupCollectionByNamespace(nss), col);
+    ASSERT(before->lookupCollectionByNamespace(newNss) == nullptr);
+
+    auto after = catalog.getSnapshot();
+    ASSERT_GT(after->version(), before->version());
+    ASSERT_EQUALS(*after->lookupNSSByUUID(colUUID), newNss);
+    ASSERT_EQUALS(*after->lookupUUIDByNSS(newNss), colUUID);
+    ASSERT_EQUALS(after->lookupCollectionByNamespace(newNss), col);
+    ASSERT(after->lookupCollectionByNamespace(nss) == nullptr);
+    ASSERT_EQUALS(*catalog.lookupNSSByUUID(colUUID), newNss);
+}
+
+TEST_F(CollectionCatalogTest, SnapshotKeepsShadowCatalogOfClosedCatalog) {
+    catalog.onCloseCatalog(&opCtx);
+    catalog.deregisterCollection(colUUID);
+    auto closed = catalog.getSnapshot();
+    ASSERT_EQUALS(*closed->lookupNSSByUUID(colUUID), nss);
+
+    catalog.onOpenCatalog(&opCtx);
+    ASSERT_EQUALS(*closed->lookupNSSByUUID(colUUID), nss);
+    ASSERT(catalog.getSnapshot()->lookupNSSByUUID(colUUID) == boost::none);
+}
+
+TEST_F(CollectionCatalogTest, BatchedPublishPublishesOnceAtTheEnd) {
+    auto before = catalog.getSnapshot();
+
+    std::vector<std::pair<CollectionUUID, NamespaceString>> registered;
+    {
+        CollectionCatalog::BatchedPublish batchedPublish(catalog);
+        for (int i = 0; i < 5; ++i) {
+            NamespaceString newNss(nss.db(), "newcol" + std::to_string(i));
+            auto newUUID = CollectionUUID::gen();
+            catalog.registerCollection(newUUID, std::make_unique<CollectionMock>(newNss));
+            registered.emplace_back(newUUID, newNss);
+        }
+        catalog.deregisterCollection(registered.back().first);
+        registered.pop_back();
+
+        // Nothing is visible until the batch ends.
+        ASSERT_EQUALS(catalog.getSnapshot()->version(), before->version());
+        for (auto&& [uuid, newNss] : registered) {
+            ASSERT(catalog.lookupCollectionByUUID(uuid) == nullptr);
+            ASSERT(catalog.lookupCollectionByNamespace(newNss) == nullptr);
+        }
+    }
+
+    auto after = catalog.getSnapshot();
+    ASSERT_GT(after->version(), before->version());
+    ASSERT_EQUALS(after->getAllCollectionUUIDsFromDb(nss.db()).size(), 5U);
+    for (auto&& [uuid, newNss] : registered) {
+        ASSERT_EQUALS(*catalog.lookupNSSByUUID(uuid), newNss);
+        ASSERT_EQUALS(catalog.lookupCollectionByNamespace(newNss),
+                      catalog.lookupCollectionByUUID(uuid));
+    }
+}
+
+TEST_F(CollectionCatalogTest, LookupsSeeSnapshotsPublishedByOtherThreads) {
+    // Cache the current snapshot on this thread.
+    ASSERT_EQUALS(catalog.lookupCollectionByUUID(colUUID), col);
+
+    stdx::thread([&] { catalog.deregisterCollection(colUUID); }).join();
+
+    ASSERT(catalog.lookupCollectionByUUID(colUUID) == nullptr);
+    ASSERT(catalog.lookupUUIDByNSS(nss) == boost::none);
+}
+
 DEATH_TEST_F(CollectionCatalogResourceTest, AddInvalidResourceType, "invariant") {
     auto rid = ResourceId(RESOURCE_GLOBAL, 0);
     catalog.addResource(rid, "");
@@ -45,6 +45,7 @@ namespace mongo {
 
 class Client;
 class Collection;
+class FieldRefSetWithStorage;
 
 class IndexDescriptor;
 struct InsertDeleteOptions;
@@ -420,12 +421,17 @@ public:
      * Both 'keysInsertedOut' and 'keysDeletedOut' are required and will be set to the number of
      * index keys inserted and deleted by this operation, respectively.
      *
+     * If 'modifiedPaths' is not null, it must contain every path at which 'newDoc' may differ from
+     * 'oldDoc'. Indexes which cannot be affected by a change to any of these paths are skipped
+     * without generating their keys.
+     *
      * This method may throw.
      */
     virtual Status updateRecord(OperationContext* const opCtx,
                                 const BSONObj& oldDoc,
                                 const BSONObj& newDoc,
                                 const RecordId& recordId,
+                                const FieldRefSetWithStorage* modifiedPaths,
                                 int64_t* const keysInsertedOut,
                                 int64_t* const keysDeletedOut) = 0;
 
@@ -49,6 +49,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/field_ref.h"
+#include "mongo/db/field_ref_set.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index_legacy.h"
@@ -63,6 +64,7 @@
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
@@ -567,7 +569,7 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
 
     const bool isSparse = spec["sparse"].trueValue();
 
-    if (pluginName == IndexNames::WILDCARD) {
+    if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
         if (isSparse) {
             return Status(ErrorCodes::CannotCreateIndex,
                           str::stream() << "Index type '" << pluginName
@@ -590,6 +592,13 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
     // Ensure if there is a filter, its valid.
     BSONElement filterElement = spec.getField("partialFilterExpression");
     if (filterElement) {
+        // A column store index must have a cell for every document in order to reconstruct them.
+        if (pluginName == IndexNames::COLUMN) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream() << "Index type '" << pluginName
+                                        << "' does not support the partialFilterExpression option");
+        }
+
         if (isSparse) {
             return Status(ErrorCodes::CannotCreateIndex,
                           "cannot mix \"partialFilterExpression\" and \"sparse\" options");
@@ -1248,6 +1257,12 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, index->descriptor(), &options);
 
+    if (bsonRecords.size() > 1 && !index->isHybridBuilding() &&
+        internalInsertIndexKeysInKeyOrder.load()) {
+        return _indexFilteredRecordsInKeyOrder(
+            opCtx, index, bsonRecords, options, keysInsertedOut);
+    }
+
     for (auto bsonRecord : bsonRecords) {
         invariant(bsonRecord.id != RecordId());
 
@@ -1285,6 +1300,53 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status IndexCatalogImpl::_indexFilteredRecordsInKeyOrder(
+    OperationContext* opCtx,
+    IndexCatalogEntry* index,
+    const std::vector<BsonRecord>& bsonRecords,
+    const InsertDeleteOptions& options,
+    int64_t* keysInsertedOut) {
+    std::vector<InsertBatchKeys> batch(bsonRecords.size());
+    for (size_t i = 0; i < bsonRecords.size(); ++i) {
+        const auto& bsonRecord = bsonRecords[i];
+        invariant(bsonRecord.id != RecordId());
+
+        batch[i].loc = bsonRecord.id;
+        index->accessMethod()->getKeys(*bsonRecord.docPtr,
+                                       options.getKeysMode,
+                                       &batch[i].keys,
+                                       &batch[i].multikeyMetadataKeys,
+                                       &batch[i].multikeyPaths,
+                                       bsonRecord.id);
+    }
+
+    // Each key is still written at the timestamp of its own document. The documents were inserted
+    // in order, so no key is written at a timestamp before the first one this transaction used.
+    Timestamp lastTimestamp;
+    auto setTimestamp = [&](size_t docIndex) {
+        const Timestamp& ts = bsonRecords[docIndex].ts;
+        if (ts.isNull() || ts == lastTimestamp) {
+            return Status::OK();
+        }
+        lastTimestamp = ts;
+        return opCtx->recoveryUnit()->setTimestamp(ts);
+    };
+
+    InsertResult result;
+    Status status = index->accessMethod()->insertKeysInKeyOrder(
+        opCtx, batch, options, setTimestamp, &result);
+    if (keysInsertedOut) {
+        *keysInsertedOut += result.numInserted;
+    }
+    if (!status.isOK()) {
+        return status;
+    }
+
+    // Leave the timestamp of the last document in place for whatever follows, as inserting the
+    // keys document by document would.
+    return setTimestamp(bsonRecords.size() - 1);
+}
+
 Status IndexCatalogImpl::_indexRecords(OperationContext* opCtx,
                                        IndexCatalogEntry* index,
                                        const std::vector<BsonRecord>& bsonRecords,
@@ -1307,8 +1369,23 @@ Status IndexCatalogImpl::_updateRecord(OperationContext* const opCtx,
                                        const BSONObj& oldDoc,
                                        const BSONObj& newDoc,
                                        const RecordId& recordId,
+                                       const FieldRefSetWithStorage* modifiedPaths,
                                        int64_t* const keysInsertedOut,
                                        int64_t* const keysDeletedOut) {
+    if (modifiedPaths) {
+        // An index on none of the modified paths has the same keys for both documents.
+        const auto& indexName = index->descriptor()->indexName();
+        const UpdateIndexData* indexedPaths =
+            CollectionQueryInfo::get(_collection).getIndexKeys(opCtx, indexName);
+        auto mightBeIndexed = [&](const FieldRef* path) {
+            return indexedPaths->mightBeIndexed(*path);
+        };
+        if (indexedPaths &&
+            std::none_of(modifiedPaths->begin(), modifiedPaths->end(), mightBeIndexed)) {
+            return Status::OK();
+        }
+    }
+
     IndexAccessMethod* iam = index->accessMethod();
 
     InsertDeleteOptions options;
@@ -1450,6 +1527,7 @@ Status IndexCatalogImpl::updateRecord(OperationContext* const opCtx,
                                       const BSONObj& oldDoc,
                                       const BSONObj& newDoc,
                                       const RecordId& recordId,
+                                      const FieldRefSetWithStorage* modifiedPaths,
                                       int64_t* const keysInsertedOut,
                                       int64_t* const keysDeletedOut) {
     *keysInsertedOut = 0;
@@ -1461,7 +1539,14 @@ Status IndexCatalogImpl::updateRecord(OperationContext* const opCtx,
          ++it) {
         IndexCatalogEntry* entry = it->get();
         auto status =
-            _updateRecord(opCtx, entry, oldDoc, newDoc, recordId, keysInsertedOut, keysDeletedOut);
+            _updateRecord(opCtx,
+                          entry,
+                          oldDoc,
+                          newDoc,
+                          recordId,
+                          modifiedPaths,
+                          keysInsertedOut,
+                          keysDeletedOut);
         if (!status.isOK())
             return status;
     }
@@ -1472,7 +1557,14 @@ Status IndexCatalogImpl::updateRecord(OperationContext* const opCtx,
          ++it) {
         IndexCatalogEntry* entry = it->get();
         auto status =
-            _updateRecord(opCtx, entry, oldDoc, newDoc, recordId, keysInsertedOut, keysDeletedOut);
+            _updateRecord(opCtx,
+                          entry,
+                          oldDoc,
+                          newDoc,
+                          recordId,
+                          modifiedPaths,
+                          keysInsertedOut,
+                          keysDeletedOut);
         if (!status.isOK())
             return status;
     }
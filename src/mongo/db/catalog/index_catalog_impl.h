@@ -261,6 +261,7 @@ public:
                         const BSONObj& oldDoc,
                         const BSONObj& newDoc,
                         const RecordId& recordId,
+                        const FieldRefSetWithStorage* modifiedPaths,
                         int64_t* const keysInsertedOut,
                         int64_t* const keysDeletedOut) override;
     /**
@@ -321,6 +322,16 @@ private:
                                  const std::vector<BsonRecord>& bsonRecords,
                                  int64_t* keysInsertedOut);
 
+    /**
+     * Inserts the keys of all of 'bsonRecords' into 'index' in key order rather than record by
+     * record.
+     */
+    Status _indexFilteredRecordsInKeyOrder(OperationContext* opCtx,
+                                           IndexCatalogEntry* index,
+                                           const std::vector<BsonRecord>& bsonRecords,
+                                           const InsertDeleteOptions& options,
+                                           int64_t* keysInsertedOut);
+
     Status _indexRecords(OperationContext* opCtx,
                          IndexCatalogEntry* index,
                          const std::vector<BsonRecord>& bsonRecords,
@@ -331,6 +342,7 @@ private:
                          const BSONObj& oldDoc,
                          const BSONObj& newDoc,
                          const RecordId& recordId,
+                         const FieldRefSetWithStorage* modifiedPaths,
                          int64_t* const keysInsertedOut,
                          int64_t* const keysDeletedOut);
 
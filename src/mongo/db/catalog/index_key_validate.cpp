@@ -137,7 +137,7 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                                           << static_cast<int>(indexVersion)};
                 }
 
-                if (pluginName == IndexNames::WILDCARD) {
+                if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
                     return {code,
                             str::stream() << "'" << pluginName
                                           << "' index plugin is not allowed with index version v:"
@@ -178,6 +178,13 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                                         << "' index must be a non-zero number, not a string.");
         }
 
+        if (pluginName == IndexNames::COLUMN && keyElement.type() != String) {
+            return Status(code,
+                          str::stream() << "Every field in a '" << IndexNames::COLUMN
+                                        << "' index key pattern must have the value '"
+                                        << IndexNames::COLUMN << "'");
+        }
+
         // Check if the wildcard index is compounded. If it is the key is invalid because
         // compounded wildcard indexes are disallowed.
         if (pluginName == IndexNames::WILDCARD && key.nFields() != 1) {
@@ -234,6 +241,24 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
         }
     }
 
+    // Each column of a column store index is written back to its own position in the output
+    // document, so no indexed path may be a prefix of another one.
+    if (pluginName == IndexNames::COLUMN) {
+        for (auto&& keyElement : key) {
+            FieldRef keyField(keyElement.fieldNameStringData());
+            for (auto&& otherElement : key) {
+                FieldRef otherField(otherElement.fieldNameStringData());
+                if (keyField.isPrefixOf(otherField)) {
+                    return Status(code,
+                                  str::stream()
+                                      << "'" << IndexNames::COLUMN << "' index paths '"
+                                      << keyField.dottedField() << "' and '"
+                                      << otherField.dottedField() << "' overlap");
+                }
+            }
+        }
+    }
+
     return Status::OK();
 }
 
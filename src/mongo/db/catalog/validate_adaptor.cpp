@@ -338,10 +338,10 @@ void ValidateAdaptor::validateIndexKeyCount(const IndexDescriptor* idx, Validate
 
     // Confirm that the number of index entries is not greater than the number of documents in the
     // collection. This check is only valid for indexes that are not multikey (indexed arrays
-    // produce an index key per array entry) and not $** indexes which can produce index keys for
-    // multiple paths within a single document.
+    // produce an index key per array entry) and not $** or column store indexes which can produce
+    // index keys for multiple paths within a single document.
     if (results.valid && !idx->isMultikey() && idx->getIndexType() != IndexType::INDEX_WILDCARD &&
-        numTotalKeys > _numRecords) {
+        idx->getIndexType() != IndexType::INDEX_COLUMN && numTotalKeys > _numRecords) {
         std::string err = str::stream()
             << "index " << idx->indexName() << " is not multi-key, but has more entries ("
             << numTotalKeys << ") than documents in the index (" << _numRecords << ")";
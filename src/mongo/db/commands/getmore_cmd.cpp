@@ -43,6 +43,7 @@
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/cursor_manager.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/exec/document_value/document_buffer_pool.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/find.h"
@@ -256,6 +257,20 @@ public:
                                                       _request.term.is_initialized()));
         }
 
+        /**
+         * Returns true if 'obj' has a $sortKey object, as the results of a sorted find sent by
+         * mongos do, and it sorts strictly after the key in 'threshold'.
+         */
+        static bool sortsAfterThreshold(const BSONObj& obj,
+                                        const GetMoreRequest::SortKeyThreshold& threshold) {
+            auto sortKey = obj[Document::metaFieldSortKey];
+            if (sortKey.type() != BSONType::Object) {
+                return false;
+            }
+            const bool considerFieldName = false;
+            return sortKey.Obj().woCompare(threshold.key, threshold.pattern, considerFieldName) > 0;
+        }
+
         /**
          * Uses 'cursor' and 'request' to fill out 'nextBatch' with the batch of result documents to
          * be returned by this getMore.
@@ -273,6 +288,8 @@ public:
                              PlanExecutor::ExecState* state,
                              std::uint64_t* numResults) {
             PlanExecutor* exec = cursor->getExecutor();
+            document_buffer_pool::Scope bufferPoolScope(
+                exec->getExpCtx() ? exec->getExpCtx()->documentBufferPoolBytes : 0);
 
             // If an awaitData getMore is killed during this process due to our max time expiring at
             // an interrupt point, we just continue as normal and return rather than reporting a
@@ -300,6 +317,15 @@ public:
                     nextBatch->setPostBatchResumeToken(exec->getPostBatchResumeToken());
                     nextBatch->append(obj);
                     (*numResults)++;
+
+                    // A merging mongos which already holds enough results sorting before the
+                    // threshold discards this result and everything after it, so the batch ends
+                    // here. Returning this result lets mongos see that it passed the threshold,
+                    // and the cursor stays positioned right after it.
+                    if (request.sortKeyThreshold &&
+                        sortsAfterThreshold(obj, *request.sortKeyThreshold)) {
+                        break;
+                    }
                 }
             } catch (const ExceptionFor<ErrorCodes::CloseChangeStream>&) {
                 // FAILURE state will make getMore command close the cursor even if it's tailable.
@@ -44,12 +44,18 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/change_stream_proxy.h"
 #include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/document_buffer_pool.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_cursor.h"
 #include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_geo_near.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_limit.h"
+#include "mongo/db/pipeline/document_source_parallel_merge.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
@@ -62,6 +68,7 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/repl/oplog.h"
@@ -172,6 +179,10 @@ bool handleCursorCommand(OperationContext* opCtx,
     auto exec = cursor->getExecutor();
     invariant(exec);
 
+    // Let the documents of this batch reuse each other's buffers, if the pipeline opted in.
+    document_buffer_pool::Scope bufferPoolScope(
+        exec->getExpCtx() ? exec->getExpCtx()->documentBufferPoolBytes : 0);
+
     bool stashedResult = false;
     for (int objCount = 0; objCount < batchSize; objCount++) {
         // The initial getNext() on a PipelineProxyStage may be very expensive so we don't
@@ -453,6 +464,187 @@ std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> createExchangePipelinesI
     return pipelines;
 }
 
+/**
+ * Returns the BSON form of 'stages', for parsing them again with a different ExpressionContext.
+ */
+template <typename Iterator>
+std::vector<BSONObj> serializeStages(Iterator begin, Iterator end) {
+    std::vector<Value> serialized;
+    for (auto it = begin; it != end; ++it) {
+        (*it)->serializeToArray(serialized);
+    }
+
+    std::vector<BSONObj> stages;
+    for (auto&& stage : serialized) {
+        stages.push_back(stage.getDocument().toBson());
+    }
+    return stages;
+}
+
+/**
+ * If 'internalQueryAggParallelism' is greater than one and 'pipeline' reads a collection through a
+ * $cursor stage followed by streaming stages and then a $group or $sort, rewrites it for parallel
+ * execution on this node:
+ *  - the $cursor and streaming stages feed an Exchange, which hash partitions the documents on the
+ *    group key for a $group or deals them round robin for a $sort;
+ *  - every worker runs its own copy of the $group or $sort on one consumer of the Exchange;
+ *  - the returned pipeline starts with a $_internalParallelMerge of the worker outputs, which keeps
+ *    the sort order for a $sort, followed by the rest of the original stages.
+ * Otherwise, returns 'pipeline' unchanged.
+ */
+std::unique_ptr<Pipeline, PipelineDeleter> createParallelPipelineIfNeeded(
+    OperationContext* opCtx,
+    const AggregationRequest& request,
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline,
+    boost::optional<UUID> uuid) {
+    const auto parallelism = static_cast<size_t>(internalQueryAggParallelism.load());
+    const auto& expCtx = pipeline->getContext();
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+
+    // The workers read with their own OperationContexts, so only plain local reads qualify. Group
+    // keys are partitioned by hash, which requires the simple collation.
+    if (parallelism <= 1 || expCtx->explain || request.getExchangeSpec() ||
+        expCtx->tailableMode != TailableModeEnum::kNormal || expCtx->getCollator() ||
+        opCtx->inMultiDocumentTransaction() ||
+        readConcernArgs.getLevel() != repl::ReadConcernLevel::kLocalReadConcern ||
+        readConcernArgs.getArgsAfterClusterTime() || readConcernArgs.getArgsAtClusterTime()) {
+        return pipeline;
+    }
+
+    auto& sources = pipeline->getSources();
+    if (sources.empty() || !dynamic_cast<DocumentSourceCursor*>(sources.front().get())) {
+        return pipeline;
+    }
+
+    // The stages before the $group or $sort run on whichever worker is loading the Exchange, so
+    // they must not block.
+    auto split = std::next(sources.begin());
+    size_t splitIndex = 1;
+    for (; split != sources.end(); ++split, ++splitIndex) {
+        if (dynamic_cast<DocumentSourceGroup*>(split->get()) ||
+            dynamic_cast<DocumentSourceSort*>(split->get())) {
+            break;
+        }
+        if ((*split)->constraints(Pipeline::SplitState::kUnsplit).streamType !=
+            DocumentSource::StreamType::kStreaming) {
+            return pipeline;
+        }
+    }
+    if (split == sources.end()) {
+        return pipeline;
+    }
+
+    boost::intrusive_ptr<DocumentSourceGroup> group =
+        dynamic_cast<DocumentSourceGroup*>(split->get());
+    boost::intrusive_ptr<DocumentSourceSort> sort = dynamic_cast<DocumentSourceSort*>(split->get());
+    if (group) {
+        // A group key that does not depend on the input puts every document in one worker.
+        auto idFields = group->getIdFields();
+        if (std::all_of(idFields.begin(), idFields.end(), [](const auto& idField) {
+                return dynamic_cast<ExpressionConstant*>(idField.second.get()) != nullptr;
+            })) {
+            return pipeline;
+        }
+    }
+
+    // The aggregation runs serially when the other parallel aggregations already use up the
+    // worker pool.
+    auto reservation =
+        DocumentSourceParallelMerge::reserveWorkers(opCtx->getServiceContext(), parallelism);
+    if (!reservation) {
+        return pipeline;
+    }
+
+    // Every worker and the merging pipeline build their own copy of the stages, since stages and
+    // ExpressionContexts cannot be shared between threads. They still see the same values of
+    // $$NOW and $$CLUSTER_TIME as the original ExpressionContext.
+    auto makeParallelExpCtx = [&] {
+        auto parallelExpCtx = makeExpressionContext(opCtx, request, nullptr, uuid);
+        parallelExpCtx->variables = expCtx->variables;
+        parallelExpCtx->variablesParseState =
+            expCtx->variablesParseState.copyWith(parallelExpCtx->variables.useIdGenerator());
+        return parallelExpCtx;
+    };
+
+    // The workers together may use as much memory as the original stage.
+    auto groupSpec = group ? serializeStages(split, std::next(split)).front() : BSONObj();
+    const size_t groupMaxMemoryBytes =
+        internalDocumentSourceGroupMaxMemoryBytes.load() / parallelism;
+    const uint64_t sortMaxMemoryBytes =
+        internalQueryMaxBlockingSortMemoryUsageBytes.load() / parallelism;
+
+    std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> workerPipelines;
+    std::vector<boost::intrusive_ptr<ExpressionContext>> workerExpCtxs;
+    for (size_t idx = 0; idx < parallelism; ++idx) {
+        workerExpCtxs.push_back(makeParallelExpCtx());
+        boost::intrusive_ptr<DocumentSource> workerStage;
+        if (group) {
+            workerStage = DocumentSourceGroup::createFromBsonWithMaxMemoryUsage(
+                groupSpec.firstElement(), workerExpCtxs.back(), groupMaxMemoryBytes);
+        } else {
+            workerStage = DocumentSourceSort::create(
+                workerExpCtxs.back(),
+                sort->getSortKeyPattern()
+                    .serialize(SortPattern::SortKeySerialization::kForPipelineSerialization)
+                    .toBson(),
+                sort->getLimit().value_or(0),
+                sortMaxMemoryBytes);
+        }
+        auto workerPipeline =
+            uassertStatusOK(Pipeline::create({std::move(workerStage)}, workerExpCtxs.back()));
+        workerPipeline->optimizePipeline();
+        workerPipelines.push_back(std::move(workerPipeline));
+    }
+
+    auto mergeExpCtx = makeParallelExpCtx();
+    auto mergePipeline = uassertStatusOK(
+        Pipeline::parse(serializeStages(std::next(split), sources.end()), mergeExpCtx));
+
+    // Only the $cursor and the streaming stages remain in the pipeline feeding the Exchange.
+    while (sources.size() > splitIndex) {
+        pipeline->popBack();
+    }
+
+    ExchangeSpec spec;
+    spec.setPolicy(ExchangePolicyEnum::kRoundRobin);
+    spec.setConsumers(parallelism);
+    spec.setBufferSize(internalQueryAggParallelBufferSizeBytes.load());
+
+    Exchange::PartitionFunction partitioner;
+    if (group) {
+        // The original $group is bound to the ExpressionContext of the Exchange input, which is
+        // only used by the loading thread.
+        partitioner = [group](const Document& doc) {
+            return group->getContext()->getValueComparator().hash(group->computeId(doc));
+        };
+    }
+    boost::intrusive_ptr<Exchange> exchange =
+        new Exchange(std::move(spec), std::move(pipeline), std::move(partitioner));
+
+    for (size_t idx = 0; idx < parallelism; ++idx) {
+        workerPipelines[idx]->addInitialSource(
+            new DocumentSourceExchange(workerExpCtxs[idx], exchange, idx, nullptr));
+        workerPipelines[idx]->detachFromOperationContext();
+    }
+
+    boost::optional<SortPattern> mergeSort;
+    if (sort) {
+        mergeSort = sort->getSortKeyPattern();
+        if (auto limit = sort->getLimit()) {
+            // Every worker keeps its own top 'limit' documents.
+            mergePipeline->addInitialSource(DocumentSourceLimit::create(mergeExpCtx, *limit));
+        }
+    }
+    mergePipeline->addInitialSource(
+        new DocumentSourceParallelMerge(mergeExpCtx,
+                                        std::move(workerPipelines),
+                                        std::move(exchange),
+                                        std::move(reservation),
+                                        std::move(mergeSort),
+                                        internalQueryAggParallelBufferSizeBytes.load()));
+    return mergePipeline;
+}
+
 /**
  * Create a PlanExecutor to execute the given 'pipeline'.
  */
@@ -668,6 +860,9 @@ Status runAggregate(OperationContext* opCtx,
                                                           std::move(attachExecutorCallback.second),
                                                           pipeline.get());
 
+            pipeline =
+                createParallelPipelineIfNeeded(opCtx, request, std::move(pipeline), uuid);
+
             auto pipelines =
                 createExchangePipelinesIfNeeded(opCtx, expCtx, request, std::move(pipeline), uuid);
             for (auto&& pipelineIt : pipelines) {
@@ -37,6 +37,9 @@
 #include "mongo/db/commands/server_status_internal.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/logv2/async_sink.h"
+#include "mongo/logv2/log_domain_global.h"
+#include "mongo/logv2/log_manager.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/http_client.h"
 #include "mongo/util/net/socket_utils.h"
@@ -256,6 +259,30 @@ public:
 
 } asserts;
 
+class AsyncLogging : public ServerStatusSection {
+public:
+    AsyncLogging() : ServerStatusSection("asyncLogging") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        auto& domain = logv2::LogManager::global().getGlobalDomainInternal();
+        auto stats = domain.asyncStats();
+
+        BSONObjBuilder bb;
+        bb.append("enabled", domain.asyncEnabled());
+        bb.append("written", stats.written);
+        bb.append("dropped", stats.dropped);
+        bb.append("blocked", stats.blocked);
+        bb.append("queued", stats.queued);
+        return bb.obj();
+    }
+
+} asyncLogging;
+
 class MemBase : public ServerStatusMetric {
 public:
     MemBase() : ServerStatusMetric(".mem.bits") {}
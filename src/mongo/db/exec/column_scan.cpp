@@ -0,0 +1,210 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/column_scan.h"
+
+#include <memory>
+
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/storage/index_entry_comparison.h"
+
+namespace mongo {
+
+// static
+const char* ColumnScan::kStageType = "COLUMN_SCAN";
+
+ColumnScan::ColumnScan(OperationContext* opCtx,
+                       const IndexDescriptor* descriptor,
+                       std::vector<std::string> paths,
+                       WorkingSet* workingSet)
+    : RequiresIndexStage(kStageType, opCtx, descriptor, workingSet), _workingSet(workingSet) {
+    _columns.emplace_back(ColumnKeyGenerator::kRowIdPath.toString());
+    for (auto&& path : paths) {
+        _columns.emplace_back(path);
+    }
+
+    _specificStats.indexName = descriptor->indexName();
+    _specificStats.keyPattern = descriptor->keyPattern();
+    _specificStats.paths = std::move(paths);
+}
+
+void ColumnScan::_openColumn(Column* column) {
+    auto cursor = indexAccessMethod()->newCursor(getOpCtx(), true);
+    cursor->setEndPosition(ColumnKeyGenerator::makeColumnEndKey(column->path), false);
+
+    auto sdi = indexAccessMethod()->getSortedDataInterface();
+    auto current = cursor->seek(IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(
+        ColumnKeyGenerator::makeColumnStartKey(column->path),
+        sdi->getKeyStringVersion(),
+        sdi->getOrdering(),
+        true /* forward */,
+        false /* inclusive */));
+
+    column->cursor = std::move(cursor);
+    column->current = std::move(current);
+    if (column->current) {
+        ++_specificStats.keysExamined;
+    }
+}
+
+void ColumnScan::_advanceColumn(Column* column) {
+    column->current = column->cursor->next();
+    column->needsAdvance = false;
+    if (column->current) {
+        ++_specificStats.keysExamined;
+    }
+}
+
+PlanStage::StageState ColumnScan::doWork(WorkingSetID* out) {
+    if (_commonStats.isEOF) {
+        return PlanStage::IS_EOF;
+    }
+
+    auto& rowColumn = _columns.front();
+    try {
+        for (auto&& column : _columns) {
+            if (!column.cursor) {
+                _openColumn(&column);
+            } else if (column.needsAdvance) {
+                _advanceColumn(&column);
+            }
+        }
+
+        // Skip over the cells of records which were deleted while we were yielded, if any.
+        if (rowColumn.current) {
+            for (size_t i = 1; i < _columns.size(); ++i) {
+                auto& column = _columns[i];
+                while (column.current && column.current->loc < rowColumn.current->loc) {
+                    _advanceColumn(&column);
+                }
+            }
+        }
+    } catch (const WriteConflictException&) {
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
+
+    if (!rowColumn.current) {
+        _commonStats.isEOF = true;
+        _columns.clear();
+        return PlanStage::IS_EOF;
+    }
+
+    const RecordId recordId = rowColumn.current->loc;
+    rowColumn.needsAdvance = true;
+
+    MutableDocument reassembled;
+    for (size_t i = 1; i < _columns.size(); ++i) {
+        auto& column = _columns[i];
+        if (!column.current || column.current->loc != recordId) {
+            // This record has no value for this path.
+            continue;
+        }
+
+        // Cells are keys of the form {'': <path>, '': <RecordId>, '': <value>}.
+        BSONObjIterator cell(column.current->key);
+        cell.next();
+        cell.next();
+        reassembled.setNestedField(column.path, Value(cell.next()));
+        column.needsAdvance = true;
+    }
+    ++_specificStats.docsReassembled;
+
+    WorkingSetID id = _workingSet->allocate();
+    WorkingSetMember* member = _workingSet->get(id);
+    member->recordId = recordId;
+    member->doc = {getOpCtx()->recoveryUnit()->getSnapshotId(), reassembled.freeze()};
+    _workingSet->transitionToOwnedObj(id);
+
+    *out = id;
+    return PlanStage::ADVANCED;
+}
+
+bool ColumnScan::isEOF() {
+    return _commonStats.isEOF;
+}
+
+void ColumnScan::doSaveStateRequiresIndex() {
+    for (auto&& column : _columns) {
+        if (!column.cursor) {
+            continue;
+        }
+
+        // The current cell may point into memory owned by the cursor, which is not guaranteed to
+        // remain valid across a yield.
+        if (column.current && !column.current->key.isOwned()) {
+            column.current->key = column.current->key.getOwned();
+        }
+        column.cursor->save();
+    }
+}
+
+void ColumnScan::doRestoreStateRequiresIndex() {
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->restore();
+        }
+    }
+}
+
+void ColumnScan::doDetachFromOperationContext() {
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->detachFromOperationContext();
+        }
+    }
+}
+
+void ColumnScan::doReattachToOperationContext() {
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->reattachToOperationContext(getOpCtx());
+        }
+    }
+}
+
+std::unique_ptr<PlanStageStats> ColumnScan::getStats() {
+    _commonStats.isEOF = isEOF();
+    auto ret = std::make_unique<PlanStageStats>(_commonStats, STAGE_COLUMN_SCAN);
+    ret->specific = std::make_unique<ColumnScanStats>(_specificStats);
+    return ret;
+}
+
+const SpecificStats* ColumnScan::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
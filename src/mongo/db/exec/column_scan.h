@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/exec/requires_index_stage.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+
+namespace mongo {
+
+class IndexDescriptor;
+class WorkingSet;
+
+/**
+ * Reads a subset of the columns of a "columnstore" index and reassembles, for every record in the
+ * collection, a document holding just the values of 'paths'. This lets queries which only need a
+ * few fields of wide documents avoid fetching and decoding the full records.
+ *
+ * One cursor is opened per column, plus one over the row marker column, which has a cell for every
+ * record. All columns are sorted by RecordId, so they are merged in a single forward pass: the row
+ * marker column drives the scan, and each other column contributes its value whenever its current
+ * cell belongs to the record being reassembled.
+ *
+ * Results are returned in the OWNED_OBJ state, in RecordId order. Fields are laid out in the order
+ * of 'paths' rather than in the order in which they appear in the stored document.
+ */
+class ColumnScan final : public RequiresIndexStage {
+public:
+    static const char* kStageType;
+
+    ColumnScan(OperationContext* opCtx,
+               const IndexDescriptor* descriptor,
+               std::vector<std::string> paths,
+               WorkingSet* workingSet);
+
+    StageState doWork(WorkingSetID* out) final;
+    bool isEOF() final;
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+    StageType stageType() const final {
+        return STAGE_COLUMN_SCAN;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final;
+
+protected:
+    void doSaveStateRequiresIndex() final;
+
+    void doRestoreStateRequiresIndex() final;
+
+private:
+    struct Column {
+        explicit Column(std::string columnPath) : path(std::move(columnPath)) {}
+
+        std::string path;
+        std::unique_ptr<SortedDataInterface::Cursor> cursor;
+
+        // The cell the cursor is positioned on, or boost::none once the column is exhausted.
+        boost::optional<IndexKeyEntry> current;
+
+        // Set once 'current' has been consumed, so that the cursor is moved forward before the
+        // next document is reassembled.
+        bool needsAdvance = false;
+    };
+
+    /**
+     * Opens the cursor of 'column' and positions it on the first cell of the column.
+     */
+    void _openColumn(Column* column);
+
+    /**
+     * Moves 'column' to its next cell.
+     */
+    void _advanceColumn(Column* column);
+
+    // The WorkingSet we annotate with results. Not owned by us.
+    WorkingSet* _workingSet;
+
+    // The row marker column comes first, followed by one column per projected path.
+    std::vector<Column> _columns;
+
+    ColumnScanStats _specificStats;
+};
+
+}  // namespace mongo
@@ -34,9 +34,11 @@
 #include <boost/functional/hash.hpp>
 
 #include "mongo/bson/bson_depth.h"
+#include "mongo/db/exec/document_value/document_buffer_pool.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/resume_token.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -160,6 +162,14 @@ Position DocumentStorage::findField(StringData requested, LookupPolicy policy) c
         return pos;
     }
 
+    if (_bson.objsize() >= BSON_INDEX_MIN_BYTES) {
+        auto bsonElement = findFieldInBsonIndex(requested);
+        if (bsonElement.eoo()) {
+            return Position();
+        }
+        return const_cast<DocumentStorage*>(this)->constructInCache(bsonElement);
+    }
+
     while (_bsonIt.more()) {
         BSONElement bsonElement(_bsonIt.next());
         // In order to avoid repeatedly scanning the BSON we were constructed from, we'll bring in a
@@ -176,11 +186,62 @@ Position DocumentStorage::findField(StringData requested, LookupPolicy policy) c
     return Position();
 }
 
+BSONElement DocumentStorage::findFieldInBsonIndex(StringData requested) const {
+    if (_bsonIndex.empty()) {
+        buildBsonIndex();
+    }
+
+    // The table is at most half full, so the probe always reaches an empty slot.
+    const unsigned mask = _bsonIndex.size() - 1;
+    for (unsigned bucket = hashKey(requested) & mask; _bsonIndex[bucket];
+         bucket = (bucket + 1) & mask) {
+        BSONElement elem(_bson.objdata() + _bsonIndex[bucket]);
+        if (elem.fieldNameStringData() == requested) {
+            return elem;
+        }
+    }
+    return BSONElement();
+}
+
+void DocumentStorage::buildBsonIndex() const {
+    std::vector<uint32_t> offsets;
+    for (auto&& elem : _bson) {
+        offsets.push_back(elem.rawdata() - _bson.objdata());
+    }
+
+    size_t buckets = HASH_TAB_INIT_SIZE;
+    while (buckets < offsets.size() * 2)
+        buckets *= 2;
+    _bsonIndex.assign(buckets, 0);
+
+    const unsigned mask = buckets - 1;
+    for (auto offset : offsets) {
+        const auto name = BSONElement(_bson.objdata() + offset).fieldNameStringData();
+        for (unsigned bucket = hashKey(name) & mask;; bucket = (bucket + 1) & mask) {
+            if (!_bsonIndex[bucket]) {
+                _bsonIndex[bucket] = offset;
+                break;
+            }
+            // Like a scan of the BSON, resolve duplicate field names to the first occurrence.
+            if (BSONElement(_bson.objdata() + _bsonIndex[bucket]).fieldNameStringData() == name) {
+                break;
+            }
+        }
+    }
+}
+
 Position DocumentStorage::constructInCache(const BSONElement& elem) {
     auto savedModified = _modified;
     auto pos = getNextPosition();
     const auto fieldName = elem.fieldNameStringData();
-    appendField(fieldName, ValueElement::Kind::kCached) = Value(elem);
+    if (elem.type() == Object && elem.valuesize() >= BSON_INDEX_MIN_BYTES && _bson.isOwned()) {
+        // Rather than copying a large subobject, let the nested document view it in our buffer.
+        // Its own fields are then materialized lazily as they are requested.
+        appendField(fieldName, ValueElement::Kind::kCached) =
+            Value(Document(elem.embeddedObject().shareOwnershipWith(_bson)));
+    } else {
+        appendField(fieldName, ValueElement::Kind::kCached) = Value(elem);
+    }
     _modified = savedModified;
 
     return pos;
@@ -247,6 +308,8 @@ void DocumentStorage::alloc(unsigned newSize) {
     const bool firstAlloc = !_cache;
     const bool doingRehash = needRehash();
     const size_t oldCapacity = _cacheEnd - _cache;
+    const size_t oldBytes = allocatedBytes();
+    const unsigned oldHashTabMask = _hashTabMask;
 
     // make new bucket count big enough
     while (needRehash() || hashTabBuckets() < HASH_TAB_INIT_SIZE)
@@ -257,15 +320,20 @@ void DocumentStorage::alloc(unsigned newSize) {
     while (capacity < newSize + hashTabBytes())
         capacity *= 2;
 
+    if (capacity > size_t(BufferMaxSize)) {
+        // Keep allocatedBytes() describing the buffer we still hold.
+        _hashTabMask = oldHashTabMask;
+    }
     uassert(16490, "Tried to make oversized document", capacity <= size_t(BufferMaxSize));
 
-    std::unique_ptr<char[]> oldBuf(_cache);
-    _cache = new char[capacity];
+    char* const oldBuf = _cache;
+    ON_BLOCK_EXIT([&] { document_buffer_pool::deallocate(oldBuf, oldBytes); });
+    _cache = document_buffer_pool::allocate(capacity);
     _cacheEnd = _cache + capacity - hashTabBytes();
 
     if (!firstAlloc) {
         // This just copies the elements
-        memcpy(_cache, oldBuf.get(), _usedBytes);
+        memcpy(_cache, oldBuf, _usedBytes);
 
         if (_numFields >= HASH_TAB_MIN) {
             // if we were hashing, deal with the hash table
@@ -273,7 +341,7 @@ void DocumentStorage::alloc(unsigned newSize) {
                 rehash();
             } else {
                 // no rehash needed so just slide table down to new position
-                memcpy(_hashTab, oldBuf.get() + oldCapacity, hashTabBytes());
+                memcpy(_hashTab, oldBuf + oldCapacity, hashTabBytes());
             }
         }
     }
@@ -292,7 +360,7 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
 
     uassert(16491, "Tried to make oversized document", newSize <= size_t(BufferMaxSize));
 
-    _cache = new char[newSize + hashTabBytes()];
+    _cache = document_buffer_pool::allocate(newSize + hashTabBytes());
     _cacheEnd = _cache + newSize;
 }
 
@@ -303,7 +371,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
         // Make a copy of the buffer with the fields.
         // It is very important that the positions of each field are the same after cloning.
         const size_t bufferBytes = allocatedBytes();
-        out->_cache = new char[bufferBytes];
+        out->_cache = document_buffer_pool::allocate(bufferBytes);
         out->_cacheEnd = out->_cache + (_cacheEnd - _cache);
         memcpy(out->_cache, _cache, bufferBytes);
 
@@ -324,6 +392,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
         dassert(out->_numFields == _numFields);
     }
 
+    out->_bsonIndex = _bsonIndex;
     out->_haveLazyLoadedMetadata = _haveLazyLoadedMetadata;
     out->_metadataFields = _metadataFields;
 
@@ -335,16 +404,17 @@ size_t DocumentStorage::getMetadataApproximateSize() const {
 }
 
 DocumentStorage::~DocumentStorage() {
-    std::unique_ptr<char[]> deleteBufferAtScopeEnd(_cache);
-
     for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
     }
+
+    document_buffer_pool::deallocate(_cache, allocatedBytes());
 }
 
 void DocumentStorage::reset(const BSONObj& bson, bool stripMetadata) {
     _bson = bson;
     _bsonIt = BSONObjIterator(_bson);
+    _bsonIndex.clear();
     _stripMetadata = stripMetadata;
     _modified = false;
 
@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/document_value/document_buffer_pool.h"
+
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+#include "mongo/util/allocator.h"
+
+namespace mongo {
+namespace document_buffer_pool {
+namespace {
+
+// DocumentStorage never allocates less than this, and grows its buffer by doubling.
+constexpr size_t kMinPooledBytes = 128;
+constexpr size_t kNumSizeClasses = 10;  // 128 bytes to 64KB
+
+/**
+ * Returns the free list index for buffers of 'bytes', or -1 if buffers of that size are not
+ * pooled. Only exact powers of two are pooled, so any buffer of a class can satisfy a request
+ * for that class no matter where it was allocated.
+ */
+int sizeClass(size_t bytes) {
+    if (bytes < kMinPooledBytes || (bytes & (bytes - 1)) != 0) {
+        return -1;
+    }
+    int sizeClass = 0;
+    for (size_t classBytes = kMinPooledBytes; classBytes < bytes; classBytes *= 2) {
+        ++sizeClass;
+    }
+    return sizeClass < int(kNumSizeClasses) ? sizeClass : -1;
+}
+
+struct ThreadPool {
+    ~ThreadPool() {
+        releaseAll();
+    }
+
+    void releaseAll() {
+        for (auto&& freeList : freeLists) {
+            for (auto buffer : freeList) {
+                std::free(buffer);
+            }
+            freeList.clear();
+        }
+        pooledBytes = 0;
+    }
+
+    int scopeDepth = 0;
+    size_t maxBytes = 0;
+    size_t pooledBytes = 0;
+    std::array<std::vector<char*>, kNumSizeClasses> freeLists;
+};
+
+thread_local ThreadPool threadPool;
+
+}  // namespace
+
+char* allocate(size_t bytes) {
+    auto& pool = threadPool;
+    if (pool.scopeDepth) {
+        if (auto index = sizeClass(bytes); index >= 0 && !pool.freeLists[index].empty()) {
+            auto buffer = pool.freeLists[index].back();
+            pool.freeLists[index].pop_back();
+            pool.pooledBytes -= bytes;
+            return buffer;
+        }
+    }
+    return static_cast<char*>(mongoMalloc(bytes));
+}
+
+void deallocate(char* buffer, size_t bytes) {
+    if (!buffer) {
+        return;
+    }
+
+    auto& pool = threadPool;
+    if (pool.scopeDepth && pool.pooledBytes + bytes <= pool.maxBytes) {
+        if (auto index = sizeClass(bytes); index >= 0) {
+            pool.freeLists[index].push_back(buffer);
+            pool.pooledBytes += bytes;
+            return;
+        }
+    }
+    std::free(buffer);
+}
+
+Scope::Scope(size_t maxBytes) : _active(maxBytes > 0) {
+    if (_active && threadPool.scopeDepth++ == 0) {
+        threadPool.maxBytes = maxBytes;
+    }
+}
+
+Scope::~Scope() {
+    if (_active && --threadPool.scopeDepth == 0) {
+        threadPool.releaseAll();
+    }
+}
+
+size_t pooledBytesForCurrentThread() {
+    return threadPool.pooledBytes;
+}
+
+}  // namespace document_buffer_pool
+}  // namespace mongo
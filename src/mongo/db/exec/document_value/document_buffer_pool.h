@@ -0,0 +1,75 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace mongo {
+namespace document_buffer_pool {
+
+/**
+ * Allocation of the field buffers of DocumentStorage.
+ *
+ * A pipeline builds and drops many documents whose buffers fall into a handful of power-of-two
+ * sizes. While a Scope is alive on a thread, buffers of those sizes released on that thread are
+ * kept on per-size free lists and handed back out by allocate() instead of going through the
+ * general-purpose allocator. The buffers kept by a thread are released in bulk when its outermost
+ * Scope ends.
+ *
+ * Buffers are plain heap memory: a buffer allocated under one Scope may be deallocated on any
+ * thread, with or without a Scope.
+ */
+char* allocate(size_t bytes);
+void deallocate(char* buffer, size_t bytes);
+
+/**
+ * Enables buffer reuse on the current thread for its lifetime, keeping at most 'maxBytes' of
+ * released buffers. A Scope with 'maxBytes' of 0 does nothing. Scopes nest; the limit of the
+ * outermost one applies.
+ */
+class Scope {
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+public:
+    explicit Scope(size_t maxBytes);
+    ~Scope();
+
+private:
+    const bool _active;
+};
+
+/**
+ * Returns the number of bytes of released buffers currently kept by the calling thread.
+ */
+size_t pooledBytesForCurrentThread();
+
+}  // namespace document_buffer_pool
+}  // namespace mongo
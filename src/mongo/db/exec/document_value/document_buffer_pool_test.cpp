@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/document_buffer_pool.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(DocumentBufferPoolTest, ReusesReleasedBuffersWithinAScope) {
+    document_buffer_pool::Scope scope(64 * 1024);
+
+    auto buffer = document_buffer_pool::allocate(256);
+    document_buffer_pool::deallocate(buffer, 256);
+    ASSERT_EQ(256U, document_buffer_pool::pooledBytesForCurrentThread());
+
+    ASSERT_EQ(buffer, document_buffer_pool::allocate(256));
+    ASSERT_EQ(0U, document_buffer_pool::pooledBytesForCurrentThread());
+    document_buffer_pool::deallocate(buffer, 256);
+}
+
+TEST(DocumentBufferPoolTest, KeepsNothingOutsideAScope) {
+    auto buffer = document_buffer_pool::allocate(256);
+    document_buffer_pool::deallocate(buffer, 256);
+    ASSERT_EQ(0U, document_buffer_pool::pooledBytesForCurrentThread());
+
+    // A Scope without a byte budget does not enable reuse either.
+    document_buffer_pool::Scope scope(0);
+    buffer = document_buffer_pool::allocate(256);
+    document_buffer_pool::deallocate(buffer, 256);
+    ASSERT_EQ(0U, document_buffer_pool::pooledBytesForCurrentThread());
+}
+
+TEST(DocumentBufferPoolTest, OnlyKeepsPowerOfTwoBuffersWithinTheBudget) {
+    document_buffer_pool::Scope scope(1024);
+
+    document_buffer_pool::deallocate(document_buffer_pool::allocate(300), 300);
+    document_buffer_pool::deallocate(document_buffer_pool::allocate(64), 64);
+    document_buffer_pool::deallocate(document_buffer_pool::allocate(1024 * 1024), 1024 * 1024);
+    ASSERT_EQ(0U, document_buffer_pool::pooledBytesForCurrentThread());
+
+    auto first = document_buffer_pool::allocate(512);
+    auto second = document_buffer_pool::allocate(512);
+    auto third = document_buffer_pool::allocate(512);
+    document_buffer_pool::deallocate(first, 512);
+    document_buffer_pool::deallocate(second, 512);
+    document_buffer_pool::deallocate(third, 512);
+    ASSERT_EQ(1024U, document_buffer_pool::pooledBytesForCurrentThread());
+}
+
+TEST(DocumentBufferPoolTest, ReleasesKeptBuffersWhenTheOutermostScopeEnds) {
+    {
+        document_buffer_pool::Scope outer(64 * 1024);
+        {
+            document_buffer_pool::Scope inner(64 * 1024);
+            document_buffer_pool::deallocate(document_buffer_pool::allocate(128), 128);
+        }
+        ASSERT_EQ(128U, document_buffer_pool::pooledBytesForCurrentThread());
+    }
+    ASSERT_EQ(0U, document_buffer_pool::pooledBytesForCurrentThread());
+}
+
+TEST(DocumentBufferPoolTest, DocumentsBuiltWithinAScopeOutliveIt) {
+    std::vector<Document> documents;
+    {
+        document_buffer_pool::Scope scope(64 * 1024);
+        for (int i = 0; i < 100; ++i) {
+            MutableDocument md;
+            for (int field = 0; field <= i % 20; ++field) {
+                md.addField("field" + std::to_string(field), Value(i));
+            }
+            if (i % 2) {
+                documents.push_back(md.freeze());
+            }
+        }
+    }
+
+    for (size_t i = 0; i < documents.size(); ++i) {
+        const int expected = 2 * i + 1;
+        ASSERT_EQ(size_t(expected % 20 + 1), documents[i].size());
+        ASSERT_VALUE_EQ(Value(expected), documents[i]["field0"]);
+    }
+}
+
+}  // namespace
+}  // namespace mongo
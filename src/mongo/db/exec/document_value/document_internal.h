@@ -33,6 +33,7 @@
 
 #include <bitset>
 #include <boost/intrusive_ptr.hpp>
+#include <vector>
 
 #include "mongo/base/static_assert.h"
 #include "mongo/db/exec/document_value/document_metadata_fields.h"
@@ -465,6 +466,15 @@ private:
     /// Returns the position of the named field in the cache or Position()
     Position findFieldInCache(StringData name) const;
 
+    /**
+     * Returns the first top-level element of '_bson' named 'name' or an EOO element. Uses the
+     * offset index over '_bson', building it on first use.
+     */
+    BSONElement findFieldInBsonIndex(StringData name) const;
+
+    /// Fills '_bsonIndex' in a single pass over the top-level elements of '_bson'.
+    void buildBsonIndex() const;
+
     /// Allocates space in _cache. Copies existing data if there is any.
     void alloc(unsigned newSize);
 
@@ -506,6 +516,7 @@ private:
         HASH_TAB_INIT_SIZE = 8,  // must be power of 2
         HASH_TAB_MIN = 4,        // don't hash fields for docs smaller than this
                                  // set to 1 to always hash
+        BSON_INDEX_MIN_BYTES = 1024,  // index the backing BSON of docs at least this big
     };
 
     // _cache layout:
@@ -535,6 +546,12 @@ private:
     BSONObj _bson;
     mutable BSONObjIterator _bsonIt;
 
+    // Open-addressed hash table over the top-level elements of a '_bson' of at least
+    // BSON_INDEX_MIN_BYTES. Each slot holds an element's offset from '_bson.objdata()', or 0 when
+    // empty, so lookups in large documents neither scan the BSON nor construct a Value for every
+    // field in front of the requested one. Offsets stay valid across makeOwned(). Lazily built.
+    mutable std::vector<uint32_t> _bsonIndex;
+
     // If '_stripMetadata' is true, tracks whether or not the metadata has been lazy-loaded from the
     // backing '_bson' object. If so, then no attempt will be made to load the metadata again, even
     // if the metadata has been released by a call to 'releaseMetadata()'.
@@ -133,6 +133,67 @@ TEST(DocumentConstruction, FromBsonReset) {
     ASSERT_BSONOBJ_EQ(bson, toBson(newDocument));
 }
 
+/**
+ * Returns an object with 'numFields' top-level fields "f0", "f1", ... whose values are their
+ * ordinal.
+ */
+BSONObj makeWideObject(int numFields) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < numFields; ++i) {
+        builder.append("f" + std::to_string(i), i);
+    }
+    return builder.obj();
+}
+
+TEST(DocumentConstruction, LooksUpFieldsOfLargeBsonOutOfOrder) {
+    auto bson = makeWideObject(500);
+    Document document(bson);
+    ASSERT_EQUALS(499, document["f499"].getInt());
+    ASSERT_TRUE(document["missing"].missing());
+    ASSERT_EQUALS(7, document["f7"].getInt());
+    ASSERT_EQUALS(499, document["f499"].getInt());
+
+    // Looking fields up out of order must not disturb the order of iteration.
+    ASSERT_EQUALS(500U, document.size());
+    ASSERT_EQUALS("f0", getNthField(document, 0).first.toString());
+    ASSERT_EQUALS("f499", getNthField(document, 499).first.toString());
+    ASSERT_BSONOBJ_EQ(bson, toBson(document));
+}
+
+TEST(DocumentConstruction, LargeBsonLookupReturnsFirstOfDuplicateFields) {
+    BSONObjBuilder builder;
+    builder.appendElements(makeWideObject(200));
+    builder.append("dup", 1);
+    builder.append("dup", 2);
+    Document document(builder.obj());
+    ASSERT_EQUALS(1, document["dup"].getInt());
+}
+
+TEST(DocumentConstruction, ModifiesLargeBsonAfterIndexedLookup) {
+    MutableDocument md{Document(makeWideObject(200))};
+    ASSERT_EQUALS(150, md.peek()["f150"].getInt());
+    md.setField("f150", Value("x"_sd));
+    md.remove("f10");
+    md.addField("extra", Value(true));
+    auto document = md.freeze();
+    ASSERT_EQUALS(200U, document.size());
+    ASSERT_EQUALS("x", document["f150"].getString());
+    ASSERT_TRUE(document["f10"].missing());
+    ASSERT_EQUALS("extra", getNthField(document, 199).first.toString());
+}
+
+TEST(DocumentConstruction, NestedLargeObjectSharesTheParentBuffer) {
+    auto inner = makeWideObject(200);
+    auto bson = BSON("a" << 1 << "inner" << inner);
+    Document document(bson);
+
+    auto nested = document["inner"].getDocument().toBson();
+    ASSERT_BSONOBJ_EQ(inner, nested);
+    ASSERT_GT(nested.objdata(), bson.objdata());
+    ASSERT_LT(nested.objdata(), bson.objdata() + bson.objsize());
+    ASSERT_EQUALS(42, document.getNestedField(FieldPath("inner.f42")).getInt());
+}
+
 /**
  * Appends to 'builder' an object nested 'depth' levels deep.
  */
@@ -31,7 +31,9 @@
 
 #include "mongo/db/exec/geo_near.h"
 
+#include <absl/hash/hash.h>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 // For s2 search
@@ -48,7 +50,9 @@
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/query/expression_index.h"
 #include "mongo/db/query/expression_index_knobs_gen.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/util/log.h"
+#include "mongo/util/lru_cache.h"
 
 #include <algorithm>
 
@@ -752,10 +756,12 @@ GeoNear2DSphereStage::GeoNear2DSphereStage(const GeoNearParams& nearParams,
       _nearParams(nearParams),
       _fullBounds(geoNearDistanceBounds(*nearParams.nearQuery)),
       _currBounds(_fullBounds.center(), -1, _fullBounds.getInner()),
-      _boundsIncrement(0.0) {
+      _boundsIncrement(0.0),
+      _bestFirst(gInternalQueryS2GeoNearBestFirst.load()) {
     _specificStats.keyPattern = s2Index->keyPattern();
     _specificStats.indexName = s2Index->indexName();
     _specificStats.indexVersion = static_cast<int>(s2Index->version());
+    _specificStats.bestFirst = _bestFirst;
 
     // initialize2dsphereParams() does not require the collator during the GEO_NEAR_2DSPHERE stage.
     // It only requires the collator for index key generation. For query execution,
@@ -769,6 +775,12 @@ GeoNear2DSphereStage::~GeoNear2DSphereStage() {}
 
 namespace {
 
+S2Point annulusCenter(const R2Annulus& sphereBounds) {
+    // Internal bounds come in SPHERE CRS units
+    // i.e. center is lon/lat, inner/outer are in meters
+    return S2LatLng::FromDegrees(sphereBounds.center().y, sphereBounds.center().x).ToPoint();
+}
+
 S2Region* buildS2Region(const R2Annulus& sphereBounds) {
     // Internal bounds come in SPHERE CRS units
     // i.e. center is lon/lat, inner/outer are in meters
@@ -806,6 +818,88 @@ S2Region* buildS2Region(const R2Annulus& sphereBounds) {
     // Takes ownership of caps
     return new S2RegionIntersection(&regions);
 }
+
+/**
+ * Returns a lower bound on the distance in meters from 'center' to any point in the cell 'cellId'.
+ */
+double minDistanceToCell(const S2Point& center, const S2CellId& cellId) {
+    const S2Cell cell(cellId);
+    if (cell.Contains(center)) {
+        return 0;
+    }
+    const S2Cap bound = cell.GetCapBound();
+    const double radians = S1Angle(center, bound.axis()).radians() - bound.angle().radians();
+    return std::max(0.0, radians * kRadiusOfEarthInMeters);
+}
+
+/**
+ * Caches the coverings of the annuli searched by 2dsphere geoNear queries, so that queries which
+ * search the same annuli, such as repeated fixed-radius geofencing queries, compute each covering
+ * only once. A covering also depends on the covering parameters, which are part of its key.
+ *
+ * The number of coverings is bounded by internalQueryS2GeoNearCoveringCacheSize, and the cache is
+ * not used when it is 0. This class is thread safe.
+ */
+class CoveringCache {
+public:
+    static CoveringCache& get() {
+        static CoveringCache cache;
+        return cache;
+    }
+
+    /**
+     * Returns the covering of 'region', which is the region of the annulus 'bounds'. Sets
+     * 'cacheHit' to whether the covering was found in the cache.
+     */
+    std::vector<S2CellId> getCovering(const R2Annulus& bounds,
+                                      const S2Region& region,
+                                      bool* cacheHit) {
+        *cacheHit = false;
+        const int capacity = gInternalQueryS2GeoNearCoveringCacheSize.load();
+        if (capacity <= 0) {
+            return ExpressionMapping::get2dsphereCovering(region);
+        }
+
+        const Key key{bounds.center().x,
+                      bounds.center().y,
+                      bounds.getInner(),
+                      bounds.getOuter(),
+                      gInternalQueryS2GeoCoarsestLevel.load(),
+                      gInternalQueryS2GeoFinestLevel.load(),
+                      gInternalQueryS2GeoMaxCells.load()};
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (_entries) {
+                auto it = _entries->find(key);
+                if (it != _entries->end()) {
+                    *cacheHit = true;
+                    return _entries->promote(it)->second;
+                }
+            }
+        }
+
+        // Compute the covering without holding the lock, since it is the expensive part.
+        std::vector<S2CellId> cover = ExpressionMapping::get2dsphereCovering(region);
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!_entries || _capacity != size_t(capacity)) {
+            _entries = std::make_unique<Entries>(capacity);
+            _capacity = capacity;
+        }
+        _entries->add(key, cover);
+        return cover;
+    }
+
+private:
+    // The center, inner and outer distances of the annulus, and the coarsest level, finest level
+    // and maximum number of cells of the covering.
+    using Key = std::tuple<double, double, double, double, int, int, int>;
+    using Entries = LRUCache<Key, std::vector<S2CellId>, absl::Hash<Key>>;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("CoveringCache::_mutex");
+    std::unique_ptr<Entries> _entries;
+    size_t _capacity = 0;
+};
 }  // namespace
 
 GeoNear2DSphereStage::DensityEstimator::DensityEstimator(PlanStage::Children* children,
@@ -966,6 +1060,10 @@ StatusWith<NearStage::CoveredInterval*>  //
 GeoNear2DSphereStage::nextInterval(OperationContext* opCtx,
                                    WorkingSet* workingSet,
                                    const Collection* collection) {
+    if (_bestFirst) {
+        return nextBestFirstInterval(opCtx, workingSet, collection);
+    }
+
     // The search is finished if we searched at least once and all the way to the edge
     if (_currBounds.getInner() >= 0 && _currBounds.getOuter() == _fullBounds.getOuter()) {
         return StatusWith<CoveredInterval*>(nullptr);
@@ -998,19 +1096,11 @@ GeoNear2DSphereStage::nextInterval(OperationContext* opCtx,
     // Setup the covering region and stages for this interval
     //
 
-    IndexScanParams scanParams(opCtx, indexDescriptor());
-
-    // This does force us to do our own deduping of results.
-    scanParams.bounds = _nearParams.baseBounds;
-
-    // Because the planner doesn't yet set up 2D index bounds, do it ourselves here
-    const string s2Field = _nearParams.nearQuery->field;
-    const int s2FieldPosition = getFieldPosition(indexDescriptor(), s2Field);
-    fassert(28678, s2FieldPosition >= 0);
-    scanParams.bounds.fields[s2FieldPosition].intervals.clear();
     std::unique_ptr<S2Region> region(buildS2Region(_currBounds));
 
-    std::vector<S2CellId> cover = ExpressionMapping::get2dsphereCovering(*region);
+    bool cacheHit;
+    std::vector<S2CellId> cover = CoveringCache::get().getCovering(_currBounds, *region, &cacheHit);
+    _specificStats.numCoveringCacheHits += cacheHit;
 
     // Generate a covering that does not intersect with any previous coverings
     S2CellUnion coverUnion;
@@ -1027,7 +1117,120 @@ GeoNear2DSphereStage::nextInterval(OperationContext* opCtx,
     // Add the cells in this covering to the _scannedCells union
     _scannedCells.Add(cover);
 
+    PlanStage* covering = buildCoveringStage(opCtx, workingSet, collection, cover);
+
+    return StatusWith<CoveredInterval*>(new CoveredInterval(
+        covering, nextBounds.getInner(), nextBounds.getOuter(), isLastInterval));
+}
+
+StatusWith<NearStage::CoveredInterval*>  //
+GeoNear2DSphereStage::nextBestFirstInterval(OperationContext* opCtx,
+                                            WorkingSet* workingSet,
+                                            const Collection* collection) {
+    if (!_fullRegion) {
+        // Start from the covering of the total search annulus. Its cells are disjoint, and so are
+        // the cells they are subdivided into, so no cell is scanned more than once.
+        _fullRegion.reset(buildS2Region(_fullBounds));
+        const S2Point center = annulusCenter(_fullBounds);
+
+        bool cacheHit;
+        for (auto cellId : CoveringCache::get().getCovering(_fullBounds, *_fullRegion, &cacheHit)) {
+            _cellQueue.push({cellId, minDistanceToCell(center, cellId)});
+        }
+        _specificStats.numCoveringCacheHits += cacheHit;
+    }
+
+    // The search is finished once every cell has been scanned. The interval which scanned the last
+    // of them extended to the edge of the total search annulus.
+    if (_cellQueue.empty()) {
+        return StatusWith<CoveredInterval*>(nullptr);
+    }
+
+    if (!_specificStats.intervalStats.empty()) {
+        const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
+
+        // As for annuli, aim for a few hundred results from each interval.
+        if (lastIntervalStats.numResultsReturned < 300)
+            _boundsIncrement *= 2;
+        else if (lastIntervalStats.numResultsReturned > 600)
+            _boundsIncrement /= 2;
+    }
+
+    invariant(_boundsIncrement > 0.0);
+
+    // Take the nearest cells until they are further than the bounds increment beyond the nearest
+    // one, subdividing any cell which is large compared to the increment so that the interval does
+    // not read many documents too far away to be returned from it. The interval starts from the
+    // nearest cell rather than from the end of the previous interval, which skips over any part of
+    // the annulus not covered by the remaining cells. All of the cells are scanned by one index
+    // scan, and there is a bound on their number to keep the index bounds small.
+    const double minDistance = _currBounds.getOuter();
+    const double cellsLimit =
+        std::max(minDistance, _cellQueue.top().minDistance) + _boundsIncrement;
+    const size_t maxCells = 4 * std::max(1, gInternalQueryS2GeoMaxCells.load());
+    const int finestLevel = gInternalQueryS2GeoFinestLevel.load();
+
+    std::vector<S2CellId> cover;
+    while (!_cellQueue.empty() &&
+           (cover.empty() ||
+            (_cellQueue.top().minDistance < cellsLimit && cover.size() < maxCells))) {
+        const CellCandidate candidate = _cellQueue.top();
+        _cellQueue.pop();
+
+        const int level = candidate.cellId.level();
+        if (level < finestLevel &&
+            S2::kMaxDiag.GetValue(level) * kRadiusOfEarthInMeters > _boundsIncrement &&
+            pushChildCells(candidate)) {
+            continue;
+        }
+        cover.push_back(candidate.cellId);
+    }
+
+    // Every document nearer than the nearest remaining cell has been found, so the interval can
+    // return documents up to that distance.
+    const bool isLastInterval = _cellQueue.empty();
+    const double maxDistance = isLastInterval
+        ? _fullBounds.getOuter()
+        : std::max(minDistance, std::min(_cellQueue.top().minDistance, _fullBounds.getOuter()));
+    _currBounds = R2Annulus(_currBounds.center(), minDistance, maxDistance);
+
+    PlanStage* covering = buildCoveringStage(opCtx, workingSet, collection, cover);
+
+    return StatusWith<CoveredInterval*>(
+        new CoveredInterval(covering, minDistance, maxDistance, isLastInterval));
+}
+
+bool GeoNear2DSphereStage::pushChildCells(const CellCandidate& parent) {
+    const S2Point center = annulusCenter(_fullBounds);
+
+    bool pushedChild = false;
+    for (S2CellId child = parent.cellId.child_begin(); child != parent.cellId.child_end();
+         child = child.next()) {
+        if (!_fullRegion->MayIntersect(S2Cell(child))) {
+            continue;
+        }
+        // The parent's bound also bounds the distance to its children, and may be the tighter one.
+        _cellQueue.push({child, std::max(parent.minDistance, minDistanceToCell(center, child))});
+        pushedChild = true;
+    }
+    return pushedChild;
+}
+
+PlanStage* GeoNear2DSphereStage::buildCoveringStage(OperationContext* opCtx,
+                                                     WorkingSet* workingSet,
+                                                     const Collection* collection,
+                                                     const std::vector<S2CellId>& cover) {
+    IndexScanParams scanParams(opCtx, indexDescriptor());
+
+    // This does force us to do our own deduping of results.
+    scanParams.bounds = _nearParams.baseBounds;
+
+    // Because the planner doesn't yet set up 2D index bounds, do it ourselves here
+    const string s2Field = _nearParams.nearQuery->field;
+    const int s2FieldPosition = getFieldPosition(indexDescriptor(), s2Field);
+    fassert(28678, s2FieldPosition >= 0);
     OrderedIntervalList* coveredIntervals = &scanParams.bounds.fields[s2FieldPosition];
+    coveredIntervals->intervals.clear();
     ExpressionMapping::S2CellIdsToIntervalsWithParents(cover, _indexParams, coveredIntervals);
 
     auto scan = std::make_unique<IndexScan>(opCtx, scanParams, workingSet, nullptr);
@@ -1035,9 +1238,7 @@ GeoNear2DSphereStage::nextInterval(OperationContext* opCtx,
     // FetchStage owns index scan
     _children.emplace_back(std::make_unique<FetchStage>(
         opCtx, workingSet, std::move(scan), _nearParams.filter, collection));
-
-    return StatusWith<CoveredInterval*>(new CoveredInterval(
-        _children.back().get(), nextBounds.getInner(), nextBounds.getOuter(), isLastInterval));
+    return _children.back().get();
 }
 
 StatusWith<double> GeoNear2DSphereStage::computeDistance(WorkingSetMember* member) {
@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <queue>
+#include <vector>
+
 #include "mongo/db/exec/index_scan.h"
 #include "mongo/db/exec/near.h"
 #include "mongo/db/exec/plan_stats.h"
@@ -40,7 +43,9 @@
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/query/index_bounds.h"
+#include "third_party/s2/s2cellid.h"
 #include "third_party/s2/s2cellunion.h"
+#include "third_party/s2/s2region.h"
 
 namespace mongo {
 
@@ -182,6 +187,34 @@ private:
         IndexScan* _indexScan = nullptr;  // Owned in PlanStage::_children.
     };
 
+    // A cell of the index which has not been scanned yet, along with a lower bound on the distance
+    // from the query point to any point in the cell.
+    struct CellCandidate {
+        // Orders candidates so that a priority queue returns the nearest first.
+        bool operator<(const CellCandidate& other) const {
+            return minDistance > other.minDistance;
+        }
+
+        S2CellId cellId;
+        double minDistance;
+    };
+
+    // Constructs the next interval from the nearest unscanned cells, rather than from the next
+    // annulus, when the search is best-first.
+    StatusWith<CoveredInterval*> nextBestFirstInterval(OperationContext* opCtx,
+                                                       WorkingSet* workingSet,
+                                                       const Collection* collection);
+
+    // Adds the children of a cell in the search region to '_cellQueue', or returns false without
+    // adding any if none of them may intersect the region.
+    bool pushChildCells(const CellCandidate& parent);
+
+    // Creates a stage which fetches the documents indexed in 'cover', and adds it to _children.
+    PlanStage* buildCoveringStage(OperationContext* opCtx,
+                                  WorkingSet* workingSet,
+                                  const Collection* collection,
+                                  const std::vector<S2CellId>& cover);
+
     const GeoNearParams _nearParams;
 
     S2IndexingParams _indexParams;
@@ -199,6 +232,14 @@ private:
     S2CellUnion _scannedCells;
 
     std::unique_ptr<DensityEstimator> _densityEstimator;
+
+    // Whether cells are searched in order of distance, as chosen when the stage is constructed.
+    const bool _bestFirst;
+
+    // The region of the total search annulus, and the cells of the index in the region which have
+    // not been scanned yet. Only used by a best-first search, and set up by its first interval.
+    std::unique_ptr<S2Region> _fullRegion;
+    std::priority_queue<CellCandidate> _cellQueue;
 };
 
 }  // namespace mongo
@@ -245,6 +245,34 @@ struct CollectionScanStats : public SpecificStats {
     boost::optional<Timestamp> maxTs;
 };
 
+struct ColumnScanStats : public SpecificStats {
+    SpecificStats* clone() const final {
+        ColumnScanStats* specific = new ColumnScanStats(*this);
+        // BSON objects have to be explicitly copied.
+        specific->keyPattern = keyPattern.getOwned();
+        return specific;
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return container_size_helper::estimateObjectSizeInBytes(
+                   paths, [](const auto& path) { return path.capacity(); }, true) +
+            keyPattern.objsize() + indexName.capacity() + sizeof(*this);
+    }
+
+    // Properties of the column store index being scanned.
+    std::string indexName;
+    BSONObj keyPattern;
+
+    // The columns which are read in order to reassemble the documents.
+    std::vector<std::string> paths;
+
+    // Number of cells read, across all columns.
+    size_t keysExamined = 0;
+
+    // Number of documents reassembled from the columns.
+    size_t docsReassembled = 0;
+};
+
 struct CountStats : public SpecificStats {
     CountStats() : nCounted(0), nSkipped(0) {}
 
@@ -713,6 +741,10 @@ struct NearStats : public SpecificStats {
     // btree index version, not geo index version
     int indexVersion;
     BSONObj keyPattern;
+    // True if the search visits index cells in order of distance rather than covering annuli.
+    bool bestFirst = false;
+    // Number of coverings which were reused from the geoNear covering cache.
+    long long numCoveringCacheHits = 0;
 };
 
 struct UpdateStats : public SpecificStats {
@@ -794,6 +826,9 @@ struct TextOrStats : public SpecificStats {
     }
 
     size_t fetches;
+
+    // The number of top-scoring documents returned, or 0 if all matching documents are returned.
+    size_t topK = 0;
 };
 
 struct TrialStats : public SpecificStats {
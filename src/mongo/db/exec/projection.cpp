@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/projection.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <memory>
 
@@ -40,8 +41,17 @@
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/pipeline/expression_javascript.h"
+#include "mongo/db/pipeline/expression_walker.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/log.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -50,6 +60,96 @@ static const char* kIdField = "_id";
 
 namespace {
 
+/**
+ * Process-wide pool of threads on which projection stages project batches of documents in
+ * parallel. The pool is only started the first time it is needed.
+ */
+class ProjectionWorkerPool {
+public:
+    ThreadPool* get() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!_pool) {
+            ThreadPool::Options options;
+            options.poolName = "ProjectionWorkerPool";
+            options.threadNamePrefix = "ProjectionWorker-";
+            options.minThreads = 0;
+            options.maxThreads = std::max(1u, ProcessInfo::getNumCores());
+            _pool = std::make_unique<ThreadPool>(options);
+            _pool->startup();
+        }
+        return _pool.get();
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("ProjectionWorkerPool::_mutex");
+    std::unique_ptr<ThreadPool> _pool;
+};
+
+const auto getProjectionWorkerPool = ServiceContext::declareDecoration<ProjectionWorkerPool>();
+
+/**
+ * Expression walker which looks for expressions that need the OperationContext when they are
+ * evaluated: server-side JavaScript, and $$NOW or $$CLUSTER_TIME.
+ */
+class OpCtxDependencyWalker {
+public:
+    void preVisit(Expression* expr) {
+        if (dynamic_cast<ExpressionInternalJs*>(expr) ||
+            dynamic_cast<ExpressionInternalJsEmit*>(expr)) {
+            _needsOpCtx = true;
+        } else if (auto fieldPath = dynamic_cast<ExpressionFieldPath*>(expr)) {
+            const auto variable = fieldPath->getVariableId();
+            _needsOpCtx = _needsOpCtx || variable == Variables::kNowId ||
+                variable == Variables::kClusterTimeId;
+        }
+    }
+
+    void inVisit(unsigned long long, Expression*) {}
+
+    void postVisit(Expression*) {}
+
+    bool needsOpCtx() const {
+        return _needsOpCtx;
+    }
+
+private:
+    bool _needsOpCtx = false;
+};
+
+/**
+ * Returns true if the projection rooted at 'node' can be evaluated on threads which have neither a
+ * Client nor the query's OperationContext. That is not the case once it contains an expression
+ * which needs the OperationContext, or a $where or $expr in a positional or $elemMatch predicate.
+ */
+bool canProjectInParallel(const projection_ast::ASTNode* node) {
+    if (auto exprNode = dynamic_cast<const projection_ast::ExpressionASTNode*>(node)) {
+        OpCtxDependencyWalker walker;
+        expression_walker::walk(&walker, exprNode->expressionRaw());
+        if (walker.needsOpCtx()) {
+            return false;
+        }
+    } else if (auto matchNode = dynamic_cast<const projection_ast::MatchExpressionASTNode*>(node)) {
+        auto matchExpr = matchNode->matchExpression();
+        if (QueryPlannerCommon::hasNode(&*matchExpr, MatchExpression::WHERE) ||
+            QueryPlannerCommon::hasNode(&*matchExpr, MatchExpression::EXPRESSION)) {
+            return false;
+        }
+    }
+
+    return std::all_of(node->children().begin(),
+                       node->children().end(),
+                       [](auto&& child) { return canProjectInParallel(child.get()); });
+}
+
+/**
+ * Returns the number of documents a projection stage for 'projection' should project at once.
+ */
+size_t projectionBatchSize(const projection_ast::Projection* projection) {
+    return internalQueryProjectionParallelism.load() > 1 && canProjectInParallel(projection->root())
+        ? static_cast<size_t>(internalQueryProjectionParallelBatchSize.load())
+        : 1;
+}
+
 void transitionMemberToOwnedObj(Document&& doc, WorkingSetMember* member) {
     member->keyData.clear();
     member->recordId = {};
@@ -119,8 +219,14 @@ ProjectionStage::ProjectionStage(OperationContext* opCtx,
                                  const BSONObj& projObj,
                                  WorkingSet* ws,
                                  std::unique_ptr<PlanStage> child,
-                                 const char* stageType)
-    : PlanStage(opCtx, std::move(child), stageType), _projObj(projObj), _ws(*ws) {}
+                                 const char* stageType,
+                                 size_t batchSize)
+    : PlanStage(opCtx, std::move(child), stageType),
+      _projObj(projObj),
+      _ws(*ws),
+      _batchSize(batchSize) {
+    invariant(_batchSize > 0);
+}
 
 // static
 void ProjectionStage::getSimpleInclusionFields(const BSONObj& projObj, FieldSet* includedFields) {
@@ -147,10 +253,14 @@ void ProjectionStage::getSimpleInclusionFields(const BSONObj& projObj, FieldSet*
 }
 
 bool ProjectionStage::isEOF() {
-    return child()->isEOF();
+    return child()->isEOF() && _pendingIds.empty() && _projectedIds.empty();
 }
 
 PlanStage::StageState ProjectionStage::doWork(WorkingSetID* out) {
+    if (_batchSize > 1) {
+        return doWorkBatched(out);
+    }
+
     WorkingSetID id = WorkingSet::INVALID_ID;
     StageState status = child()->work(&id);
 
@@ -179,6 +289,73 @@ PlanStage::StageState ProjectionStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState ProjectionStage::doWorkBatched(WorkingSetID* out) {
+    if (!_projectedIds.empty()) {
+        *out = _projectedIds.front();
+        _projectedIds.pop_front();
+        return PlanStage::ADVANCED;
+    }
+
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    StageState status = child()->work(&id);
+
+    if (PlanStage::ADVANCED == status) {
+        // The buffered results must survive a yield, so they cannot point into storage engine
+        // memory.
+        WorkingSetMember* member = _ws.get(id);
+        member->makeObjOwnedIfNeeded();
+        for (auto&& keyDatum : member->keyData) {
+            keyDatum.keyData = keyDatum.keyData.getOwned();
+        }
+        _pendingIds.push_back(id);
+        if (_pendingIds.size() < _batchSize) {
+            return PlanStage::NEED_TIME;
+        }
+    } else if (PlanStage::IS_EOF == status) {
+        // Our child might be a tailable cursor which will produce more results later, so we
+        // project whatever we have buffered so far rather than waiting for a full batch.
+        if (_pendingIds.empty()) {
+            return PlanStage::IS_EOF;
+        }
+    } else {
+        // The stage which produces a failure is responsible for allocating a working set member
+        // with error details.
+        invariant(PlanStage::FAILURE != status || WorkingSet::INVALID_ID != id);
+        *out = id;
+        return status;
+    }
+
+    std::vector<WorkingSetMember*> members;
+    members.reserve(_pendingIds.size());
+    for (auto pendingId : _pendingIds) {
+        members.push_back(_ws.get(pendingId));
+    }
+
+    Status projStatus = transformBatch(members);
+    if (!projStatus.isOK()) {
+        warning() << "Couldn't execute projection, status = " << redact(projStatus);
+        *out = WorkingSetCommon::allocateStatusMember(&_ws, projStatus);
+        return PlanStage::FAILURE;
+    }
+
+    _projectedIds.insert(_projectedIds.end(), _pendingIds.begin(), _pendingIds.end());
+    _pendingIds.clear();
+
+    *out = _projectedIds.front();
+    _projectedIds.pop_front();
+    return PlanStage::ADVANCED;
+}
+
+Status ProjectionStage::transformBatch(const std::vector<WorkingSetMember*>& members) const {
+    for (auto member : members) {
+        Status status = transform(member);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
+
 std::unique_ptr<PlanStageStats> ProjectionStage::getStats() {
     _commonStats.isEOF = isEOF();
     auto ret = std::make_unique<PlanStageStats>(_commonStats, stageType());
@@ -196,12 +373,86 @@ ProjectionStageDefault::ProjectionStageDefault(boost::intrusive_ptr<ExpressionCo
                                                const projection_ast::Projection* projection,
                                                WorkingSet* ws,
                                                std::unique_ptr<PlanStage> child)
-    : ProjectionStage{expCtx->opCtx, projObj, ws, std::move(child), "PROJECTION_DEFAULT"},
+    : ProjectionStage{expCtx->opCtx,
+                      projObj,
+                      ws,
+                      std::move(child),
+                      "PROJECTION_DEFAULT",
+                      projectionBatchSize(projection)},
       _wantRecordId{projection->metadataDeps()[DocumentMetadataFields::kRecordId]},
       _projectType{projection->type()},
-      _executor{projection_executor::buildProjectionExecutor(expCtx, projection, {})} {}
+      _executor{projection_executor::buildProjectionExecutor(expCtx, projection, {})} {
+    // Projections which need the OperationContext are only ever evaluated by the query's thread.
+    const auto parallelism =
+        canProjectInParallel(projection->root()) ? internalQueryProjectionParallelism.load() : 1;
+    for (int i = 1; i < parallelism; ++i) {
+        _workerExecutors.push_back(projection_executor::buildProjectionExecutor(
+            expCtx->copyWith(expCtx->ns), projection, {}));
+    }
+}
 
 Status ProjectionStageDefault::transform(WorkingSetMember* member) const {
+    transformWith(_executor.get(), member);
+    return Status::OK();
+}
+
+Status ProjectionStageDefault::transformBatch(const std::vector<WorkingSetMember*>& members) const {
+    const size_t numRanges = std::min(_workerExecutors.size() + 1, members.size());
+    if (numRanges <= 1) {
+        return ProjectionStage::transformBatch(members);
+    }
+
+    const size_t rangeSize = (members.size() + numRanges - 1) / numRanges;
+    std::vector<Status> statuses(numRanges, Status::OK());
+    auto projectRange = [&](size_t range,
+                            parsed_aggregation_projection::ParsedAggregationProjection* executor) {
+        const size_t end = std::min(members.size(), (range + 1) * rangeSize);
+        try {
+            for (size_t i = range * rangeSize; i < end; ++i) {
+                transformWith(executor, members[i]);
+            }
+        } catch (...) {
+            // Nothing may escape a worker thread, and the query thread must not skip waiting for
+            // the other ranges.
+            statuses[range] = exceptionToStatus();
+        }
+    };
+
+    auto mutex = MONGO_MAKE_LATCH("ProjectionStageDefault::transformBatch");
+    stdx::condition_variable rangesDone;
+    size_t numOutstanding = numRanges - 1;
+
+    auto pool = getProjectionWorkerPool(getOpCtx()->getServiceContext()).get();
+    for (size_t range = 1; range < numRanges; ++range) {
+        // If the pool cannot accept the task, it is run inline with a non-OK status, in which case
+        // we still project the range on this thread.
+        pool->schedule([&, range](Status) {
+            projectRange(range, _workerExecutors[range - 1].get());
+            stdx::lock_guard<Latch> lk(mutex);
+            if (--numOutstanding == 0) {
+                rangesDone.notify_one();
+            }
+        });
+    }
+    projectRange(0, _executor.get());
+
+    // The worker threads refer to state on this stack frame, so we must wait for all of them even
+    // if the operation is interrupted.
+    {
+        stdx::unique_lock<Latch> lk(mutex);
+        rangesDone.wait(lk, [&] { return numOutstanding == 0; });
+    }
+
+    // Report errors as if the documents had been projected one at a time.
+    for (auto&& status : statuses) {
+        uassertStatusOK(status);
+    }
+    return Status::OK();
+}
+
+void ProjectionStageDefault::transformWith(
+    parsed_aggregation_projection::ParsedAggregationProjection* executor,
+    WorkingSetMember* member) const {
     Document input;
 
     // Most metadata should have already been stored within the WSM when we project out a document.
@@ -232,13 +483,11 @@ Status ProjectionStageDefault::transform(WorkingSetMember* member) const {
     // itself, in case the projection contains $meta expressions and needs this data, and will move
     // it back to the WSM once the projection has been applied.
     auto projected = attachMetadataToWorkingSetMember(
-        _executor->applyTransformation(attachMetadataToDocument(std::move(input), member)), member);
+        executor->applyTransformation(attachMetadataToDocument(std::move(input), member)), member);
     // An exclusion projection can return an unowned object since the output document is
     // constructed from the input one backed by BSON which is owned by the storage system, so we
     // need to  make sure we transition an owned document.
     transitionMemberToOwnedObj(projected.getOwned(), member);
-
-    return Status::OK();
 }
 
 ProjectionStageCovered::ProjectionStageCovered(OperationContext* opCtx,
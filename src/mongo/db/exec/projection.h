@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <deque>
+#include <vector>
+
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/exec/projection_executor.h"
 #include "mongo/db/jsobj.h"
@@ -47,7 +50,8 @@ protected:
                     const BSONObj& projObj,
                     WorkingSet* ws,
                     std::unique_ptr<PlanStage> child,
-                    const char* stageType);
+                    const char* stageType,
+                    size_t batchSize = 1);
 
 public:
     bool isEOF() final;
@@ -69,6 +73,12 @@ protected:
      */
     static void getSimpleInclusionFields(const BSONObj& projObj, FieldSet* includedFields);
 
+    /**
+     * Projects every member of 'members'. The default implementation calls 'transform()' on each
+     * of them in turn.
+     */
+    virtual Status transformBatch(const std::vector<WorkingSetMember*>& members) const;
+
     bool projObjHasOwnedData() {
         return _projObj.isOwned() && !_projObj.isEmpty();
     }
@@ -84,9 +94,26 @@ private:
      */
     virtual Status transform(WorkingSetMember* member) const = 0;
 
+    /**
+     * Implementation of 'doWork()' used when the stage projects documents in batches. Buffers up to
+     * '_batchSize' results of the child, projects them all at once with 'transformBatch()' and then
+     * returns them one at a time in their original order.
+     */
+    StageState doWorkBatched(WorkingSetID* out);
+
     // Used to retrieve a WorkingSetMember as part of 'doWork()'.
     WorkingSet& _ws;
 
+    // The number of documents to project at once. A value of 1 projects each document as soon as
+    // the child returns it.
+    const size_t _batchSize;
+
+    // Results of the child which have not been projected yet. Only used when '_batchSize' > 1.
+    std::vector<WorkingSetID> _pendingIds;
+
+    // Projected results which have not been returned yet. Only used when '_batchSize' > 1.
+    std::deque<WorkingSetID> _projectedIds;
+
     // Populated by 'getStats()'.
     ProjectionStats _specificStats;
 };
@@ -112,10 +139,28 @@ public:
 private:
     Status transform(WorkingSetMember* member) const final;
 
+    /**
+     * Splits 'members' into contiguous ranges and projects each range on a different thread.
+     */
+    Status transformBatch(const std::vector<WorkingSetMember*>& members) const final;
+
+    /**
+     * Applies the projection computed by 'executor' to 'member'.
+     */
+    void transformWith(parsed_aggregation_projection::ParsedAggregationProjection* executor,
+                       WorkingSetMember* member) const;
+
     // True, if the projection contains a recordId $meta expression.
     const bool _wantRecordId;
     const projection_ast::ProjectType _projectType;
     std::unique_ptr<parsed_aggregation_projection::ParsedAggregationProjection> _executor;
+
+    // Additional executors for the same projection, used by the worker threads of a parallel
+    // 'transformBatch()'. Each one is built with its own copy of the ExpressionContext so that the
+    // workers never share the Variables used to evaluate the projection's expressions. Empty if the
+    // projection needs the OperationContext, which the workers do not have.
+    std::vector<std::unique_ptr<parsed_aggregation_projection::ParsedAggregationProjection>>
+        _workerExecutors;
 };
 
 /**
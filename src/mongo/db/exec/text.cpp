@@ -43,6 +43,7 @@
 #include "mongo/db/fts/fts_index_format.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 
@@ -121,8 +122,15 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* opCtx,
     if (wantTextScore) {
         // We use a TEXT_OR stage to get the union of the results from the index scans and then
         // compute their text scores. This is a blocking operation.
-        auto textScorer =
-            std::make_unique<TextOrStage>(opCtx, _params.spec, ws, filter, collection);
+        const auto& terms = _params.query.getTermsForBounds();
+        auto textScorer = std::make_unique<TextOrStage>(opCtx,
+                                                        _params.spec,
+                                                        ws,
+                                                        filter,
+                                                        collection,
+                                                        textOrTopK(),
+                                                        std::vector<std::string>(terms.begin(),
+                                                                                 terms.end()));
 
         textScorer->addChildren(std::move(indexScanList));
 
@@ -149,4 +157,15 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* opCtx,
     return textMatchStage;
 }
 
+size_t TextStage::textOrTopK() const {
+    const auto& query = _params.query;
+    if (!_params.topK || !internalQueryEnableTextTopK.load() || query.getCaseSensitive() ||
+        query.getDiacriticSensitive() || !query.getNegatedTerms().empty() ||
+        !query.getPositivePhr().empty() || !query.getNegatedPhr().empty() ||
+        query.getTermsForBounds().size() > 64) {
+        return 0;
+    }
+    return _params.topK;
+}
+
 }  // namespace mongo
@@ -64,6 +64,10 @@ struct TextStageParams {
     // True if we need the text score in the output, because the projection includes the 'textScore'
     // metadata field.
     bool wantTextScore = true;
+
+    // If nonzero, only the 'topK' documents with the highest text scores are needed, because the
+    // results are sorted by text score and limited. The other documents may still be returned.
+    size_t topK = 0;
 };
 
 /**
@@ -100,6 +104,13 @@ private:
                                              const MatchExpression* filter,
                                              bool wantTextScore) const;
 
+    /**
+     * Returns the number of top-scoring documents the TEXT_OR stage should limit its output to, or
+     * 0 if it must return every matching document. A limit is only safe when the TEXT_MATCH stage
+     * cannot reject any document containing a positive term.
+     */
+    size_t textOrTopK() const;
+
     // Parameters of this text stage.
     TextStageParams _params;
 
@@ -29,6 +29,7 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <vector>
@@ -56,13 +57,25 @@ TextOrStage::TextOrStage(OperationContext* opCtx,
                          const FTSSpec& ftsSpec,
                          WorkingSet* ws,
                          const MatchExpression* filter,
-                         const Collection* collection)
+                         const Collection* collection,
+                         size_t topK,
+                         std::vector<std::string> terms)
     : RequiresCollectionStage(kStageType, opCtx, collection),
       _ftsSpec(ftsSpec),
       _ws(ws),
       _scoreIterator(_scores.end()),
+      _topK(topK),
+      _terms(std::move(terms)),
       _filter(filter),
-      _idRetrying(WorkingSet::INVALID_ID) {}
+      _idRetrying(WorkingSet::INVALID_ID) {
+    if (_topK) {
+        // Each candidate records the terms it has been seen with in a 64-bit mask.
+        invariant(_terms.size() <= 64);
+        _termBounds.assign(_terms.size(), fts::MAX_WEIGHT);
+        _childExhausted.assign(_terms.size(), false);
+        _specificStats.topK = _topK;
+    }
+}
 
 void TextOrStage::addChild(unique_ptr<PlanStage> child) {
     _children.push_back(std::move(child));
@@ -135,10 +148,10 @@ PlanStage::StageState TextOrStage::doWork(WorkingSetID* out) {
             stageState = initStage(out);
             break;
         case State::kReadingTerms:
-            stageState = readFromChildren(out);
+            stageState = _topK ? readFromChildrenTopK(out) : readFromChildren(out);
             break;
         case State::kReturningResults:
-            stageState = returnResults(out);
+            stageState = _topK ? returnResultsTopK(out) : returnResults(out);
             break;
         case State::kDone:
             // Should have been handled above.
@@ -295,8 +308,14 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         wsm = _ws->get(textRecordData->wsid);
     }
 
+    // Aggregate relevance score, term keys.
+    textRecordData->score += termScore(newKeyData.keyData);
+    return NEED_TIME;
+}
+
+double TextOrStage::termScore(const BSONObj& keyData) const {
     // Locate score within possibly compound key: {prefix,term,score,suffix}.
-    BSONObjIterator keyIt(newKeyData.keyData);
+    BSONObjIterator keyIt(keyData);
     for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
         keyIt.next();
     }
@@ -304,11 +323,188 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
     keyIt.next();  // Skip past 'term'.
 
     BSONElement scoreElement = keyIt.next();
-    double documentTermScore = scoreElement.number();
+    return scoreElement.number();
+}
 
-    // Aggregate relevance score, term keys.
-    textRecordData->score += documentTermScore;
-    return NEED_TIME;
+PlanStage::StageState TextOrStage::readFromChildrenTopK(WorkingSetID* out) {
+    if (_children.size() == 0) {
+        _internalState = State::kDone;
+        return PlanStage::IS_EOF;
+    }
+    invariant(_children.size() == _terms.size());
+
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    StageState childState = _children[_currentChild]->work(&id);
+
+    if (PlanStage::ADVANCED == childState) {
+        addTermTopK(id);
+        ++_keysSinceSelect;
+    } else if (PlanStage::IS_EOF == childState) {
+        _termBounds[_currentChild] = 0;
+        _childExhausted[_currentChild] = true;
+    } else if (PlanStage::FAILURE == childState) {
+        if (WorkingSet::INVALID_ID == id) {
+            str::stream ss;
+            ss << "TEXT_OR stage failed to read in results from child";
+            Status status(ErrorCodes::InternalError, ss);
+            *out = WorkingSetCommon::allocateStatusMember(_ws, status);
+        } else {
+            *out = id;
+        }
+        return PlanStage::FAILURE;
+    } else {
+        // Propagate WSID from below, and read from the same child again next time.
+        *out = id;
+        return childState;
+    }
+
+    // Checking whether the top documents are known takes time linear in the number of candidates,
+    // so it is done only once as many keys as there are candidates have been read since the last
+    // check, or once every child is exhausted.
+    const bool exhausted =
+        std::all_of(_childExhausted.begin(), _childExhausted.end(), [](bool b) { return b; });
+    if ((exhausted || _keysSinceSelect >= std::max(_candidates.size(), _topK)) &&
+        selectTopKResults()) {
+        _candidates.clear();
+        _internalState = State::kReturningResults;
+        return PlanStage::NEED_TIME;
+    }
+    invariant(!exhausted);
+
+    // Move on to the next child with keys left, so that the bounds of all terms decrease together.
+    do {
+        _currentChild = (_currentChild + 1) % _children.size();
+    } while (_childExhausted[_currentChild]);
+    return PlanStage::NEED_TIME;
+}
+
+void TextOrStage::addTermTopK(WorkingSetID wsid) {
+    WorkingSetMember* wsm = _ws->get(wsid);
+    invariant(wsm->getState() == WorkingSetMember::RID_AND_IDX);
+    invariant(1 == wsm->keyData.size());
+    const IndexKeyDatum& keyDatum = wsm->keyData.back();
+
+    const double score = termScore(keyDatum.keyData);
+    _termBounds[_currentChild] = score;
+
+    auto insertion = _candidates.emplace(wsm->recordId, TopKCandidate());
+    TopKCandidate& candidate = insertion.first->second;
+    if (insertion.second &&
+        !Filter::passes(keyDatum.keyData, keyDatum.indexKeyPattern, _filter)) {
+        candidate.rejected = true;
+    }
+    if (!candidate.rejected) {
+        candidate.score += score;
+        candidate.terms |= uint64_t{1} << _currentChild;
+    }
+    _ws->free(wsid);
+}
+
+bool TextOrStage::selectTopKResults() {
+    _keysSinceSelect = 0;
+
+    // No document which has not been seen yet can score more than the sum of the bounds.
+    double unseenBound = 0;
+    for (double bound : _termBounds) {
+        unseenBound += bound;
+    }
+
+    struct Entry {
+        double lowerBound;
+        double upperBound;
+        RecordId recordId;
+    };
+    std::vector<Entry> entries;
+    entries.reserve(_candidates.size());
+    for (auto&& candidate : _candidates) {
+        if (candidate.second.rejected) {
+            continue;
+        }
+        double upperBound = candidate.second.score;
+        for (size_t i = 0; i < _termBounds.size(); ++i) {
+            if (!(candidate.second.terms & (uint64_t{1} << i))) {
+                upperBound += _termBounds[i];
+            }
+        }
+        entries.push_back({candidate.second.score, upperBound, candidate.first});
+    }
+
+    if (entries.size() > _topK) {
+        auto kth = entries.begin() + (_topK - 1);
+        std::nth_element(entries.begin(), kth, entries.end(), [](const Entry& a, const Entry& b) {
+            return a.lowerBound > b.lowerBound;
+        });
+        const double kthScore = kth->lowerBound;
+        if (unseenBound > kthScore) {
+            return false;
+        }
+        for (auto it = kth + 1; it != entries.end(); ++it) {
+            if (it->upperBound > kthScore) {
+                return false;
+            }
+        }
+        entries.erase(kth + 1, entries.end());
+    } else if (!std::all_of(
+                   _childExhausted.begin(), _childExhausted.end(), [](bool b) { return b; })) {
+        // Documents not seen yet may still be among the top documents.
+        return false;
+    }
+
+    for (auto&& entry : entries) {
+        _topKResults.push_back(entry.recordId);
+    }
+    return true;
+}
+
+PlanStage::StageState TextOrStage::returnResultsTopK(WorkingSetID* out) {
+    if (_topKResultIndex == _topKResults.size()) {
+        _internalState = State::kDone;
+        return PlanStage::IS_EOF;
+    }
+
+    const RecordId recordId = _topKResults[_topKResultIndex];
+    boost::optional<Record> record;
+    try {
+        record = _recordCursor->seekExact(recordId);
+    } catch (const WriteConflictException&) {
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+    ++_topKResultIndex;
+
+    if (!record) {
+        // The document was deleted since its index keys were read.
+        return NEED_TIME;
+    }
+    ++_specificStats.fetches;
+
+    // Only the scores of some of the terms of the document were read from the index, so score the
+    // document again. The term scores are added in the order of the children, as addTerm() would
+    // have added them, so that the score is the same as without a limit.
+    BSONObj obj = record->data.releaseToBson();
+    fts::TermFrequencyMap termScores;
+    _ftsSpec.scoreDocument(obj, &termScores);
+    double score = 0;
+    bool hasTerm = false;
+    for (auto&& term : _terms) {
+        auto it = termScores.find(term);
+        if (it != termScores.end()) {
+            score += it->second;
+            hasTerm = true;
+        }
+    }
+    if (!hasTerm) {
+        // The document no longer contains any of the terms.
+        return NEED_TIME;
+    }
+
+    *out = _ws->allocate();
+    WorkingSetMember* member = _ws->get(*out);
+    member->recordId = recordId;
+    member->resetDocument(getOpCtx()->recoveryUnit()->getSnapshotId(), obj);
+    _ws->transitionToRecordIdAndObj(*out);
+    member->metadata().setTextScore(score);
+    return PlanStage::ADVANCED;
 }
 
 }  // namespace mongo
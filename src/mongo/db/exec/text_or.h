@@ -30,6 +30,8 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/fts/fts_spec.h"
@@ -47,6 +49,12 @@ class OperationContext;
  * the positive terms in the search query, as well as their scores.
  *
  * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state.
+ *
+ * If constructed with a nonzero 'topK', the stage returns only the 'topK' documents with the
+ * highest scores. Each child must then scan the postings of one term of 'terms', in order, from the
+ * highest score to the lowest. The children are read in turn, and the stage stops reading as soon
+ * as the scores seen so far bound the set of top documents, which it then fetches. Any other
+ * document which would have been returned has a score no greater than the lowest returned score.
  */
 class TextOrStage final : public RequiresCollectionStage {
 public:
@@ -71,7 +79,9 @@ public:
                 const FTSSpec& ftsSpec,
                 WorkingSet* ws,
                 const MatchExpression* filter,
-                const Collection* collection);
+                const Collection* collection,
+                size_t topK = 0,
+                std::vector<std::string> terms = {});
 
     void addChild(std::unique_ptr<PlanStage> child);
 
@@ -123,6 +133,23 @@ private:
      */
     StageState returnResults(WorkingSetID* out);
 
+    /**
+     * Top-k versions of readFromChildren(), addTerm() and returnResults(). The index keys are
+     * scored without fetching the documents, and only the documents in '_topKResults' are fetched.
+     */
+    StageState readFromChildrenTopK(WorkingSetID* out);
+    void addTermTopK(WorkingSetID wsid);
+    StageState returnResultsTopK(WorkingSetID* out);
+
+    /**
+     * Returns true, and fills out '_topKResults', if no document outside of the '_topK' documents
+     * with the highest scores so far can score more than the lowest of them.
+     */
+    bool selectTopKResults();
+
+    // Returns the score of a (term, score) index key.
+    double termScore(const BSONObj& keyData) const;
+
     // The index spec used to determine where to find the score.
     FTSSpec _ftsSpec;
 
@@ -150,6 +177,31 @@ private:
     ScoreMap _scores;
     ScoreMap::const_iterator _scoreIterator;
 
+    // If nonzero, the number of documents with the highest scores which are returned.
+    const size_t _topK;
+
+    // The term scanned by each child, used to compute the score of a document in top-k mode.
+    const std::vector<std::string> _terms;
+
+    /**
+     * Top-k scoring state. The score of a candidate is the sum of the scores of the terms it has
+     * been seen with, and 'terms' has the bit for each of these terms set. For every child, the
+     * bound is the score of the last key it returned, or 0 once it is exhausted, and no document
+     * still to be returned by the child can score more than it for the child's term.
+     */
+    struct TopKCandidate {
+        double score = 0.0;
+        uint64_t terms = 0;
+        bool rejected = false;
+    };
+
+    stdx::unordered_map<RecordId, TopKCandidate, RecordId::Hasher> _candidates;
+    std::vector<double> _termBounds;
+    std::vector<bool> _childExhausted;
+    size_t _keysSinceSelect = 0;
+    std::vector<RecordId> _topKResults;
+    size_t _topKResultIndex = 0;
+
     TextOrStats _specificStats;
 
     // Members needed only for using the TextMatchableDocument.
@@ -39,6 +39,7 @@
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bson_comparator_interface_base.h"
 #include "mongo/bson/mutable/algorithm.h"
+#include "mongo/bson/mutable/damage_vector.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/exec/scoped_timer.h"
@@ -47,6 +48,7 @@
 #include "mongo/db/op_observer.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/service_context.h"
@@ -201,6 +203,14 @@ UpdateStage::UpdateStage(OperationContext* opCtx,
         OperationShardingState::isOperationVersioned(opCtx);
 
     _specificStats.isModUpdate = params.driver->type() == UpdateDriver::UpdateType::kOperator;
+
+    // Only operator-style updates report the paths they modify. Decide once for the whole
+    // operation whether to track them.
+    _skipUnaffectedIndexes =
+        _specificStats.isModUpdate && internalQueryUpdateSkipUnaffectedIndexes.load();
+
+    // Documents in capped collections cannot change size.
+    _useSpliceDamages = internalQueryUpdateWithSpliceDamages.load() && !collection->isCapped();
 }
 
 BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, RecordId& recordId) {
@@ -226,6 +236,9 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
 
     bool docWasModified = false;
 
+    _modifiedPaths.clear();
+    FieldRefSetWithStorage* modifiedPaths = _skipUnaffectedIndexes ? &_modifiedPaths : nullptr;
+
     auto* const css = CollectionShardingState::get(getOpCtx(), collection()->ns());
     auto metadata = css->getCurrentMetadata();
     Status status = Status::OK();
@@ -248,7 +261,8 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                                 immutablePaths,
                                 isInsert,
                                 &logObj,
-                                &docWasModified);
+                                &docWasModified,
+                                modifiedPaths);
     } else {
         // If there was a matched field, obtain it.
         MatchDetails matchDetails;
@@ -267,7 +281,8 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                                 immutablePaths,
                                 isInsert,
                                 &logObj,
-                                &docWasModified);
+                                &docWasModified,
+                                modifiedPaths);
     }
 
     if (!status.isOK()) {
@@ -284,6 +299,9 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         // Create ObjectId _id field if we are doing that
         if (createIdField) {
             addObjectIDIdField(&_doc);
+            if (modifiedPaths) {
+                modifiedPaths->keepShortest(idFieldRef);
+            }
         }
     } else {
         uassertStatusOK(status);
@@ -319,6 +337,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                     !request->isMulti() || args.criteria.hasField("_id"_sd));
             args.fromMigrate = request->isFromMigration();
             args.storeDocOption = getStoreDocMode(*request);
+            args.modifiedPaths = modifiedPaths;
             if (args.storeDocOption == CollectionUpdateArgs::StoreDocOption::PreImage) {
                 args.preImageDoc = oldObj.value().getOwned();
             }
@@ -367,14 +386,30 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                     }
                 }
 
+                // If no index needs updating, write only the elements which changed, shifting the
+                // rest of the record as needed, when they are a small part of the document.
+                _damages.clear();
+                const bool writeDamages = _useSpliceDamages && !driver->modsAffectIndices() &&
+                    collection()->updateWithDamagesSupported() &&
+                    mutablebson::computeDamages(
+                        oldObj.value(), newObj, newObj.objsize() / 10, &_damages);
+
                 WriteUnitOfWork wunit(getOpCtx());
-                newRecordId = collection()->updateDocument(getOpCtx(),
-                                                           recordId,
-                                                           oldObj,
-                                                           newObj,
-                                                           driver->modsAffectIndices(),
-                                                           _params.opDebug,
-                                                           &args);
+                if (writeDamages) {
+                    const RecordData oldRec(oldObj.value().objdata(), oldObj.value().objsize());
+                    Snapshotted<RecordData> snap(oldObj.snapshotId(), oldRec);
+                    uassertStatusOK(collection()->updateDocumentWithDamages(
+                        getOpCtx(), recordId, std::move(snap), newObj.objdata(), _damages, &args));
+                    newRecordId = recordId;
+                } else {
+                    newRecordId = collection()->updateDocument(getOpCtx(),
+                                                               recordId,
+                                                               oldObj,
+                                                               newObj,
+                                                               driver->modsAffectIndices(),
+                                                               _params.opDebug,
+                                                               &args);
+                }
                 invariant(oldObj.snapshotId() == getOpCtx()->recoveryUnit()->getSnapshotId());
                 wunit.commit();
             }
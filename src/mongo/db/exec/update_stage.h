@@ -32,6 +32,7 @@
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/field_ref_set.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/ops/parsed_update.h"
 #include "mongo/db/ops/update_request.h"
@@ -230,6 +231,14 @@ private:
     // True if the request should be checked for an update to the shard key.
     bool _shouldCheckForShardKeyUpdate;
 
+    // True if the paths modified by each update are recorded in '_modifiedPaths', so that indexes
+    // on none of those paths are not updated.
+    bool _skipUnaffectedIndexes;
+
+    // True if updates which change the size of a document, but affect no index, may be written
+    // to the record store as damages rather than as a whole new document.
+    bool _useSpliceDamages;
+
     // If the update was in-place, we may see it again.  This only matters if we're doing
     // a multi-update; if we're not doing a multi-update we stop after one update and we
     // won't see any more docs.
@@ -248,6 +257,7 @@ private:
     // These get reused for each update.
     mutablebson::Document& _doc;
     mutablebson::DamageVector _damages;
+    FieldRefSetWithStorage _modifiedPaths;
 };
 
 }  // namespace mongo
@@ -151,6 +151,14 @@ public:
         _fieldRefSet.keepShortest(inserted);
     }
 
+    FieldRefSet::const_iterator begin() const {
+        return _fieldRefSet.begin();
+    }
+
+    FieldRefSet::const_iterator end() const {
+        return _fieldRefSet.end();
+    }
+
     std::vector<std::string> serialize() const {
         std::vector<std::string> ret;
         for (const auto fieldRef : _fieldRefSet) {
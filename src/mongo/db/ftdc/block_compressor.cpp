@@ -32,12 +32,38 @@
 #include "mongo/db/ftdc/block_compressor.h"
 
 #include <zlib.h>
+#include <zstd.h>
 
+#include "mongo/base/data_type_endian.h"
+#include "mongo/base/data_view.h"
+#include "mongo/util/assert_util.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
-StatusWith<ConstDataRange> BlockCompressor::compress(ConstDataRange source) {
+StatusWith<ConstDataRange> BlockCompressor::compress(ConstDataRange source,
+                                                     FTDCBlockCompressor compressor) {
+    switch (compressor) {
+        case FTDCBlockCompressor::kZlib:
+            return compressZlib(source);
+        case FTDCBlockCompressor::kZstd:
+            return compressZstd(source);
+    }
+
+    MONGO_UNREACHABLE;
+}
+
+StatusWith<ConstDataRange> BlockCompressor::uncompress(ConstDataRange source,
+                                                       size_t uncompressedLength) {
+    if (source.length() >= sizeof(std::uint32_t) &&
+        ConstDataView(source.data()).read<LittleEndian<std::uint32_t>>() == ZSTD_MAGICNUMBER) {
+        return uncompressZstd(source, uncompressedLength);
+    }
+
+    return uncompressZlib(source, uncompressedLength);
+}
+
+StatusWith<ConstDataRange> BlockCompressor::compressZlib(ConstDataRange source) {
     z_stream stream;
     int level = Z_DEFAULT_COMPRESSION;
 
@@ -77,8 +103,21 @@ StatusWith<ConstDataRange> BlockCompressor::compress(ConstDataRange source) {
     return ConstDataRange(_buffer.data(), stream.total_out);
 }
 
-StatusWith<ConstDataRange> BlockCompressor::uncompress(ConstDataRange source,
-                                                       size_t uncompressedLength) {
+StatusWith<ConstDataRange> BlockCompressor::compressZstd(ConstDataRange source) {
+    _buffer.resize(ZSTD_compressBound(source.length()));
+
+    size_t ret = ZSTD_compress(
+        _buffer.data(), _buffer.size(), source.data(), source.length(), ZSTD_CLEVEL_DEFAULT);
+    if (ZSTD_isError(ret)) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "ZSTD_compress failed with " << ZSTD_getErrorName(ret)};
+    }
+
+    return ConstDataRange(_buffer.data(), ret);
+}
+
+StatusWith<ConstDataRange> BlockCompressor::uncompressZlib(ConstDataRange source,
+                                                           size_t uncompressedLength) {
     z_stream stream;
 
     stream.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(source.data()));
@@ -115,4 +154,17 @@ StatusWith<ConstDataRange> BlockCompressor::uncompress(ConstDataRange source,
     return ConstDataRange(_buffer.data(), stream.total_out);
 }
 
+StatusWith<ConstDataRange> BlockCompressor::uncompressZstd(ConstDataRange source,
+                                                           size_t uncompressedLength) {
+    _buffer.resize(uncompressedLength);
+
+    size_t ret = ZSTD_decompress(_buffer.data(), _buffer.size(), source.data(), source.length());
+    if (ZSTD_isError(ret)) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "ZSTD_decompress failed with " << ZSTD_getErrorName(ret)};
+    }
+
+    return ConstDataRange(_buffer.data(), ret);
+}
+
 }  // namespace mongo
@@ -34,11 +34,16 @@
 
 #include "mongo/base/data_range.h"
 #include "mongo/base/status_with.h"
+#include "mongo/db/ftdc/config.h"
 
 namespace mongo {
 
 /**
- * Compesses and uncompresses a block of buffer using zlib.
+ * Compesses and uncompresses a block of buffer using zlib or zstd.
+ *
+ * A block does not record its compressor. Zstd blocks are recognized by the magic number at the
+ * start of every zstd frame, and all other blocks are zlib streams as they were before zstd
+ * support, so existing files remain readable.
  */
 class BlockCompressor {
     BlockCompressor(const BlockCompressor&) = delete;
@@ -53,7 +58,8 @@ public:
      * Returns a pointer to a buffer that BlockCompressor owns.
      * The returned buffer is valid until the next call to compress or uncompress.
      */
-    StatusWith<ConstDataRange> compress(ConstDataRange source);
+    StatusWith<ConstDataRange> compress(
+        ConstDataRange source, FTDCBlockCompressor compressor = FTDCBlockCompressor::kZlib);
 
     /**
      * Uncompress a buffer of data.
@@ -66,6 +72,13 @@ public:
      */
     StatusWith<ConstDataRange> uncompress(ConstDataRange source, size_t maxUncompressedLength);
 
+private:
+    StatusWith<ConstDataRange> compressZlib(ConstDataRange source);
+    StatusWith<ConstDataRange> compressZstd(ConstDataRange source);
+
+    StatusWith<ConstDataRange> uncompressZlib(ConstDataRange source, size_t uncompressedLength);
+    StatusWith<ConstDataRange> uncompressZstd(ConstDataRange source, size_t uncompressedLength);
+
 private:
     std::vector<std::uint8_t> _buffer;
 };
@@ -70,6 +70,10 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
     ShouldNotConflictWithSecondaryBatchApplicationBlock shouldNotConflictBlock(opCtx->lockState());
     opCtx->lockState()->skipAcquireTicket();
 
+    if (_neverWaitForLocks) {
+        opCtx->lockState()->setMaxLockTimeout(Milliseconds(0));
+    }
+
     // Explicitly start future read transactions without a timestamp.
     opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kNoTimestamp);
 
@@ -85,6 +85,14 @@ class FTDCCollectorCollection {
 public:
     FTDCCollectorCollection() = default;
 
+    /**
+     * If 'neverWaitForLocks' is true, collectors run with a lock timeout of zero so that a lock
+     * which cannot be granted immediately fails the collector instead of stalling the sample.
+     * Used for the high resolution collectors, whose samples are only useful if taken on time.
+     */
+    explicit FTDCCollectorCollection(bool neverWaitForLocks)
+        : _neverWaitForLocks(neverWaitForLocks) {}
+
     /**
      * Add a metric collector to the collection.
      * Must be called before collect. Cannot be called after collect is called.
@@ -112,6 +120,9 @@ public:
 private:
     // collection of collectors
     std::vector<std::unique_ptr<FTDCCollectorInterface>> _collectors;
+
+    // True if collectors must fail rather than wait for a lock
+    const bool _neverWaitForLocks = false;
 };
 
 }  // namespace mongo
@@ -146,7 +146,7 @@ StatusWith<std::tuple<ConstDataRange, Date_t>> FTDCCompressor::getCompressedSamp
         // 3. Finally, for non-zero members, we store these as VarInt packed
         //
         // These byte arrays are added to a buffer which is then concatenated with other chunks and
-        // compressed with ZLIB.
+        // compressed with the configured block compressor.
         for (std::uint32_t i = 0; i < _metricsCount; i++) {
             for (std::uint32_t j = 0; j < _deltaCount; j++) {
                 std::uint64_t delta = _deltas[getArrayOffset(_maxDeltas, j, i)];
@@ -199,7 +199,8 @@ StatusWith<std::tuple<ConstDataRange, Date_t>> FTDCCompressor::getCompressedSamp
     }
 
     auto swDest = _compressor.compress(
-        ConstDataRange(_uncompressedChunkBuffer.buf(), _uncompressedChunkBuffer.len()));
+        ConstDataRange(_uncompressedChunkBuffer.buf(), _uncompressedChunkBuffer.len()),
+        _config->blockCompressor);
 
     // The only way for compression to fail is if the buffer size calculations are wrong
     if (!swDest.isOK()) {
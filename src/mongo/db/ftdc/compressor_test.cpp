@@ -35,6 +35,7 @@
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/ftdc/block_compressor.h"
 #include "mongo/db/ftdc/compressor.h"
 #include "mongo/db/ftdc/config.h"
 #include "mongo/db/ftdc/decompressor.h"
@@ -122,8 +123,11 @@ TEST_F(FTDCCompressorTest, TestStrings) {
  */
 class TestTie {
 public:
-    TestTie(FTDCValidationMode mode = FTDCValidationMode::kStrict)
-        : _compressor(&_config), _mode(mode) {}
+    TestTie(FTDCValidationMode mode = FTDCValidationMode::kStrict,
+            FTDCBlockCompressor blockCompressor = FTDCBlockCompressor::kZlib)
+        : _compressor(&_config), _mode(mode) {
+        _config.blockCompressor = blockCompressor;
+    }
 
     ~TestTie() {
         validate(boost::none);
@@ -469,8 +473,9 @@ TEST_F(FTDCCompressorTest, Types) {
 // Test a full buffer
 TEST_F(FTDCCompressorTest, TestFull) {
     // Test a large numbers of zeros, and incremental numbers in a full buffer
-    for (int j = 0; j < 2; j++) {
-        TestTie c;
+    for (int j = 0; j < 4; j++) {
+        TestTie c(FTDCValidationMode::kStrict,
+                  j < 2 ? FTDCBlockCompressor::kZlib : FTDCBlockCompressor::kZstd);
 
         auto st = c.addSample(BSON("name"
                                    << "joe"
@@ -497,6 +502,36 @@ TEST_F(FTDCCompressorTest, TestFull) {
     }
 }
 
+// Test that a block compressor uncompresses both zlib and zstd blocks
+TEST_F(FTDCCompressorTest, TestBlockCompressors) {
+    std::string source;
+    for (int i = 0; i < 1000; ++i) {
+        source += std::to_string(i % 17);
+    }
+
+    BlockCompressor compressor;
+    BlockCompressor decompressor;
+    for (auto type : {FTDCBlockCompressor::kZlib, FTDCBlockCompressor::kZstd}) {
+        auto swCompressed = compressor.compress(ConstDataRange(source.data(), source.size()), type);
+        ASSERT_OK(swCompressed.getStatus());
+        const std::string compressed(swCompressed.getValue().data(),
+                                     swCompressed.getValue().length());
+        ASSERT_LT(compressed.size(), source.size());
+
+        // Zstd frames start with the magic number 0xFD2FB528, zlib streams never do
+        ASSERT_EQ(compressed.compare(0, 4, "\x28\xb5\x2f\xfd") == 0,
+                  type == FTDCBlockCompressor::kZstd);
+
+        auto swUncompressed =
+            decompressor.uncompress(ConstDataRange(compressed.data(), compressed.size()),
+                                    source.size());
+        ASSERT_OK(swUncompressed.getStatus());
+        ASSERT_EQ(source,
+                  std::string(swUncompressed.getValue().data(),
+                              swUncompressed.getValue().length()));
+    }
+}
+
 template <typename T>
 BSONObj generateSample(std::random_device& rd, T generator, size_t count) {
     BSONObjBuilder builder;
@@ -35,6 +35,14 @@
 
 namespace mongo {
 
+/**
+ * Block compression applied to each FTDC metric chunk.
+ */
+enum class FTDCBlockCompressor {
+    kZlib,
+    kZstd,
+};
+
 /**
  * Configuration settings for full-time diagnostic data capture (FTDC).
  *
@@ -47,7 +55,11 @@ struct FTDCConfig {
           maxFileSizeBytes(kMaxFileSizeBytesDefault),
           period(kPeriodMillisDefault),
           maxSamplesPerArchiveMetricChunk(kMaxSamplesPerArchiveMetricChunkDefault),
-          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault) {}
+          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault),
+          blockCompressor(kBlockCompressorDefault),
+          highResolutionEnabled(kHighResolutionEnabledDefault),
+          highResolutionPeriod(kHighResolutionPeriodMillisDefault),
+          highResolutionMaxDirectorySizeBytes(kHighResolutionMaxDirectorySizeBytesDefault) {}
 
     /**
      * True if FTDC is collecting data. False otherwise
@@ -84,6 +96,29 @@ struct FTDCConfig {
      */
     std::uint32_t maxSamplesPerInterimMetricChunk;
 
+    /**
+     * Compression used for newly written metric chunks. Readers detect the compression of each
+     * chunk, so changing it does not affect existing files.
+     */
+    FTDCBlockCompressor blockCompressor;
+
+    /**
+     * True if the high resolution collectors are sampled in addition to the periodic collectors.
+     * Only takes effect while FTDC is enabled.
+     */
+    bool highResolutionEnabled;
+
+    /**
+     * Period at which to run the high resolution collectors.
+     */
+    Milliseconds highResolutionPeriod;
+
+    /**
+     * Max size of all files in the high resolution subdirectory. It is managed separately from
+     * maxDirectorySizeBytes so that high resolution data cannot displace the regular history.
+     */
+    std::uint64_t highResolutionMaxDirectorySizeBytes;
+
     static const bool kEnabledDefault = true;
 
     static const std::int64_t kPeriodMillisDefault;
@@ -94,6 +129,12 @@ struct FTDCConfig {
 
     static const std::uint32_t kMaxSamplesPerArchiveMetricChunkDefault = 300;
     static const std::uint32_t kMaxSamplesPerInterimMetricChunkDefault = 10;
+
+    static const FTDCBlockCompressor kBlockCompressorDefault = FTDCBlockCompressor::kZlib;
+
+    static const bool kHighResolutionEnabledDefault = false;
+    static const std::int64_t kHighResolutionPeriodMillisDefault;
+    static const std::uint64_t kHighResolutionMaxDirectorySizeBytesDefault = 100 * 1024 * 1024;
 };
 
 }  // namespace mongo
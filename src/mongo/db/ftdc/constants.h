@@ -49,4 +49,7 @@ extern const char kFTDCCollectEndField[];
 
 constexpr StringData kFTDCDefaultDirectory = "diagnostic.data"_sd;
 
+// Subdirectory of the FTDC directory that holds the files written by the high resolution collectors
+constexpr StringData kFTDCHighResolutionDirectory = "highResolution"_sd;
+
 }  // namespace mongo
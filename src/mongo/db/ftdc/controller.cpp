@@ -33,10 +33,12 @@
 
 #include "mongo/db/ftdc/controller.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/client.h"
 #include "mongo/db/ftdc/collector.h"
+#include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/util.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/platform/mutex.h"
@@ -59,7 +61,7 @@ Status FTDCController::setEnabled(bool enabled) {
     }
 
     _configTemp.enabled = enabled;
-    _condvar.notify_one();
+    _condvar.notify_all();
 
     return Status::OK();
 }
@@ -67,31 +69,55 @@ Status FTDCController::setEnabled(bool enabled) {
 void FTDCController::setPeriod(Milliseconds millis) {
     stdx::lock_guard<Latch> lock(_mutex);
     _configTemp.period = millis;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxDirectorySizeBytes(std::uint64_t size) {
     stdx::lock_guard<Latch> lock(_mutex);
     _configTemp.maxDirectorySizeBytes = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxFileSizeBytes(std::uint64_t size) {
     stdx::lock_guard<Latch> lock(_mutex);
     _configTemp.maxFileSizeBytes = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxSamplesPerArchiveMetricChunk(size_t size) {
     stdx::lock_guard<Latch> lock(_mutex);
     _configTemp.maxSamplesPerArchiveMetricChunk = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxSamplesPerInterimMetricChunk(size_t size) {
     stdx::lock_guard<Latch> lock(_mutex);
     _configTemp.maxSamplesPerInterimMetricChunk = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
+}
+
+void FTDCController::setBlockCompressor(FTDCBlockCompressor compressor) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _configTemp.blockCompressor = compressor;
+    _condvar.notify_all();
+}
+
+void FTDCController::setHighResolutionEnabled(bool enabled) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _configTemp.highResolutionEnabled = enabled;
+    _condvar.notify_all();
+}
+
+void FTDCController::setHighResolutionPeriod(Milliseconds millis) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _configTemp.highResolutionPeriod = millis;
+    _condvar.notify_all();
+}
+
+void FTDCController::setHighResolutionMaxDirectorySizeBytes(std::uint64_t size) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _configTemp.highResolutionMaxDirectorySizeBytes = size;
+    _condvar.notify_all();
 }
 
 Status FTDCController::setDirectory(const boost::filesystem::path& path) {
@@ -129,6 +155,15 @@ void FTDCController::addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface
     }
 }
 
+void FTDCController::addHighResolutionCollector(std::unique_ptr<FTDCCollectorInterface> collector) {
+    {
+        stdx::lock_guard<Latch> lock(_mutex);
+        invariant(_state == State::kNotStarted);
+
+        _highResolutionCollectors.add(std::move(collector));
+    }
+}
+
 BSONObj FTDCController::getMostRecentPeriodicDocument() {
     {
         stdx::lock_guard<Latch> lock(_mutex);
@@ -140,8 +175,9 @@ void FTDCController::start() {
     log() << "Initializing full-time diagnostic data capture with directory '"
           << _path.generic_string() << "'";
 
-    // Start the thread
+    // Start the threads
     _thread = stdx::thread([this] { doLoop(); });
+    _highResolutionThread = stdx::thread([this] { doHighResolutionLoop(); });
 
     {
         stdx::lock_guard<Latch> lock(_mutex);
@@ -169,11 +205,12 @@ void FTDCController::stop() {
         _configTemp.enabled = false;
         _state = State::kStopRequested;
 
-        // Wake up the thread if sleeping so that it will check if we are done
-        _condvar.notify_one();
+        // Wake up the threads if sleeping so that they will check if we are done
+        _condvar.notify_all();
     }
 
     _thread.join();
+    _highResolutionThread.join();
 
     _state = State::kDone;
 
@@ -183,6 +220,36 @@ void FTDCController::stop() {
             log() << "Failed to close full-time diagnostic data capture file manager: " << s;
         }
     }
+
+    if (_highResolutionMgr) {
+        auto s = _highResolutionMgr->close();
+        if (!s.isOK()) {
+            log() << "Failed to close high resolution full-time diagnostic data capture file "
+                     "manager: "
+                  << s;
+        }
+    }
+}
+
+FTDCConfig FTDCController::makeHighResolutionConfig(const FTDCConfig& config) {
+    FTDCConfig highResolutionConfig = config;
+
+    highResolutionConfig.enabled = config.enabled && config.highResolutionEnabled;
+    highResolutionConfig.period = config.highResolutionPeriod;
+    highResolutionConfig.maxDirectorySizeBytes = config.highResolutionMaxDirectorySizeBytes;
+    highResolutionConfig.maxFileSizeBytes =
+        std::min(config.maxFileSizeBytes, config.highResolutionMaxDirectorySizeBytes);
+
+    // Write the interim file about as often in time as the periodic collectors do. At the high
+    // resolution period, a write every few samples would rewrite the interim file many times a
+    // second.
+    const std::int64_t samplesPerPeriod = std::max<std::int64_t>(
+        1, config.period.count() / config.highResolutionPeriod.count());
+    highResolutionConfig.maxSamplesPerInterimMetricChunk =
+        std::min<std::int64_t>(config.maxSamplesPerInterimMetricChunk * samplesPerPeriod,
+                               config.maxSamplesPerArchiveMetricChunk);
+
+    return highResolutionConfig;
 }
 
 void FTDCController::doLoop() {
@@ -264,4 +331,73 @@ void FTDCController::doLoop() {
     }
 }
 
+void FTDCController::doHighResolutionLoop() {
+    try {
+        Client::initThread("ftdc-hr");
+        Client* client = &cc();
+
+        while (true) {
+            {
+                stdx::unique_lock<Latch> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+
+                // Unlike the periodic thread, sleep until high resolution collection is enabled
+                // rather than waking up every high resolution period to do nothing.
+                _condvar.wait(lock, [this] {
+                    return _state == State::kStopRequested ||
+                        (_configTemp.enabled && _configTemp.highResolutionEnabled);
+                });
+
+                if (_state == State::kStopRequested) {
+                    break;
+                }
+
+                auto now = getGlobalServiceContext()->getPreciseClockSource()->now();
+                auto next_time = FTDCUtil::roundTime(now, _configTemp.highResolutionPeriod);
+
+                auto status = _condvar.wait_until(lock, next_time.toSystemTimePoint());
+
+                if (_state == State::kStopRequested) {
+                    break;
+                }
+
+                _highResolutionConfig = makeHighResolutionConfig(_configTemp);
+
+                // if we were signalled, then we have a config update only
+                if (status == stdx::cv_status::no_timeout) {
+                    continue;
+                }
+            }
+
+            if (!_highResolutionConfig.enabled) {
+                continue;
+            }
+
+            if (!_highResolutionMgr) {
+                auto swMgr =
+                    FTDCFileManager::create(&_highResolutionConfig,
+                                            _path / kFTDCHighResolutionDirectory.toString(),
+                                            &_highResolutionRotateCollectors,
+                                            client);
+
+                _highResolutionMgr = uassertStatusOK(std::move(swMgr));
+            }
+
+            auto collectSample = _highResolutionCollectors.collect(client);
+            if (std::get<0>(collectSample).isEmpty()) {
+                continue;
+            }
+
+            Status s = _highResolutionMgr->writeSampleAndRotateIfNeeded(
+                client, std::get<0>(collectSample), std::get<1>(collectSample));
+
+            uassertStatusOK(s);
+        }
+    } catch (...) {
+        warning() << "Uncaught exception in '" << exceptionToStatus()
+                  << "' in high resolution full-time diagnostic data capture. Shutting down high "
+                     "resolution full-time diagnostic data capture.";
+    }
+}
+
 }  // namespace mongo
@@ -57,7 +57,10 @@ class FTDCController {
 
 public:
     FTDCController(const boost::filesystem::path path, FTDCConfig config)
-        : _path(path), _config(std::move(config)), _configTemp(_config) {}
+        : _path(path),
+          _config(std::move(config)),
+          _configTemp(_config),
+          _highResolutionConfig(makeHighResolutionConfig(_config)) {}
 
     ~FTDCController() = default;
 
@@ -99,6 +102,26 @@ public:
      */
     void setMaxSamplesPerInterimMetricChunk(size_t size);
 
+    /**
+     * Set the compressor used for newly written metric chunks.
+     */
+    void setBlockCompressor(FTDCBlockCompressor compressor);
+
+    /**
+     * Set whether the high resolution collectors are sampled.
+     */
+    void setHighResolutionEnabled(bool enabled);
+
+    /**
+     * Set the period for high resolution data collection.
+     */
+    void setHighResolutionPeriod(Milliseconds millis);
+
+    /**
+     * Set the maximum size in bytes of the high resolution subdirectory.
+     */
+    void setHighResolutionMaxDirectorySizeBytes(std::uint64_t size);
+
     /*
      * Set the path to store FTDC files if not already set.
      *
@@ -118,10 +141,19 @@ public:
      */
     void addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Add a metric collector to collect at the high resolution period, i.e., a subset of
+     * serverStatus.
+     *
+     * High resolution collectors run on their own thread, never wait for locks, and write to a
+     * separate set of files in a subdirectory of the FTDC directory.
+     */
+    void addHighResolutionCollector(std::unique_ptr<FTDCCollectorInterface> collector);
+
     /**
      * Start the controller.
      *
-     * Spawns a new thread.
+     * Spawns a thread for the periodic collectors, and one for the high resolution collectors.
      */
     void start();
 
@@ -148,6 +180,16 @@ private:
      */
     void doLoop();
 
+    /**
+     * Do high resolution statistics collection and writing on its own background thread.
+     */
+    void doHighResolutionLoop();
+
+    /**
+     * Derive the configuration of the high resolution file manager from the user configuration.
+     */
+    static FTDCConfig makeHighResolutionConfig(const FTDCConfig& config);
+
 private:
     /**
      * Private enum to track state.
@@ -197,6 +239,10 @@ private:
     // Config settings that are manipulated by setters via setParameter.
     FTDCConfig _configTemp;
 
+    // Config settings that are used by the high resolution file manager.
+    // Derived from _configTemp by the high resolution thread.
+    FTDCConfig _highResolutionConfig;
+
     // Set of periodic collectors
     FTDCCollectorCollection _periodicCollectors;
 
@@ -207,11 +253,24 @@ private:
     // Set of file rotation collectors
     FTDCCollectorCollection _rotateCollectors;
 
+    // Set of high resolution collectors
+    FTDCCollectorCollection _highResolutionCollectors{true};
+
+    // Set of file rotation collectors for the high resolution files. Always empty since the
+    // machine configuration is already recorded in the regular files.
+    FTDCCollectorCollection _highResolutionRotateCollectors;
+
     // File manager that manages file rotation, and logging
     std::unique_ptr<FTDCFileManager> _mgr;
 
+    // File manager for the high resolution subdirectory
+    std::unique_ptr<FTDCFileManager> _highResolutionMgr;
+
     // Background collection and writing thread
     stdx::thread _thread;
+
+    // Background high resolution collection and writing thread
+    stdx::thread _highResolutionThread;
 };
 
 }  // namespace mongo
@@ -280,4 +280,49 @@ TEST_F(FTDCControllerTest, TestStartAsDisabled) {
     ValidateDocumentList(alog, allDocs, FTDCValidationMode::kStrict);
 }
 
+// Test that the high resolution collectors are written, with zstd, to their own subdirectory
+TEST_F(FTDCControllerTest, TestHighResolution) {
+    unittest::TempDir tempdir("metrics_testpath");
+    boost::filesystem::path dir(tempdir.path());
+
+    createDirectoryClean(dir);
+
+    FTDCConfig config;
+    config.enabled = true;
+    config.period = Hours(1);
+    config.maxFileSizeBytes = FTDCConfig::kMaxFileSizeBytesDefault;
+    config.maxDirectorySizeBytes = FTDCConfig::kMaxDirectorySizeBytesDefault;
+    config.blockCompressor = FTDCBlockCompressor::kZstd;
+    config.highResolutionEnabled = true;
+    config.highResolutionPeriod = Milliseconds(1);
+
+    FTDCController c(dir, config);
+
+    auto c1 = std::make_unique<FTDCMetricsCollectorMock2>();
+
+    auto c1Ptr = c1.get();
+
+    c1Ptr->setSignalOnCount(100);
+
+    c.addHighResolutionCollector(std::move(c1));
+
+    c.start();
+
+    // Wait for 100 samples to have occured
+    c1Ptr->wait();
+
+    c.stop();
+
+    auto docsHighResolution = c1Ptr->getDocs();
+    ASSERT_GREATER_THAN_OR_EQUALS(docsHighResolution.size(), 100UL);
+
+    auto files = scanDirectory(dir / kFTDCHighResolutionDirectory.toString());
+
+    ASSERT_EQUALS(files.size(), 1UL);
+
+    auto alog = files[0];
+
+    ValidateDocumentList(alog, docsHighResolution, FTDCValidationMode::kStrict);
+}
+
 }  // namespace mongo
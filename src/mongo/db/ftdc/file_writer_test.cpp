@@ -163,6 +163,10 @@ public:
         _docs.emplace_back(sample);
     }
 
+    void setBlockCompressor(FTDCBlockCompressor compressor) {
+        _config.blockCompressor = compressor;
+    }
+
 private:
     void validate() {
         // Verify we are flushing writes correctly by copying the file, and then reading it.
@@ -241,6 +245,23 @@ TEST_F(FTDCFileTest, TestSchemaChanges) {
                      << "key3" << 47));
 }
 
+// Test a file whose chunks were written with different block compressors
+TEST_F(FTDCFileTest, TestMixedBlockCompressors) {
+    FileTestTie c;
+
+    for (size_t i = 0; i < 3 * FTDCConfig::kMaxSamplesPerArchiveMetricChunkDefault; i++) {
+        if (i % FTDCConfig::kMaxSamplesPerArchiveMetricChunkDefault == 0) {
+            c.setBlockCompressor((i / FTDCConfig::kMaxSamplesPerArchiveMetricChunkDefault) % 2
+                                     ? FTDCBlockCompressor::kZstd
+                                     : FTDCBlockCompressor::kZlib);
+        }
+
+        c.addSample(BSON("name"
+                         << "joe"
+                         << "key1" << static_cast<long long int>(i) << "key2" << 45));
+    }
+}
+
 // Test a full buffer
 TEST_F(FTDCFileTest, TestFull) {
     // Test a large numbers of zeros, and incremental numbers in a full buffer
@@ -93,6 +93,38 @@ Status DiagnosticDataCollectionDirectoryPathServerParameter::setFromString(const
     return Status::OK();
 }
 
+void DiagnosticDataCollectionBlockCompressorServerParameter::append(OperationContext* opCtx,
+                                                                   BSONObjBuilder& b,
+                                                                   const std::string& name) {
+    b.append(name,
+             ftdcStartupParams.blockCompressor.load() == FTDCBlockCompressor::kZstd ? "zstd"
+                                                                                     : "zlib");
+}
+
+Status DiagnosticDataCollectionBlockCompressorServerParameter::setFromString(
+    const std::string& str) {
+    FTDCBlockCompressor compressor;
+    if (str == "zlib") {
+        compressor = FTDCBlockCompressor::kZlib;
+    } else if (str == "zstd") {
+        compressor = FTDCBlockCompressor::kZstd;
+    } else {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "diagnosticDataCollectionBlockCompressor must be 'zlib' or "
+                                       "'zstd', not '"
+                                    << str << "'");
+    }
+
+    ftdcStartupParams.blockCompressor.store(compressor);
+
+    auto controller = getGlobalFTDCController();
+    if (controller) {
+        controller->setBlockCompressor(compressor);
+    }
+
+    return Status::OK();
+}
+
 boost::filesystem::path getFTDCDirectoryPathParameter() {
     return ftdcDirectoryPathParameter.get();
 }
@@ -169,6 +201,33 @@ Status onUpdateFTDCPerInterimUpdate(const std::int32_t potentialNewValue) {
     return Status::OK();
 }
 
+Status onUpdateFTDCHighResolutionEnabled(const bool value) {
+    auto controller = getGlobalFTDCController();
+    if (controller) {
+        controller->setHighResolutionEnabled(value);
+    }
+
+    return Status::OK();
+}
+
+Status onUpdateFTDCHighResolutionPeriod(const std::int32_t potentialNewValue) {
+    auto controller = getGlobalFTDCController();
+    if (controller) {
+        controller->setHighResolutionPeriod(Milliseconds(potentialNewValue));
+    }
+
+    return Status::OK();
+}
+
+Status onUpdateFTDCHighResolutionDirectorySize(const std::int32_t potentialNewValue) {
+    auto controller = getGlobalFTDCController();
+    if (controller) {
+        controller->setHighResolutionMaxDirectorySizeBytes(potentialNewValue * 1024 * 1024);
+    }
+
+    return Status::OK();
+}
+
 FTDCSimpleInternalCommandCollector::FTDCSimpleInternalCommandCollector(StringData command,
                                                                        StringData name,
                                                                        StringData ns,
@@ -207,6 +266,11 @@ void startFTDC(boost::filesystem::path& path,
         ftdcStartupParams.maxSamplesPerArchiveMetricChunk.load();
     config.maxSamplesPerInterimMetricChunk =
         ftdcStartupParams.maxSamplesPerInterimMetricChunk.load();
+    config.blockCompressor = ftdcStartupParams.blockCompressor.load();
+    config.highResolutionEnabled = ftdcStartupParams.highResolutionEnabled.load();
+    config.highResolutionPeriod = Milliseconds(ftdcStartupParams.highResolutionPeriodMillis.load());
+    config.highResolutionMaxDirectorySizeBytes =
+        ftdcStartupParams.highResolutionMaxDirectorySizeMB.load() * 1024 * 1024;
 
     ftdcDirectoryPathParameter = path;
 
@@ -231,6 +295,20 @@ void startFTDC(boost::filesystem::path& path,
         BSON("serverStatus" << 1 << "tcMalloc" << true << "sharding" << false << "timing"
                             << false)));
 
+    // Install high resolution collectors
+    // These are collected on the high resolution period in FTDCConfig, when enabled, to catch
+    // stalls shorter than the regular period. They fail rather than wait if a lock is not
+    // available, so the sections that are expensive, or that wait on replication or sharding
+    // state, are filtered out.
+    controller->addHighResolutionCollector(std::make_unique<FTDCSimpleInternalCommandCollector>(
+        "serverStatus",
+        "serverStatus",
+        "",
+        BSON("serverStatus" << 1 << "sharding" << false << "shardingStatistics" << false
+                            << "repl" << false << "electionMetrics" << false << "transactions"
+                            << false << "twoPhaseCommitCoordinator" << false << "freeMonitoring"
+                            << false << "timing" << false)));
+
     registerCollectors(controller.get());
 
     // Install System Metric Collector as a periodic collector
@@ -65,7 +65,7 @@ enum class FTDCStartMode {
 
 /**
  * Start Full Time Data Capture
- * Starts 1 thread.
+ * Starts 2 threads, one for the periodic and one for the high resolution collectors.
  *
  * See MongoD and MongoS specific functions.
  */
@@ -111,6 +111,10 @@ struct FTDCStartupParams {
     AtomicWord<int> maxFileSizeMB;
     AtomicWord<int> maxSamplesPerArchiveMetricChunk;
     AtomicWord<int> maxSamplesPerInterimMetricChunk;
+    AtomicWord<FTDCBlockCompressor> blockCompressor;
+    AtomicWord<bool> highResolutionEnabled;
+    AtomicWord<int> highResolutionPeriodMillis;
+    AtomicWord<int> highResolutionMaxDirectorySizeMB;
 
     FTDCStartupParams()
         : enabled(FTDCConfig::kEnabledDefault),
@@ -119,7 +123,12 @@ struct FTDCStartupParams {
           maxDirectorySizeMB(FTDCConfig::kMaxDirectorySizeBytesDefault / (1024 * 1024)),
           maxFileSizeMB(FTDCConfig::kMaxFileSizeBytesDefault / (1024 * 1024)),
           maxSamplesPerArchiveMetricChunk(FTDCConfig::kMaxSamplesPerArchiveMetricChunkDefault),
-          maxSamplesPerInterimMetricChunk(FTDCConfig::kMaxSamplesPerInterimMetricChunkDefault) {}
+          maxSamplesPerInterimMetricChunk(FTDCConfig::kMaxSamplesPerInterimMetricChunkDefault),
+          blockCompressor(FTDCConfig::kBlockCompressorDefault),
+          highResolutionEnabled(FTDCConfig::kHighResolutionEnabledDefault),
+          highResolutionPeriodMillis(FTDCConfig::kHighResolutionPeriodMillisDefault),
+          highResolutionMaxDirectorySizeMB(FTDCConfig::kHighResolutionMaxDirectorySizeBytesDefault /
+                                           (1024 * 1024)) {}
 };
 
 extern FTDCStartupParams ftdcStartupParams;
@@ -133,6 +142,9 @@ Status onUpdateFTDCDirectorySize(const std::int32_t value);
 Status onUpdateFTDCFileSize(const std::int32_t value);
 Status onUpdateFTDCSamplesPerChunk(const std::int32_t value);
 Status onUpdateFTDCPerInterimUpdate(const std::int32_t value);
+Status onUpdateFTDCHighResolutionEnabled(const bool value);
+Status onUpdateFTDCHighResolutionPeriod(const std::int32_t value);
+Status onUpdateFTDCHighResolutionDirectorySize(const std::int32_t value);
 
 /**
  * Server Parameter accessors
@@ -29,6 +29,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/db/fts/fts_element_iterator.h"
 #include "mongo/db/fts/fts_matcher.h"
 #include "mongo/db/fts/fts_phrase_matcher.h"
@@ -41,7 +43,10 @@ namespace fts {
 using std::string;
 
 FTSMatcher::FTSMatcher(const FTSQueryImpl& query, const FTSSpec& spec)
-    : _query(query), _spec(spec) {}
+    : _query(query), _spec(spec) {
+    _phrases = _query.getPositivePhr();
+    _phrases.insert(_phrases.end(), _query.getNegatedPhr().begin(), _query.getNegatedPhr().end());
+}
 
 bool FTSMatcher::matches(const BSONObj& obj) const {
     if (canSkipPositiveTermCheck()) {
@@ -58,11 +63,21 @@ bool FTSMatcher::matches(const BSONObj& obj) const {
         return false;
     }
 
-    if (!positivePhrasesMatch(obj)) {
-        return false;
+    if (_phrases.empty()) {
+        return true;
     }
 
-    return negativePhrasesMatch(obj);
+    // Check the positive and negated phrases together, stopping as soon as a negated phrase
+    // matches.
+    const size_t numPositive = _query.getPositivePhr().size();
+    std::vector<bool> matched(_phrases.size(), false);
+    _phrasesMatch(_phrases, obj, numPositive, &matched);
+    for (size_t i = 0; i < matched.size(); ++i) {
+        if (matched[i] != (i < numPositive)) {
+            return false;
+        }
+    }
+    return true;
 }
 
 bool FTSMatcher::hasPositiveTerm(const BSONObj& obj) const {
@@ -122,46 +137,49 @@ bool FTSMatcher::_hasNegativeTerm_string(const FTSLanguage* language, const stri
 }
 
 bool FTSMatcher::positivePhrasesMatch(const BSONObj& obj) const {
-    for (size_t i = 0; i < _query.getPositivePhr().size(); i++) {
-        if (!_phraseMatch(_query.getPositivePhr()[i], obj)) {
-            return false;
-        }
-    }
-
-    return true;
+    const auto& phrases = _query.getPositivePhr();
+    std::vector<bool> matched(phrases.size(), false);
+    _phrasesMatch(phrases, obj, phrases.size(), &matched);
+    return std::find(matched.begin(), matched.end(), false) == matched.end();
 }
 
 bool FTSMatcher::negativePhrasesMatch(const BSONObj& obj) const {
-    for (size_t i = 0; i < _query.getNegatedPhr().size(); i++) {
-        if (_phraseMatch(_query.getNegatedPhr()[i], obj)) {
-            return false;
-        }
+    const auto& phrases = _query.getNegatedPhr();
+    std::vector<bool> matched(phrases.size(), false);
+    _phrasesMatch(phrases, obj, 0, &matched);
+    return std::find(matched.begin(), matched.end(), true) == matched.end();
+}
+
+void FTSMatcher::_phrasesMatch(const std::vector<string>& phrases,
+                               const BSONObj& obj,
+                               size_t stopAfter,
+                               std::vector<bool>* matched) const {
+    if (phrases.empty()) {
+        return;
     }
 
-    return true;
-}
+    FTSPhraseMatcher::Options matcherOptions = FTSPhraseMatcher::kNone;
 
-bool FTSMatcher::_phraseMatch(const string& phrase, const BSONObj& obj) const {
-    FTSElementIterator it(_spec, obj);
+    if (_query.getCaseSensitive()) {
+        matcherOptions |= FTSPhraseMatcher::kCaseSensitive;
+    }
+    if (_query.getDiacriticSensitive()) {
+        matcherOptions |= FTSPhraseMatcher::kDiacriticSensitive;
+    }
 
+    FTSElementIterator it(_spec, obj);
     while (it.more()) {
         FTSIteratorValue val = it.next();
 
-        FTSPhraseMatcher::Options matcherOptions = FTSPhraseMatcher::kNone;
+        // Convert the field's text once for all of the phrases.
+        const string haystack(val._text);
+        val._language->getPhraseMatcher().phrasesMatch(phrases, haystack, matcherOptions, matched);
 
-        if (_query.getCaseSensitive()) {
-            matcherOptions |= FTSPhraseMatcher::kCaseSensitive;
-        }
-        if (_query.getDiacriticSensitive()) {
-            matcherOptions |= FTSPhraseMatcher::kDiacriticSensitive;
-        }
-
-        if (val._language->getPhraseMatcher().phraseMatches(phrase, val._text, matcherOptions)) {
-            return true;
+        if (std::find(matched->begin() + stopAfter, matched->end(), true) != matched->end() ||
+            std::find(matched->begin(), matched->end(), false) == matched->end()) {
+            return;
         }
     }
-
-    return false;
 }
 
 FTSTokenizer::Options FTSMatcher::_getTokenizerOptions() const {
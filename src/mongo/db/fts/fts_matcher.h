@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/fts/fts_tokenizer.h"
@@ -98,9 +101,15 @@ private:
     bool _hasNegativeTerm_string(const FTSLanguage* language, const std::string& raw) const;
 
     /**
-     * Returns whether 'obj' contains the exact string 'phrase' in any indexed fields.
+     * Sets the entry of 'matched' for each of 'phrases' to whether 'obj' contains the exact phrase
+     * in any indexed field. The indexed fields are walked once for all of the phrases, and the walk
+     * stops early once every phrase has matched or, if 'stopAfter' is less than the number of
+     * phrases, once any phrase at or after index 'stopAfter' has matched.
      */
-    bool _phraseMatch(const std::string& phrase, const BSONObj& obj) const;
+    void _phrasesMatch(const std::vector<std::string>& phrases,
+                       const BSONObj& obj,
+                       size_t stopAfter,
+                       std::vector<bool>* matched) const;
 
     /**
      * Helper method that returns the tokenizer options that this matcher should use, based on the
@@ -111,6 +120,10 @@ private:
     // TODO These should be unowned pointers instead of owned copies.
     const FTSQueryImpl _query;
     const FTSSpec _spec;
+
+    // The positive phrases of the query followed by the negated phrases, so that matches() can
+    // check all of them in one walk over the document.
+    std::vector<std::string> _phrases;
 };
 }  // namespace fts
 }  // namespace mongo
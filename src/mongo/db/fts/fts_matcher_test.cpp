@@ -98,6 +98,40 @@ TEST(FTSMatcher, Phrase1) {
                                         << "table a top")));
 }
 
+TEST(FTSMatcher, MultiplePhrases) {
+    FTSQueryImpl q;
+    q.setQuery("foo \"table top\" \"chair leg\" -\"lamp shade\"");
+    q.setLanguage("english");
+    q.setCaseSensitive(false);
+    q.setDiacriticSensitive(false);
+    ASSERT(q.parse(TEXT_INDEX_VERSION_3).isOK());
+    FTSMatcher m(q,
+                 FTSSpec(assertGet(FTSSpec::fixSpec(BSON("key" << BSON("$**"
+                                                                       << "text"))))));
+
+    // Each positive phrase may be found in a different field.
+    ASSERT(m.matches(BSON("x"
+                          << "foo table top"
+                          << "y"
+                          << "chair leg")));
+    ASSERT(m.matches(BSON("x" << BSON_ARRAY("Chair Leg"
+                                            << "foo TABLE TOP"))));
+    ASSERT(!m.matches(BSON("x"
+                           << "foo table top")));
+    ASSERT(!m.matches(BSON("x"
+                           << "foo table top chair leg"
+                           << "y"
+                           << "lamp shade")));
+    ASSERT(m.positivePhrasesMatch(BSON("x"
+                                       << "table top"
+                                       << "y"
+                                       << "chair leg lamp shade")));
+    ASSERT(!m.negativePhrasesMatch(BSON("x"
+                                        << "table top"
+                                        << "y"
+                                        << "chair leg lamp shade")));
+}
+
 TEST(FTSMatcher, Phrase2) {
     FTSQueryImpl q;
     q.setQuery("foo \"table top\"");
@@ -31,6 +31,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace mongo {
 namespace fts {
@@ -65,6 +66,22 @@ public:
     virtual bool phraseMatches(const std::string& phrase,
                                const std::string& haystack,
                                Options options) const = 0;
+
+    /**
+     * For each phrase of 'phrases' whose entry in 'matched' is false, sets the entry to whether
+     * the phrase occurs in 'haystack'. Matchers which normalize the haystack override this to do
+     * so once for all of the phrases.
+     */
+    virtual void phrasesMatch(const std::vector<std::string>& phrases,
+                              const std::string& haystack,
+                              Options options,
+                              std::vector<bool>* matched) const {
+        for (size_t i = 0; i < phrases.size(); ++i) {
+            if (!(*matched)[i]) {
+                (*matched)[i] = phraseMatches(phrases[i], haystack, options);
+            }
+        }
+    }
 };
 
 }  // namespace fts
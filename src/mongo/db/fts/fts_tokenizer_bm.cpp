@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+#include "mongo/db/fts/fts_language.h"
+#include "mongo/db/fts/fts_tokenizer.h"
+#include "mongo/db/fts/stem_cache.h"
+#include "mongo/db/query/query_knobs_gen.h"
+
+namespace mongo {
+namespace fts {
+namespace {
+
+const char* const kEnglishText =
+    "The quick brown fox jumps over the lazy dog, while the dogs were running around the "
+    "garden and barking at the neighbours' cats. Nobody expected the generalizations to hold. ";
+
+const char* const kFrenchText =
+    "Je ne vais pas être énervé. Les élèves étudiaient la littérature française pendant "
+    "que leurs professeurs préparaient les examens de fin d'année. ";
+
+const char* const kTurkishText =
+    "İstanbul Boğazı'nın iki yakasında yaşayan insanlar, akşamları vapurla karşıya "
+    "geçerek arkadaşlarıyla buluşmayı severler. ";
+
+/**
+ * Tokenizes a document of about 16KB made of repetitions of 'text', reporting the number of tokens
+ * produced. The stem cache is enabled if the benchmark's argument is non-zero.
+ */
+void BM_tokenize(benchmark::State& state, const char* languageName, const char* text) {
+    const FTSLanguage* language = &FTSLanguage::make(languageName, TEXT_INDEX_VERSION_3);
+    std::string document;
+    while (document.size() < 16 * 1024) {
+        document += text;
+    }
+
+    const int savedCacheSize = internalQueryFTSStemCacheSize.load();
+    internalQueryFTSStemCacheSize.store(state.range(0) ? 10000 : 0);
+    StemCache::get(language)->clear();
+
+    auto tokenizer = language->createTokenizer();
+    size_t numTokens = 0;
+    for (auto _ : state) {
+        tokenizer->reset(document, FTSTokenizer::kFilterStopWords);
+        while (tokenizer->moveNext()) {
+            benchmark::DoNotOptimize(tokenizer->get());
+            ++numTokens;
+        }
+    }
+    state.SetItemsProcessed(numTokens);
+    state.SetBytesProcessed(state.iterations() * document.size());
+
+    internalQueryFTSStemCacheSize.store(savedCacheSize);
+}
+
+BENCHMARK_CAPTURE(BM_tokenize, english, "english", kEnglishText)->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(BM_tokenize, french, "french", kFrenchText)->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(BM_tokenize, turkish, "turkish", kTurkishText)->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(BM_tokenize, none, "none", kEnglishText)->Arg(0)->Arg(1);
+
+}  // namespace
+}  // namespace fts
+}  // namespace mongo
@@ -61,5 +61,22 @@ bool UnicodeFTSPhraseMatcher::phraseMatches(const string& phrase,
     return unicode::String::substrMatch(haystack, phrase, matchOptions, _caseFoldMode);
 }
 
+void UnicodeFTSPhraseMatcher::phrasesMatch(const std::vector<std::string>& phrases,
+                                           const std::string& haystack,
+                                           Options options,
+                                           std::vector<bool>* matched) const {
+    unicode::String::SubstrMatchOptions matchOptions = unicode::String::kNone;
+
+    if (options & kCaseSensitive) {
+        matchOptions |= unicode::String::kCaseSensitive;
+    }
+
+    if (options & kDiacriticSensitive) {
+        matchOptions |= unicode::String::kDiacriticSensitive;
+    }
+
+    unicode::String::substrMatchEach(haystack, phrases, matchOptions, _caseFoldMode, matched);
+}
+
 }  // namespace fts
 }  // namespace mongo
@@ -57,6 +57,11 @@ public:
                        const std::string& haystack,
                        Options options) const override;
 
+    void phrasesMatch(const std::vector<std::string>& phrases,
+                      const std::string& haystack,
+                      Options options,
+                      std::vector<bool>* matched) const override;
+
 private:
     unicode::CaseFoldMode _caseFoldMode;
 };
@@ -38,6 +38,7 @@
 #include "mongo/db/fts/stemmer.h"
 #include "mongo/db/fts/stop_words.h"
 #include "mongo/db/fts/tokenizer.h"
+#include "mongo/db/fts/unicode/byte_vector.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -45,6 +46,44 @@ namespace fts {
 
 using std::string;
 
+namespace {
+
+/**
+ * Returns true if every byte of 'str' is an ASCII character.
+ */
+bool isAscii(StringData str) {
+    auto it = str.begin();
+    const auto end = str.end();
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+    using unicode::ByteVector;
+    for (; size_t(end - it) >= ByteVector::size; it += ByteVector::size) {
+        if (ByteVector::load(&*it).maskHigh()) {
+            return false;
+        }
+    }
+#endif
+    for (; it != end; ++it) {
+        if (uint8_t(*it) > 0x7f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+/**
+ * Returns a mask of the bytes of the ASCII 'word' which are not letters or digits. Letters and
+ * digits are never delimiters, so only the bytes in this mask need to be checked individually.
+ */
+unicode::ByteVector::Mask maskNonAlphanumeric(unicode::ByteVector word) {
+    return (word.compareLT('0') | (word.compareGT('9') & word.compareLT('A')) |
+            (word.compareGT('Z') & word.compareLT('a')) | word.compareGT('z'))
+        .maskAny();
+}
+#endif
+
+}  // namespace
+
 UnicodeFTSTokenizer::UnicodeFTSTokenizer(const FTSLanguage* language)
     : _language(language),
       _stemmer(language),
@@ -53,11 +92,25 @@ UnicodeFTSTokenizer::UnicodeFTSTokenizer(const FTSLanguage* language)
                              ? unicode::DelimiterListLanguage::kEnglish
                              : unicode::DelimiterListLanguage::kNotEnglish),
       _caseFoldMode(_language->str() == "turkish" ? unicode::CaseFoldMode::kTurkish
-                                                  : unicode::CaseFoldMode::kNormal) {}
+                                                  : unicode::CaseFoldMode::kNormal) {
+    for (char32_t cp = 0; cp < _asciiDelimiters.size(); ++cp) {
+        _asciiDelimiters[cp] = unicode::codepointIsDelimiter(cp, _delimListLanguage);
+    }
+}
 
 void UnicodeFTSTokenizer::reset(StringData document, Options options) {
     _options = options;
     _pos = 0;
+
+    // A document which is entirely ASCII is valid UTF8 and is tokenized from its bytes, which saves
+    // decoding it and encoding each of its tokens again.
+    if (isAscii(document)) {
+        _asciiDocument = document;
+        _pos = _findAsciiNonDelimiter(0);
+        return;
+    }
+
+    _asciiDocument = boost::none;
     _document.resetData(document);  // Validates that document is valid UTF8.
 
     // Skip any leading delimiters (and handle the case where the document is entirely delimiters).
@@ -65,6 +118,10 @@ void UnicodeFTSTokenizer::reset(StringData document, Options options) {
 }
 
 bool UnicodeFTSTokenizer::moveNext() {
+    if (_asciiDocument) {
+        return _moveNextAscii();
+    }
+
     while (true) {
         if (_pos >= _document.size()) {
             _word = "";
@@ -107,6 +164,120 @@ bool UnicodeFTSTokenizer::moveNext() {
     }
 }
 
+bool UnicodeFTSTokenizer::_moveNextAscii() {
+    while (true) {
+        if (_pos >= _asciiDocument->size()) {
+            _word = "";
+            return false;
+        }
+
+        // The token runs from the current non-delimiter to the next delimiter.
+        const size_t start = _pos;
+        _pos = _findAsciiDelimiter(_pos + 1);
+        const size_t len = _pos - start;
+
+        // Skip the delimiters before the next token.
+        _pos = _findAsciiNonDelimiter(_pos);
+
+        // The steps below must produce the same tokens as those of moveNext() for a document which
+        // is not entirely ASCII.
+        _word = _asciiToLowerToBuf(start, len);
+
+        if ((_options & kFilterStopWords) && _stopWords->isStopWord(_word)) {
+            continue;
+        }
+
+        if (_options & kGenerateCaseSensitiveTokens) {
+            _wordBuf.reset();
+            _wordBuf.appendStr(_asciiDocument->substr(start, len), false /* includeEndingNull */);
+            _word = StringData(_wordBuf.buf(), _wordBuf.len());
+        }
+
+        _word = _stemmer.stem(_word);
+
+        if (!(_options & kGenerateDiacriticSensitiveTokens)) {
+            _word = unicode::String::caseFoldAndStripDiacritics(
+                &_finalBuf, _word, unicode::String::kCaseSensitive, _caseFoldMode);
+        }
+
+        return true;
+    }
+}
+
+size_t UnicodeFTSTokenizer::_findAsciiDelimiter(size_t pos) const {
+    const char* const data = _asciiDocument->rawData();
+    const size_t size = _asciiDocument->size();
+    while (pos < size) {
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+        using unicode::ByteVector;
+        if (size - pos >= ByteVector::size) {
+            // Skip the letters and digits, which are most of the bytes of a token, 16 at a time.
+            const uint32_t alphanumeric = ByteVector::countInitialZeros(
+                maskNonAlphanumeric(ByteVector::load(data + pos)));
+            pos += alphanumeric;
+            if (alphanumeric == ByteVector::size) {
+                continue;
+            }
+        }
+#endif
+        if (_asciiDelimiters[uint8_t(data[pos])]) {
+            return pos;
+        }
+        ++pos;
+    }
+    return size;
+}
+
+size_t UnicodeFTSTokenizer::_findAsciiNonDelimiter(size_t pos) const {
+    const char* const data = _asciiDocument->rawData();
+    const size_t size = _asciiDocument->size();
+    while (pos < size && _asciiDelimiters[uint8_t(data[pos])]) {
+        ++pos;
+    }
+    return pos;
+}
+
+StringData UnicodeFTSTokenizer::_asciiToLowerToBuf(size_t pos, size_t len) {
+    const char* input = _asciiDocument->rawData() + pos;
+    const char* const end = input + len;
+
+    // In Turkish, 'I' is lowercased to the two byte 'ı' (i with no dot).
+    _wordBuf.reset();
+    char* output = _wordBuf.skip(_caseFoldMode == unicode::CaseFoldMode::kTurkish ? len * 2 : len);
+    char* const outputStart = output;
+
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+    using unicode::ByteVector;
+    if (_caseFoldMode != unicode::CaseFoldMode::kTurkish) {
+        for (; size_t(end - input) >= ByteVector::size;
+             input += ByteVector::size, output += ByteVector::size) {
+            auto word = ByteVector::load(input);
+            // 0xFF for each byte in word that is uppercase, 0x00 for all others.
+            ByteVector uppercaseMask = word.compareGT('A' - 1) & word.compareLT('Z' + 1);
+            word |= (uppercaseMask & ByteVector(0x20));  // Set the ascii lowercase bit.
+            word.store(output);
+        }
+    }
+#endif
+
+    for (; input != end; ++input) {
+        const char c = *input;
+        if (c >= 'A' && c <= 'Z') {
+            if (_caseFoldMode == unicode::CaseFoldMode::kTurkish && c == 'I') {
+                *output++ = char(0xc4);
+                *output++ = char(0xb1);
+            } else {
+                *output++ = c | 0x20;  // Set the ascii lowercase bit on the character.
+            }
+        } else {
+            *output++ = c;
+        }
+    }
+
+    _wordBuf.setlen(output - _wordBuf.buf());
+    return StringData(outputStart, output - outputStart);
+}
+
 StringData UnicodeFTSTokenizer::get() const {
     return _word;
 }
@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <array>
+#include <boost/optional.hpp>
+
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_tokenizer.h"
 #include "mongo/db/fts/stemmer.h"
@@ -61,6 +64,10 @@ class UnicodeFTSTokenizer final : public FTSTokenizer {
 public:
     UnicodeFTSTokenizer(const FTSLanguage* language);
 
+    /**
+     * The document must remain valid until the next call to reset(), since a document which is
+     * entirely ASCII is tokenized in place.
+     */
     void reset(StringData document, Options options) override;
 
     bool moveNext() override;
@@ -74,13 +81,43 @@ private:
      */
     void _skipDelimiters();
 
+    /**
+     * Implementation of moveNext() for a document which is entirely ASCII, which is tokenized
+     * directly from its UTF-8 bytes instead of from its decoded code points.
+     */
+    bool _moveNextAscii();
+
+    /**
+     * Returns the position in the ASCII document of the first delimiter at or after 'pos', or the
+     * document's size if there is none.
+     */
+    size_t _findAsciiDelimiter(size_t pos) const;
+
+    /**
+     * Returns the position in the ASCII document of the first non-delimiter at or after 'pos', or
+     * the document's size if there is none.
+     */
+    size_t _findAsciiNonDelimiter(size_t pos) const;
+
+    /**
+     * Lowercases a substring of the ASCII document and stores the UTF8 result in _wordBuf.
+     */
+    StringData _asciiToLowerToBuf(size_t pos, size_t len);
+
     const FTSLanguage* const _language;
     const Stemmer _stemmer;
     const StopWords* const _stopWords;
     const unicode::DelimiterListLanguage _delimListLanguage;
     const unicode::CaseFoldMode _caseFoldMode;
 
+    // Whether each ASCII character is a delimiter in this tokenizer's language.
+    std::array<bool, 128> _asciiDelimiters;
+
     unicode::String _document;
+
+    // The document passed to reset() if it is entirely ASCII, in which case _document is not used.
+    boost::optional<StringData> _asciiDocument;
+
     size_t _pos;
     StringData _word;
     Options _options;
@@ -239,5 +239,52 @@ TEST(FtsUnicodeTokenizer, FrenchStopWordsAndDiacriticSensitive) {
     ASSERT_EQUALS("excit", terms[4]);
 }
 
+// Ensure that a document which is entirely ASCII produces the same tokens as one which is not, by
+// appending a non-ASCII word to the document and removing the word's token.
+void assertAsciiTokensMatch(const std::string& document, const char* language) {
+    const FTSTokenizer::Options allOptions[] = {
+        FTSTokenizer::kNone,
+        FTSTokenizer::kFilterStopWords,
+        FTSTokenizer::kGenerateCaseSensitiveTokens,
+        FTSTokenizer::kGenerateDiacriticSensitiveTokens,
+        FTSTokenizer::kFilterStopWords | FTSTokenizer::kGenerateCaseSensitiveTokens |
+            FTSTokenizer::kGenerateDiacriticSensitiveTokens,
+    };
+    for (auto options : allOptions) {
+        std::vector<std::string> asciiTerms = tokenizeString(document.c_str(), language, options);
+        std::vector<std::string> unicodeTerms =
+            tokenizeString((document + " z\u00f8z").c_str(), language, options);
+        ASSERT_EQUALS(asciiTerms.size() + 1, unicodeTerms.size());
+        unicodeTerms.pop_back();
+        ASSERT(asciiTerms == unicodeTerms);
+    }
+}
+
+TEST(FtsUnicodeTokenizer, AsciiDocumentMatchesUnicodeDocument) {
+    const std::string document =
+        "  The QUICK brown fox's Jumping-over the LAZY dogs: (again) and again!\t"
+        "Internationalization_and_Localization \"Quoted\" 12345 x^y `ticks` "
+        "SupercalifragilisticexpialidociousIsAVeryLongWord, and I am IRRITATED; ^`  ";
+    assertAsciiTokensMatch(document, "english");
+    assertAsciiTokensMatch(document, "french");
+    assertAsciiTokensMatch(document, "turkish");
+    assertAsciiTokensMatch(document, "none");
+}
+
+TEST(FtsUnicodeTokenizer, AsciiDocumentOnlyDelimiters) {
+    std::vector<std::string> terms = tokenizeString(" .,~, ", "english", FTSTokenizer::kNone);
+
+    ASSERT_EQUALS(0U, terms.size());
+}
+
+TEST(FtsUnicodeTokenizer, AsciiDocumentTurkishCapitalI) {
+    std::vector<std::string> terms = tokenizeString(
+        "ISTANBUL Izmir", "turkish", FTSTokenizer::kGenerateDiacriticSensitiveTokens);
+
+    ASSERT_EQUALS(2U, terms.size());
+    ASSERT(StringData(terms[0]).startsWith("\u0131st"));
+    ASSERT(StringData(terms[1]).startsWith("\u0131zm"));
+}
+
 }  // namespace fts
 }  // namespace mongo
@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/fts/stem_cache.h"
+
+#include "mongo/db/fts/fts_language.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+namespace fts {
+
+namespace {
+
+Mutex cachesMutex = MONGO_MAKE_LATCH("StemCache::cachesMutex");
+
+// Languages with the same name, such as those of different text index versions, use the same
+// stemmer and so share a cache.
+StringMap<std::unique_ptr<StemCache>>& caches() {
+    static StringMap<std::unique_ptr<StemCache>> caches;
+    return caches;
+}
+
+/**
+ * Returns the number of entries allowed in each shard, or 0 if the cache is disabled.
+ */
+size_t shardCapacity(size_t numShards) {
+    const int cacheSize = internalQueryFTSStemCacheSize.load();
+    if (cacheSize <= 0) {
+        return 0;
+    }
+    return std::max(size_t(1), size_t(cacheSize) / numShards);
+}
+
+}  // namespace
+
+StemCache* StemCache::get(const FTSLanguage* language) {
+    stdx::lock_guard<Latch> lk(cachesMutex);
+    auto& cache = caches()[language->str()];
+    if (!cache) {
+        cache = std::make_unique<StemCache>();
+    }
+    return cache.get();
+}
+
+bool StemCache::find(StringData word, std::string* stem) {
+    if (shardCapacity(kNumShards) == 0) {
+        return false;
+    }
+
+    auto& shard = _shardFor(word);
+    stdx::lock_guard<Latch> lk(shard.mutex);
+    if (!shard.entries) {
+        return false;
+    }
+
+    auto it = shard.entries->find(word.toString());
+    if (it == shard.entries->end()) {
+        return false;
+    }
+    *stem = shard.entries->promote(it)->second;
+    return true;
+}
+
+void StemCache::add(StringData word, StringData stem) {
+    const size_t capacity = shardCapacity(kNumShards);
+    if (capacity == 0) {
+        return;
+    }
+
+    auto& shard = _shardFor(word);
+    stdx::lock_guard<Latch> lk(shard.mutex);
+    if (!shard.entries || shard.capacity != capacity) {
+        shard.entries = std::make_unique<LRUCache<std::string, std::string>>(capacity);
+        shard.capacity = capacity;
+    }
+    shard.entries->add(word.toString(), stem.toString());
+}
+
+void StemCache::clear() {
+    for (auto& shard : _shards) {
+        stdx::lock_guard<Latch> lk(shard.mutex);
+        shard.entries.reset();
+    }
+}
+
+StemCache::Shard& StemCache::_shardFor(StringData word) {
+    return _shards[StringMapHasher()(word) % kNumShards];
+}
+
+}  // namespace fts
+}  // namespace mongo
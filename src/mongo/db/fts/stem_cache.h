@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include "mongo/base/string_data.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+
+namespace mongo {
+
+namespace fts {
+
+class FTSLanguage;
+
+/**
+ * A cache of the stems of words in a single language, which is shared by all of the Stemmers for
+ * the language so that a word which occurs in many documents is only stemmed once. The least
+ * recently used entries are evicted when the number of entries exceeds the
+ * internalQueryFTSStemCacheSize server parameter, and the cache is not used when it is 0.
+ *
+ * The cache is split into shards which are locked independently, so that concurrent index builds
+ * seldom wait for each other. This class is thread safe.
+ */
+class StemCache {
+    StemCache(const StemCache&) = delete;
+    StemCache& operator=(const StemCache&) = delete;
+
+public:
+    StemCache() = default;
+
+    /**
+     * Returns the cache for 'language', which lives as long as the process.
+     */
+    static StemCache* get(const FTSLanguage* language);
+
+    /**
+     * If the stem of 'word' is cached, copies it to 'stem' and returns true.
+     */
+    bool find(StringData word, std::string* stem);
+
+    /**
+     * Caches 'stem' as the stem of 'word', evicting the least recently used entry of its shard if
+     * the shard is full.
+     */
+    void add(StringData word, StringData stem);
+
+    /**
+     * Removes all of the entries.
+     */
+    void clear();
+
+private:
+    static constexpr size_t kNumShards = 16;
+
+    struct Shard {
+        Mutex mutex = MONGO_MAKE_LATCH("StemCache::Shard::mutex");
+
+        // Null until the first word is added, and replaced when the cache size is changed.
+        std::unique_ptr<LRUCache<std::string, std::string>> entries;
+        size_t capacity = 0;
+    };
+
+    Shard& _shardFor(StringData word);
+
+    std::array<Shard, kNumShards> _shards;
+};
+
+}  // namespace fts
+}  // namespace mongo
@@ -0,0 +1,165 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+
+#include "mongo/db/fts/fts_language.h"
+#include "mongo/db/fts/stem_cache.h"
+#include "mongo/db/fts/stemmer.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace fts {
+namespace {
+
+class StemCacheTest : public unittest::Test {
+public:
+    StemCacheTest() : _savedCacheSize(internalQueryFTSStemCacheSize.load()) {
+        internalQueryFTSStemCacheSize.store(1000);
+    }
+
+    ~StemCacheTest() {
+        internalQueryFTSStemCacheSize.store(_savedCacheSize);
+        englishCache()->clear();
+    }
+
+    static const FTSLanguage* english() {
+        return &FTSLanguage::make("english", TEXT_INDEX_VERSION_3);
+    }
+
+    static StemCache* englishCache() {
+        return StemCache::get(english());
+    }
+
+private:
+    const int _savedCacheSize;
+};
+
+TEST_F(StemCacheTest, FindReturnsAddedStem) {
+    StemCache cache;
+    std::string stem;
+    ASSERT_FALSE(cache.find("running", &stem));
+
+    cache.add("running", "run");
+    ASSERT_TRUE(cache.find("running", &stem));
+    ASSERT_EQUALS("run", stem);
+
+    cache.clear();
+    ASSERT_FALSE(cache.find("running", &stem));
+}
+
+TEST_F(StemCacheTest, DisabledWhenSizeIsZero) {
+    internalQueryFTSStemCacheSize.store(0);
+
+    StemCache cache;
+    std::string stem;
+    cache.add("running", "run");
+    ASSERT_FALSE(cache.find("running", &stem));
+}
+
+TEST_F(StemCacheTest, EvictsWhenFull) {
+    // Each of the cache's shards holds a single entry.
+    internalQueryFTSStemCacheSize.store(1);
+
+    StemCache cache;
+    for (int i = 0; i < 1000; ++i) {
+        const std::string word = "word" + std::to_string(i);
+        cache.add(word, word);
+    }
+
+    int numFound = 0;
+    std::string stem;
+    for (int i = 0; i < 1000; ++i) {
+        numFound += cache.find("word" + std::to_string(i), &stem);
+    }
+    ASSERT_GT(numFound, 0);
+    ASSERT_LTE(numFound, 16);
+}
+
+TEST_F(StemCacheTest, ResizingDiscardsEntries) {
+    StemCache cache;
+    cache.add("running", "run");
+
+    internalQueryFTSStemCacheSize.store(2000);
+    cache.add("jumping", "jump");
+
+    std::string stem;
+    ASSERT_TRUE(cache.find("jumping", &stem));
+    ASSERT_EQUALS("jump", stem);
+}
+
+TEST_F(StemCacheTest, LanguagesWithTheSameNameShareACache) {
+    ASSERT_EQUALS(englishCache(),
+                  StemCache::get(&FTSLanguage::make("english", TEXT_INDEX_VERSION_2)));
+    ASSERT_NOT_EQUALS(englishCache(),
+                      StemCache::get(&FTSLanguage::make("french", TEXT_INDEX_VERSION_3)));
+}
+
+TEST_F(StemCacheTest, StemmerUsesCache) {
+    Stemmer stemmer(english());
+    ASSERT_EQUALS("run", stemmer.stem("running"));
+
+    std::string stem;
+    ASSERT_TRUE(englishCache()->find("running", &stem));
+    ASSERT_EQUALS("run", stem);
+
+    // A second stemmer for the language finds the stem in the cache.
+    Stemmer otherStemmer(english());
+    ASSERT_EQUALS("run", otherStemmer.stem("running"));
+    ASSERT_EQUALS("Run", otherStemmer.stem("Running"));
+    ASSERT_EQUALS("Run", stemmer.stem("Running"));
+}
+
+TEST_F(StemCacheTest, StemmerResultsMatchWithoutCache) {
+    const char* words[] = {"running", "runs", "united", "generalizations", "stemming", "dogs", "a"};
+
+    internalQueryFTSStemCacheSize.store(0);
+    std::vector<std::string> uncached;
+    {
+        Stemmer stemmer(english());
+        for (auto word : words) {
+            uncached.push_back(stemmer.stem(word).toString());
+        }
+    }
+
+    internalQueryFTSStemCacheSize.store(1000);
+    Stemmer stemmer(english());
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < uncached.size(); ++i) {
+            ASSERT_EQUALS(uncached[i], stemmer.stem(words[i]));
+        }
+    }
+}
+
+}  // namespace
+}  // namespace fts
+}  // namespace mongo
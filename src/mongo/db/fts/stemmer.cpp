@@ -30,6 +30,8 @@
 #include <cstdlib>
 
 #include "mongo/db/fts/stemmer.h"
+
+#include "mongo/db/fts/stem_cache.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -38,8 +40,11 @@ namespace fts {
 
 Stemmer::Stemmer(const FTSLanguage* language) {
     _stemmer = nullptr;
-    if (language->str() != "none")
+    _cache = nullptr;
+    if (language->str() != "none") {
         _stemmer = sb_stemmer_new(language->str().c_str(), "UTF_8");
+        _cache = StemCache::get(language);
+    }
 }
 
 Stemmer::~Stemmer() {
@@ -53,6 +58,10 @@ StringData Stemmer::stem(StringData word) const {
     if (!_stemmer)
         return word;
 
+    if (_cache->find(word, &_cachedStem)) {
+        return _cachedStem;
+    }
+
     const sb_symbol* sb_sym =
         sb_stemmer_stem(_stemmer, (const sb_symbol*)word.rawData(), word.size());
 
@@ -61,7 +70,9 @@ StringData Stemmer::stem(StringData word) const {
         MONGO_UNREACHABLE;
     }
 
-    return StringData((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    StringData stem((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    _cache->add(word, stem);
+    return stem;
 }
 }  // namespace fts
 }  // namespace mongo
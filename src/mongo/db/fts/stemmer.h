@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_language.h"
 #include "third_party/libstemmer_c/include/libstemmer.h"
@@ -38,6 +40,8 @@ namespace mongo {
 
 namespace fts {
 
+class StemCache;
+
 /**
  * maintains case
  * but works
@@ -57,11 +61,19 @@ public:
      * The returned StringData is valid until the next call to any method on this object. Since the
      * input may be returned unmodified, the output's lifetime may also expire when the input's
      * does.
+     *
+     * Stems are looked up in, and added to, the cache shared by the stemmers for this language.
      */
     StringData stem(StringData word) const;
 
 private:
     struct sb_stemmer* _stemmer;
+
+    // Null if _stemmer is null.
+    StemCache* _cache;
+
+    // Holds the result of stem() when it was found in _cache.
+    mutable std::string _cachedStem;
 };
 }  // namespace fts
 }  // namespace mongo
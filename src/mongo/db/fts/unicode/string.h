@@ -32,6 +32,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/bson/util/builder.h"
@@ -126,6 +127,17 @@ public:
                             SubstrMatchOptions options,
                             CaseFoldMode mode = CaseFoldMode::kNormal);
 
+    /**
+     * Searches the string 'str' for each of the strings in 'finds' which does not already have its
+     * entry of 'found' set, as substrMatch() would, and sets the entries of those which exist in
+     * 'str'. 'str' is case folded and stripped of diacritics only once for all of the searches.
+     */
+    static void substrMatchEach(const std::string& str,
+                                const std::vector<std::string>& finds,
+                                SubstrMatchOptions options,
+                                CaseFoldMode mode,
+                                std::vector<bool>* found);
+
     /**
      * Strips diacritics and case-folds the utf8 input string, as needed to support options.
      *
@@ -184,6 +184,28 @@ TEST(UnicodeString, SubstringMatch) {
         str, UTF8("Одумаися!"), String::kDiacriticSensitive | String::kCaseSensitive));
 }
 
+TEST(UnicodeString, SubstringMatchEach) {
+    std::string str = UTF8("Одумайся! Престол свой сохрани; И ярость укроти.");
+    std::vector<std::string> finds = {
+        UTF8("ПРЁСТОЛ СВОИ"), UTF8("Престол сохрани"), UTF8("ярость"), UTF8("Одумаися!")};
+
+    for (auto options : {String::kNone, String::kCaseSensitive, String::kDiacriticSensitive}) {
+        std::vector<bool> found(finds.size(), false);
+        String::substrMatchEach(str, finds, options, CaseFoldMode::kNormal, &found);
+        for (size_t i = 0; i < finds.size(); ++i) {
+            ASSERT_EQ(String::substrMatch(str, finds[i], options), found[i]);
+        }
+    }
+
+    // Strings which are already found are not searched for again.
+    std::vector<bool> found = {false, true, false, false};
+    String::substrMatchEach(str, finds, String::kNone, CaseFoldMode::kNormal, &found);
+    ASSERT_TRUE(found[0]);
+    ASSERT_TRUE(found[1]);
+    ASSERT_TRUE(found[2]);
+    ASSERT_TRUE(found[3]);
+}
+
 TEST(UnicodeString, SubstringMatchTurkish) {
     std::string str = UTF8("KAÇ YAŞINDASINIZ?");
 
@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/column_key_generator.h"
+
+#include <algorithm>
+
+#include "mongo/db/bson/dotted_path_support.h"
+
+namespace mongo {
+
+namespace dps = ::mongo::dotted_path_support;
+
+constexpr StringData ColumnKeyGenerator::kRowIdPath;
+
+ColumnKeyGenerator::ColumnKeyGenerator(BSONObj keyPattern,
+                                       KeyString::Version keyStringVersion,
+                                       Ordering ordering)
+    : _keyPattern(keyPattern.getOwned()),
+      _keyStringVersion(keyStringVersion),
+      _ordering(ordering) {
+    for (auto&& elem : _keyPattern) {
+        _paths.push_back(elem.fieldName());
+    }
+}
+
+void ColumnKeyGenerator::getKeys(const BSONObj& obj,
+                                 KeyStringSet* keys,
+                                 MultikeyPaths* multikeyPaths,
+                                 const RecordId& id) const {
+    if (multikeyPaths) {
+        multikeyPaths->clear();
+        multikeyPaths->resize(_paths.size());
+    }
+
+    static const BSONObj nullObj = BSON("" << BSONNULL);
+    _addKey(kRowIdPath, id, nullObj.firstElement(), keys);
+
+    for (size_t i = 0; i < _paths.size(); ++i) {
+        const auto& path = _paths[i];
+        const char* remaining = path.c_str();
+        auto value = dps::extractElementAtPathOrArrayAlongPath(obj, remaining);
+        if (value.eoo()) {
+            continue;
+        }
+
+        // The value of a path which traverses an array depends on every element of that array, so
+        // it cannot be stored as a single cell.
+        if (*remaining != '\0') {
+            invariant(value.type() == BSONType::Array);
+            if (multikeyPaths) {
+                const auto arrayPathLength = remaining - path.c_str() - 1;
+                const auto arrayComponent =
+                    std::count(path.begin(), path.begin() + arrayPathLength, '.');
+                (*multikeyPaths)[i].insert(arrayComponent);
+            }
+            continue;
+        }
+
+        _addKey(path, id, value, keys);
+    }
+}
+
+BSONObj ColumnKeyGenerator::makeColumnStartKey(StringData path) {
+    return BSON("" << path << "" << MINKEY);
+}
+
+BSONObj ColumnKeyGenerator::makeColumnEndKey(StringData path) {
+    return BSON("" << path << "" << MAXKEY);
+}
+
+void ColumnKeyGenerator::_addKey(StringData path,
+                                 const RecordId& id,
+                                 BSONElement value,
+                                 KeyStringSet* keys) const {
+    KeyString::HeapBuilder keyString(_keyStringVersion, _ordering);
+    keyString.appendString(path);
+    keyString.appendNumberLong(id.repr());
+    keyString.appendBSONElement(value);
+    keyString.appendRecordId(id);
+    keys->insert(keyString.release());
+}
+
+}  // namespace mongo
@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/index/multikey_paths.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo {
+
+/**
+ * Generates the keys stored by a "columnstore" index. Such an index stores every indexed path as
+ * its own column, sorted by RecordId, so that a subset of the fields of each document can be read
+ * without fetching the full record. A key pattern of {a: "columnstore", "b.c": "columnstore"}
+ * produces, for a document with RecordId 7, the keys
+ *      { '': '$_row', '': 7, '': null }
+ *      { '': 'a', '': 7, '': <value of 'a'> }
+ *      { '': 'b.c', '': 7, '': <value of 'b.c'> }
+ *
+ * The '$_row' column holds one cell per document, which lets a scan enumerate every record even if
+ * it contains none of the indexed paths. Values are stored whole, including arrays and
+ * sub-documents, and are not collation-encoded. Paths which are missing from a document have no
+ * cell. If an array is found along a dotted path before its final component, no cell is produced
+ * for that path and the array component is reported in 'multikeyPaths'; an index in this state
+ * cannot be used to reconstruct documents.
+ */
+class ColumnKeyGenerator {
+public:
+    static constexpr StringData kRowIdPath = "$_row"_sd;
+
+    ColumnKeyGenerator(BSONObj keyPattern, KeyString::Version keyStringVersion, Ordering ordering);
+
+    /**
+     * Returns the paths stored by this index, in key pattern order.
+     */
+    const std::vector<std::string>& getPaths() const {
+        return _paths;
+    }
+
+    /**
+     * Adds one key per indexed path present in 'obj', plus one row marker key, to 'keys'. If
+     * 'multikeyPaths' is non-null, it is resized to the number of indexed paths and populated with
+     * the components of each path along which an array was found.
+     */
+    void getKeys(const BSONObj& obj,
+                 KeyStringSet* keys,
+                 MultikeyPaths* multikeyPaths,
+                 const RecordId& id) const;
+
+    /**
+     * Returns the keys bounding the column for 'path'. Every cell of the column sorts strictly
+     * between the two.
+     */
+    static BSONObj makeColumnStartKey(StringData path);
+    static BSONObj makeColumnEndKey(StringData path);
+
+private:
+    void _addKey(StringData path,
+                 const RecordId& id,
+                 BSONElement value,
+                 KeyStringSet* keys) const;
+
+    const BSONObj _keyPattern;
+    std::vector<std::string> _paths;
+    const KeyString::Version _keyStringVersion;
+    const Ordering _ordering;
+};
+
+}  // namespace mongo
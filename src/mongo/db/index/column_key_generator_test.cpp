@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kIndex
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+namespace {
+
+const RecordId kRecordId(17);
+
+KeyStringSet makeKeySet(std::initializer_list<std::pair<std::string, BSONObj>> init) {
+    KeyStringSet keys;
+    for (const auto& cell : init) {
+        KeyString::HeapBuilder keyString(KeyString::Version::kLatestVersion,
+                                         Ordering::make(BSONObj()));
+        keyString.appendString(cell.first);
+        keyString.appendNumberLong(kRecordId.repr());
+        keyString.appendBSONElement(cell.second.firstElement());
+        keyString.appendRecordId(kRecordId);
+        keys.insert(keyString.release());
+    }
+    return keys;
+}
+
+std::string dumpKeyset(const KeyStringSet& keyStrings) {
+    std::stringstream ss;
+    ss << "[ ";
+    for (auto& keyString : keyStrings) {
+        auto key = KeyString::toBson(keyString, Ordering::make(BSONObj()));
+        ss << key.toString() << " ";
+    }
+    ss << "]";
+
+    return ss.str();
+}
+
+bool assertKeysetsEqual(const KeyStringSet& expectedKeys, const KeyStringSet& actualKeys) {
+    if (expectedKeys.size() != actualKeys.size() ||
+        !std::equal(expectedKeys.begin(), expectedKeys.end(), actualKeys.begin())) {
+        log() << "Expected: " << dumpKeyset(expectedKeys) << ", "
+              << "Actual: " << dumpKeyset(actualKeys);
+        return false;
+    }
+
+    return true;
+}
+
+ColumnKeyGenerator makeKeyGen(const char* keyPattern) {
+    return ColumnKeyGenerator{
+        fromjson(keyPattern), KeyString::Version::kLatestVersion, Ordering::make(BSONObj())};
+}
+
+TEST(ColumnKeyGeneratorTest, RowMarkerIsAlwaysPresent) {
+    auto keyGen = makeKeyGen("{a: 'columnstore'}");
+
+    KeyStringSet keys;
+    MultikeyPaths multikeyPaths;
+    keyGen.getKeys(fromjson("{b: 1}"), &keys, &multikeyPaths, kRecordId);
+
+    ASSERT(assertKeysetsEqual(makeKeySet({{"$_row", BSON("" << BSONNULL)}}), keys));
+    ASSERT(multikeyPaths == MultikeyPaths{std::set<size_t>{}});
+}
+
+TEST(ColumnKeyGeneratorTest, ExtractsTopLevelAndDottedPaths) {
+    auto keyGen = makeKeyGen("{a: 'columnstore', 'b.c': 'columnstore'}");
+
+    KeyStringSet keys;
+    MultikeyPaths multikeyPaths;
+    keyGen.getKeys(fromjson("{a: 'one', b: {c: 2, d: 3}}"), &keys, &multikeyPaths, kRecordId);
+
+    auto expectedKeys = makeKeySet({{"$_row", BSON("" << BSONNULL)},
+                                    {"a", fromjson("{'': 'one'}")},
+                                    {"b.c", BSON("" << 2)}});
+    ASSERT(assertKeysetsEqual(expectedKeys, keys));
+    ASSERT(multikeyPaths == MultikeyPaths(2));
+}
+
+TEST(ColumnKeyGeneratorTest, StoresObjectsAndTrailingArraysWhole) {
+    auto keyGen = makeKeyGen("{a: 'columnstore', b: 'columnstore'}");
+
+    KeyStringSet keys;
+    MultikeyPaths multikeyPaths;
+    keyGen.getKeys(
+        fromjson("{a: {x: 1, y: [1, 2]}, b: [3, {z: 4}]}"), &keys, &multikeyPaths, kRecordId);
+
+    auto expectedKeys = makeKeySet({{"$_row", BSON("" << BSONNULL)},
+                                    {"a", fromjson("{'': {x: 1, y: [1, 2]}}")},
+                                    {"b", fromjson("{'': [3, {z: 4}]}")}});
+    ASSERT(assertKeysetsEqual(expectedKeys, keys));
+    ASSERT(multikeyPaths == MultikeyPaths(2));
+}
+
+TEST(ColumnKeyGeneratorTest, ArrayAlongPathProducesNoCellAndIsMultikey) {
+    auto keyGen = makeKeyGen("{'a.b.c': 'columnstore', d: 'columnstore'}");
+
+    KeyStringSet keys;
+    MultikeyPaths multikeyPaths;
+    keyGen.getKeys(fromjson("{a: {b: [{c: 1}, {c: 2}]}, d: 5}"), &keys, &multikeyPaths, kRecordId);
+
+    auto expectedKeys = makeKeySet({{"$_row", BSON("" << BSONNULL)}, {"d", BSON("" << 5)}});
+    ASSERT(assertKeysetsEqual(expectedKeys, keys));
+    ASSERT(multikeyPaths == MultikeyPaths({std::set<size_t>{1U}, std::set<size_t>{}}));
+}
+
+TEST(ColumnKeyGeneratorTest, ColumnBoundsBracketEveryCellOfThePath) {
+    auto keyGen = makeKeyGen("{a: 'columnstore'}");
+
+    KeyStringSet keys;
+    keyGen.getKeys(fromjson("{a: {$maxKey: 1}}"), &keys, nullptr, kRecordId);
+
+    const auto ordering = Ordering::make(BSONObj());
+    auto start = KeyString::HeapBuilder(KeyString::Version::kLatestVersion,
+                                        ColumnKeyGenerator::makeColumnStartKey("a"),
+                                        ordering)
+                     .release();
+    auto end = KeyString::HeapBuilder(KeyString::Version::kLatestVersion,
+                                      ColumnKeyGenerator::makeColumnEndKey("a"),
+                                      ordering)
+                   .release();
+
+    auto cell = makeKeySet({{"a", fromjson("{'': {$maxKey: 1}}")}});
+    ASSERT_EQ(keys.count(*cell.begin()), 1U);
+    ASSERT_LT(start, *cell.begin());
+    ASSERT_LT(*cell.begin(), end);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,72 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/db/index/index_access_method.h"
+
+namespace mongo {
+
+/**
+ * The access method for "columnstore" indexes, created with a key pattern such as
+ * {a: "columnstore", "b.c": "columnstore"}. Each indexed path is stored as its own column of
+ * (RecordId, value) cells; see ColumnKeyGenerator for the key format. These indexes cannot answer
+ * predicates. Instead, the ColumnScan stage reads a subset of the columns in parallel and
+ * reassembles the projected fields of each document without fetching the record.
+ */
+class ColumnStoreAccessMethod final : public AbstractIndexAccessMethod {
+public:
+    ColumnStoreAccessMethod(IndexCatalogEntry* columnState,
+                            std::unique_ptr<SortedDataInterface> btree);
+
+    /**
+     * Every document produces several keys, one per column, so the number of keys says nothing
+     * about arrays. The index only becomes multikey when an array is found along a dotted path,
+     * which means that the column for that path is incomplete.
+     */
+    bool shouldMarkIndexAsMultikey(size_t numberOfKeys,
+                                   const std::vector<KeyString::Value>& multikeyMetadataKeys,
+                                   const MultikeyPaths& multikeyPaths) const final;
+
+    const ColumnKeyGenerator& getKeyGenerator() const {
+        return _keyGen;
+    }
+
+private:
+    void doGetKeys(const BSONObj& obj,
+                   KeyStringSet* keys,
+                   KeyStringSet* multikeyMetadataKeys,
+                   MultikeyPaths* multikeyPaths,
+                   boost::optional<RecordId> id) const final;
+
+    const ColumnKeyGenerator _keyGen;
+};
+
+}  // namespace mongo
@@ -33,6 +33,7 @@
 
 #include "mongo/db/index/btree_access_method.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -154,22 +155,8 @@ Status AbstractIndexAccessMethod::insertKeys(OperationContext* opCtx,
     // the multikey metadata keys, they should point to the reserved 'kMultikeyMetadataKeyId'.
     for (const auto keyVec : {&keys, &multikeyMetadataKeys}) {
         for (const auto& keyString : *keyVec) {
-            bool unique = _descriptor->unique();
-            Status status = _newInterface->insert(opCtx, keyString, !unique /* dupsAllowed */);
-
-            // When duplicates are encountered and allowed, retry with dupsAllowed. Add the
-            // key to the output vector so callers know which duplicate keys were inserted.
-            if (ErrorCodes::DuplicateKey == status.code() && options.dupsAllowed) {
-                invariant(unique);
-                status = _newInterface->insert(opCtx, keyString, true /* dupsAllowed */);
-
-                if (status.isOK() && result) {
-                    auto key =
-                        KeyString::toBson(keyString, getSortedDataInterface()->getOrdering());
-                    result->dupsInserted.push_back(key);
-                }
-            }
-            if (isFatalError(opCtx, status, keyString)) {
+            Status status = insertOneKey(opCtx, keyString, options, result);
+            if (!status.isOK()) {
                 return status;
             }
         }
@@ -185,6 +172,80 @@ Status AbstractIndexAccessMethod::insertKeys(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status AbstractIndexAccessMethod::insertKeysInKeyOrder(
+    OperationContext* opCtx,
+    const std::vector<InsertBatchKeys>& batch,
+    const InsertDeleteOptions& options,
+    const std::function<Status(size_t)>& beforeInsert,
+    InsertResult* result) {
+    // Merge the keys of every document, remembering which document each came from. Data keys end
+    // with the RecordId of their document, so they are distinct across documents. Multikey
+    // metadata keys all point to 'kMultikeyMetadataKeyId' and may repeat, which the index accepts.
+    std::vector<std::pair<const KeyString::Value*, size_t>> sortedKeys;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        for (const auto keySet : {&batch[i].keys, &batch[i].multikeyMetadataKeys}) {
+            for (const auto& keyString : *keySet) {
+                sortedKeys.emplace_back(&keyString, i);
+            }
+        }
+    }
+    std::stable_sort(sortedKeys.begin(), sortedKeys.end(), [](const auto& lhs, const auto& rhs) {
+        return *lhs.first < *rhs.first;
+    });
+
+    for (const auto& [keyString, docIndex] : sortedKeys) {
+        Status status = beforeInsert(docIndex);
+        if (status.isOK()) {
+            status = insertOneKey(opCtx, *keyString, options, result);
+        }
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
+    if (result) {
+        result->numInserted += sortedKeys.size();
+    }
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const auto& docKeys = batch[i];
+        if (shouldMarkIndexAsMultikey(docKeys.keys.size(),
+                                      asVector(docKeys.multikeyMetadataKeys),
+                                      docKeys.multikeyPaths)) {
+            Status status = beforeInsert(i);
+            if (!status.isOK()) {
+                return status;
+            }
+            _btreeState->setMultikey(opCtx, docKeys.multikeyPaths);
+        }
+    }
+    return Status::OK();
+}
+
+Status AbstractIndexAccessMethod::insertOneKey(OperationContext* opCtx,
+                                               const KeyString::Value& keyString,
+                                               const InsertDeleteOptions& options,
+                                               InsertResult* result) {
+    bool unique = _descriptor->unique();
+    Status status = _newInterface->insert(opCtx, keyString, !unique /* dupsAllowed */);
+
+    // When duplicates are encountered and allowed, retry with dupsAllowed. Add the key to the
+    // output vector so callers know which duplicate keys were inserted.
+    if (ErrorCodes::DuplicateKey == status.code() && options.dupsAllowed) {
+        invariant(unique);
+        status = _newInterface->insert(opCtx, keyString, true /* dupsAllowed */);
+
+        if (status.isOK() && result) {
+            auto key = KeyString::toBson(keyString, getSortedDataInterface()->getOrdering());
+            result->dupsInserted.push_back(key);
+        }
+    }
+    if (isFatalError(opCtx, status, keyString)) {
+        return status;
+    }
+    return Status::OK();
+}
+
 void AbstractIndexAccessMethod::removeOneKey(OperationContext* opCtx,
                                              const KeyString::Value& keyString,
                                              const RecordId& loc,
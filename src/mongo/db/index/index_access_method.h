@@ -30,6 +30,7 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <set>
 
@@ -49,6 +50,7 @@ class BSONObjBuilder;
 class MatchExpression;
 struct UpdateTicket;
 struct InsertResult;
+struct InsertBatchKeys;
 struct InsertDeleteOptions;
 
 /**
@@ -98,6 +100,21 @@ public:
                               const InsertDeleteOptions& options,
                               InsertResult* result) = 0;
 
+    /**
+     * Inserts the keys of a batch of documents, one element of 'batch' per document, in key order
+     * rather than document by document. This keeps consecutive inserts on the same or neighboring
+     * pages of the index. 'beforeInsert' is called with the position in 'batch' of a document
+     * before each of its keys is inserted and before the index is marked multikey because of it. A
+     * non-OK status from 'beforeInsert' is returned.
+     *
+     * 'result' accumulates over the whole batch as insertKeys() would for each document.
+     */
+    virtual Status insertKeysInKeyOrder(OperationContext* opCtx,
+                                        const std::vector<InsertBatchKeys>& batch,
+                                        const InsertDeleteOptions& options,
+                                        const std::function<Status(size_t)>& beforeInsert,
+                                        InsertResult* result) = 0;
+
     /**
      * Analogous to insertKeys above, but remove the keys instead of inserting them.
      * 'numDeleted' will be set to the number of keys removed from the index for the provided keys.
@@ -364,6 +381,16 @@ public:
     std::vector<BSONObj> dupsInserted;
 };
 
+/**
+ * The keys generated for one document of a batch passed to insertKeysInKeyOrder().
+ */
+struct InsertBatchKeys {
+    KeyStringSet keys;
+    KeyStringSet multikeyMetadataKeys;
+    MultikeyPaths multikeyPaths;
+    RecordId loc;
+};
+
 /**
  * Updates are two steps: verify that it's a valid update, and perform it.
  * prepareUpdate fills out the UpdateStatus and update actually applies it.
@@ -448,6 +475,12 @@ public:
                       const InsertDeleteOptions& options,
                       InsertResult* result) final;
 
+    Status insertKeysInKeyOrder(OperationContext* opCtx,
+                                const std::vector<InsertBatchKeys>& batch,
+                                const InsertDeleteOptions& options,
+                                const std::function<Status(size_t)>& beforeInsert,
+                                InsertResult* result) final;
+
     Status removeKeys(OperationContext* opCtx,
                       const std::vector<KeyString::Value>& keys,
                       const RecordId& loc,
@@ -545,6 +578,17 @@ private:
      */
     bool isFatalError(OperationContext* opCtx, Status status, KeyString::Value key);
 
+    /**
+     * Inserts a single key into the index, retrying with duplicates allowed if 'options' allow
+     * them. Returns a non-OK status only for fatal errors.
+     *
+     * Used by insertKeys() and insertKeysInKeyOrder() only.
+     */
+    Status insertOneKey(OperationContext* opCtx,
+                        const KeyString::Value& keyString,
+                        const InsertDeleteOptions& options,
+                        InsertResult* result);
+
     /**
      * Removes a single key from the index.
      *
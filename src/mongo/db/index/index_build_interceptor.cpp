@@ -60,7 +60,7 @@ bool IndexBuildInterceptor::typeCanFastpathMultikeyUpdates(IndexType indexType)
     // vector.
     invariant(indexType == INDEX_BTREE || indexType == INDEX_2D || indexType == INDEX_HAYSTACK ||
               indexType == INDEX_2DSPHERE || indexType == INDEX_TEXT || indexType == INDEX_HASHED ||
-              indexType == INDEX_WILDCARD);
+              indexType == INDEX_WILDCARD || indexType == INDEX_COLUMN);
     // Only BTREE indexes are guaranteed to use the multikeyPaths vector. Other index types either
     // do not track path-level multikey information or have "special" handling of multikey
     // information.
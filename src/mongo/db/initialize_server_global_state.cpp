@@ -373,6 +373,10 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
 
     if (serverGlobalParams.logV2) {
         lv2Config._format = serverGlobalParams.logFormat;
+        lv2Config._asyncEnabled = serverGlobalParams.logAsync;
+        lv2Config._asyncOverflowPolicy = serverGlobalParams.logAsyncDropOnOverflow
+            ? logv2::LogDomainGlobal::ConfigurationOptions::AsyncOverflowPolicy::kDrop
+            : logv2::LogDomainGlobal::ConfigurationOptions::AsyncOverflowPolicy::kBlock;
         return lv2Manager.getGlobalDomainInternal().configure(lv2Config);
     }
 
@@ -0,0 +1,252 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_match_expression.h"
+
+#include <algorithm>
+#include <boost/container/small_vector.hpp>
+
+#include "mongo/db/matcher/expression_path.h"
+#include "mongo/db/query/query_knobs_gen.h"
+
+namespace mongo {
+
+namespace {
+
+// The number of top-level fields which can be tracked while matching a document without a heap
+// allocation.
+constexpr size_t kInlineFields = 16;
+
+uint64_t fieldLengthBit(size_t length) {
+    return uint64_t{1} << std::min<size_t>(length, 63);
+}
+
+}  // namespace
+
+/**
+ * Flattens a MatchExpression tree into the nodes of a CompiledMatchExpression.
+ */
+class CompiledMatchExpressionBuilder {
+public:
+    explicit CompiledMatchExpressionBuilder(CompiledMatchExpression* compiled)
+        : _compiled(compiled) {}
+
+    size_t numPaths() const {
+        return _numPaths;
+    }
+
+    /**
+     * Appends the nodes for 'expr' and its descendants, and returns the index of the node for
+     * 'expr'.
+     */
+    size_t build(const MatchExpression* expr) {
+        using Kind = CompiledMatchExpression::Node::Kind;
+
+        const size_t index = _compiled->_nodes.size();
+        _compiled->_nodes.emplace_back();
+        _compiled->_nodes[index].expr = expr;
+
+        Kind kind;
+        switch (expr->matchType()) {
+            case MatchExpression::AND:
+                kind = Kind::kAnd;
+                break;
+            case MatchExpression::OR:
+                kind = Kind::kOr;
+                break;
+            case MatchExpression::NOR:
+                kind = Kind::kNor;
+                break;
+            case MatchExpression::NOT:
+                kind = Kind::kNot;
+                break;
+            default:
+                kind = isCompilablePath(expr) ? Kind::kPath : Kind::kOpaque;
+        }
+        _compiled->_nodes[index].kind = kind;
+
+        if (kind == Kind::kPath) {
+            _compiled->_nodes[index].field = fieldIndex(FieldRef(expr->path()).getPart(0));
+            ++_numPaths;
+        } else if (kind != Kind::kOpaque) {
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                // Evaluated before indexing '_nodes', which the recursive call may reallocate.
+                const size_t child = build(expr->getChild(i));
+                _compiled->_nodes[index].children.push_back(child);
+            }
+        }
+        return index;
+    }
+
+private:
+    static bool isCompilablePath(const MatchExpression* expr) {
+        return !expr->path().empty() && dynamic_cast<const PathMatchExpression*>(expr);
+    }
+
+    size_t fieldIndex(StringData fieldName) {
+        auto& fields = _compiled->_fields;
+        auto it = std::find(fields.begin(), fields.end(), fieldName);
+        if (it != fields.end()) {
+            return it - fields.begin();
+        }
+        fields.push_back(fieldName.toString());
+        _compiled->_eagerNodes.emplace_back();
+        _compiled->_fieldLengthMask |= fieldLengthBit(fieldName.size());
+        return fields.size() - 1;
+    }
+
+    CompiledMatchExpression* const _compiled;
+    size_t _numPaths = 0;
+};
+
+std::unique_ptr<CompiledMatchExpression> CompiledMatchExpression::compile(
+    const MatchExpression* expr) {
+    if (!internalQueryEnableMatchExpressionCompilation.load()) {
+        return nullptr;
+    }
+
+    std::unique_ptr<CompiledMatchExpression> compiled(new CompiledMatchExpression());
+    CompiledMatchExpressionBuilder builder(compiled.get());
+    const size_t root = builder.build(expr);
+    if (builder.numPaths() < 2) {
+        return nullptr;
+    }
+
+    // The path predicates directly beneath a top-level $and decide the result on their own, so
+    // they are resolved as soon as their field is reached.
+    const Node& rootNode = compiled->_nodes[root];
+    if (rootNode.kind == Node::Kind::kAnd) {
+        for (size_t child : rootNode.children) {
+            const Node& childNode = compiled->_nodes[child];
+            if (childNode.kind == Node::Kind::kPath) {
+                compiled->_eagerNodes[childNode.field].push_back(child);
+            } else {
+                compiled->_deferredNodes.push_back(child);
+            }
+        }
+    } else {
+        compiled->_deferredNodes.push_back(root);
+    }
+    return compiled;
+}
+
+bool CompiledMatchExpression::matchesBSON(const BSONObj& doc) const {
+    // The first occurrence of each field in the document, as found by BSONObj::getField(), or EOO
+    // if the document does not have the field.
+    boost::container::small_vector<BSONElement, kInlineFields> elements(_fields.size());
+    size_t remaining = _fields.size();
+
+    BSONObjIterator it(doc);
+    while (remaining > 0 && it.more()) {
+        const BSONElement elem = it.next();
+        if (!(_fieldLengthMask & fieldLengthBit(elem.fieldNameSize() - 1))) {
+            continue;
+        }
+
+        const StringData fieldName = elem.fieldNameStringData();
+        for (size_t i = 0; i < _fields.size(); ++i) {
+            if (!elements[i].eoo() || fieldName != _fields[i]) {
+                continue;
+            }
+            elements[i] = elem;
+            --remaining;
+            for (size_t node : _eagerNodes[i]) {
+                if (!_matchesPath(_nodes[node], elem)) {
+                    return false;
+                }
+            }
+            break;
+        }
+    }
+
+    if (remaining > 0) {
+        for (size_t i = 0; i < _fields.size(); ++i) {
+            if (!elements[i].eoo()) {
+                continue;
+            }
+            for (size_t node : _eagerNodes[i]) {
+                if (!_matchesPath(_nodes[node], BSONElement())) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    for (size_t node : _deferredNodes) {
+        if (!_matchesNode(node, elements.data(), doc)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CompiledMatchExpression::_matchesPath(const Node& node, BSONElement topLevelElement) const {
+    return static_cast<const PathMatchExpression*>(node.expr)
+        ->matchesTopLevelElement(topLevelElement);
+}
+
+bool CompiledMatchExpression::_matchesNode(size_t nodeIndex,
+                                           const BSONElement* elements,
+                                           const BSONObj& doc) const {
+    const Node& node = _nodes[nodeIndex];
+    switch (node.kind) {
+        case Node::Kind::kAnd:
+            for (size_t child : node.children) {
+                if (!_matchesNode(child, elements, doc)) {
+                    return false;
+                }
+            }
+            return true;
+        case Node::Kind::kOr:
+            for (size_t child : node.children) {
+                if (_matchesNode(child, elements, doc)) {
+                    return true;
+                }
+            }
+            return false;
+        case Node::Kind::kNor:
+            for (size_t child : node.children) {
+                if (_matchesNode(child, elements, doc)) {
+                    return false;
+                }
+            }
+            return true;
+        case Node::Kind::kNot:
+            return !_matchesNode(node.children[0], elements, doc);
+        case Node::Kind::kPath:
+            return _matchesPath(node, elements[node.field]);
+        case Node::Kind::kOpaque:
+            return node.expr->matchesBSON(doc);
+    }
+    MONGO_UNREACHABLE;
+}
+
+}  // namespace mongo
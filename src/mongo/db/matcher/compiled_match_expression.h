@@ -0,0 +1,114 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+
+/**
+ * A form of a MatchExpression tree which matches a document in a single pass over its top-level
+ * fields, instead of searching the document once for every predicate.
+ *
+ * Each top-level field named by a path predicate is located once, in BSON order, and every
+ * predicate on that field (or on a path beneath it) is resolved against the element found. The
+ * predicates which are direct children of a top-level $and are resolved as soon as their field is
+ * reached, so that a document which fails one of them is rejected without scanning the rest of it.
+ * $and, $or, $nor and $not short-circuit as usual. Expressions which do not act on a path, such as
+ * $expr or $where, are matched by the source tree.
+ *
+ * Whether a document matches is always the same as for MatchExpression::matchesBSON() on the source
+ * tree. The compiled form refers to the nodes of the source tree, which must outlive it and must
+ * not be modified after compilation.
+ */
+class CompiledMatchExpression {
+public:
+    /**
+     * Compiles 'expr'. Returns nullptr if compilation is disabled, or if 'expr' does not contain at
+     * least two path predicates, in which case matching the source tree is just as fast.
+     */
+    static std::unique_ptr<CompiledMatchExpression> compile(const MatchExpression* expr);
+
+    bool matchesBSON(const BSONObj& doc) const;
+
+    size_t numFields() const {
+        return _fields.size();
+    }
+
+private:
+    friend class CompiledMatchExpressionBuilder;
+
+    struct Node {
+        enum class Kind { kAnd, kOr, kNor, kNot, kPath, kOpaque };
+
+        Kind kind;
+        const MatchExpression* expr;
+
+        // For kPath, the index of the top-level field the path starts with, in '_fields'.
+        size_t field = 0;
+
+        // For the logical kinds, the indexes of the children in '_nodes'.
+        std::vector<size_t> children;
+    };
+
+    CompiledMatchExpression() = default;
+
+    bool _matchesPath(const Node& node, BSONElement topLevelElement) const;
+
+    bool _matchesNode(size_t nodeIndex,
+                      const BSONElement* elements,
+                      const BSONObj& doc) const;
+
+    // Node 0 is the root.
+    std::vector<Node> _nodes;
+
+    // The distinct top-level field names referenced by path predicates.
+    std::vector<std::string> _fields;
+
+    // For each entry of '_fields', the path predicates which are resolved as soon as the field is
+    // reached during the scan of the document.
+    std::vector<std::vector<size_t>> _eagerNodes;
+
+    // The non-eager children of the root, or the root itself if it is not an $and. They are
+    // matched once the scan has completed.
+    std::vector<size_t> _deferredNodes;
+
+    // Bit 'n' is set if a field of length 'n' is referenced, with longer names sharing bit 63.
+    // Used to skip most fields of the document without comparing names.
+    uint64_t _fieldLengthMask = 0;
+};
+
+}  // namespace mongo
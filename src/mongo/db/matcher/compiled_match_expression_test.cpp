@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_match_expression.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class CompiledMatchExpressionTest : public unittest::Test {
+public:
+    CompiledMatchExpressionTest() {
+        internalQueryEnableMatchExpressionCompilation.store(true);
+    }
+
+    ~CompiledMatchExpressionTest() {
+        internalQueryEnableMatchExpressionCompilation.store(false);
+    }
+
+protected:
+    std::unique_ptr<MatchExpression> parse(const char* json) {
+        auto status = MatchExpressionParser::parse(fromjson(json),
+                                                   _expCtx,
+                                                   ExtensionsCallbackNoop(),
+                                                   MatchExpressionParser::kAllowAllSpecialFeatures);
+        ASSERT_OK(status.getStatus());
+        return std::move(status.getValue());
+    }
+
+    /**
+     * Asserts that the compiled form of 'filter' exists and agrees with the source tree on every
+     * document in 'docs'.
+     */
+    void assertMatchesSourceTree(const char* filter, const std::vector<BSONObj>& docs) {
+        auto expr = parse(filter);
+        auto compiled = CompiledMatchExpression::compile(expr.get());
+        ASSERT(compiled);
+        for (auto&& doc : docs) {
+            ASSERT_EQ(expr->matchesBSON(doc), compiled->matchesBSON(doc))
+                << "filter: " << filter << ", document: " << doc;
+        }
+    }
+
+private:
+    boost::intrusive_ptr<ExpressionContextForTest> _expCtx{new ExpressionContextForTest()};
+};
+
+const std::vector<BSONObj> kDocuments = {
+    fromjson("{}"),
+    fromjson("{a: 1, b: 2, c: 3}"),
+    fromjson("{c: 3, b: 2, a: 1}"),
+    fromjson("{a: 1, b: 3}"),
+    fromjson("{a: null, b: 2}"),
+    fromjson("{b: 2}"),
+    fromjson("{a: [1, 5], b: [2]}"),
+    fromjson("{a: [], b: 2}"),
+    fromjson("{a: [[1]], b: 2}"),
+    fromjson("{a: 1, b: 2, a: 7}"),
+    fromjson("{a: 7, b: 2, a: 1}"),
+    fromjson("{a: {b: 1}, b: 2}"),
+    fromjson("{a: [{b: 1}, {b: 4}], b: 2}"),
+    fromjson("{a: 'x', b: 'y', longFieldName: 1}"),
+    fromjson("{x: 1, y: 2, z: 3, a: 1, b: 2}"),
+};
+
+TEST_F(CompiledMatchExpressionTest, DoesNotCompileWhenDisabled) {
+    internalQueryEnableMatchExpressionCompilation.store(false);
+    auto expr = parse("{a: 1, b: 2}");
+    ASSERT_FALSE(CompiledMatchExpression::compile(expr.get()));
+}
+
+TEST_F(CompiledMatchExpressionTest, DoesNotCompileSinglePredicate) {
+    auto expr = parse("{a: 1}");
+    ASSERT_FALSE(CompiledMatchExpression::compile(expr.get()));
+    expr = parse("{a: 1, $expr: {$eq: ['$b', 2]}}");
+    ASSERT_FALSE(CompiledMatchExpression::compile(expr.get()));
+}
+
+TEST_F(CompiledMatchExpressionTest, LocatesEachTopLevelFieldOnce) {
+    auto expr = parse("{a: {$gt: 0}, 'a.b': 1, b: 2, a: {$lt: 10}}");
+    auto compiled = CompiledMatchExpression::compile(expr.get());
+    ASSERT(compiled);
+    ASSERT_EQ(2U, compiled->numFields());
+}
+
+TEST_F(CompiledMatchExpressionTest, MatchesConjunctionsOfComparisons) {
+    assertMatchesSourceTree("{a: 1, b: 2}", kDocuments);
+    assertMatchesSourceTree("{a: 1, b: 2, c: 3}", kDocuments);
+    assertMatchesSourceTree("{a: {$gte: 1, $lt: 6}, b: {$ne: 3}}", kDocuments);
+    assertMatchesSourceTree("{a: null, b: 2}", kDocuments);
+    assertMatchesSourceTree("{a: [1, 5], b: 2}", kDocuments);
+    assertMatchesSourceTree("{a: {$in: [5, 'x']}, b: {$exists: true}}", kDocuments);
+    assertMatchesSourceTree("{a: {$exists: false}, b: 2}", kDocuments);
+    assertMatchesSourceTree("{a: {$size: 0}, b: {$type: 'number'}}", kDocuments);
+    assertMatchesSourceTree("{a: {$regex: '^x'}, longFieldName: 1}", kDocuments);
+}
+
+TEST_F(CompiledMatchExpressionTest, MatchesFirstOccurrenceOfDuplicateFields) {
+    assertMatchesSourceTree("{a: 1, b: 2}", {fromjson("{a: 1, b: 2, a: 7}")});
+    assertMatchesSourceTree("{a: 7, b: 2}", {fromjson("{a: 1, b: 2, a: 7}")});
+}
+
+TEST_F(CompiledMatchExpressionTest, MatchesDottedPaths) {
+    assertMatchesSourceTree("{'a.b': 1, b: 2}", kDocuments);
+    assertMatchesSourceTree("{'a.b': {$gt: 3}, 'a.0': {$exists: true}}", kDocuments);
+    assertMatchesSourceTree("{'a.0': 1, 'a.1': 5}", kDocuments);
+    assertMatchesSourceTree("{'a.0.0': 1, b: 2}", kDocuments);
+    assertMatchesSourceTree("{a: {$elemMatch: {b: {$gt: 3}}}, b: 2}", kDocuments);
+}
+
+TEST_F(CompiledMatchExpressionTest, MatchesLogicalOperators) {
+    assertMatchesSourceTree("{$or: [{a: 1}, {b: 3}]}", kDocuments);
+    assertMatchesSourceTree("{$nor: [{a: 1}, {b: 3}]}", kDocuments);
+    assertMatchesSourceTree("{a: {$not: {$gt: 2}}, b: 2}", kDocuments);
+    assertMatchesSourceTree("{b: 2, $or: [{a: 1}, {c: {$exists: true}}, {'a.b': 4}]}", kDocuments);
+    assertMatchesSourceTree("{$and: [{$or: [{a: 1}, {a: 7}]}, {$nor: [{b: 3}, {c: 3}]}]}",
+                            kDocuments);
+}
+
+TEST_F(CompiledMatchExpressionTest, MatchesExpressionsWithoutPaths) {
+    assertMatchesSourceTree("{a: 1, b: 2, $expr: {$eq: ['$c', 3]}}", kDocuments);
+    assertMatchesSourceTree("{$or: [{a: 1, b: 3}, {$expr: {$lt: ['$a', '$b']}}]}", kDocuments);
+    assertMatchesSourceTree("{a: {$exists: true}, b: 2, $alwaysFalse: 1}", kDocuments);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -36,6 +36,7 @@
 #include "mongo/db/matcher/rewrite_expr.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/expression_program.h"
 
 namespace mongo {
 
@@ -106,6 +107,9 @@ private:
 
     boost::intrusive_ptr<Expression> _expression;
 
+    // Compiled form of '_expression' once it has been optimized, if compilation is enabled.
+    std::unique_ptr<ExpressionProgram> _program;
+
     boost::optional<RewriteExpr::RewriteResult> _rewriteResult;
 };
 
@@ -69,6 +69,23 @@ public:
         return false;
     }
 
+    /**
+     * Returns the same result as matches() on a document whose field named by the first component
+     * of the path is 'topLevelElement', or which has no such field if 'topLevelElement' is EOO.
+     * Allows a caller which has already located the top-level field to skip searching for it. The
+     * path must not be empty.
+     */
+    bool matchesTopLevelElement(BSONElement topLevelElement) const {
+        BSONElementIterator cursor;
+        cursor.reset(&_elementPath, 1, topLevelElement);
+        while (cursor.more()) {
+            if (matchesSingleElement(cursor.next().element())) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     const StringData path() const final {
         return _path;
     }
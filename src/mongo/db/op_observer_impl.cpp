@@ -47,6 +47,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/op_observer_util.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/change_stream_post_image_cache.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_entry_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -454,6 +455,19 @@ void OpObserverImpl::onUpdate(OperationContext* opCtx, const OplogUpdateEntryArg
         sessionTxnRecord.setLastWriteOpTime(opTime.writeOpTime);
         sessionTxnRecord.setLastWriteDate(opTime.wallClockTime);
         onWriteOpCompleted(opCtx, std::vector<StmtId>{args.updateArgs.stmtId}, sessionTxnRecord);
+
+        // Keep the post-image for the change streams which look up the full document of update
+        // events, once the update is committed.
+        auto postImageCache = ChangeStreamPostImageCache::get(opCtx->getServiceContext());
+        if (!opTime.writeOpTime.isNull() && postImageCache->isActive()) {
+            opCtx->recoveryUnit()->onCommit(
+                [postImageCache,
+                 uuid = args.uuid,
+                 ts = opTime.writeOpTime.getTimestamp(),
+                 postImage = args.updateArgs.updatedDoc.getOwned()](boost::optional<Timestamp>) {
+                    postImageCache->insert(uuid, ts, postImage);
+                });
+        }
     }
 
     if (args.nss != NamespaceString::kSessionTransactionsTableNamespace) {
@@ -0,0 +1,347 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/change_stream_oplog_reader.h"
+
+#include <limits>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/document_source_change_stream.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const auto getChangeStreamOplogReader =
+    ServiceContext::declareDecoration<ChangeStreamOplogReader>();
+
+/**
+ * Returns the greatest timestamp which is smaller than 'ts'.
+ */
+Timestamp precedingTimestamp(Timestamp ts) {
+    if (ts.getInc() > 0) {
+        return Timestamp(ts.getSecs(), ts.getInc() - 1);
+    }
+    if (ts.getSecs() > 0) {
+        return Timestamp(ts.getSecs() - 1, std::numeric_limits<uint32_t>::max());
+    }
+    return Timestamp();
+}
+
+Timestamp entryTimestamp(const BSONObj& entry) {
+    return entry["ts"].timestamp();
+}
+
+size_t scanBatchSize() {
+    return static_cast<size_t>(internalChangeStreamSharedOplogReaderBatchSize.load());
+}
+
+Milliseconds pollInterval() {
+    return Milliseconds(internalChangeStreamSharedOplogReaderPollIntervalMS.load());
+}
+
+}  // namespace
+
+ChangeStreamOplogReader* ChangeStreamOplogReader::get(ServiceContext* serviceContext) {
+    return &getChangeStreamOplogReader(serviceContext);
+}
+
+std::unique_ptr<ChangeStreamOplogReader::Watcher> ChangeStreamOplogReader::registerWatcher(
+    const NamespaceString& nss, Timestamp startFrom) {
+    return std::unique_ptr<Watcher>(new Watcher(this, nss, precedingTimestamp(startFrom)));
+}
+
+Timestamp ChangeStreamOplogReader::getScannedThrough() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _scannedThrough;
+}
+
+void ChangeStreamOplogReader::_attach(WithLock, Watcher* watcher) {
+    invariant(!watcher->_attached);
+    if (watcher->_indexKey.empty()) {
+        _clusterWatchers.insert(watcher);
+    } else if (watcher->_watchesDatabase) {
+        _databaseWatchers[watcher->_indexKey].insert(watcher);
+    } else {
+        _collectionWatchers[watcher->_indexKey].insert(watcher);
+    }
+    watcher->_attached = true;
+    ++_numAttached;
+}
+
+void ChangeStreamOplogReader::_detach(WithLock, Watcher* watcher) {
+    invariant(watcher->_attached);
+    auto eraseFrom = [&](auto& index) {
+        auto it = index.find(watcher->_indexKey);
+        it->second.erase(watcher);
+        if (it->second.empty()) {
+            index.erase(it);
+        }
+    };
+    if (watcher->_indexKey.empty()) {
+        _clusterWatchers.erase(watcher);
+    } else if (watcher->_watchesDatabase) {
+        eraseFrom(_databaseWatchers);
+    } else {
+        eraseFrom(_collectionWatchers);
+    }
+    watcher->_attached = false;
+    // The watcher reads the entries it drops here again when it catches up.
+    watcher->_queue.clear();
+    --_numAttached;
+}
+
+void ChangeStreamOplogReader::_dispatch(WithLock lk,
+                                        const Watcher* scanner,
+                                        const std::vector<BSONObj>& entries) {
+    const auto maxQueued =
+        static_cast<size_t>(internalChangeStreamSharedOplogReaderMaxQueuedEntries.load());
+    stdx::unordered_set<Watcher*> overflowed;
+    auto enqueue = [&](Watcher* watcher, const BSONObj& entry) {
+        if (overflowed.count(watcher)) {
+            return;
+        }
+        if (watcher != scanner && watcher->_queue.size() >= maxQueued) {
+            overflowed.insert(watcher);
+            return;
+        }
+        watcher->_queue.push_back(entry);
+    };
+
+    for (auto&& entry : entries) {
+        const auto ts = entryTimestamp(entry);
+        if (ts <= _scannedThrough) {
+            continue;
+        }
+        _scannedThrough = ts;
+
+        // Commands, including the 'applyOps' entries of transactions, may concern collections
+        // other than the one in their namespace, so they go to every watcher. Other entries only
+        // go to the watchers of their collection, of its database, and of the whole cluster.
+        const auto ns = entry["ns"].valueStringDataSafe();
+        const auto dot = ns.find('.');
+        if (dot == std::string::npos || ns.endsWith(".$cmd"_sd)) {
+            for (auto&& [key, watchers] : _collectionWatchers) {
+                for (auto&& watcher : watchers) {
+                    enqueue(watcher, entry);
+                }
+            }
+            for (auto&& [key, watchers] : _databaseWatchers) {
+                for (auto&& watcher : watchers) {
+                    enqueue(watcher, entry);
+                }
+            }
+        } else {
+            if (auto it = _collectionWatchers.find(ns.toString());
+                it != _collectionWatchers.end()) {
+                for (auto&& watcher : it->second) {
+                    enqueue(watcher, entry);
+                }
+            }
+            if (auto it = _databaseWatchers.find(ns.substr(0, dot).toString());
+                it != _databaseWatchers.end()) {
+                for (auto&& watcher : it->second) {
+                    enqueue(watcher, entry);
+                }
+            }
+        }
+        for (auto&& watcher : _clusterWatchers) {
+            enqueue(watcher, entry);
+        }
+    }
+
+    for (auto&& watcher : overflowed) {
+        _detach(lk, watcher);
+    }
+}
+
+ChangeStreamOplogReader::Watcher::Watcher(ChangeStreamOplogReader* reader,
+                                          const NamespaceString& nss,
+                                          Timestamp position)
+    : _reader(reader),
+      _indexKey([&] {
+          switch (DocumentSourceChangeStream::getChangeStreamType(nss)) {
+              case DocumentSourceChangeStream::ChangeStreamType::kSingleCollection:
+                  return nss.ns();
+              case DocumentSourceChangeStream::ChangeStreamType::kSingleDatabase:
+                  return nss.db().toString();
+              case DocumentSourceChangeStream::ChangeStreamType::kAllChangesForCluster:
+                  return std::string();
+          }
+          MONGO_UNREACHABLE;
+      }()),
+      _watchesDatabase(DocumentSourceChangeStream::getChangeStreamType(nss) ==
+                       DocumentSourceChangeStream::ChangeStreamType::kSingleDatabase),
+      _position(position) {}
+
+ChangeStreamOplogReader::Watcher::~Watcher() {
+    stdx::lock_guard<Latch> lk(_reader->_mutex);
+    if (_attached) {
+        _reader->_detach(lk, this);
+    }
+}
+
+Timestamp ChangeStreamOplogReader::Watcher::getLatestOplogTimestamp() const {
+    stdx::lock_guard<Latch> lk(_reader->_mutex);
+    if (_attached && _queue.empty()) {
+        return std::max(_position, _reader->_scannedThrough);
+    }
+    return _position;
+}
+
+boost::optional<BSONObj> ChangeStreamOplogReader::Watcher::_popFront(WithLock) {
+    while (!_queue.empty()) {
+        auto entry = std::move(_queue.front());
+        _queue.pop_front();
+
+        // Entries up to '_position' may be queued again by the shared scan after this watcher
+        // caught up on its own.
+        const auto ts = entryTimestamp(entry);
+        if (ts <= _position) {
+            continue;
+        }
+        _position = ts;
+        return entry;
+    }
+    return boost::none;
+}
+
+void ChangeStreamOplogReader::Watcher::_catchUp(stdx::unique_lock<Latch>& lk,
+                                                const ScanFunction& scan) {
+    invariant(!_attached && _queue.empty());
+    const auto after = _position;
+    lk.unlock();
+    auto entries = scan(after, scanBatchSize());
+    lk.lock();
+
+    bool caughtUp = false;
+    for (auto&& entry : entries) {
+        const auto ts = entryTimestamp(entry);
+        if (ts > _reader->_scannedThrough) {
+            // The shared scan queues this entry and the following ones once attached.
+            caughtUp = true;
+            break;
+        }
+        _queue.push_back(std::move(entry));
+        if (ts == _reader->_scannedThrough) {
+            caughtUp = true;
+            break;
+        }
+    }
+    if (caughtUp) {
+        _reader->_attach(lk, this);
+    }
+}
+
+boost::optional<BSONObj> ChangeStreamOplogReader::Watcher::next(OperationContext* opCtx,
+                                                                const ScanFunction& scan,
+                                                                Date_t deadline) {
+    stdx::unique_lock<Latch> lk(_reader->_mutex);
+    while (true) {
+        if (auto entry = _popFront(lk)) {
+            return entry;
+        }
+
+        if (!_attached) {
+            if (_reader->_numAttached == 0 && !_reader->_scanning) {
+                // Nobody else relies on the shared scan, so it can start from this watcher.
+                _reader->_scannedThrough = _position;
+            }
+            if (_position >= _reader->_scannedThrough) {
+                _reader->_attach(lk, this);
+                continue;
+            }
+
+            _catchUp(lk, scan);
+            if (!_queue.empty() || _attached) {
+                continue;
+            }
+            // The oplog visible to this operation ends before the entries already scanned. Give
+            // its snapshot time to advance before reading again.
+            const auto now = Date_t::now();
+            if (now >= deadline) {
+                return boost::none;
+            }
+            opCtx->waitForConditionOrInterruptUntil(
+                _reader->_scanned, lk, std::min(deadline, now + pollInterval()), [] {
+                    return false;
+                });
+            continue;
+        }
+
+        const auto now = Date_t::now();
+        if (!_reader->_scanning && now >= _reader->_nextScan) {
+            _reader->_scanning = true;
+            const auto after = _reader->_scannedThrough;
+            std::vector<BSONObj> entries;
+            {
+                // However the scan ends, the other watchers must be able to scan again.
+                ON_BLOCK_EXIT([&] {
+                    if (!lk.owns_lock()) {
+                        lk.lock();
+                    }
+                    _reader->_scanning = false;
+                    ++_reader->_numScans;
+                    _reader->_scanned.notify_all();
+                });
+                lk.unlock();
+                entries = scan(after, scanBatchSize());
+                lk.lock();
+            }
+
+            // The waiters only see the new count once the entries are dispatched and 'lk' is
+            // released.
+            if (entries.empty()) {
+                _reader->_nextScan = now + pollInterval();
+            }
+            _reader->_dispatch(lk, this, entries);
+            if (!entries.empty()) {
+                continue;
+            }
+        }
+
+        if (now >= deadline) {
+            return boost::none;
+        }
+
+        // Wait for another watcher to complete its scan, or for the next scan to be due.
+        const auto numScans = _reader->_numScans;
+        const auto waitUntil =
+            _reader->_scanning ? deadline : std::min(deadline, _reader->_nextScan);
+        opCtx->waitForConditionOrInterruptUntil(_reader->_scanned, lk, waitUntil, [&] {
+            return _reader->_numScans != numScans || !_attached;
+        });
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,175 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/timestamp.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/stdx/unordered_set.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * A node-wide reader of the oplog shared by the change streams opened on this node. Instead of
+ * each change stream scanning the oplog on its own, the change streams register a Watcher, and
+ * whichever watcher first runs out of entries scans the oplog on behalf of all of them. The
+ * entries read are dispatched to the watchers through an index of the namespaces they watch, so
+ * that each entry is only queued for the watchers which may be interested in it; every watcher
+ * then applies its own oplog filter to the entries queued for it.
+ *
+ * A watcher which starts behind the entries already scanned, or which falls too far behind the
+ * other watchers, reads the oplog on its own until it catches up with the shared scan. Every
+ * watcher keeps its own position, from which its resume tokens are produced.
+ */
+class ChangeStreamOplogReader {
+    ChangeStreamOplogReader(const ChangeStreamOplogReader&) = delete;
+    ChangeStreamOplogReader& operator=(const ChangeStreamOplogReader&) = delete;
+
+public:
+    /**
+     * Returns up to 'limit' owned oplog entries whose timestamp is greater than 'after', in oplog
+     * order.
+     */
+    using ScanFunction = std::function<std::vector<BSONObj>(Timestamp after, size_t limit)>;
+
+    class Watcher {
+        Watcher(const Watcher&) = delete;
+        Watcher& operator=(const Watcher&) = delete;
+
+    public:
+        ~Watcher();
+
+        /**
+         * Returns the next oplog entry that may be relevant to this watcher, scanning the oplog
+         * with 'scan' when no entry is queued. When the oplog has no new entries, waits for them
+         * until 'deadline', and returns boost::none if none arrived. Throws if 'opCtx' is
+         * interrupted.
+         */
+        boost::optional<BSONObj> next(OperationContext* opCtx,
+                                      const ScanFunction& scan,
+                                      Date_t deadline);
+
+        /**
+         * Returns the timestamp through which this watcher has seen every oplog entry.
+         */
+        Timestamp getLatestOplogTimestamp() const;
+
+    private:
+        friend class ChangeStreamOplogReader;
+
+        Watcher(ChangeStreamOplogReader* reader, const NamespaceString& nss, Timestamp position);
+
+        boost::optional<BSONObj> _popFront(WithLock);
+
+        // Reads the oplog on behalf of this watcher only, until it reaches the shared scan.
+        void _catchUp(stdx::unique_lock<Latch>& lk, const ScanFunction& scan);
+
+        ChangeStreamOplogReader* const _reader;
+
+        // The key under which this watcher is indexed: a full namespace for a single collection
+        // stream, a database name for a whole database stream, or empty for a whole cluster.
+        const std::string _indexKey;
+        const bool _watchesDatabase;
+
+        // Everything below is protected by the reader's mutex.
+
+        // Entries queued for this watcher, in oplog order.
+        std::deque<BSONObj> _queue;
+
+        // Every oplog entry with a timestamp up to '_position' has been returned or skipped.
+        Timestamp _position;
+
+        // Whether this watcher receives the entries read by the shared scan.
+        bool _attached = false;
+    };
+
+    ChangeStreamOplogReader() = default;
+
+    static ChangeStreamOplogReader* get(ServiceContext* serviceContext);
+
+    /**
+     * Registers a watcher of the change stream opened on 'nss', which needs the oplog entries with
+     * a timestamp of 'startFrom' or later.
+     */
+    std::unique_ptr<Watcher> registerWatcher(const NamespaceString& nss, Timestamp startFrom);
+
+    /**
+     * Returns the timestamp through which the shared scan has read the oplog.
+     */
+    Timestamp getScannedThrough() const;
+
+private:
+    void _attach(WithLock, Watcher* watcher);
+    void _detach(WithLock, Watcher* watcher);
+
+    // Queues 'entries', which were just read by the shared scan of 'scanner', for the watchers
+    // they may be relevant to. Detaches the watchers other than 'scanner' which fell too far
+    // behind.
+    void _dispatch(WithLock, const Watcher* scanner, const std::vector<BSONObj>& entries);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ChangeStreamOplogReader::_mutex");
+
+    // Notified whenever the shared scan completes.
+    stdx::condition_variable _scanned;
+
+    // The shared scan has read every oplog entry with a timestamp up to '_scannedThrough'.
+    Timestamp _scannedThrough;
+
+    // Whether a watcher is currently scanning the oplog on behalf of the others.
+    bool _scanning = false;
+
+    // The number of shared scans completed so far.
+    uint64_t _numScans = 0;
+
+    // When the last shared scan found no new entries, the next one is not started before this.
+    Date_t _nextScan;
+
+    // The attached watchers, indexed by what they watch.
+    stdx::unordered_map<std::string, stdx::unordered_set<Watcher*>> _collectionWatchers;
+    stdx::unordered_map<std::string, stdx::unordered_set<Watcher*>> _databaseWatchers;
+    stdx::unordered_set<Watcher*> _clusterWatchers;
+    size_t _numAttached = 0;
+};
+
+}  // namespace mongo
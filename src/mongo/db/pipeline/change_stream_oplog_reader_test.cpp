@@ -0,0 +1,210 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/change_stream_oplog_reader.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class ChangeStreamOplogReaderTest : public ServiceContextTest {
+protected:
+    void setUp() override {
+        _savedPollInterval = internalChangeStreamSharedOplogReaderPollIntervalMS.load();
+        _savedMaxQueued = internalChangeStreamSharedOplogReaderMaxQueuedEntries.load();
+        // Let every call scan the oplog again, so that the tests do not depend on the clock.
+        internalChangeStreamSharedOplogReaderPollIntervalMS.store(0);
+    }
+
+    void tearDown() override {
+        internalChangeStreamSharedOplogReaderPollIntervalMS.store(_savedPollInterval);
+        internalChangeStreamSharedOplogReaderMaxQueuedEntries.store(_savedMaxQueued);
+    }
+
+    ChangeStreamOplogReader* reader() {
+        return ChangeStreamOplogReader::get(getServiceContext());
+    }
+
+    void appendEntry(StringData ns) {
+        _oplog.push_back(BSON("ts" << Timestamp(100, _oplog.size() + 1) << "op"
+                                   << "i"
+                                   << "ns" << ns));
+    }
+
+    ChangeStreamOplogReader::ScanFunction scanFunction() {
+        return [this](Timestamp after, size_t limit) {
+            ++_numScans;
+            std::vector<BSONObj> entries;
+            for (auto&& entry : _oplog) {
+                if (entries.size() < limit && entry["ts"].timestamp() > after) {
+                    entries.push_back(entry);
+                }
+            }
+            return entries;
+        };
+    }
+
+    /**
+     * Returns the namespaces of all of the entries currently available to 'watcher'.
+     */
+    std::vector<std::string> drain(ChangeStreamOplogReader::Watcher* watcher) {
+        std::vector<std::string> namespaces;
+        while (auto entry = watcher->next(_opCtx.get(), scanFunction(), Date_t::min())) {
+            namespaces.push_back((*entry)["ns"].str());
+        }
+        return namespaces;
+    }
+
+    ServiceContext::UniqueOperationContext _opCtx = makeOperationContext();
+    std::vector<BSONObj> _oplog;
+    int _numScans = 0;
+
+private:
+    int _savedPollInterval;
+    int _savedMaxQueued;
+};
+
+using Namespaces = std::vector<std::string>;
+
+TEST_F(ChangeStreamOplogReaderTest, EntriesAreDispatchedToTheWatchersOfTheirNamespace) {
+    auto collWatcher = reader()->registerWatcher(NamespaceString("a.b"), Timestamp(100, 1));
+    auto otherCollWatcher = reader()->registerWatcher(NamespaceString("a.c"), Timestamp(100, 1));
+    auto dbWatcher = reader()->registerWatcher(
+        NamespaceString::makeCollectionlessAggregateNSS("a"), Timestamp(100, 1));
+    auto clusterWatcher = reader()->registerWatcher(
+        NamespaceString::makeCollectionlessAggregateNSS("admin"), Timestamp(100, 1));
+
+    // Attach all of the watchers to the shared scan.
+    ASSERT_TRUE(drain(collWatcher.get()).empty());
+    ASSERT_TRUE(drain(otherCollWatcher.get()).empty());
+    ASSERT_TRUE(drain(dbWatcher.get()).empty());
+    ASSERT_TRUE(drain(clusterWatcher.get()).empty());
+
+    appendEntry("a.b");
+    appendEntry("x.y");
+    appendEntry("a.$cmd");
+    appendEntry("a.c");
+
+    _numScans = 0;
+    ASSERT(drain(collWatcher.get()) == Namespaces({"a.b", "a.$cmd"}));
+    const auto scansForFirstWatcher = _numScans;
+    ASSERT_EQ(scansForFirstWatcher, 2);
+
+    // The other watchers are served by the scan of the first one.
+    ASSERT(drain(otherCollWatcher.get()) == Namespaces({"a.$cmd", "a.c"}));
+    ASSERT(drain(dbWatcher.get()) == Namespaces({"a.b", "a.$cmd", "a.c"}));
+    ASSERT(drain(clusterWatcher.get()) == Namespaces({"a.b", "x.y", "a.$cmd", "a.c"}));
+    ASSERT_EQ(_numScans, scansForFirstWatcher + 3);
+
+    ASSERT_EQ(reader()->getScannedThrough(), Timestamp(100, 4));
+    ASSERT_EQ(collWatcher->getLatestOplogTimestamp(), Timestamp(100, 4));
+}
+
+TEST_F(ChangeStreamOplogReaderTest, LateWatcherCatchesUpBeforeJoiningTheSharedScan) {
+    auto firstWatcher = reader()->registerWatcher(NamespaceString("a.b"), Timestamp(100, 1));
+    appendEntry("a.b");
+    appendEntry("a.b");
+    appendEntry("a.b");
+    ASSERT_EQ(drain(firstWatcher.get()).size(), 3u);
+
+    // The second watcher starts from an entry the shared scan has already read.
+    auto secondWatcher = reader()->registerWatcher(NamespaceString("a.b"), Timestamp(100, 2));
+    appendEntry("a.b");
+    ASSERT_EQ(drain(secondWatcher.get()).size(), 3u);
+    ASSERT_EQ(drain(firstWatcher.get()).size(), 1u);
+    ASSERT_EQ(secondWatcher->getLatestOplogTimestamp(), Timestamp(100, 4));
+}
+
+TEST_F(ChangeStreamOplogReaderTest, WatcherWhichFallsBehindReadsTheOplogOnItsOwn) {
+    internalChangeStreamSharedOplogReaderMaxQueuedEntries.store(2);
+
+    auto fastWatcher = reader()->registerWatcher(NamespaceString("a.b"), Timestamp(100, 1));
+    auto slowWatcher = reader()->registerWatcher(NamespaceString("a.b"), Timestamp(100, 1));
+    ASSERT_TRUE(drain(fastWatcher.get()).empty());
+    ASSERT_TRUE(drain(slowWatcher.get()).empty());
+
+    for (int i = 0; i < 5; ++i) {
+        appendEntry("a.b");
+    }
+    ASSERT_EQ(drain(fastWatcher.get()).size(), 5u);
+
+    // The slow watcher lost its queue but still sees every entry, in order.
+    std::vector<Timestamp> timestamps;
+    while (auto entry = slowWatcher->next(_opCtx.get(), scanFunction(), Date_t::min())) {
+        timestamps.push_back((*entry)["ts"].timestamp());
+    }
+    ASSERT_EQ(timestamps.size(), 5u);
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        ASSERT_EQ(timestamps[i], Timestamp(100, i + 1));
+    }
+}
+
+TEST_F(ChangeStreamOplogReaderTest, FirstWatcherStartsTheSharedScanFromItsPosition) {
+    for (int i = 0; i < 5; ++i) {
+        appendEntry("a.b");
+    }
+    auto watcher = reader()->registerWatcher(NamespaceString("a.b"), Timestamp(100, 4));
+    ASSERT_EQ(watcher->getLatestOplogTimestamp(), Timestamp(100, 3));
+
+    _numScans = 0;
+    ASSERT_EQ(drain(watcher.get()).size(), 2u);
+    ASSERT_EQ(_numScans, 2);
+    ASSERT_EQ(watcher->getLatestOplogTimestamp(), Timestamp(100, 5));
+}
+
+TEST_F(ChangeStreamOplogReaderTest, FailedScanLetsTheNextWatcherScan) {
+    auto firstWatcher = reader()->registerWatcher(NamespaceString("a.b"), Timestamp(100, 1));
+    auto secondWatcher = reader()->registerWatcher(NamespaceString("a.b"), Timestamp(100, 1));
+    ASSERT_TRUE(drain(firstWatcher.get()).empty());
+    ASSERT_TRUE(drain(secondWatcher.get()).empty());
+    appendEntry("a.b");
+
+    // The scan may fail with something other than a DBException.
+    ChangeStreamOplogReader::ScanFunction failingScan = [](Timestamp, size_t) {
+        throw std::runtime_error("scan failed");
+        return std::vector<BSONObj>();
+    };
+    ASSERT_THROWS(firstWatcher->next(_opCtx.get(), failingScan, Date_t::min()),
+                  std::runtime_error);
+
+    ASSERT_EQ(drain(secondWatcher.get()).size(), 1u);
+    ASSERT_EQ(drain(firstWatcher.get()).size(), 1u);
+}
+
+}  // namespace
+}  // namespace mongo
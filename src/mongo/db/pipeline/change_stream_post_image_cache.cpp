@@ -0,0 +1,129 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/change_stream_post_image_cache.h"
+
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getChangeStreamPostImageCache =
+    ServiceContext::declareDecoration<ChangeStreamPostImageCache>();
+
+// The approximate memory used by an entry besides the post-image itself.
+constexpr size_t kEntryOverheadBytes = sizeof(Timestamp) + sizeof(UUID) + sizeof(BSONObj) + 32;
+
+size_t entrySize(const BSONObj& postImage) {
+    return static_cast<size_t>(postImage.objsize()) + kEntryOverheadBytes;
+}
+
+}  // namespace
+
+ChangeStreamPostImageCache* ChangeStreamPostImageCache::get(ServiceContext* serviceContext) {
+    return &getChangeStreamPostImageCache(serviceContext);
+}
+
+void ChangeStreamPostImageCache::addConsumer() {
+    _numConsumers.fetchAndAdd(1);
+}
+
+void ChangeStreamPostImageCache::removeConsumer() {
+    invariant(_numConsumers.fetchAndSubtract(1) > 0);
+}
+
+bool ChangeStreamPostImageCache::isActive() const {
+    return _numConsumers.load() > 0 && internalChangeStreamPostImageCacheSizeBytes.load() > 0;
+}
+
+ChangeStreamPostImageCache::Partition& ChangeStreamPostImageCache::_partitionFor(Timestamp ts) {
+    return _partitions[ts.asULL() % kNumPartitions];
+}
+
+void ChangeStreamPostImageCache::insert(const UUID& uuid, Timestamp ts, BSONObj postImage) {
+    const auto maxPartitionBytes =
+        static_cast<size_t>(internalChangeStreamPostImageCacheSizeBytes.load()) / kNumPartitions;
+    const auto size = entrySize(postImage);
+    if (size > maxPartitionBytes) {
+        return;
+    }
+
+    auto& partition = _partitionFor(ts);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto [it, inserted] =
+        partition.postImages.emplace(std::make_pair(ts, uuid), std::move(postImage));
+    if (!inserted) {
+        return;
+    }
+    partition.bytes += size;
+
+    // Evict the oldest post-images, which change streams are the least likely to still need.
+    long long evicted = 0;
+    while (partition.bytes > maxPartitionBytes) {
+        auto oldest = partition.postImages.begin();
+        partition.bytes -= entrySize(oldest->second);
+        partition.postImages.erase(oldest);
+        ++evicted;
+    }
+    if (evicted) {
+        _evictions.fetchAndAdd(evicted);
+    }
+}
+
+boost::optional<BSONObj> ChangeStreamPostImageCache::find(const UUID& uuid, Timestamp ts) {
+    auto& partition = _partitionFor(ts);
+    {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        auto it = partition.postImages.find(std::make_pair(ts, uuid));
+        if (it != partition.postImages.end()) {
+            _hits.fetchAndAdd(1);
+            return it->second;
+        }
+    }
+    _misses.fetchAndAdd(1);
+    return boost::none;
+}
+
+ChangeStreamPostImageCache::Stats ChangeStreamPostImageCache::getStats() const {
+    Stats stats;
+    stats.hits = _hits.load();
+    stats.misses = _misses.load();
+    stats.evictions = _evictions.load();
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        stats.entries += partition.postImages.size();
+        stats.bytes += partition.bytes;
+    }
+    return stats;
+}
+
+}  // namespace mongo
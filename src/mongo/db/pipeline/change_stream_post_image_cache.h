@@ -0,0 +1,122 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <map>
+#include <utility>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/timestamp.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * A bounded, in-memory store of the post-images of recent updates, which lets change streams
+ * opened with {fullDocument: "updateLookup"} return the version of the document produced by each
+ * update event without querying the collection again.
+ *
+ * The write path records the post-image of every update outside of a multi-document transaction
+ * as its storage transaction commits, keyed by collection UUID and oplog timestamp, but only while
+ * the cache has a capacity and a change stream on this node looks post-images up. The oldest
+ * post-images are evicted first. A change stream that misses in the cache falls back to looking
+ * up the current version of the document.
+ */
+class ChangeStreamPostImageCache {
+    ChangeStreamPostImageCache(const ChangeStreamPostImageCache&) = delete;
+    ChangeStreamPostImageCache& operator=(const ChangeStreamPostImageCache&) = delete;
+
+public:
+    struct Stats {
+        long long hits = 0;
+        long long misses = 0;
+        long long evictions = 0;
+        long long entries = 0;
+        long long bytes = 0;
+    };
+
+    ChangeStreamPostImageCache() = default;
+
+    static ChangeStreamPostImageCache* get(ServiceContext* serviceContext);
+
+    /**
+     * Registers and unregisters a change stream stage which looks up post-images. The write path
+     * only records post-images while at least one is registered.
+     */
+    void addConsumer();
+    void removeConsumer();
+
+    /**
+     * Returns true if the write path should record post-images.
+     */
+    bool isActive() const;
+
+    /**
+     * Records 'postImage', the document produced by the update logged at 'ts' on the collection
+     * 'uuid'.
+     */
+    void insert(const UUID& uuid, Timestamp ts, BSONObj postImage);
+
+    /**
+     * Returns the post-image of the update logged at 'ts' on the collection 'uuid', if it is still
+     * cached.
+     */
+    boost::optional<BSONObj> find(const UUID& uuid, Timestamp ts);
+
+    Stats getStats() const;
+
+private:
+    static constexpr size_t kNumPartitions = 16;
+
+    // Updates are spread over the partitions by timestamp, so that concurrent writers rarely
+    // contend on the same mutex.
+    struct Partition {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("ChangeStreamPostImageCache::Partition::mutex");
+        std::map<std::pair<Timestamp, UUID>, BSONObj> postImages;
+        size_t bytes = 0;
+    };
+
+    Partition& _partitionFor(Timestamp ts);
+
+    std::array<Partition, kNumPartitions> _partitions;
+
+    AtomicWord<int> _numConsumers{0};
+
+    AtomicWord<long long> _hits{0};
+    AtomicWord<long long> _misses{0};
+    AtomicWord<long long> _evictions{0};
+};
+
+}  // namespace mongo
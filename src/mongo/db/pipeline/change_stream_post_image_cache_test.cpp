@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/change_stream_post_image_cache.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class ChangeStreamPostImageCacheTest : public ServiceContextTest {
+protected:
+    void setUp() override {
+        _savedCacheSize = internalChangeStreamPostImageCacheSizeBytes.load();
+        internalChangeStreamPostImageCacheSizeBytes.store(1024 * 1024);
+    }
+
+    void tearDown() override {
+        internalChangeStreamPostImageCacheSizeBytes.store(_savedCacheSize);
+    }
+
+    ChangeStreamPostImageCache* cache() {
+        return ChangeStreamPostImageCache::get(getServiceContext());
+    }
+
+private:
+    long long _savedCacheSize;
+};
+
+TEST_F(ChangeStreamPostImageCacheTest, IsOnlyActiveWithConsumersAndCapacity) {
+    ASSERT_FALSE(cache()->isActive());
+    cache()->addConsumer();
+    ASSERT_TRUE(cache()->isActive());
+
+    internalChangeStreamPostImageCacheSizeBytes.store(0);
+    ASSERT_FALSE(cache()->isActive());
+
+    internalChangeStreamPostImageCacheSizeBytes.store(1024);
+    cache()->removeConsumer();
+    ASSERT_FALSE(cache()->isActive());
+}
+
+TEST_F(ChangeStreamPostImageCacheTest, FindsPostImagesByCollectionAndTimestamp) {
+    const auto uuid = UUID::gen();
+    const auto otherUuid = UUID::gen();
+    cache()->insert(uuid, Timestamp(10, 1), BSON("_id" << 1 << "a" << 1));
+    cache()->insert(otherUuid, Timestamp(10, 2), BSON("_id" << 1 << "a" << 2));
+
+    auto postImage = cache()->find(uuid, Timestamp(10, 1));
+    ASSERT_TRUE(postImage);
+    ASSERT_BSONOBJ_EQ(*postImage, BSON("_id" << 1 << "a" << 1));
+
+    ASSERT_FALSE(cache()->find(uuid, Timestamp(10, 2)));
+    ASSERT_FALSE(cache()->find(otherUuid, Timestamp(10, 1)));
+
+    auto stats = cache()->getStats();
+    ASSERT_EQ(stats.hits, 1);
+    ASSERT_EQ(stats.misses, 2);
+    ASSERT_EQ(stats.entries, 2);
+}
+
+TEST_F(ChangeStreamPostImageCacheTest, EvictsTheOldestPostImagesFirst) {
+    // Room for a few documents in each partition.
+    internalChangeStreamPostImageCacheSizeBytes.store(16 * 1024);
+    const auto uuid = UUID::gen();
+    const std::string padding(200, 'x');
+    const int numUpdates = 2000;
+    for (int i = 1; i <= numUpdates; ++i) {
+        cache()->insert(uuid, Timestamp(10, i), BSON("_id" << i << "padding" << padding));
+    }
+
+    auto stats = cache()->getStats();
+    ASSERT_GT(stats.evictions, 0);
+    ASSERT_LTE(stats.bytes, 16 * 1024);
+    ASSERT_EQ(stats.entries + stats.evictions, numUpdates);
+
+    ASSERT_FALSE(cache()->find(uuid, Timestamp(10, 1)));
+    ASSERT_TRUE(cache()->find(uuid, Timestamp(10, numUpdates)));
+}
+
+TEST_F(ChangeStreamPostImageCacheTest, SkipsPostImagesLargerThanAPartition) {
+    internalChangeStreamPostImageCacheSizeBytes.store(1024);
+    const auto uuid = UUID::gen();
+    cache()->insert(uuid, Timestamp(10, 1), BSON("_id" << 1 << "padding" << std::string(200, 'x')));
+    ASSERT_FALSE(cache()->find(uuid, Timestamp(10, 1)));
+    ASSERT_EQ(cache()->getStats().entries, 0);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -109,7 +109,9 @@ DocumentSource::GetNextResult DocumentSourceExchange::doGetNext() {
     return _exchange->getNext(pExpCtx->opCtx, _consumerId, _resourceYielder.get());
 }
 
-Exchange::Exchange(ExchangeSpec spec, std::unique_ptr<Pipeline, PipelineDeleter> pipeline)
+Exchange::Exchange(ExchangeSpec spec,
+                   std::unique_ptr<Pipeline, PipelineDeleter> pipeline,
+                   PartitionFunction partitioner)
     : _spec(std::move(spec)),
       _keyPattern(_spec.getKey().getOwned()),
       _ordering(extractOrdering(_keyPattern)),
@@ -117,6 +119,7 @@ Exchange::Exchange(ExchangeSpec spec, std::unique_ptr<Pipeline, PipelineDeleter>
       _boundaries(extractBoundaries(_spec.getBoundaries(), _ordering)),
       _consumerIds(extractConsumerIds(_spec.getConsumerIds(), _spec.getConsumers())),
       _policy(_spec.getPolicy()),
+      _partitioner(std::move(partitioner)),
       _orderPreserving(_spec.getOrderPreserving()),
       _maxBufferSize(_spec.getBufferSize()),
       _pipeline(std::move(pipeline)) {
@@ -130,6 +133,11 @@ Exchange::Exchange(ExchangeSpec spec, std::unique_ptr<Pipeline, PipelineDeleter>
     for (int idx = 0; idx < _spec.getConsumers(); ++idx) {
         _consumers.emplace_back(std::make_unique<ExchangeBuffer>());
     }
+    _takenResults.resize(_consumers.size());
+
+    uassert(4629400,
+            "An exchange partition function requires the round robin policy",
+            !_partitioner || _policy == ExchangePolicyEnum::kRoundRobin);
 
     if (_policy == ExchangePolicyEnum::kKeyRange) {
         uassert(50900,
@@ -279,6 +287,14 @@ void Exchange::unblockLoading(size_t consumerId) {
 DocumentSource::GetNextResult Exchange::getNext(OperationContext* opCtx,
                                                 size_t consumerId,
                                                 ResourceYielder* resourceYielder) {
+    // Serve the results taken out of the buffer by an earlier call first; they need no lock.
+    auto& taken = _takenResults[consumerId];
+    if (!taken.empty()) {
+        auto doc = std::move(taken.front());
+        taken.pop_front();
+        return doc;
+    }
+
     // Grab a lock.
     stdx::unique_lock<Latch> lk(_mutex);
 
@@ -292,11 +308,14 @@ DocumentSource::GetNextResult Exchange::getNext(OperationContext* opCtx,
                       "Exchange failed due to an error on different thread.");
         }
 
-        // Check if we have a document.
+        // Check if we have a document. Take the whole buffer so that the loading can make progress
+        // while this consumer processes the batch.
         if (!_consumers[consumerId]->isEmpty()) {
-            auto doc = _consumers[consumerId]->getNext();
+            _consumers[consumerId]->takeAll(&taken);
             unblockLoading(consumerId);
 
+            auto doc = std::move(taken.front());
+            taken.pop_front();
             return doc;
         }
 
@@ -352,6 +371,13 @@ size_t Exchange::loadNextBatch() {
     auto input = _pipeline->getSources().back()->getNext();
 
     for (; input.isAdvanced(); input = _pipeline->getSources().back()->getNext()) {
+        if (_partitioner) {
+            size_t target = _partitioner(input.getDocument()) % _consumers.size();
+            if (_consumers[target]->appendDocument(std::move(input), _maxBufferSize))
+                return target;
+            continue;
+        }
+
         // We have a document and we will deliver it to a consumer(s) based on the policy.
         switch (_policy) {
             case ExchangePolicyEnum::kBroadcast: {
@@ -455,9 +481,16 @@ void Exchange::dispose(OperationContext* opCtx, size_t consumerId) {
     }
 
     _consumers[consumerId]->dispose();
+    _takenResults[consumerId].clear();
     unblockLoading(consumerId);
 }
 
+void Exchange::visitInputPipeline(const std::function<void(const Pipeline&)>& visitor) {
+    // The loading consumer holds '_mutex' for as long as it uses the input pipeline.
+    stdx::lock_guard<Latch> lk(_mutex);
+    visitor(*_pipeline);
+}
+
 DocumentSource::GetNextResult Exchange::ExchangeBuffer::getNext() {
     invariant(!_buffer.empty());
 
@@ -471,6 +504,12 @@ DocumentSource::GetNextResult Exchange::ExchangeBuffer::getNext() {
     return result;
 }
 
+void Exchange::ExchangeBuffer::takeAll(std::deque<DocumentSource::GetNextResult>* out) {
+    std::move(_buffer.begin(), _buffer.end(), std::back_inserter(*out));
+    _buffer.clear();
+    _bytesInBuffer = 0;
+}
+
 bool Exchange::ExchangeBuffer::appendDocument(DocumentSource::GetNextResult input, size_t limit) {
     // If the buffer is disposed then we simply ignore any appends.
     if (_disposed) {
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <deque>
+#include <functional>
 #include <vector>
 
 #include "mongo/bson/ordering.h"
@@ -71,11 +72,21 @@ class Exchange : public RefCountable {
     static std::vector<FieldPath> extractKeyPaths(const BSONObj& keyPattern);
 
 public:
+    /**
+     * Maps a document to the consumer it is delivered to. The result is taken modulo the number of
+     * consumers.
+     */
+    using PartitionFunction = std::function<size_t(const Document&)>;
+
     /**
      * Create an exchange. 'pipeline' represents the input to the exchange operator and must not be
-     * nullptr.
+     * nullptr. If 'partitioner' is provided it decides which consumer receives each document and
+     * the policy of 'spec' must be round robin; this is how a single node hash partitions its
+     * input between parallel workers on a key that cannot be expressed as a key pattern.
      **/
-    Exchange(ExchangeSpec spec, std::unique_ptr<Pipeline, PipelineDeleter> pipeline);
+    Exchange(ExchangeSpec spec,
+             std::unique_ptr<Pipeline, PipelineDeleter> pipeline,
+             PartitionFunction partitioner = nullptr);
 
     /**
      * Interface for retrieving the next document. 'resourceYielder' is optional, and if provided,
@@ -95,6 +106,12 @@ public:
 
     void dispose(OperationContext* opCtx, size_t consumerId);
 
+    /**
+     * Calls 'visitor' with the input pipeline while no consumer is loading from it, for example to
+     * read its execution statistics from a thread other than the consumers.
+     */
+    void visitInputPipeline(const std::function<void(const Pipeline&)>& visitor);
+
     /**
      * Unblocks the loading thread (a producer) if the loading is blocked by a consumer identified
      * by consumerId. Note that there is no such thing as being blocked by multiple consumers. It is
@@ -113,6 +130,10 @@ private:
     public:
         bool appendDocument(DocumentSource::GetNextResult input, size_t limit);
         DocumentSource::GetNextResult getNext();
+        /**
+         * Moves every buffered result to the end of 'out' and empties the buffer.
+         */
+        void takeAll(std::deque<DocumentSource::GetNextResult>* out);
         bool isEmpty() const {
             return _buffer.empty();
         }
@@ -159,6 +180,9 @@ private:
     // A policy that tells how to distribute input documents to consumers.
     const ExchangePolicyEnum _policy;
 
+    // If set, overrides '_policy' to pick the consumer of every input document.
+    const PartitionFunction _partitioner;
+
     // If set to true then a producer sends special 'high watermark' documents to consumers in order
     // to prevent deadlocks.
     const bool _orderPreserving;
@@ -187,6 +211,12 @@ private:
     size_t _disposeRunDown{0};
 
     std::vector<std::unique_ptr<ExchangeBuffer>> _consumers;
+
+    // Results a consumer has already moved out of its buffer. A consumer takes its whole buffer at
+    // once and serves the following getNext() calls from here, so it only contends on '_mutex'
+    // once per batch rather than once per document. Each deque is only accessed by its consumer,
+    // without holding '_mutex'.
+    std::vector<std::deque<DocumentSource::GetNextResult>> _takenResults;
 };
 
 class DocumentSourceExchange final : public DocumentSource {
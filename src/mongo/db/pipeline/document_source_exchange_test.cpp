@@ -32,7 +32,10 @@
 #include "mongo/db/hasher.h"
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/document_source_exchange.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_source_parallel_merge.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/executor/network_interface_factory.h"
 #include "mongo/executor/thread_pool_task_executor.h"
@@ -640,6 +643,118 @@ TEST_F(DocumentSourceExchangeTest, RangeRandomHashExchangeNConsumer) {
     ASSERT_EQ(nDocs, processedDocs.load());
 }
 
+TEST_F(DocumentSourceExchangeTest, ParallelGroupOverPartitionedExchange) {
+    const size_t nDocs = 500;
+    const size_t nGroups = 7;
+    const size_t nWorkers = 4;
+    auto opCtx = getExpCtx()->opCtx;
+
+    auto source = DocumentSourceMock::createForTest();
+    for (size_t i = 0; i < nDocs; ++i) {
+        source->emplace_back(Document{{"a", static_cast<int>(i % nGroups)}});
+    }
+
+    auto groupSpec = BSON("$group" << BSON("_id"
+                                           << "$a"
+                                           << "count" << BSON("$sum" << 1)));
+    auto makeExpCtx = [&] {
+        boost::intrusive_ptr<ExpressionContext> expCtx = new ExpressionContext(opCtx, nullptr);
+        expCtx->mongoProcessInterface = std::make_shared<StubMongoProcessOkWithOpCtxChanges>();
+        return expCtx;
+    };
+
+    // The documents of a group must all reach the same worker.
+    boost::intrusive_ptr<DocumentSourceGroup> partitionGroup =
+        static_cast<DocumentSourceGroup*>(
+            DocumentSourceGroup::createFromBson(groupSpec.firstElement(), getExpCtx()).get());
+    Exchange::PartitionFunction partitioner = [partitionGroup](const Document& doc) {
+        return ValueComparator().hash(partitionGroup->computeId(doc));
+    };
+
+    ExchangeSpec spec;
+    spec.setPolicy(ExchangePolicyEnum::kRoundRobin);
+    spec.setConsumers(nWorkers);
+    spec.setBufferSize(1024);
+    boost::intrusive_ptr<Exchange> ex =
+        new Exchange(spec,
+                     unittest::assertGet(Pipeline::create({source}, getExpCtx())),
+                     std::move(partitioner));
+
+    std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> workers;
+    for (size_t id = 0; id < nWorkers; ++id) {
+        auto workerExpCtx = makeExpCtx();
+        auto worker = unittest::assertGet(Pipeline::create(
+            {new DocumentSourceExchange(workerExpCtx, ex, id, nullptr),
+             DocumentSourceGroup::createFromBson(groupSpec.firstElement(), workerExpCtx)},
+            workerExpCtx));
+        worker->detachFromOperationContext();
+        workers.push_back(std::move(worker));
+    }
+
+    boost::intrusive_ptr<DocumentSourceParallelMerge> merge =
+        new DocumentSourceParallelMerge(makeExpCtx(), std::move(workers), boost::none, 1024);
+
+    std::set<int> groups;
+    size_t docs = 0;
+    for (auto next = merge->getNext(); next.isAdvanced(); next = merge->getNext()) {
+        auto doc = next.releaseDocument();
+        ASSERT_TRUE(groups.insert(doc["_id"].getInt()).second);
+        docs += doc["count"].getInt();
+    }
+    ASSERT_EQ(groups.size(), nGroups);
+    ASSERT_EQ(docs, nDocs);
+
+    merge->dispose();
+}
+
+TEST_F(DocumentSourceExchangeTest, ParallelSortMergesWorkerOutputsInOrder) {
+    const size_t nDocs = 500;
+    const size_t nWorkers = 4;
+    auto opCtx = getExpCtx()->opCtx;
+
+    auto source = getRandomMockSource(nDocs, getNewSeed());
+
+    ExchangeSpec spec;
+    spec.setPolicy(ExchangePolicyEnum::kRoundRobin);
+    spec.setConsumers(nWorkers);
+    spec.setBufferSize(1024);
+    boost::intrusive_ptr<Exchange> ex =
+        new Exchange(spec, unittest::assertGet(Pipeline::create({source}, getExpCtx())));
+
+    auto makeExpCtx = [&] {
+        boost::intrusive_ptr<ExpressionContext> expCtx = new ExpressionContext(opCtx, nullptr);
+        expCtx->mongoProcessInterface = std::make_shared<StubMongoProcessOkWithOpCtxChanges>();
+        return expCtx;
+    };
+
+    std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> workers;
+    for (size_t id = 0; id < nWorkers; ++id) {
+        auto workerExpCtx = makeExpCtx();
+        auto worker = unittest::assertGet(
+            Pipeline::create({new DocumentSourceExchange(workerExpCtx, ex, id, nullptr),
+                              DocumentSourceSort::create(workerExpCtx, BSON("a" << 1))},
+                             workerExpCtx));
+        worker->detachFromOperationContext();
+        workers.push_back(std::move(worker));
+    }
+
+    auto mergeExpCtx = makeExpCtx();
+    boost::intrusive_ptr<DocumentSourceParallelMerge> merge = new DocumentSourceParallelMerge(
+        mergeExpCtx, std::move(workers), SortPattern(BSON("a" << 1), mergeExpCtx), 1024);
+
+    size_t docs = 0;
+    int previous = std::numeric_limits<int>::min();
+    for (auto next = merge->getNext(); next.isAdvanced(); next = merge->getNext()) {
+        auto current = next.getDocument()["a"].getInt();
+        ASSERT_LTE(previous, current);
+        previous = current;
+        ++docs;
+    }
+    ASSERT_EQ(docs, nDocs);
+
+    merge->dispose();
+}
+
 TEST_F(DocumentSourceExchangeTest, RejectNoConsumers) {
     BSONObj spec = BSON("policy"
                         << "broadcast"
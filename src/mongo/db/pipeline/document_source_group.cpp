@@ -402,9 +402,17 @@ void DocumentSourceGroup::setIdExpression(const boost::intrusive_ptr<Expression>
 
 intrusive_ptr<DocumentSource> DocumentSourceGroup::createFromBson(
     BSONElement elem, const intrusive_ptr<ExpressionContext>& pExpCtx) {
+    return createFromBsonWithMaxMemoryUsage(elem, pExpCtx, boost::none);
+}
+
+intrusive_ptr<DocumentSource> DocumentSourceGroup::createFromBsonWithMaxMemoryUsage(
+    BSONElement elem,
+    const intrusive_ptr<ExpressionContext>& pExpCtx,
+    boost::optional<size_t> maxMemoryUsageBytes) {
     uassert(15947, "a group's fields must be specified in an object", elem.type() == Object);
 
-    intrusive_ptr<DocumentSourceGroup> pGroup(new DocumentSourceGroup(pExpCtx));
+    intrusive_ptr<DocumentSourceGroup> pGroup(
+        new DocumentSourceGroup(pExpCtx, maxMemoryUsageBytes));
 
     BSONObj groupObj(elem.Obj());
     BSONObjIterator groupIterator(groupObj);
@@ -118,6 +118,15 @@ public:
     static boost::intrusive_ptr<DocumentSource> createFromBson(
         BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
 
+    /**
+     * Like createFromBson(), but the $group spills to disk, or fails, once it uses more than
+     * 'maxMemoryUsageBytes' instead of internalDocumentSourceGroupMaxMemoryBytes.
+     */
+    static boost::intrusive_ptr<DocumentSource> createFromBsonWithMaxMemoryUsage(
+        BSONElement elem,
+        const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
+        boost::optional<size_t> maxMemoryUsageBytes);
+
     StageConstraints constraints(Pipeline::SplitState pipeState) const final {
         StageConstraints constraints(StreamType::kBlocking,
                                      PositionRequirement::kNone,
@@ -176,6 +185,12 @@ public:
     std::unique_ptr<GroupFromFirstDocumentTransformation> rewriteGroupAsTransformOnFirstDocument()
         const;
 
+    /**
+     * Computes the internal representation of the group key. Documents with equal keys under the
+     * ExpressionContext's value comparator belong to the same group.
+     */
+    Value computeId(const Document& root);
+
 protected:
     GetNextResult doGetNext() final;
     void doDispose() final;
@@ -215,11 +230,6 @@ private:
 
     Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
 
-    /**
-     * Computes the internal representation of the group key.
-     */
-    Value computeId(const Document& root);
-
     /**
      * Converts the internal representation of the group key to the _id shape specified by the
      * user.
@@ -51,6 +51,22 @@ Value assertFieldHasType(const Document& fullDoc, StringData fieldName, BSONType
 }
 }  // namespace
 
+DocumentSourceLookupChangePostImage::DocumentSourceLookupChangePostImage(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx)
+    : DocumentSource(kStageName, expCtx) {
+    // Post-images are only cached on the nodes which perform the writes.
+    if (!expCtx->inMongos && expCtx->opCtx) {
+        _postImageCache = ChangeStreamPostImageCache::get(expCtx->opCtx->getServiceContext());
+        _postImageCache->addConsumer();
+    }
+}
+
+DocumentSourceLookupChangePostImage::~DocumentSourceLookupChangePostImage() {
+    if (_postImageCache) {
+        _postImageCache->removeConsumer();
+    }
+}
+
 DocumentSource::GetNextResult DocumentSourceLookupChangePostImage::doGetNext() {
     auto input = pSource->getNext();
     if (!input.isAdvanced()) {
@@ -112,6 +128,18 @@ Value DocumentSourceLookupChangePostImage::lookupPostImage(const Document& updat
     // reads.
     const auto allowSpeculativeMajorityRead = pExpCtx->inMongos;
     invariant(resumeToken.getData().uuid);
+
+    // The cached post-image is the one produced by this very update, rather than the current
+    // version of the document.
+    if (_postImageCache) {
+        auto postImage =
+            _postImageCache->find(*resumeToken.getData().uuid, resumeToken.getData().clusterTime);
+        if (postImage &&
+            ValueComparator().evaluate(Value((*postImage)["_id"]) == documentKey["_id"])) {
+            return Value(*postImage);
+        }
+    }
+
     auto lookedUpDoc =
         pExpCtx->mongoProcessInterface->lookupSingleDocument(pExpCtx,
                                                              nss,
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/pipeline/change_stream_post_image_cache.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 
@@ -104,9 +105,10 @@ public:
         return kStageName.rawData();
     }
 
+    ~DocumentSourceLookupChangePostImage();
+
 private:
-    DocumentSourceLookupChangePostImage(const boost::intrusive_ptr<ExpressionContext>& expCtx)
-        : DocumentSource(kStageName, expCtx) {}
+    DocumentSourceLookupChangePostImage(const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
     /**
      * Performs the lookup to retrieve the full document.
@@ -114,11 +116,15 @@ private:
     GetNextResult doGetNext() final;
 
     /**
-     * Uses the "documentKey" field from 'updateOp' to look up the current version of the document.
+     * Returns the post-image produced by 'updateOp' if this node cached it. Otherwise, uses the
+     * "documentKey" field from 'updateOp' to look up the current version of the document.
      * Returns Value(BSONNULL) if the document couldn't be found.
      */
     Value lookupPostImage(const Document& updateOp) const;
 
+    // The cache of post-images written on this node, or null when running on mongoS.
+    ChangeStreamPostImageCache* _postImageCache = nullptr;
+
     /**
      * Throws a AssertionException if the namespace found in 'inputDoc' doesn't match the one on the
      * ExpressionContext. If the namespace on the ExpressionContext is 'collectionless', then this
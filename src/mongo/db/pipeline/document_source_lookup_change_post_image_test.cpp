@@ -40,11 +40,13 @@
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/change_stream_post_image_cache.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 #include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/stub_mongo_process_interface_lookup_single_document.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 namespace {
@@ -324,5 +326,48 @@ TEST_F(DocumentSourceLookupChangePostImageTest, ShouldPropagatePauses) {
     ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceLookupChangePostImageTest, ShouldReturnCachedPostImageOfTheUpdate) {
+    auto expCtx = getExpCtx();
+    const auto savedCacheSize = internalChangeStreamPostImageCacheSizeBytes.load();
+    internalChangeStreamPostImageCacheSizeBytes.store(1024 * 1024);
+    ON_BLOCK_EXIT([&] { internalChangeStreamPostImageCacheSizeBytes.store(savedCacheSize); });
+
+    auto lookupChangeStage = DocumentSourceLookupChangePostImage::create(expCtx);
+    auto cache = ChangeStreamPostImageCache::get(expCtx->opCtx->getServiceContext());
+    ASSERT_TRUE(cache->isActive());
+    cache->insert(testUuid(), Timestamp(100, 1), BSON("_id" << 0 << "version" << 1));
+
+    // The second event has the same timestamp but a different document key, so the cached
+    // post-image cannot be its own.
+    auto mockLocalSource = DocumentSourceMock::createForTest(
+        {Document{{"_id", makeResumeToken(0)},
+                  {"documentKey", Document{{"_id", 0}}},
+                  {"operationType", "update"_sd},
+                  {"ns", Document{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}}}},
+         Document{{"_id", makeResumeToken(1)},
+                  {"documentKey", Document{{"_id", 1}}},
+                  {"operationType", "update"_sd},
+                  {"ns", Document{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}}}}});
+    lookupChangeStage->setSource(mockLocalSource.get());
+
+    // The collection holds newer versions of the documents.
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document{{"_id", 0}, {"version", 2}}, Document{{"_id", 1}, {"version", 2}}};
+    getExpCtx()->mongoProcessInterface =
+        std::make_unique<MockMongoInterface>(std::move(mockForeignContents));
+
+    auto next = lookupChangeStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_VALUE_EQ(next.releaseDocument()["fullDocument"],
+                    Value(Document{{"_id", 0}, {"version", 1}}));
+
+    next = lookupChangeStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_VALUE_EQ(next.releaseDocument()["fullDocument"],
+                    Value(Document{{"_id", 1}, {"version", 2}}));
+
+    ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,371 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_parallel_merge.h"
+
+#include <algorithm>
+
+#include "mongo/db/client.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Process-wide pool of threads on which the workers of parallel aggregations run. The pool is only
+ * started the first time it is needed. Every worker occupies its thread until its aggregation is
+ * disposed of, so aggregations reserve their threads before they start any worker.
+ */
+class ParallelMergeWorkerPool {
+public:
+    bool tryReserve(size_t numWorkers) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        const auto maxThreads = static_cast<size_t>(internalQueryAggParallelMaxWorkerThreads.load());
+        if (_numReserved + numWorkers > maxThreads) {
+            return false;
+        }
+        _numReserved += numWorkers;
+        return true;
+    }
+
+    void release(size_t numWorkers) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        invariant(_numReserved >= numWorkers);
+        _numReserved -= numWorkers;
+    }
+
+    ThreadPool* get() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!_pool) {
+            ThreadPool::Options options;
+            options.poolName = "ParallelAggWorkerPool";
+            options.threadNamePrefix = "parallelAggWorker-";
+            options.minThreads = 0;
+            options.maxThreads = internalQueryAggParallelMaxWorkerThreads.load();
+            _pool = std::make_unique<ThreadPool>(options);
+            _pool->startup();
+        }
+        return _pool.get();
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("ParallelMergeWorkerPool::_mutex");
+    size_t _numReserved = 0;
+    std::unique_ptr<ThreadPool> _pool;
+};
+
+const auto getParallelMergeWorkerPool =
+    ServiceContext::declareDecoration<ParallelMergeWorkerPool>();
+
+}  // namespace
+
+DocumentSourceParallelMerge::WorkerReservation::~WorkerReservation() {
+    getParallelMergeWorkerPool(_serviceContext).release(_numWorkers);
+}
+
+std::unique_ptr<DocumentSourceParallelMerge::WorkerReservation>
+DocumentSourceParallelMerge::reserveWorkers(ServiceContext* serviceContext, size_t numWorkers) {
+    if (!getParallelMergeWorkerPool(serviceContext).tryReserve(numWorkers)) {
+        return nullptr;
+    }
+    return std::unique_ptr<WorkerReservation>(new WorkerReservation(serviceContext, numWorkers));
+}
+
+DocumentSourceParallelMerge::DocumentSourceParallelMerge(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> workers,
+    boost::intrusive_ptr<Exchange> exchange,
+    std::unique_ptr<WorkerReservation> reservation,
+    boost::optional<SortPattern> mergeSort,
+    size_t maxBufferSizeBytes)
+    : DocumentSource(kStageName, expCtx),
+      _exchange(std::move(exchange)),
+      _reservation(std::move(reservation)),
+      _mergeSort(std::move(mergeSort)),
+      _sortKeyComparator(_mergeSort ? boost::make_optional(SortKeyComparator(*_mergeSort))
+                                    : boost::none),
+      _maxBufferSizeBytes(maxBufferSizeBytes) {
+    invariant(!workers.empty());
+    invariant(_exchange);
+    invariant(_reservation && _reservation->_numWorkers == workers.size());
+    for (auto&& pipeline : workers) {
+        auto worker = std::make_unique<Worker>();
+        // The worker pipelines are disposed of explicitly, on whichever thread ran them.
+        pipeline.get_deleter().dismissDisposal();
+        worker->pipeline = std::move(pipeline);
+        if (_mergeSort) {
+            worker->sortKeyGen.emplace(*_mergeSort, nullptr);
+        }
+        _workers.push_back(std::move(worker));
+    }
+}
+
+DocumentSourceParallelMerge::~DocumentSourceParallelMerge() {
+    stopWorkers();
+}
+
+const char* DocumentSourceParallelMerge::getSourceName() const {
+    return kStageName.rawData();
+}
+
+Value DocumentSourceParallelMerge::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    MutableDocument spec;
+    spec["workers"] = Value(static_cast<long long>(_workers.size()));
+    if (_mergeSort) {
+        spec["sortBy"] = Value(
+            _mergeSort->serialize(SortPattern::SortKeySerialization::kForPipelineSerialization));
+    }
+    return Value(DOC(getSourceName() << spec.freeze()));
+}
+
+void DocumentSourceParallelMerge::startWorkers() {
+    invariant(!_started);
+    _started = true;
+
+    auto serviceContext = pExpCtx->opCtx->getServiceContext();
+    auto pool = getParallelMergeWorkerPool(serviceContext).get();
+    for (size_t workerId = 0; workerId < _workers.size(); ++workerId) {
+        pool->schedule([this, serviceContext, workerId](Status status) {
+            if (!status.isOK()) {
+                // The pool is shutting down and runs the task inline, on the thread of this stage.
+                _workers[workerId]->pipeline->dispose(pExpCtx->opCtx);
+                stdx::lock_guard<Latch> lk(_mutex);
+                finishWorker(lk, workerId, status);
+                return;
+            }
+            runWorker(serviceContext, workerId);
+        });
+    }
+}
+
+void DocumentSourceParallelMerge::runWorker(ServiceContext* serviceContext, size_t workerId) {
+    auto& worker = *_workers[workerId];
+    ThreadClient tc(str::stream() << "parallelAggWorker-" << workerId, serviceContext);
+    auto opCtx = cc().makeOperationContext();
+    {
+        stdx::lock_guard<Latch> lk(_opCtxMutex);
+        worker.opCtx = opCtx.get();
+    }
+
+    Status status = Status::OK();
+    bool recordedUsedDisk = false;
+    try {
+        worker.pipeline->reattachToOperationContext(opCtx.get());
+
+        auto& source = *worker.pipeline->getSources().back();
+        for (auto next = source.getNext(); !next.isEOF(); next = source.getNext()) {
+            if (!next.isAdvanced()) {
+                continue;
+            }
+
+            BufferedResult result;
+            result.document = next.releaseDocument();
+            result.size = result.document.getApproximateSize();
+            if (worker.sortKeyGen) {
+                result.sortKey = worker.sortKeyGen->computeSortKeyFromDocument(result.document);
+            }
+
+            stdx::unique_lock<Latch> lk(_mutex);
+            opCtx->waitForConditionOrInterrupt(_haveBufferSpace, lk, [&] {
+                return _stopping || worker.bytesInBuffer < _maxBufferSizeBytes;
+            });
+            if (_stopping) {
+                break;
+            }
+            // The blocking stage has consumed all of its input by the time it returns its first
+            // result, so whether it spilled to disk is known from then on.
+            if (!recordedUsedDisk) {
+                worker.usedDisk = worker.pipeline->usedDisk();
+                recordedUsedDisk = true;
+            }
+            worker.bytesInBuffer += result.size;
+            worker.buffer.push_back(std::move(result));
+            _haveResults.notify_all();
+        }
+    } catch (...) {
+        status = exceptionToStatus();
+    }
+
+    const bool usedDisk = worker.pipeline->usedDisk();
+    worker.pipeline->dispose(opCtx.get());
+
+    {
+        stdx::lock_guard<Latch> lk(_opCtxMutex);
+        worker.opCtx = nullptr;
+    }
+
+    // Once the worker is marked as done this stage may be destroyed, so it is the last access to
+    // any of its state.
+    stdx::lock_guard<Latch> lk(_mutex);
+    worker.usedDisk = usedDisk;
+    finishWorker(lk, workerId, std::move(status));
+}
+
+void DocumentSourceParallelMerge::finishWorker(WithLock, size_t workerId, Status status) {
+    _workers[workerId]->done = true;
+    // A failure of one consumer of an Exchange makes all of the others fail with
+    // ExchangePassthrough; report the original error.
+    if (!status.isOK() &&
+        (_workerError.isOK() || _workerError.code() == ErrorCodes::ExchangePassthrough)) {
+        _workerError = std::move(status);
+    }
+    _haveResults.notify_all();
+}
+
+void DocumentSourceParallelMerge::stopWorkers() {
+    if (!_started) {
+        return;
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _stopping = true;
+        _haveBufferSpace.notify_all();
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(_opCtxMutex);
+        for (auto&& worker : _workers) {
+            if (worker->opCtx) {
+                stdx::lock_guard<Client> clientLock(*worker->opCtx->getClient());
+                worker->opCtx->getServiceContext()->killOperation(
+                    clientLock, worker->opCtx, ErrorCodes::Interrupted);
+            }
+        }
+    }
+
+    // The workers refer to this stage, so we must wait for all of them even if our own operation
+    // is interrupted.
+    stdx::unique_lock<Latch> lk(_mutex);
+    _haveResults.wait(lk, [&] {
+        return std::all_of(_workers.begin(), _workers.end(), [](const auto& worker) {
+            return worker->done;
+        });
+    });
+}
+
+bool DocumentSourceParallelMerge::usedDisk() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return std::any_of(_workers.begin(), _workers.end(), [](const auto& worker) {
+        return worker->usedDisk;
+    });
+}
+
+void DocumentSourceParallelMerge::doDispose() {
+    if (_started) {
+        stopWorkers();
+        return;
+    }
+
+    // The workers never ran, so their pipelines are disposed of here.
+    _stopping = true;
+    for (auto&& worker : _workers) {
+        worker->pipeline->dispose(pExpCtx->opCtx);
+    }
+}
+
+bool DocumentSourceParallelMerge::canProduceNext(WithLock) const {
+    if (_mergeSort) {
+        // The smallest result is only known once every running worker has produced one.
+        return std::all_of(_workers.begin(), _workers.end(), [](const auto& worker) {
+            return worker->done || !worker->buffer.empty();
+        });
+    }
+    return std::any_of(_workers.begin(), _workers.end(), [](const auto& worker) {
+        return !worker->buffer.empty();
+    }) || std::all_of(_workers.begin(), _workers.end(), [](const auto& worker) {
+        return worker->done;
+    });
+}
+
+boost::optional<size_t> DocumentSourceParallelMerge::pickNextWorker(WithLock) {
+    boost::optional<size_t> next;
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        size_t workerId = (_nextWorker + i) % _workers.size();
+        const auto& buffer = _workers[workerId]->buffer;
+        if (buffer.empty()) {
+            continue;
+        }
+        if (!_mergeSort) {
+            next = workerId;
+            break;
+        }
+        if (!next ||
+            (*_sortKeyComparator)(buffer.front().sortKey,
+                                  _workers[*next]->buffer.front().sortKey) < 0) {
+            next = workerId;
+        }
+    }
+
+    if (next && !_mergeSort) {
+        _nextWorker = (*next + 1) % _workers.size();
+    }
+    return next;
+}
+
+DocumentSource::GetNextResult DocumentSourceParallelMerge::doGetNext() {
+    if (!_started) {
+        startWorkers();
+    }
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    pExpCtx->opCtx->waitForConditionOrInterrupt(_haveResults, lk, [&] {
+        if (_workerError.isOK()) {
+            return canProduceNext(lk);
+        }
+        // Wait for the worker that hit the original error to report it.
+        return _workerError.code() != ErrorCodes::ExchangePassthrough ||
+            std::all_of(_workers.begin(), _workers.end(), [](const auto& worker) {
+                   return worker->done;
+               });
+    });
+    uassertStatusOK(_workerError);
+
+    auto workerId = pickNextWorker(lk);
+    if (!workerId) {
+        return GetNextResult::makeEOF();
+    }
+
+    auto& worker = *_workers[*workerId];
+    auto result = std::move(worker.buffer.front());
+    worker.buffer.pop_front();
+    worker.bytesInBuffer -= result.size;
+    _haveBufferSpace.notify_all();
+
+    return std::move(result.document);
+}
+
+}  // namespace mongo
@@ -0,0 +1,221 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/exec/sort_key_comparator.h"
+#include "mongo/db/index/sort_key_generator.h"
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_exchange.h"
+#include "mongo/db/query/sort_pattern.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+
+namespace mongo {
+
+/**
+ * Runs a set of worker pipelines on threads of a process-wide pool and merges their output. This is
+ * the last step of intra-node parallel execution: the workers read from the consumers of a shared
+ * Exchange, each running a copy of the same blocking stage ($group or $sort) over its share of the
+ * input.
+ *
+ * If 'mergeSort' is provided, every worker must produce its results in that order and this stage
+ * preserves it by merging the worker streams. Otherwise results are returned in the order they
+ * arrive from the workers.
+ *
+ * The workers are started on the first call to getNext() and keep running between getMores, each
+ * buffering up to 'maxBufferSizeBytes' of results. Disposing of this stage interrupts the workers
+ * and waits for them to finish.
+ */
+class DocumentSourceParallelMerge final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalParallelMerge"_sd;
+
+    /**
+     * Threads of the worker pool set aside for the workers of one aggregation. A worker keeps its
+     * thread until the aggregation is disposed of, so reserving them up front guarantees that every
+     * worker gets to run. The threads are given back on destruction.
+     */
+    class WorkerReservation {
+    public:
+        ~WorkerReservation();
+
+        WorkerReservation(const WorkerReservation&) = delete;
+        WorkerReservation& operator=(const WorkerReservation&) = delete;
+
+    private:
+        friend class DocumentSourceParallelMerge;
+
+        WorkerReservation(ServiceContext* serviceContext, size_t numWorkers)
+            : _serviceContext(serviceContext), _numWorkers(numWorkers) {}
+
+        ServiceContext* const _serviceContext;
+        const size_t _numWorkers;
+    };
+
+    /**
+     * Reserves 'numWorkers' threads of the pool, which has internalQueryAggParallelMaxWorkerThreads
+     * threads in total. Returns nullptr if that many are not available, in which case the
+     * aggregation should run serially.
+     */
+    static std::unique_ptr<WorkerReservation> reserveWorkers(ServiceContext* serviceContext,
+                                                             size_t numWorkers);
+
+    /**
+     * 'exchange' is the Exchange the workers read from, which is where the plan summary of the
+     * aggregation is found. 'reservation' must cover every worker.
+     */
+    DocumentSourceParallelMerge(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> workers,
+                                boost::intrusive_ptr<Exchange> exchange,
+                                std::unique_ptr<WorkerReservation> reservation,
+                                boost::optional<SortPattern> mergeSort,
+                                size_t maxBufferSizeBytes);
+
+    ~DocumentSourceParallelMerge();
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        return {StreamType::kStreaming,
+                PositionRequirement::kFirst,
+                HostTypeRequirement::kNone,
+                DiskUseRequirement::kNoDiskUse,
+                FacetRequirement::kNotAllowed,
+                TransactionRequirement::kNotAllowed,
+                LookupRequirement::kNotAllowed};
+    }
+
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        return boost::none;
+    }
+
+    const char* getSourceName() const final;
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    /**
+     * The input of this stage comes from the worker pipelines.
+     */
+    void setSource(DocumentSource* source) final {
+        invariant(!source);
+    }
+
+    size_t getWorkers() const {
+        return _workers.size();
+    }
+
+    const boost::intrusive_ptr<Exchange>& getExchange() const {
+        return _exchange;
+    }
+
+    /**
+     * True if the workers each run a $sort.
+     */
+    bool isMergingSortedStreams() const {
+        return static_cast<bool>(_mergeSort);
+    }
+
+    /**
+     * True if the blocking stage of any worker spilled to disk.
+     */
+    bool usedDisk() final;
+
+private:
+    struct BufferedResult {
+        Value sortKey;  // Only set when merging sorted streams.
+        Document document;
+        size_t size;
+    };
+
+    struct Worker {
+        std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
+        boost::optional<SortKeyGenerator> sortKeyGen;
+
+        // Protected by '_mutex'.
+        std::deque<BufferedResult> buffer;
+        size_t bytesInBuffer = 0;
+        bool usedDisk = false;
+        bool done = false;
+
+        // Protected by '_opCtxMutex'. Set while the worker thread has an OperationContext.
+        OperationContext* opCtx = nullptr;
+    };
+
+    GetNextResult doGetNext() final;
+    void doDispose() final;
+
+    void startWorkers();
+    void runWorker(ServiceContext* serviceContext, size_t workerId);
+
+    /**
+     * Records that the worker 'workerId' exited with 'status' and wakes up whoever waits for it.
+     */
+    void finishWorker(WithLock, size_t workerId, Status status);
+
+    /**
+     * Interrupts the workers and waits for all of them to finish.
+     */
+    void stopWorkers();
+
+    /**
+     * Returns true if the next result can be chosen without waiting for more worker output.
+     */
+    bool canProduceNext(WithLock) const;
+
+    /**
+     * Returns the worker whose buffer holds the next result, or boost::none if every worker is
+     * exhausted.
+     */
+    boost::optional<size_t> pickNextWorker(WithLock);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    const boost::intrusive_ptr<Exchange> _exchange;
+    const std::unique_ptr<WorkerReservation> _reservation;
+    const boost::optional<SortPattern> _mergeSort;
+    const boost::optional<SortKeyComparator> _sortKeyComparator;
+    const size_t _maxBufferSizeBytes;
+
+    bool _started = false;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("DocumentSourceParallelMerge::_mutex");
+    stdx::condition_variable _haveResults;  // Also signalled when a worker finishes.
+    stdx::condition_variable _haveBufferSpace;
+    bool _stopping = false;
+    Status _workerError = Status::OK();
+    size_t _nextWorker = 0;  // Where the unsorted merge resumes its round robin.
+
+    // Guards the 'opCtx' of every worker. Never acquired while holding '_mutex', because
+    // interrupting a worker's OperationContext acquires the mutex the worker is waiting with.
+    Mutex _opCtxMutex = MONGO_MAKE_LATCH("DocumentSourceParallelMerge::_opCtxMutex");
+};
+
+}  // namespace mongo
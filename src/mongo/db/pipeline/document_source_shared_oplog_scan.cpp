@@ -0,0 +1,130 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_shared_oplog_scan.h"
+
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/pipeline/document_source_change_stream.h"
+#include "mongo/db/pipeline/resume_token.h"
+#include "mongo/db/query/find_common.h"
+
+namespace mongo {
+
+boost::intrusive_ptr<DocumentSourceSharedOplogScan> DocumentSourceSharedOplogScan::create(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, const BSONObj& filter) {
+    return new DocumentSourceSharedOplogScan(expCtx, filter);
+}
+
+DocumentSourceSharedOplogScan::DocumentSourceSharedOplogScan(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, const BSONObj& filter)
+    : DocumentSource(kStageName, expCtx),
+      _filter(filter.getOwned()),
+      _matcher(uassertStatusOK(MatchExpressionParser::parse(
+          _filter, expCtx, ExtensionsCallbackNoop(), Pipeline::kAllowedMatcherFeatures))),
+      _startFrom(ResumeToken::parse(expCtx->initialPostBatchResumeToken).getData().clusterTime) {
+}
+
+const char* DocumentSourceSharedOplogScan::getSourceName() const {
+    return kStageName.rawData();
+}
+
+StageConstraints DocumentSourceSharedOplogScan::constraints(Pipeline::SplitState pipeState) const {
+    StageConstraints constraints(StreamType::kStreaming,
+                                 PositionRequirement::kFirst,
+                                 HostTypeRequirement::kAnyShard,
+                                 DiskUseRequirement::kNoDiskUse,
+                                 FacetRequirement::kNotAllowed,
+                                 TransactionRequirement::kNotAllowed,
+                                 LookupRequirement::kNotAllowed,
+                                 ChangeStreamRequirement::kChangeStreamStage);
+    constraints.requiresInputDocSource = false;
+    constraints.isIndependentOfAnyCollection = pExpCtx->ns.isCollectionlessAggregateNS();
+    return constraints;
+}
+
+Value DocumentSourceSharedOplogScan::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    // Like the DocumentSourceOplogMatch it replaces, this stage is an alias of $changeStream.
+    if (explain) {
+        return Value(Document{{kStageName, Document{{"filter", _filter}}}});
+    }
+    return Value();
+}
+
+Timestamp DocumentSourceSharedOplogScan::getLatestOplogTimestamp() const {
+    return _watcher ? _watcher->getLatestOplogTimestamp() : Timestamp();
+}
+
+std::vector<BSONObj> DocumentSourceSharedOplogScan::_scanOplog(Timestamp after,
+                                                               size_t limit) const {
+    std::vector<BSONObj> entries;
+    DBDirectClient client(pExpCtx->opCtx);
+    auto cursor = client.query(NamespaceString::kRsOplogNamespace,
+                               QUERY("ts" << GT << after),
+                               static_cast<int>(limit));
+    uassert(ErrorCodes::OperationFailed, "Could not read the oplog", cursor);
+    while (cursor->more()) {
+        entries.push_back(cursor->nextSafe().getOwned());
+    }
+    return entries;
+}
+
+DocumentSource::GetNextResult DocumentSourceSharedOplogScan::doGetNext() {
+    auto opCtx = pExpCtx->opCtx;
+    if (!_watcher) {
+        _watcher = ChangeStreamOplogReader::get(opCtx->getServiceContext())
+                       ->registerWatcher(pExpCtx->ns, _startFrom);
+    }
+
+    // Like the tailable oplog cursor it replaces, wait for new entries only when the getMore
+    // asks to.
+    const auto& awaitData = awaitDataState(opCtx);
+    const auto deadline =
+        awaitData.shouldWaitForInserts ? awaitData.waitForInsertsDeadline : Date_t::min();
+
+    const ChangeStreamOplogReader::ScanFunction scan = [this](Timestamp after, size_t limit) {
+        return _scanOplog(after, limit);
+    };
+    while (auto entry = _watcher->next(opCtx, scan, deadline)) {
+        if (_matcher->matchesBSON(*entry)) {
+            return Document(*entry);
+        }
+    }
+    return GetNextResult::makeEOF();
+}
+
+void DocumentSourceSharedOplogScan::doDispose() {
+    _watcher.reset();
+}
+
+}  // namespace mongo
@@ -0,0 +1,95 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/pipeline/change_stream_oplog_reader.h"
+#include "mongo/db/pipeline/document_source.h"
+
+namespace mongo {
+
+/**
+ * Replaces the $cursor over the oplog at the front of a change stream pipeline when the change
+ * streams on this node share their oplog scan. Draws the oplog entries from a watcher of the
+ * node's ChangeStreamOplogReader and returns the ones which match the change stream's oplog
+ * filter.
+ */
+class DocumentSourceSharedOplogScan final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalSharedOplogScan"_sd;
+
+    /**
+     * Creates a stage returning the oplog entries which match 'filter', the filter of the
+     * change stream's DocumentSourceOplogMatch. The filter is parsed with the simple collation.
+     */
+    static boost::intrusive_ptr<DocumentSourceSharedOplogScan> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx, const BSONObj& filter);
+
+    const char* getSourceName() const final;
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final;
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        return boost::none;
+    }
+
+    /**
+     * Returns the timestamp through which every oplog entry has been examined, for the
+     * high-water mark of the change stream.
+     */
+    Timestamp getLatestOplogTimestamp() const;
+
+private:
+    DocumentSourceSharedOplogScan(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                  const BSONObj& filter);
+
+    GetNextResult doGetNext() final;
+
+    void doDispose() final;
+
+    // Reads up to 'limit' oplog entries following 'after' on behalf of the shared reader.
+    std::vector<BSONObj> _scanOplog(Timestamp after, size_t limit) const;
+
+    const BSONObj _filter;
+    std::unique_ptr<MatchExpression> _matcher;
+
+    // The stream needs the oplog entries from this timestamp onwards.
+    const Timestamp _startFrom;
+
+    // Registered on the first call to getNext().
+    std::unique_ptr<ChangeStreamOplogReader::Watcher> _watcher;
+};
+
+}  // namespace mongo
@@ -266,7 +266,12 @@ const char* ExpressionAbs::getOpName() const {
 
 /* ------------------------- ExpressionAdd ----------------------------- */
 
-Value ExpressionAdd::evaluate(const Document& root, Variables* variables) const {
+namespace {
+/**
+ * Sums the 'n' values produced in order by 'valueAt', stopping at the first nullish one.
+ */
+template <typename ValueAt>
+Value addValues(size_t n, const ValueAt& valueAt) {
     // We'll try to return the narrowest possible result value while avoiding overflow, loss
     // of precision due to intermediate rounding or implicit use of decimal types. To do that,
     // compute a compensated sum for non-decimal values and a separate decimal sum for decimal
@@ -276,9 +281,8 @@ Value ExpressionAdd::evaluate(const Document& root, Variables* variables) const
     BSONType totalType = NumberInt;
     bool haveDate = false;
 
-    const size_t n = _children.size();
     for (size_t i = 0; i < n; ++i) {
-        Value val = _children[i]->evaluate(root, variables);
+        Value val = valueAt(i);
 
         switch (val.getType()) {
             case NumberDecimal:
@@ -340,6 +344,16 @@ Value ExpressionAdd::evaluate(const Document& root, Variables* variables) const
             massert(16417, "$add resulted in a non-numeric type", false);
     }
 }
+}  // namespace
+
+Value ExpressionAdd::evaluate(const Document& root, Variables* variables) const {
+    return addValues(_children.size(),
+                     [&](size_t i) { return _children[i]->evaluate(root, variables); });
+}
+
+Value ExpressionAdd::apply(const std::vector<Value>& values) {
+    return addValues(values.size(), [&](size_t i) { return values[i]; });
+}
 
 REGISTER_EXPRESSION(add, ExpressionAdd::parse);
 const char* ExpressionAdd::getOpName() const {
@@ -814,8 +828,11 @@ Value ExpressionCompare::evaluate(const Document& root, Variables* variables) co
     Value pLeft(_children[0]->evaluate(root, variables));
     Value pRight(_children[1]->evaluate(root, variables));
 
-    int cmp = getExpressionContext()->getValueComparator().compare(pLeft, pRight);
+    return resultFor(cmpOp,
+                     getExpressionContext()->getValueComparator().compare(pLeft, pRight));
+}
 
+Value ExpressionCompare::resultFor(CmpOp cmpOp, int cmp) {
     // Make cmp one of 1, 0, or -1.
     if (cmp == 0) {
         // leave as 0
@@ -1833,7 +1850,10 @@ void ExpressionDateToString::_doAddDependencies(DepsTracker* deps) const {
 Value ExpressionDivide::evaluate(const Document& root, Variables* variables) const {
     Value lhs = _children[0]->evaluate(root, variables);
     Value rhs = _children[1]->evaluate(root, variables);
+    return apply(lhs, rhs);
+}
 
+Value ExpressionDivide::apply(const Value& lhs, const Value& rhs) {
     auto assertNonZero = [](bool nonZero) { uassert(16608, "can't $divide by zero", nonZero); };
 
     if (lhs.numeric() && rhs.numeric()) {
@@ -2722,7 +2742,12 @@ const char* ExpressionMod::getOpName() const {
 
 /* ------------------------- ExpressionMultiply ----------------------------- */
 
-Value ExpressionMultiply::evaluate(const Document& root, Variables* variables) const {
+namespace {
+/**
+ * Multiplies the 'n' values produced in order by 'valueAt', stopping at the first nullish one.
+ */
+template <typename ValueAt>
+Value multiplyValues(size_t n, const ValueAt& valueAt) {
     /*
       We'll try to return the narrowest possible result value.  To do that
       without creating intermediate Values, do the arithmetic for double
@@ -2735,9 +2760,8 @@ Value ExpressionMultiply::evaluate(const Document& root, Variables* variables) c
 
     BSONType productType = NumberInt;
 
-    const size_t n = _children.size();
     for (size_t i = 0; i < n; ++i) {
-        Value val = _children[i]->evaluate(root, variables);
+        Value val = valueAt(i);
 
         if (val.numeric()) {
             BSONType oldProductType = productType;
@@ -2780,6 +2804,16 @@ Value ExpressionMultiply::evaluate(const Document& root, Variables* variables) c
     else
         massert(16418, "$multiply resulted in a non-numeric type", false);
 }
+}  // namespace
+
+Value ExpressionMultiply::evaluate(const Document& root, Variables* variables) const {
+    return multiplyValues(_children.size(),
+                          [&](size_t i) { return _children[i]->evaluate(root, variables); });
+}
+
+Value ExpressionMultiply::apply(const std::vector<Value>& values) {
+    return multiplyValues(values.size(), [&](size_t i) { return values[i]; });
+}
 
 REGISTER_EXPRESSION(multiply, ExpressionMultiply::parse);
 const char* ExpressionMultiply::getOpName() const {
@@ -4467,7 +4501,10 @@ const char* ExpressionStrLenCP::getOpName() const {
 Value ExpressionSubtract::evaluate(const Document& root, Variables* variables) const {
     Value lhs = _children[0]->evaluate(root, variables);
     Value rhs = _children[1]->evaluate(root, variables);
+    return apply(lhs, rhs);
+}
 
+Value ExpressionSubtract::apply(const Value& lhs, const Value& rhs) {
     BSONType diffType = Value::getWidestNumeric(rhs.getType(), lhs.getType());
 
     if (diffType == NumberDecimal) {
@@ -757,6 +757,11 @@ public:
     Value evaluate(const Document& root, Variables* variables) const final;
     const char* getOpName() const final;
 
+    /**
+     * Returns the sum of 'values' as evaluate() computes the sum of its operands.
+     */
+    static Value apply(const std::vector<Value>& values);
+
     bool isAssociative() const final {
         return true;
     }
@@ -955,6 +960,11 @@ public:
         return cmpOp;
     }
 
+    /**
+     * Returns the result of 'cmpOp' given the three-way comparison 'cmp' of its operands.
+     */
+    static Value resultFor(CmpOp cmpOp, int cmp);
+
     static boost::intrusive_ptr<Expression> parse(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         BSONElement bsonExpr,
@@ -1274,6 +1284,11 @@ public:
     Value evaluate(const Document& root, Variables* variables) const final;
     const char* getOpName() const final;
 
+    /**
+     * Returns 'lhs' / 'rhs' as evaluate() computes the quotient of its operands.
+     */
+    static Value apply(const Value& lhs, const Value& rhs);
+
     void acceptVisitor(ExpressionVisitor* visitor) final {
         return visitor->visit(this);
     }
@@ -1340,6 +1355,10 @@ public:
         return _fieldPath.tail();
     }
 
+    Variables::Id getVariableId() const {
+        return _variable;
+    }
+
     ComputedPaths getComputedPaths(const std::string& exprFieldPath,
                                    Variables::Id renamingVar) const final;
 
@@ -1744,6 +1763,11 @@ public:
     Value evaluate(const Document& root, Variables* variables) const final;
     const char* getOpName() const final;
 
+    /**
+     * Returns the product of 'values' as evaluate() computes the product of its operands.
+     */
+    static Value apply(const std::vector<Value>& values);
+
     bool isAssociative() const final {
         return true;
     }
@@ -2224,6 +2248,11 @@ public:
     Value evaluate(const Document& root, Variables* variables) const final;
     const char* getOpName() const final;
 
+    /**
+     * Returns 'lhs' - 'rhs' as evaluate() computes the difference of its operands.
+     */
+    static Value apply(const Value& lhs, const Value& rhs);
+
     void acceptVisitor(ExpressionVisitor* visitor) final {
         return visitor->visit(this);
     }
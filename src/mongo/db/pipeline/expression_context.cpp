@@ -35,6 +35,7 @@
 #include "mongo/db/pipeline/stub_mongo_process_interface.h"
 #include "mongo/db/query/collation/collation_spec.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/intrusive_counter.h"
 
 namespace mongo {
@@ -95,6 +96,7 @@ ExpressionContext::ExpressionContext(
       _documentComparator(_unownedCollator),
       _valueComparator(_unownedCollator),
       _resolvedNamespaces(std::move(resolvedNamespaces)) {
+    documentBufferPoolBytes = internalQueryDocumentBufferPoolBytes.load();
 
     if (runtimeConstants)
         variables.setRuntimeConstants(*runtimeConstants);
@@ -297,6 +297,11 @@ public:
     // True if this ExpressionContext is used to parse a collection validator expression.
     bool isParsingCollectionValidator = false;
 
+    // The number of bytes of released document buffers to keep for reuse while this pipeline
+    // produces a batch of results, or 0 to allocate every buffer from the heap. See
+    // document_buffer_pool.h.
+    size_t documentBufferPoolBytes = 0;
+
 protected:
     static const int kInterruptCheckPeriod = 128;
 
@@ -0,0 +1,526 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/expression_program.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <string>
+
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/platform/overflow_arithmetic.h"
+
+namespace mongo {
+
+/**
+ * Lowers an Expression tree into the instructions of an ExpressionProgram.
+ */
+class ExpressionProgramCompiler {
+public:
+    using Instruction = ExpressionProgram::Instruction;
+    using OpCode = ExpressionProgram::OpCode;
+
+    explicit ExpressionProgramCompiler(ExpressionProgram* program) : _program(program) {}
+
+    /**
+     * Emits the instructions evaluating 'expr' and returns the operand holding its value.
+     */
+    uint16_t compile(const Expression* expr) {
+        if (auto constant = dynamic_cast<const ExpressionConstant*>(expr)) {
+            return addConstant(constant->getValue());
+        }
+
+        // A subexpression free of side effects is evaluated only once, and later occurrences read
+        // its register. Only field paths and the operators compiled below are known to be free of
+        // side effects.
+        const bool pure = isPure(expr);
+        std::string key;
+        if (pure) {
+            key = keyFor(expr);
+            if (auto it = _common.find(key); it != _common.end()) {
+                return it->second;
+            }
+        }
+
+        auto result = compileNode(expr);
+        if (pure) {
+            _common.emplace(std::move(key), result);
+        }
+        return result;
+    }
+
+    /**
+     * Returns true if any instruction other than calls into the interpreter was emitted.
+     */
+    bool compiledAnyOperator() const {
+        return _numOperators > 0;
+    }
+
+    /**
+     * Returns true if the program ran out of registers or constants. The program is then unusable.
+     */
+    bool overflowed() const {
+        return _overflowed;
+    }
+
+private:
+    uint16_t compileNode(const Expression* expr) {
+        const auto& children = expr->getChildren();
+
+        const bool isAdd = dynamic_cast<const ExpressionAdd*>(expr);
+        if ((isAdd || dynamic_cast<const ExpressionMultiply*>(expr)) &&
+            children.size() <= std::numeric_limits<uint16_t>::max()) {
+            // These stop at the first operand which decides the result, such as a null, without
+            // evaluating the rest. So before each operand whose evaluation could fail, a guard
+            // finishes the operation early if the operands so far already decide it.
+            auto dst = newRegister();
+            auto args = addArgList();
+            auto common = _common;
+            std::vector<size_t> guards;
+            for (size_t i = 0; i < children.size(); ++i) {
+                if (i > 0 && mayFail(children[i].get())) {
+                    guards.push_back(emit(isAdd ? OpCode::kAddGuard : OpCode::kMultiplyGuard,
+                                          dst,
+                                          args,
+                                          i,
+                                          0));
+                }
+                auto operand = compile(children[i].get());
+                _program->_argLists[args].push_back(operand);
+                if (i == 0) {
+                    common = _common;
+                }
+            }
+            _common = std::move(common);
+
+            emit(isAdd ? OpCode::kAdd : OpCode::kMultiply, dst, args, children.size(), 0);
+            for (auto guard : guards) {
+                patchJump(guard);
+            }
+            ++_numOperators;
+            return dst;
+        }
+
+        if (dynamic_cast<const ExpressionSubtract*>(expr) ||
+            dynamic_cast<const ExpressionDivide*>(expr)) {
+            auto lhs = compile(children[0].get());
+            auto rhs = compile(children[1].get());
+            return emitOperator(dynamic_cast<const ExpressionSubtract*>(expr) ? OpCode::kSubtract
+                                                                                : OpCode::kDivide,
+                                lhs,
+                                rhs,
+                                0);
+        }
+
+        if (dynamic_cast<const ExpressionCompare*>(expr)) {
+            auto lhs = compile(children[0].get());
+            auto rhs = compile(children[1].get());
+            return emitOperator(OpCode::kCompare, lhs, rhs, addNode(expr));
+        }
+
+        if (dynamic_cast<const ExpressionNot*>(expr)) {
+            return emitOperator(OpCode::kNot, compile(children[0].get()), 0, 0);
+        }
+
+        if (dynamic_cast<const ExpressionCond*>(expr)) {
+            auto dst = newRegister();
+            auto jumpToElse = emit(OpCode::kJumpIfFalse, 0, compile(children[0].get()), 0, 0);
+            emit(OpCode::kMove, dst, compileBranch(children[1].get()), 0, 0);
+            auto jumpToEnd = emit(OpCode::kJump, 0, 0, 0, 0);
+            patchJump(jumpToElse);
+            emit(OpCode::kMove, dst, compileBranch(children[2].get()), 0, 0);
+            patchJump(jumpToEnd);
+            ++_numOperators;
+            return dst;
+        }
+
+        const bool isAnd = dynamic_cast<const ExpressionAnd*>(expr);
+        if (isAnd || dynamic_cast<const ExpressionOr*>(expr)) {
+            // Operands after the first are only evaluated if the result is still undecided.
+            auto dst = newRegister();
+            auto common = _common;
+            std::vector<size_t> jumpsToShortCircuit;
+            for (size_t i = 0; i < children.size(); ++i) {
+                auto operand = compile(children[i].get());
+                if (i == 0) {
+                    common = _common;
+                }
+                jumpsToShortCircuit.push_back(emit(
+                    isAnd ? OpCode::kJumpIfFalse : OpCode::kJumpIfTrue, 0, operand, 0, 0));
+            }
+            _common = std::move(common);
+
+            emit(OpCode::kMove, dst, addConstant(Value(isAnd)), 0, 0);
+            auto jumpToEnd = emit(OpCode::kJump, 0, 0, 0, 0);
+            for (auto jump : jumpsToShortCircuit) {
+                patchJump(jump);
+            }
+            emit(OpCode::kMove, dst, addConstant(Value(!isAnd)), 0, 0);
+            patchJump(jumpToEnd);
+            ++_numOperators;
+            return dst;
+        }
+
+        return emitEvaluate(expr);
+    }
+
+    /**
+     * Compiles an operand which is only evaluated on some paths through the program. Its
+     * subexpressions must not be reused by code that runs on other paths.
+     */
+    uint16_t compileBranch(const Expression* expr) {
+        auto common = _common;
+        auto result = compile(expr);
+        _common = std::move(common);
+        return result;
+    }
+
+    /**
+     * Returns true unless 'expr' is known to evaluate without error or side effect.
+     */
+    bool mayFail(const Expression* expr) {
+        if (dynamic_cast<const ExpressionConstant*>(expr) ||
+            dynamic_cast<const ExpressionFieldPath*>(expr)) {
+            return false;
+        }
+        // An operand which repeats an earlier one reads its register.
+        return !(isPure(expr) && _common.count(keyFor(expr)));
+    }
+
+    static bool isPure(const Expression* expr) {
+        if (dynamic_cast<const ExpressionConstant*>(expr) ||
+            dynamic_cast<const ExpressionFieldPath*>(expr)) {
+            return true;
+        }
+        if (!dynamic_cast<const ExpressionAdd*>(expr) &&
+            !dynamic_cast<const ExpressionMultiply*>(expr) &&
+            !dynamic_cast<const ExpressionSubtract*>(expr) &&
+            !dynamic_cast<const ExpressionDivide*>(expr) &&
+            !dynamic_cast<const ExpressionCompare*>(expr) &&
+            !dynamic_cast<const ExpressionNot*>(expr) &&
+            !dynamic_cast<const ExpressionCond*>(expr) &&
+            !dynamic_cast<const ExpressionAnd*>(expr) && !dynamic_cast<const ExpressionOr*>(expr)) {
+            return false;
+        }
+        const auto& children = expr->getChildren();
+        return std::all_of(children.begin(), children.end(), [](auto&& child) {
+            return child && isPure(child.get());
+        });
+    }
+
+    static std::string keyFor(const Expression* expr) {
+        BSONObjBuilder builder;
+        expr->serialize(false).addToBsonObj(&builder, "");
+        auto obj = builder.obj();
+        return std::string(obj.objdata(), obj.objsize());
+    }
+
+    uint16_t newRegister() {
+        if (_program->_numRegisters == ExpressionProgram::kConstantBit - 1) {
+            _overflowed = true;
+            return 0;
+        }
+        return _program->_numRegisters++;
+    }
+
+    uint16_t addConstant(Value value) {
+        if (_program->_constants.size() == ExpressionProgram::kConstantBit - 1) {
+            _overflowed = true;
+            return 0;
+        }
+        _program->_constants.push_back(std::move(value));
+        return (_program->_constants.size() - 1) | ExpressionProgram::kConstantBit;
+    }
+
+    uint16_t addArgList() {
+        if (_program->_argLists.size() == std::numeric_limits<uint16_t>::max()) {
+            _overflowed = true;
+            return 0;
+        }
+        _program->_argLists.emplace_back();
+        return _program->_argLists.size() - 1;
+    }
+
+    uint32_t addNode(const Expression* expr) {
+        _program->_nodes.push_back(expr);
+        return _program->_nodes.size() - 1;
+    }
+
+    size_t emit(OpCode op, uint16_t dst, uint16_t lhs, uint16_t rhs, uint32_t operand) {
+        _program->_instructions.push_back({op, dst, lhs, rhs, operand});
+        return _program->_instructions.size() - 1;
+    }
+
+    uint16_t emitOperator(OpCode op, uint16_t lhs, uint16_t rhs, uint32_t operand) {
+        auto dst = newRegister();
+        emit(op, dst, lhs, rhs, operand);
+        ++_numOperators;
+        return dst;
+    }
+
+    uint16_t emitEvaluate(const Expression* expr) {
+        auto dst = newRegister();
+        emit(OpCode::kEvaluate, dst, 0, 0, addNode(expr));
+        return dst;
+    }
+
+    /**
+     * Makes the jump emitted at 'index' target the next instruction to be emitted.
+     */
+    void patchJump(size_t index) {
+        _program->_instructions[index].operand = _program->_instructions.size();
+    }
+
+    ExpressionProgram* _program;
+
+    // Maps the serialization of each pure subexpression to the operand holding its value, for the
+    // subexpressions evaluated on every path to the instruction being emitted.
+    std::map<std::string, uint16_t> _common;
+
+    size_t _numOperators = 0;
+    bool _overflowed = false;
+};
+
+namespace {
+
+bool isIntOrLong(BSONType type) {
+    return type == NumberInt || type == NumberLong;
+}
+
+bool isIntOrDouble(BSONType type) {
+    return type == NumberInt || type == NumberDouble;
+}
+
+/**
+ * Computes 'lhs' + 'rhs' into 'out' and returns true if both are of a type for which this gives
+ * exactly the result of $add. Otherwise returns false.
+ */
+bool addNumbers(const Value& lhs, const Value& rhs, Value* out) {
+    const auto lhsType = lhs.getType();
+    const auto rhsType = rhs.getType();
+    if (lhsType == NumberInt && rhsType == NumberInt) {
+        *out = Value::createIntOrLong(static_cast<long long>(lhs.getInt()) + rhs.getInt());
+        return true;
+    }
+    if (isIntOrLong(lhsType) && isIntOrLong(rhsType)) {
+        long long sum;
+        if (overflow::add(lhs.coerceToLong(), rhs.coerceToLong(), &sum)) {
+            return false;
+        }
+        *out = Value(sum);
+        return true;
+    }
+    if (isIntOrDouble(lhsType) && isIntOrDouble(rhsType)) {
+        *out = Value(lhs.coerceToDouble() + rhs.coerceToDouble());
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Like addNumbers() for $multiply.
+ */
+bool multiplyNumbers(const Value& lhs, const Value& rhs, Value* out) {
+    const auto lhsType = lhs.getType();
+    const auto rhsType = rhs.getType();
+    if (lhsType == NumberInt && rhsType == NumberInt) {
+        *out = Value::createIntOrLong(static_cast<long long>(lhs.getInt()) * rhs.getInt());
+        return true;
+    }
+    if (isIntOrLong(lhsType) && isIntOrLong(rhsType)) {
+        long long product;
+        if (overflow::mul(lhs.coerceToLong(), rhs.coerceToLong(), &product)) {
+            return false;
+        }
+        *out = Value(product);
+        return true;
+    }
+    if (isIntOrDouble(lhsType) && isIntOrDouble(rhsType)) {
+        *out = Value(lhs.coerceToDouble() * rhs.coerceToDouble());
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Returns the three-way comparison of 'lhs' and 'rhs' as ValueComparator would, for operands of
+ * the same numeric type. Returns boost::none for other operands.
+ */
+boost::optional<int> compareNumbers(const Value& lhs, const Value& rhs) {
+    if (lhs.getType() == NumberInt && rhs.getType() == NumberInt) {
+        return (lhs.getInt() > rhs.getInt()) - (lhs.getInt() < rhs.getInt());
+    }
+    if (lhs.getType() == NumberDouble && rhs.getType() == NumberDouble &&
+        !std::isnan(lhs.getDouble()) && !std::isnan(rhs.getDouble())) {
+        return (lhs.getDouble() > rhs.getDouble()) - (lhs.getDouble() < rhs.getDouble());
+    }
+    return boost::none;
+}
+
+}  // namespace
+
+std::unique_ptr<ExpressionProgram> ExpressionProgram::compile(
+    const boost::intrusive_ptr<Expression>& expression) {
+    if (!expression || !internalQueryEnableExpressionCompilation.load()) {
+        return nullptr;
+    }
+
+    std::unique_ptr<ExpressionProgram> program(new ExpressionProgram(expression));
+    ExpressionProgramCompiler compiler(program.get());
+    program->_result = compiler.compile(expression.get());
+    if (compiler.overflowed() || !compiler.compiledAnyOperator()) {
+        return nullptr;
+    }
+    return program;
+}
+
+Value ExpressionProgram::evaluate(const Document& root, Variables* variables) const {
+    constexpr size_t kInlineRegisters = 16;
+    Value inlineRegisters[kInlineRegisters];
+    std::unique_ptr<Value[]> heapRegisters;
+    Value* registers = inlineRegisters;
+    if (_numRegisters > kInlineRegisters) {
+        heapRegisters.reset(new Value[_numRegisters]);
+        registers = heapRegisters.get();
+    }
+
+    const size_t numInstructions = _instructions.size();
+    size_t pc = 0;
+    while (pc < numInstructions) {
+        const auto& instruction = _instructions[pc++];
+        auto& dst = registers[instruction.dst];
+        switch (instruction.op) {
+            case OpCode::kEvaluate:
+                dst = _nodes[instruction.operand]->evaluate(root, variables);
+                break;
+            case OpCode::kAdd:
+            case OpCode::kMultiply: {
+                const bool isAdd = instruction.op == OpCode::kAdd;
+                const auto& args = _argLists[instruction.lhs];
+                if (args.size() == 2) {
+                    const auto& lhs = operand(registers, args[0]);
+                    const auto& rhs = operand(registers, args[1]);
+                    if (isAdd ? addNumbers(lhs, rhs, &dst) : multiplyNumbers(lhs, rhs, &dst)) {
+                        break;
+                    }
+                }
+                dst = applyArithmetic(isAdd, registers, args, args.size());
+                break;
+            }
+            case OpCode::kAddGuard:
+            case OpCode::kMultiplyGuard: {
+                const bool isAdd = instruction.op == OpCode::kAddGuard;
+                const auto& args = _argLists[instruction.lhs];
+                if (decidesArithmetic(isAdd, registers, args, instruction.rhs)) {
+                    dst = applyArithmetic(isAdd, registers, args, instruction.rhs);
+                    pc = instruction.operand;
+                }
+                break;
+            }
+            case OpCode::kSubtract:
+                dst = ExpressionSubtract::apply(operand(registers, instruction.lhs),
+                                                operand(registers, instruction.rhs));
+                break;
+            case OpCode::kDivide:
+                dst = ExpressionDivide::apply(operand(registers, instruction.lhs),
+                                              operand(registers, instruction.rhs));
+                break;
+            case OpCode::kCompare: {
+                const auto& lhs = operand(registers, instruction.lhs);
+                const auto& rhs = operand(registers, instruction.rhs);
+                auto node = static_cast<const ExpressionCompare*>(_nodes[instruction.operand]);
+                auto cmp = compareNumbers(lhs, rhs);
+                dst = ExpressionCompare::resultFor(
+                    node->getOp(),
+                    cmp ? *cmp
+                        : node->getExpressionContext()->getValueComparator().compare(lhs, rhs));
+                break;
+            }
+            case OpCode::kNot:
+                dst = Value(!operand(registers, instruction.lhs).coerceToBool());
+                break;
+            case OpCode::kMove:
+                dst = operand(registers, instruction.lhs);
+                break;
+            case OpCode::kJump:
+                pc = instruction.operand;
+                break;
+            case OpCode::kJumpIfFalse:
+                if (!operand(registers, instruction.lhs).coerceToBool()) {
+                    pc = instruction.operand;
+                }
+                break;
+            case OpCode::kJumpIfTrue:
+                if (operand(registers, instruction.lhs).coerceToBool()) {
+                    pc = instruction.operand;
+                }
+                break;
+        }
+    }
+
+    return operand(registers, _result);
+}
+
+bool ExpressionProgram::decidesArithmetic(bool isAdd,
+                                          const Value* registers,
+                                          const std::vector<uint16_t>& args,
+                                          size_t count) const {
+    // $add accepts numbers and a single date, $multiply only numbers. Any other operand either
+    // makes the result null or is an error.
+    bool haveDate = false;
+    for (size_t i = 0; i < count; ++i) {
+        const auto& value = operand(registers, args[i]);
+        if (value.numeric()) {
+            continue;
+        }
+        if (!isAdd || value.getType() != Date || haveDate) {
+            return true;
+        }
+        haveDate = true;
+    }
+    return false;
+}
+
+Value ExpressionProgram::applyArithmetic(bool isAdd,
+                                         const Value* registers,
+                                         const std::vector<uint16_t>& args,
+                                         size_t count) const {
+    std::vector<Value> values;
+    values.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        values.push_back(operand(registers, args[i]));
+    }
+    return isAdd ? ExpressionAdd::apply(values) : ExpressionMultiply::apply(values);
+}
+
+}  // namespace mongo
@@ -0,0 +1,140 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/variables.h"
+
+namespace mongo {
+
+/**
+ * A compiled form of an optimized Expression tree, evaluated by a small register machine instead
+ * of by recursive calls to Expression::evaluate().
+ *
+ * Arithmetic, comparison and boolean operators and $cond are lowered to instructions, with fast
+ * paths for operands of the common numeric types. Identical subexpressions which are always
+ * evaluated, such as a field path referenced several times, are evaluated once. All other
+ * expressions are evaluated by the interpreter from within the program. The result, including any
+ * error raised, is always the same as that of Expression::evaluate() on the source tree.
+ *
+ * The program refers to the nodes of the source tree, which must outlive it and must not be
+ * modified after compilation. evaluate() is thread-safe in the same way as Expression::evaluate().
+ */
+class ExpressionProgram {
+public:
+    /**
+     * Compiles 'expression'. Returns nullptr if compilation is disabled, or if the program would do
+     * nothing but call Expression::evaluate() on the root of the tree.
+     */
+    static std::unique_ptr<ExpressionProgram> compile(
+        const boost::intrusive_ptr<Expression>& expression);
+
+    Value evaluate(const Document& root, Variables* variables) const;
+
+    size_t numInstructions() const {
+        return _instructions.size();
+    }
+
+    size_t numRegisters() const {
+        return _numRegisters;
+    }
+
+private:
+    friend class ExpressionProgramCompiler;
+
+    enum class OpCode : uint8_t {
+        kEvaluate,       // dst = nodes[operand]->evaluate(root, variables)
+        kAdd,            // dst = $add over the first rhs operands of argLists[lhs]
+        kMultiply,       // dst = $multiply over the first rhs operands of argLists[lhs]
+        kAddGuard,       // if the first rhs operands decide kAdd, dst = kAdd and goto operand
+        kMultiplyGuard,  // if the first rhs operands decide kMultiply, ditto
+        kSubtract,       // dst = lhs - rhs
+        kDivide,         // dst = lhs / rhs
+        kCompare,        // dst = nodes[operand] compared as (lhs, rhs)
+        kNot,            // dst = !lhs
+        kMove,           // dst = lhs
+        kJump,           // goto operand
+        kJumpIfFalse,    // if !lhs goto operand
+        kJumpIfTrue,     // if lhs goto operand
+    };
+
+    struct Instruction {
+        OpCode op;
+        uint16_t dst;
+        uint16_t lhs;
+        uint16_t rhs;
+        uint32_t operand;
+    };
+
+    // Operands with this bit set name an entry of '_constants' rather than a register.
+    static constexpr uint16_t kConstantBit = 0x8000;
+
+    ExpressionProgram(boost::intrusive_ptr<Expression> source) : _source(std::move(source)) {}
+
+    const Value& operand(const Value* registers, uint16_t index) const {
+        return (index & kConstantBit) ? _constants[index & ~kConstantBit] : registers[index];
+    }
+
+    /**
+     * Returns true if the first 'count' operands listed in 'args' are enough to decide the result
+     * of $add, or of $multiply if 'isAdd' is false, because one of them is not a valid summand or
+     * factor.
+     */
+    bool decidesArithmetic(bool isAdd,
+                           const Value* registers,
+                           const std::vector<uint16_t>& args,
+                           size_t count) const;
+
+    /**
+     * Returns the result of $add, or of $multiply if 'isAdd' is false, over the first 'count'
+     * operands listed in 'args'.
+     */
+    Value applyArithmetic(bool isAdd,
+                          const Value* registers,
+                          const std::vector<uint16_t>& args,
+                          size_t count) const;
+
+    boost::intrusive_ptr<Expression> _source;
+    std::vector<Instruction> _instructions;
+    std::vector<Value> _constants;
+    std::vector<const Expression*> _nodes;
+    std::vector<std::vector<uint16_t>> _argLists;
+    uint16_t _numRegisters = 0;
+    uint16_t _result = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,197 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <limits>
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/json.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/expression_program.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class ExpressionProgramTest : public unittest::Test {
+public:
+    ExpressionProgramTest() : _wasEnabled(internalQueryEnableExpressionCompilation.load()) {
+        internalQueryEnableExpressionCompilation.store(true);
+    }
+
+    ~ExpressionProgramTest() {
+        internalQueryEnableExpressionCompilation.store(_wasEnabled);
+    }
+
+    boost::intrusive_ptr<Expression> parse(StringData json) {
+        auto obj = BSON("" << fromjson(json.toString()));
+        return Expression::parseOperand(_expCtx, obj.firstElement(), _expCtx->variablesParseState)
+            ->optimize();
+    }
+
+    StatusWith<Value> interpret(const boost::intrusive_ptr<Expression>& expr, const Document& doc) {
+        try {
+            return expr->evaluate(doc, &_expCtx->variables);
+        } catch (const DBException& ex) {
+            return ex.toStatus();
+        }
+    }
+
+    StatusWith<Value> runProgram(const ExpressionProgram& program, const Document& doc) {
+        try {
+            return program.evaluate(doc, &_expCtx->variables);
+        } catch (const DBException& ex) {
+            return ex.toStatus();
+        }
+    }
+
+    /**
+     * Asserts that the compiled form of 'json' produces exactly the same value, or error, as the
+     * interpreter on each of 'docs'.
+     */
+    void assertMatchesInterpreter(StringData json, const std::vector<Document>& docs) {
+        auto expr = parse(json);
+        auto program = ExpressionProgram::compile(expr);
+        ASSERT_TRUE(program);
+
+        for (auto&& doc : docs) {
+            auto expected = interpret(expr, doc);
+            auto actual = runProgram(*program, doc);
+            ASSERT_EQ(expected.getStatus().code(), actual.getStatus().code())
+                << json << " on " << doc.toString();
+            if (expected.isOK()) {
+                ASSERT_VALUE_EQ(expected.getValue(), actual.getValue());
+                ASSERT_EQ(expected.getValue().getType(), actual.getValue().getType())
+                    << json << " on " << doc.toString();
+            }
+        }
+    }
+
+private:
+    boost::intrusive_ptr<ExpressionContextForTest> _expCtx = new ExpressionContextForTest();
+    const bool _wasEnabled;
+};
+
+std::vector<Document> numericDocs() {
+    return {Document{{"a", 1}, {"b", 2}},
+            Document{{"a", std::numeric_limits<int>::max()}, {"b", 1}},
+            Document{{"a", std::numeric_limits<long long>::max()}, {"b", 1}},
+            Document{{"a", 3LL}, {"b", -4}},
+            Document{{"a", 1.5}, {"b", 2}},
+            Document{{"a", std::numeric_limits<double>::quiet_NaN()}, {"b", 1.0}},
+            Document{{"a", std::numeric_limits<double>::infinity()}, {"b", -2.5}},
+            Document{{"a", Decimal128("1.1")}, {"b", 2}},
+            Document{{"a", BSONNULL}, {"b", 2}},
+            Document{{"a", Date_t::fromMillisSinceEpoch(1000)}, {"b", 5}},
+            Document{{"a", "str"_sd}, {"b", 1}},
+            Document{{"a", 0}, {"b", 0}},
+            Document{}};
+}
+
+TEST_F(ExpressionProgramTest, MatchesInterpreterOnArithmetic) {
+    for (auto json : {"{$add: ['$a', '$b']}",
+                      "{$add: ['$a', '$b', 1]}",
+                      "{$multiply: ['$a', '$b']}",
+                      "{$multiply: ['$a', '$b', 2]}",
+                      "{$subtract: ['$a', '$b']}",
+                      "{$divide: ['$a', '$b']}",
+                      "{$add: [{$multiply: ['$a', 2]}, {$subtract: ['$b', '$a']}]}"}) {
+        assertMatchesInterpreter(json, numericDocs());
+    }
+}
+
+TEST_F(ExpressionProgramTest, MatchesInterpreterOnComparisonsAndBooleans) {
+    for (auto json : {"{$gt: ['$a', '$b']}",
+                      "{$lte: ['$a', '$b']}",
+                      "{$cmp: ['$a', '$b']}",
+                      "{$eq: ['$a', 1]}",
+                      "{$not: ['$a']}",
+                      "{$and: [{$gt: ['$a', 0]}, {$lt: ['$b', 5]}]}",
+                      "{$or: ['$a', {$not: ['$b']}]}",
+                      "{$cond: [{$gte: ['$a', 2]}, {$add: ['$a', '$a']}, "
+                      "{$multiply: ['$a', '$b']}]}",
+                      "{$cond: [{$lt: ['$a', '$b']}, '$a', '$b']}"}) {
+        assertMatchesInterpreter(json, numericDocs());
+    }
+}
+
+TEST_F(ExpressionProgramTest, MatchesInterpreterWhenMixedWithUncompiledExpressions) {
+    assertMatchesInterpreter("{$add: [{$strLenBytes: {$ifNull: ['$s', '']}}, 1]}",
+                             {Document{{"s", "abc"_sd}}, Document{}, Document{{"s", 1}}});
+}
+
+TEST_F(ExpressionProgramTest, DoesNotEvaluateOperandsTheInterpreterSkips) {
+    const std::vector<Document> docs{Document{{"zero", 0}}, Document{{"zero", 2}}};
+    assertMatchesInterpreter("{$cond: [{$eq: ['$zero', 0]}, 'ok', {$divide: [1, '$zero']}]}",
+                             docs);
+    assertMatchesInterpreter("{$and: [{$ne: ['$zero', 0]}, {$gt: [{$divide: [1, '$zero']}, 0]}]}",
+                             docs);
+    assertMatchesInterpreter("{$or: [{$eq: ['$zero', 0]}, {$gt: [{$divide: [1, '$zero']}, 0]}]}",
+                             docs);
+    assertMatchesInterpreter("{$add: [{$divide: [1, 1]}, '$missing', {$divide: [1, '$zero']}]}",
+                             docs);
+}
+
+TEST_F(ExpressionProgramTest, EvaluatesCommonSubexpressionsOnce) {
+    auto program = ExpressionProgram::compile(
+        parse("{$add: [{$multiply: ['$a', '$b']}, {$multiply: ['$a', '$b']}]}"));
+    ASSERT(program);
+    // Reads of 'a' and 'b', one $multiply and the $add.
+    ASSERT_EQ(4U, program->numInstructions());
+}
+
+TEST_F(ExpressionProgramTest, DoesNotReuseSubexpressionsFromBranchesNotTaken) {
+    assertMatchesInterpreter(
+        "{$add: [{$cond: [{$gt: ['$a', 0]}, {$multiply: ['$a', '$b']}, 0]}, "
+        "{$multiply: ['$a', '$b']}]}",
+        {Document{{"a", 1}, {"b", 2}}, Document{{"a", -1}, {"b", 2}}});
+    assertMatchesInterpreter(
+        "{$add: [{$cond: [{$and: ['$c', {$multiply: ['$a', '$b']}]}, 1, 0]}, "
+        "{$multiply: ['$a', '$b']}]}",
+        {Document{{"a", 1}, {"b", 2}, {"c", true}}, Document{{"a", 1}, {"b", 2}, {"c", false}}});
+}
+
+TEST_F(ExpressionProgramTest, DoesNotCompileExpressionsWithoutOperators) {
+    ASSERT_FALSE(ExpressionProgram::compile(parse("'$a'")));
+    ASSERT_FALSE(ExpressionProgram::compile(parse("{$concat: ['$a', 'x']}")));
+    ASSERT_FALSE(ExpressionProgram::compile(parse("{$add: [1, 2]}")));
+}
+
+TEST_F(ExpressionProgramTest, DoesNotCompileWhenDisabled) {
+    internalQueryEnableExpressionCompilation.store(false);
+    ASSERT_FALSE(ExpressionProgram::compile(parse("{$add: ['$a', 1]}")));
+}
+
+}  // namespace
+}  // namespace mongo
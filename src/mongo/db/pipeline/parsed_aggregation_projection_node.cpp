@@ -171,10 +171,12 @@ void ProjectionNode::applyExpressions(const Document& root, MutableDocument* out
         } else {
             auto expressionIt = _expressions.find(field);
             invariant(expressionIt != _expressions.end());
-            outputDoc->setField(
-                field,
-                expressionIt->second->evaluate(
-                    root, &expressionIt->second->getExpressionContext()->variables));
+            auto variables = &expressionIt->second->getExpressionContext()->variables;
+            auto programIt = _programs.find(field);
+            outputDoc->setField(field,
+                                programIt != _programs.end()
+                                    ? programIt->second->evaluate(root, variables)
+                                    : expressionIt->second->evaluate(root, variables));
         }
     }
 }
@@ -240,8 +242,12 @@ void ProjectionNode::reportComputedPaths(std::set<std::string>* computedPaths,
 }
 
 void ProjectionNode::optimize() {
+    _programs.clear();
     for (auto&& expressionIt : _expressions) {
         _expressions[expressionIt.first] = expressionIt.second->optimize();
+        if (auto program = ExpressionProgram::compile(_expressions[expressionIt.first])) {
+            _programs[expressionIt.first] = std::move(program);
+        }
     }
     for (auto&& childPair : _children) {
         childPair.second->optimize();
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/pipeline/expression_program.h"
 #include "mongo/db/pipeline/parsed_aggregation_projection.h"
 
 #include "mongo/db/query/projection_policies.h"
@@ -157,6 +158,9 @@ protected:
     stdx::unordered_map<size_t, std::unique_ptr<ProjectionNode>> _arrayBranches;
 
     StringMap<boost::intrusive_ptr<Expression>> _expressions;
+
+    // Compiled forms of the optimized '_expressions', for those which compilation applies to.
+    StringMap<std::unique_ptr<ExpressionProgram>> _programs;
     stdx::unordered_set<std::string> _projectedFields;
 
     ProjectionPolicies _policies;
@@ -63,8 +63,10 @@
 #include "mongo/db/pipeline/document_source_geo_near_cursor.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_parallel_merge.h"
 #include "mongo/db/pipeline/document_source_sample.h"
 #include "mongo/db/pipeline/document_source_sample_from_random_cursor.h"
+#include "mongo/db/pipeline/document_source_shared_oplog_scan.h"
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/parsed_inclusion_projection.h"
@@ -72,6 +74,7 @@
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -328,6 +331,21 @@ PipelineD::buildInnerQueryExecutor(Collection* collection,
         return {};
     }
 
+    // A change stream may draw its oplog entries from the scan shared by all of the change streams
+    // on this node instead of scanning the oplog itself.
+    if (!sources.empty() && !expCtx->explain && internalChangeStreamUseSharedOplogReader.load()) {
+        if (auto oplogMatch = dynamic_cast<DocumentSourceOplogMatch*>(sources.front().get())) {
+            invariant(expCtx->tailableMode == TailableModeEnum::kTailableAndAwaitData);
+            invariant(aggRequest);
+            expCtx->use42ChangeStreamSortKeys = !aggRequest->getUse44SortKeys();
+
+            auto filter = oplogMatch->getQuery();
+            pipeline->popFront();
+            pipeline->addInitialSource(DocumentSourceSharedOplogScan::create(expCtx, filter));
+            return {};
+        }
+    }
+
     // We are going to generate an input cursor, so we need to be holding the collection lock.
     dassert(expCtx->opCtx->lockState()->isCollectionLockedForMode(nss, MODE_IS));
 
@@ -786,6 +804,10 @@ Timestamp PipelineD::getLatestOplogTimestamp(const Pipeline* pipeline) {
             dynamic_cast<DocumentSourceCursor*>(pipeline->_sources.front().get())) {
         return docSourceCursor->getLatestOplogTimestamp();
     }
+    if (auto sharedOplogScan =
+            dynamic_cast<DocumentSourceSharedOplogScan*>(pipeline->_sources.front().get())) {
+        return sharedOplogScan->getLatestOplogTimestamp();
+    }
     return Timestamp();
 }
 
@@ -795,6 +817,15 @@ std::string PipelineD::getPlanSummaryStr(const Pipeline* pipeline) {
         return docSourceCursor->getPlanSummaryStr();
     }
 
+    // A parallel aggregation reads the collection in the pipeline feeding its workers.
+    if (auto parallelMerge =
+            dynamic_cast<DocumentSourceParallelMerge*>(pipeline->_sources.front().get())) {
+        std::string planSummary;
+        parallelMerge->getExchange()->visitInputPipeline(
+            [&](const Pipeline& input) { planSummary = getPlanSummaryStr(&input); });
+        return planSummary;
+    }
+
     return "";
 }
 
@@ -806,6 +837,15 @@ void PipelineD::getPlanSummaryStats(const Pipeline* pipeline, PlanSummaryStats*
         *statsOut = docSourceCursor->getPlanSummaryStats();
     }
 
+    // The stats of a parallel aggregation combine those of the pipeline feeding its workers with
+    // whether the workers ran a $sort. The merge stage reports whether any of them spilled.
+    if (auto parallelMerge =
+            dynamic_cast<DocumentSourceParallelMerge*>(pipeline->_sources.front().get())) {
+        parallelMerge->getExchange()->visitInputPipeline(
+            [&](const Pipeline& input) { getPlanSummaryStats(&input, statsOut); });
+        statsOut->hasSortStage = statsOut->hasSortStage || parallelMerge->isMergingSortedStreams();
+    }
+
     for (auto&& source : pipeline->_sources) {
         if (dynamic_cast<DocumentSourceSort*>(source.get()))
             statsOut->hasSortStage = true;
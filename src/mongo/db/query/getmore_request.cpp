@@ -51,6 +51,9 @@ const char kBatchSizeField[] = "batchSize";
 const char kAwaitDataTimeoutField[] = "maxTimeMS";
 const char kTermField[] = "term";
 const char kLastKnownCommittedOpTimeField[] = "lastKnownCommittedOpTime";
+const char kSortKeyThresholdField[] = "$_sortKeyThreshold";
+const char kSortKeyThresholdKeyField[] = "key";
+const char kSortKeyThresholdPatternField[] = "pattern";
 
 }  // namespace
 
@@ -63,13 +66,15 @@ GetMoreRequest::GetMoreRequest(NamespaceString namespaceString,
                                boost::optional<std::int64_t> sizeOfBatch,
                                boost::optional<Milliseconds> awaitDataTimeout,
                                boost::optional<long long> term,
-                               boost::optional<repl::OpTime> lastKnownCommittedOpTime)
+                               boost::optional<repl::OpTime> lastKnownCommittedOpTime,
+                               boost::optional<SortKeyThreshold> sortKeyThreshold)
     : nss(std::move(namespaceString)),
       cursorid(id),
       batchSize(sizeOfBatch),
       awaitDataTimeout(awaitDataTimeout),
       term(term),
-      lastKnownCommittedOpTime(lastKnownCommittedOpTime) {}
+      lastKnownCommittedOpTime(lastKnownCommittedOpTime),
+      sortKeyThreshold(std::move(sortKeyThreshold)) {}
 
 Status GetMoreRequest::isValid() const {
     if (!nss.isValid()) {
@@ -102,6 +107,7 @@ StatusWith<GetMoreRequest> GetMoreRequest::parseFromBSON(const std::string& dbna
     boost::optional<Milliseconds> awaitDataTimeout;
     boost::optional<long long> term;
     boost::optional<repl::OpTime> lastKnownCommittedOpTime;
+    boost::optional<SortKeyThreshold> sortKeyThreshold;
 
     for (BSONElement el : cmdObj) {
         const auto fieldName = el.fieldNameStringData();
@@ -151,6 +157,23 @@ StatusWith<GetMoreRequest> GetMoreRequest::parseFromBSON(const std::string& dbna
                 return status;
             }
             lastKnownCommittedOpTime = ot;
+        } else if (fieldName == kSortKeyThresholdField) {
+            if (el.type() != BSONType::Object) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << "Field '" << kSortKeyThresholdField
+                                      << "' must be of type object in: " << cmdObj};
+            }
+
+            auto key = el.Obj()[kSortKeyThresholdKeyField];
+            auto pattern = el.Obj()[kSortKeyThresholdPatternField];
+            if (key.type() != BSONType::Object || pattern.type() != BSONType::Object) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << "Field '" << kSortKeyThresholdField
+                                      << "' must have object fields '" << kSortKeyThresholdKeyField
+                                      << "' and '" << kSortKeyThresholdPatternField
+                                      << "' in: " << cmdObj};
+            }
+            sortKeyThreshold = SortKeyThreshold{key.Obj().getOwned(), pattern.Obj().getOwned()};
         } else if (!isGenericArgument(fieldName)) {
             return {ErrorCodes::FailedToParse,
                     str::stream() << "Failed to parse: " << cmdObj << ". "
@@ -168,8 +191,13 @@ StatusWith<GetMoreRequest> GetMoreRequest::parseFromBSON(const std::string& dbna
                 str::stream() << "Field 'collection' missing in: " << cmdObj};
     }
 
-    GetMoreRequest request(
-        std::move(*nss), *cursorid, batchSize, awaitDataTimeout, term, lastKnownCommittedOpTime);
+    GetMoreRequest request(std::move(*nss),
+                           *cursorid,
+                           batchSize,
+                           awaitDataTimeout,
+                           term,
+                           lastKnownCommittedOpTime,
+                           std::move(sortKeyThreshold));
     Status validStatus = request.isValid();
     if (!validStatus.isOK()) {
         return validStatus;
@@ -200,6 +228,12 @@ BSONObj GetMoreRequest::toBSON() const {
         lastKnownCommittedOpTime->append(&builder, kLastKnownCommittedOpTimeField);
     }
 
+    if (sortKeyThreshold) {
+        BSONObjBuilder thresholdBuilder(builder.subobjStart(kSortKeyThresholdField));
+        thresholdBuilder.append(kSortKeyThresholdKeyField, sortKeyThreshold->key);
+        thresholdBuilder.append(kSortKeyThresholdPatternField, sortKeyThreshold->pattern);
+    }
+
     return builder.obj();
 }
 
@@ -43,6 +43,16 @@ namespace mongo {
 struct GetMoreRequest {
     static const char kGetMoreCommandName[];
 
+    /**
+     * Sent by mongos when merging the sorted results of a query with a limit. 'key' is the sort key
+     * of the last result which can still be part of the final result set, so results whose
+     * $sortKey sorts after 'key' according to 'pattern' need not be returned.
+     */
+    struct SortKeyThreshold {
+        BSONObj key;
+        BSONObj pattern;
+    };
+
     /**
      * Construct an empty request.
      */
@@ -56,7 +66,8 @@ struct GetMoreRequest {
                    boost::optional<std::int64_t> sizeOfBatch,
                    boost::optional<Milliseconds> awaitDataTimeout,
                    boost::optional<long long> term,
-                   boost::optional<repl::OpTime> lastKnownCommittedOpTime);
+                   boost::optional<repl::OpTime> lastKnownCommittedOpTime,
+                   boost::optional<SortKeyThreshold> sortKeyThreshold = boost::none);
 
     /**
      * Construct a GetMoreRequest from the command specification and db name.
@@ -86,6 +97,9 @@ struct GetMoreRequest {
     // Only internal queries from replication will have a last known committed optime.
     const boost::optional<repl::OpTime> lastKnownCommittedOpTime;
 
+    // Only getMores issued by mongos on behalf of a sorted query with a limit have a threshold.
+    const boost::optional<SortKeyThreshold> sortKeyThreshold;
+
 private:
     /**
      * Returns a non-OK status if there are semantic errors in the parsed request
@@ -266,4 +266,44 @@ TEST(GetMoreRequestTest, toBSONHasMaxTimeMS) {
     ASSERT_BSONOBJ_EQ(requestObj, expectedRequest);
 }
 
+TEST(GetMoreRequestTest, parseFromBSONHasSortKeyThreshold) {
+    StatusWith<GetMoreRequest> result = GetMoreRequest::parseFromBSON(
+        "db",
+        BSON("getMore" << CursorId(123) << "collection"
+                       << "coll"
+                       << "$_sortKeyThreshold"
+                       << BSON("key" << BSON("" << 5) << "pattern" << BSON("a" << -1))));
+    ASSERT_OK(result.getStatus());
+    ASSERT(result.getValue().sortKeyThreshold);
+    ASSERT_BSONOBJ_EQ(BSON("" << 5), result.getValue().sortKeyThreshold->key);
+    ASSERT_BSONOBJ_EQ(BSON("a" << -1), result.getValue().sortKeyThreshold->pattern);
+}
+
+TEST(GetMoreRequestTest, parseFromBSONSortKeyThresholdMissingPattern) {
+    StatusWith<GetMoreRequest> result =
+        GetMoreRequest::parseFromBSON("db",
+                                      BSON("getMore" << CursorId(123) << "collection"
+                                                     << "coll"
+                                                     << "$_sortKeyThreshold"
+                                                     << BSON("key" << BSON("" << 5))));
+    ASSERT_EQUALS(ErrorCodes::TypeMismatch, result.getStatus().code());
+}
+
+TEST(GetMoreRequestTest, toBSONHasSortKeyThreshold) {
+    GetMoreRequest request(NamespaceString("testdb.testcoll"),
+                           123,
+                           10,
+                           boost::none,
+                           boost::none,
+                           boost::none,
+                           GetMoreRequest::SortKeyThreshold{BSON("" << 5), BSON("a" << 1)});
+    BSONObj requestObj = request.toBSON();
+    BSONObj expectedRequest =
+        BSON("getMore" << CursorId(123) << "collection"
+                       << "testcoll"
+                       << "batchSize" << 10 << "$_sortKeyThreshold"
+                       << BSON("key" << BSON("" << 5) << "pattern" << BSON("a" << 1)));
+    ASSERT_BSONOBJ_EQ(requestObj, expectedRequest);
+}
+
 }  // namespace
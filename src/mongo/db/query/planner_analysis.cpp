@@ -712,6 +712,14 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         sort->limit = 0;
     }
 
+    // A TEXT stage whose results go straight to a top-k sort on the text score only needs to
+    // produce the documents which can be among the top k.
+    QuerySolutionNode* sortInput = keyGenNode->children[0];
+    if (sort->limit && STAGE_TEXT == sortInput->getType() && sortObj.nFields() == 1 &&
+        QueryRequest::isTextScoreMeta(sortObj.firstElement())) {
+        static_cast<TextNode*>(sortInput)->topK = sort->limit;
+    }
+
     *blockingSortOut = true;
 
     return solnRoot;
@@ -579,6 +579,10 @@ bool QueryPlannerIXSelect::_compatible(const BSONElement& keyPatternElt,
         return (exprtype == MatchExpression::TEXT);
     } else if (IndexNames::GEO_HAYSTACK == indexedFieldType) {
         return false;
+    } else if (IndexNames::COLUMN == indexedFieldType) {
+        // Columnstore indexes are never used to answer predicates. They may only provide the
+        // projected fields of an unfiltered scan; see QueryPlanner::plan().
+        return false;
     } else {
         warning() << "Unknown indexing for node " << node->debugString() << " and field "
                   << keyPatternElt.toString();
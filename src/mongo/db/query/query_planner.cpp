@@ -39,6 +39,7 @@
 #include "mongo/base/string_data.h"
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/field_ref.h"
 #include "mongo/db/index/wildcard_key_generator.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/matcher/expression_algo.h"
@@ -129,6 +130,9 @@ string optionString(size_t options) {
             case QueryPlannerParams::STRICT_DISTINCT_ONLY:
                 ss << "STRICT_DISTINCT_ONLY ";
                 break;
+            case QueryPlannerParams::GENERATE_SKIP_SCANS:
+                ss << "GENERATE_SKIP_SCANS ";
+                break;
             case QueryPlannerParams::DEFAULT:
                 MONGO_UNREACHABLE;
                 break;
@@ -284,6 +288,179 @@ std::unique_ptr<QuerySolution> buildWholeIXSoln(const IndexEntry& index,
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
 }
 
+/**
+ * Attempts to build a skip scan over the compound btree index 'index' for a query which has no
+ * predicate on the leading field of the index, but which constrains some of the trailing fields.
+ * The leading fields are given all-values bounds, so that the IndexBoundsChecker jumps from each
+ * distinct value of the leading fields directly into the bounds of the trailing fields beneath it.
+ * Returns nullptr if no such scan can be built.
+ *
+ * Only top-level comparison and $in predicates are turned into bounds, and the entire query is
+ * re-applied after fetching, so the bounds need not be exact. As in the regular planner, the bounds
+ * of several predicates on the same field are intersected only if the index is not multikey.
+ */
+std::unique_ptr<QuerySolution> buildSkipScanSoln(const IndexEntry& index,
+                                                 const CanonicalQuery& query,
+                                                 const QueryPlannerParams& params) {
+    if (index.type != INDEX_BTREE || index.keyPattern.nFields() < 2 || index.sparse ||
+        index.filterExpr ||
+        !CollatorInterface::collatorsMatch(index.collator, query.getCollator())) {
+        return nullptr;
+    }
+
+    std::vector<const MatchExpression*> predicates;
+    const MatchExpression* root = query.root();
+    if (MatchExpression::AND == root->matchType()) {
+        for (size_t i = 0; i < root->numChildren(); ++i) {
+            predicates.push_back(root->getChild(i));
+        }
+    } else {
+        predicates.push_back(root);
+    }
+
+    auto findPredicates = [&](StringData path) {
+        std::vector<const MatchExpression*> found;
+        for (auto&& pred : predicates) {
+            switch (pred->matchType()) {
+                case MatchExpression::EQ:
+                case MatchExpression::LT:
+                case MatchExpression::LTE:
+                case MatchExpression::GT:
+                case MatchExpression::GTE:
+                case MatchExpression::MATCH_IN:
+                    if (pred->path() == path) {
+                        found.push_back(pred);
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        return found;
+    };
+
+    auto isn = std::make_unique<IndexScanNode>(index);
+    isn->addKeyMetadata = query.getQueryRequest().returnKey();
+    isn->queryCollator = query.getCollator();
+
+    bool hasTrailingBounds = false;
+    size_t fieldNo = 0;
+    for (auto&& elt : index.keyPattern) {
+        OrderedIntervalList oil(elt.fieldName());
+        const auto fieldPredicates = findPredicates(elt.fieldNameStringData());
+        if (fieldNo == 0 && !fieldPredicates.empty()) {
+            // The index can be used by the regular planner; there is no gap to skip over.
+            return nullptr;
+        }
+
+        if (!fieldPredicates.empty()) {
+            IndexBoundsBuilder::BoundsTightness tightness;
+            IndexBoundsBuilder::translate(fieldPredicates.front(), elt, index, &oil, &tightness);
+            if (!index.multikey) {
+                for (size_t i = 1; i < fieldPredicates.size(); ++i) {
+                    IndexBoundsBuilder::translateAndIntersect(
+                        fieldPredicates[i], elt, index, &oil, &tightness);
+                }
+            }
+            hasTrailingBounds = true;
+        } else {
+            IndexBoundsBuilder::allValuesForField(elt, &oil);
+        }
+        isn->bounds.fields.push_back(std::move(oil));
+        ++fieldNo;
+    }
+
+    if (!hasTrailingBounds) {
+        return nullptr;
+    }
+    IndexBoundsBuilder::alignBounds(&isn->bounds, index.keyPattern);
+
+    auto fetch = std::make_unique<FetchNode>();
+    fetch->filter = query.root()->shallowClone();
+    fetch->children.push_back(isn.release());
+    return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(fetch));
+}
+
+bool solutionHasStage(const QuerySolutionNode* node, StageType type) {
+    if (node->getType() == type) {
+        return true;
+    }
+    for (auto&& child : node->children) {
+        if (solutionHasStage(child, type)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Attempts to answer an unfiltered, projected query by reassembling the projected fields from the
+ * columns of the columnstore index 'index'. Returns nullptr if 'index' cannot be used this way,
+ * either because it is not a columnstore index, or because some field needed by the query does
+ * not live under one of its columns. The resulting plan is not cached.
+ */
+std::unique_ptr<QuerySolution> buildColumnScanSoln(const IndexEntry& index,
+                                                   const CanonicalQuery& query,
+                                                   const QueryPlannerParams& params) {
+    // A multikey columnstore index has no cells for paths which traverse an array, so it cannot
+    // reproduce the values of such paths.
+    if (index.type != INDEX_COLUMN || index.multikey) {
+        return nullptr;
+    }
+
+    const auto projection = query.getProj();
+    if (!query.getQueryObj().isEmpty() || !projection ||
+        projection->type() != projection_ast::ProjectType::kInclusion ||
+        projection->requiresDocument() || projection->requiresMatchDetails() ||
+        projection->metadataDeps().any()) {
+        return nullptr;
+    }
+
+    std::vector<std::string> indexPaths;
+    for (auto&& elem : index.keyPattern) {
+        indexPaths.push_back(elem.fieldName());
+    }
+
+    // Every field read by the query must be available in full from some column.
+    std::vector<bool> pathNeeded(indexPaths.size(), false);
+    auto markColumnFor = [&](StringData field) {
+        const FieldRef fieldRef{field};
+        for (size_t i = 0; i < indexPaths.size(); ++i) {
+            if (FieldRef{indexPaths[i]}.isPrefixOfOrEqualTo(fieldRef)) {
+                pathNeeded[i] = true;
+                return true;
+            }
+        }
+        return false;
+    };
+    for (auto&& field : projection->getRequiredFields()) {
+        if (!markColumnFor(field)) {
+            return nullptr;
+        }
+    }
+    for (auto&& sortElem : query.getQueryRequest().getSort()) {
+        if (!markColumnFor(sortElem.fieldNameStringData())) {
+            return nullptr;
+        }
+    }
+
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < indexPaths.size(); ++i) {
+        if (pathNeeded[i]) {
+            paths.push_back(indexPaths[i]);
+        }
+    }
+
+    auto soln = QueryPlannerAnalysis::analyzeDataAccess(
+        query, params, std::make_unique<ColumnScanNode>(index, std::move(paths)));
+
+    // Needing a FETCH anywhere in the plan, e.g. for shard filtering, defeats the purpose.
+    if (!soln || solutionHasStage(soln->root.get(), STAGE_FETCH)) {
+        return nullptr;
+    }
+    return soln;
+}
+
 bool providesSort(const CanonicalQuery& query, const BSONObj& kp) {
     return query.getQueryRequest().getSort().isPrefixOf(kp, SimpleBSONElementComparator::kInstance);
 }
@@ -453,6 +630,14 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
         } else {
             return {std::move(soln)};
         }
+    } else if (SolutionCacheData::SKIP_SCAN_SOLN == winnerCacheData.solnType) {
+        auto soln = buildSkipScanSoln(*winnerCacheData.tree->entry, query, params);
+        if (!soln) {
+            return Status(ErrorCodes::NoQueryExecutionPlans,
+                          "plan cache error: soln that skip-scans index");
+        } else {
+            return {std::move(soln)};
+        }
     } else if (SolutionCacheData::COLLSCAN_SOLN == winnerCacheData.solnType) {
         // The cached solution is a collection scan. We don't cache collscans
         // with tailable==true, hence the false below.
@@ -846,8 +1031,21 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
     // $** index is hinted, we do not want this behavior.
     if (!hintedIndex.isEmpty() && relevantIndices.size() == 1) {
         if (0 == out.size() && relevantIndices.front().type != IndexType::INDEX_WILDCARD) {
-            // Push hinted index solution to output list if found.
-            auto soln = buildWholeIXSoln(relevantIndices.front(), query, params);
+            // Push hinted index solution to output list if found. A columnstore index cannot be
+            // scanned like a btree; it may only be used to reassemble the projected fields. A
+            // compound index whose leading field is unconstrained is skip-scanned if possible.
+            const auto& hinted = relevantIndices.front();
+            std::unique_ptr<QuerySolution> soln;
+            if (hinted.type == IndexType::INDEX_COLUMN) {
+                soln = buildColumnScanSoln(hinted, query, params);
+            } else {
+                if (params.options & QueryPlannerParams::GENERATE_SKIP_SCANS) {
+                    soln = buildSkipScanSoln(hinted, query, params);
+                }
+                if (!soln) {
+                    soln = buildWholeIXSoln(hinted, query, params);
+                }
+            }
             if (soln) {
                 LOG(5) << "Planner: outputting soln that uses hinted index as scan.";
                 out.push_back(std::move(soln));
@@ -979,6 +1177,52 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         }
     }
 
+    // Failing that, a columnstore index may be able to provide the projected fields without reading
+    // the full documents.
+    if (out.size() == 0) {
+        const auto* indicesToConsider = hintedIndex.isEmpty() ? &fullIndexList : &relevantIndices;
+        for (auto&& index : *indicesToConsider) {
+            auto soln = buildColumnScanSoln(index, query, params);
+            if (soln) {
+                LOG(5) << "Planner: outputting soln that uses columnstore index to provide "
+                          "projection.";
+                out.push_back(std::move(soln));
+                break;
+            }
+        }
+    }
+
+    // If there is still no indexed plan, a compound index may be able to answer a predicate on one
+    // of its trailing fields by skipping over the distinct values of its leading fields. Whether
+    // that beats a collection scan depends on the number of such values, so the collection scan is
+    // also generated and the two are ranked against each other.
+    bool onlySkipScans = false;
+    if (params.options & QueryPlannerParams::GENERATE_SKIP_SCANS && out.size() == 0 &&
+        hintedIndex.isEmpty() && !isTailable &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::GEO_NEAR) &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::TEXT)) {
+        for (auto&& index : fullIndexList) {
+            if (out.size() >= params.maxIndexedSolutions) {
+                break;
+            }
+
+            auto soln = buildSkipScanSoln(index, query, params);
+            if (soln) {
+                LOG(5) << "Planner: outputting soln that skip-scans index " << index.identifier;
+                PlanCacheIndexTree* indexTree = new PlanCacheIndexTree();
+                indexTree->setIndexEntry(index);
+
+                SolutionCacheData* scd = new SolutionCacheData();
+                scd->tree.reset(indexTree);
+                scd->solnType = SolutionCacheData::SKIP_SCAN_SOLN;
+                soln->cacheData.reset(scd);
+
+                out.push_back(std::move(soln));
+            }
+        }
+        onlySkipScans = out.size() > 0;
+    }
+
     // geoNear and text queries *require* an index.
     // Also, if a hint is specified it indicates that we MUST use it.
     bool possibleToCollscan =
@@ -989,7 +1233,7 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
     bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN);
 
     // No indexed plans?  We must provide a collscan if possible or else we can't run the query.
-    bool collscanNeeded = (0 == out.size() && canTableScan);
+    bool collscanNeeded = ((0 == out.size() || onlySkipScans) && canTableScan);
 
     if (possibleToCollscan && (collscanRequested || collscanNeeded)) {
         auto collscan = buildCollscanSoln(query, isTailable, params);
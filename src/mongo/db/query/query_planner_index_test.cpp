@@ -1310,5 +1310,74 @@ TEST_F(QueryPlannerTest, MustFetchWhenNotAllSortKeysAreCoveredByIndex) {
 }
 
 
+TEST_F(QueryPlannerTest, SkipScanGeneratedForPredicateOnTrailingField) {
+    params.options = QueryPlannerParams::GENERATE_SKIP_SCANS;
+    addIndex(fromjson("{a: 1, b: 1}"));
+
+    runQuery(fromjson("{b: {$gte: 3, $lt: 5}}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{fetch: {filter: {b: {$gte: 3, $lt: 5}}, node: {ixscan: {pattern: {a: 1, b: 1}, "
+        "bounds: {a: [['MinKey', 'MaxKey', true, true]], b: [[3, 5, true, false]]}}}}}");
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanUsesAllValuesBoundsForEachUnconstrainedField) {
+    params.options = QueryPlannerParams::GENERATE_SKIP_SCANS;
+    addIndex(fromjson("{a: 1, b: -1, c: 1}"));
+
+    runQuery(fromjson("{c: {$in: [1, 4]}, d: 1}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{fetch: {filter: {c: {$in: [1, 4]}, d: 1}, node: {ixscan: {pattern: {a: 1, b: -1, c: 1}, "
+        "bounds: {a: [['MinKey', 'MaxKey', true, true]], b: [['MaxKey', 'MinKey', true, true]], "
+        "c: [[1, 1, true, true], [4, 4, true, true]]}}}}}");
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanNotGeneratedWithoutOption) {
+    addIndex(fromjson("{a: 1, b: 1}"));
+
+    runQuery(fromjson("{b: 3}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanNotGeneratedWhenRegularIndexedPlanExists) {
+    params.options = QueryPlannerParams::GENERATE_SKIP_SCANS;
+    addIndex(fromjson("{a: 1, b: 1}"));
+    addIndex(fromjson("{b: 1}"));
+
+    runQuery(fromjson("{b: 3}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{fetch: {filter: null, node: {ixscan: {pattern: {b: 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanNotGeneratedForSparseIndex) {
+    params.options = QueryPlannerParams::GENERATE_SKIP_SCANS;
+    addIndex(fromjson("{a: 1, b: 1}"), false /* multikey */, true /* sparse */);
+
+    runQuery(fromjson("{b: 3}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+}
+
+TEST_F(QueryPlannerTest, HintedIndexIsSkipScannedWhenLeadingFieldIsUnconstrained) {
+    params.options = QueryPlannerParams::GENERATE_SKIP_SCANS;
+    addIndex(fromjson("{a: 1, b: 1}"));
+
+    runQueryHint(fromjson("{b: 3}"), fromjson("{a: 1, b: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: {b: 3}, node: {ixscan: {pattern: {a: 1, b: 1}, "
+        "bounds: {a: [['MinKey', 'MaxKey', true, true]], b: [[3, 3, true, true]]}}}}}");
+}
+
 }  // namespace
 }  // namespace mongo
@@ -91,6 +91,11 @@ struct QueryPlannerParams {
         // return exactly one document per value of the distinct field. See the comments above the
         // declaration of getExecutorDistinct() for more detail.
         STRICT_DISTINCT_ONLY = 1 << 9,
+
+        // Set this to generate IXSCAN plans over compound indexes whose leading fields have no
+        // predicate. The scan skips from one distinct value of the leading fields to the next,
+        // seeking into the bounds of the trailing fields under each.
+        GENERATE_SKIP_SCANS = 1 << 10,
     };
 
     // See Options enum above.
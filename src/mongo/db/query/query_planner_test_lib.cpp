@@ -403,7 +403,8 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
                                          "diacriticSensitive",
                                          "prefix",
                                          "collation",
-                                         "filter"}));
+                                         "filter",
+                                         "topK"}));
 
         BSONElement searchElt = textObj["search"];
         if (!searchElt.eoo()) {
@@ -444,6 +445,13 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
             }
         }
 
+        BSONElement topKElt = textObj["topK"];
+        if (!topKElt.eoo()) {
+            if (!topKElt.isNumber() || topKElt.numberLong() != static_cast<long long>(node->topK)) {
+                return false;
+            }
+        }
+
         BSONObj collation;
         if (BSONElement collationElt = textObj["collation"]) {
             if (!collationElt.isABSONObj()) {
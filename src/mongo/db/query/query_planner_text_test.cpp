@@ -439,6 +439,49 @@ TEST_F(QueryPlannerTest, SortKeyMetaProjectionWithTextScoreMetaSort) {
         "{sortKeyGen: {node: {text: {search: 'foo'}}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, TextScoreSortWithLimitLimitsTextStage) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx" << 1));
+
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {$text: {$search: 'foo bar'}}, sort: {a: {$meta: "
+                 "'textScore'}}, projection: {a: {$meta: 'textScore'}}, skip: 2, limit: 3}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {a: {$meta: 'textScore'}}, node: {skip: {n: 2, node: "
+        "{sort: {limit: 5, pattern: {a: {$meta: 'textScore'}}, node: "
+        "{sortKeyGen: {node: {text: {search: 'foo bar', topK: 5}}}}}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, TextStageIsNotLimitedBelowOtherStages) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx" << 1));
+
+    // The TEXT stage is not limited when a filter sits between it and the sort, or when the sort is
+    // not only on the text score.
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {$text: {$search: 'foo'}, b: 1}, sort: {a: {$meta: "
+                 "'textScore'}}, projection: {a: {$meta: 'textScore'}}, limit: 3}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {a: {$meta: 'textScore'}}, node: "
+        "{sort: {limit: 3, pattern: {a: {$meta: 'textScore'}}, node: "
+        "{sortKeyGen: {node: {fetch: {filter: {b: 1}, node: "
+        "{text: {search: 'foo', topK: 0}}}}}}}}}}");
+
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {$text: {$search: 'foo'}}, sort: {a: {$meta: "
+                 "'textScore'}, b: 1}, projection: {a: {$meta: 'textScore'}}, limit: 3}"));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {a: {$meta: 'textScore'}}, node: "
+        "{sort: {limit: 3, pattern: {a: {$meta: 'textScore'}, b: 1}, node: "
+        "{sortKeyGen: {node: {text: {search: 'foo', topK: 0}}}}}}}}");
+}
+
 TEST_F(QueryPlannerTest, PredicatesOverLeadingFieldsWithSharedPathPrefixHandledCorrectly) {
     const bool multikey = true;
     addIndex(BSON("a.x" << 1 << "a.y" << 1 << "b.x" << 1 << "b.y" << 1 << "_fts"
@@ -37,6 +37,7 @@
 #include "mongo/bson/bsontypes.h"
 #include "mongo/bson/mutable/document.h"
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/field_ref.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/query/collation/collation_index_key.h"
@@ -207,6 +208,10 @@ void TextNode::appendToString(str::stream* ss, int indent) const {
     *ss << "diacriticSensitive= " << ftsQuery->getDiacriticSensitive() << '\n';
     addIndent(ss, indent + 1);
     *ss << "indexPrefix = " << indexPrefix.toString() << '\n';
+    if (topK) {
+        addIndent(ss, indent + 1);
+        *ss << "topK = " << topK << '\n';
+    }
     if (nullptr != filter) {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->debugString();
@@ -221,6 +226,7 @@ QuerySolutionNode* TextNode::clone() const {
     copy->_sort = this->_sort;
     copy->ftsQuery = this->ftsQuery->clone();
     copy->indexPrefix = this->indexPrefix;
+    copy->topK = this->topK;
 
     return copy;
 }
@@ -258,6 +264,42 @@ QuerySolutionNode* CollectionScanNode::clone() const {
     return copy;
 }
 
+//
+// ColumnScanNode
+//
+
+ColumnScanNode::ColumnScanNode(IndexEntry index, std::vector<std::string> paths)
+    : _sort(SimpleBSONObjComparator::kInstance.makeBSONObjSet()),
+      index(std::move(index)),
+      paths(std::move(paths)) {}
+
+void ColumnScanNode::appendToString(str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "COLUMN_SCAN\n";
+    addIndent(ss, indent + 1);
+    *ss << "name = " << index.identifier.catalogName << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "paths = [" << boost::algorithm::join(paths, ", ") << "]\n";
+    addCommon(ss, indent);
+}
+
+bool ColumnScanNode::hasField(const std::string& field) const {
+    // Every column holds the whole value of its path, so any path beneath it is available too.
+    const FieldRef fieldRef(field);
+    return std::any_of(paths.begin(), paths.end(), [&](const std::string& path) {
+        return FieldRef(path).isPrefixOfOrEqualTo(fieldRef);
+    });
+}
+
+QuerySolutionNode* ColumnScanNode::clone() const {
+    ColumnScanNode* copy = new ColumnScanNode(this->index, this->paths);
+    cloneBaseData(copy);
+
+    copy->_sort = this->_sort;
+
+    return copy;
+}
+
 //
 // AndHashNode
 //
@@ -287,6 +287,9 @@ struct TextNode : public QuerySolutionNode {
     // text node while creating the text leaf node and convert them into a BSONObj index prefix
     // when we finish the text leaf node.
     BSONObj indexPrefix;
+
+    // If nonzero, the results are sorted by text score and only the first 'topK' are needed.
+    size_t topK = 0;
 };
 
 struct CollectionScanNode : public QuerySolutionNode {
@@ -345,6 +348,41 @@ struct CollectionScanNode : public QuerySolutionNode {
     bool stopApplyingFilterAfterFirstMatch = false;
 };
 
+/**
+ * Reads the columns for 'paths' from a column store index and reassembles, for every record in the
+ * collection, a document containing only those paths.
+ */
+struct ColumnScanNode : public QuerySolutionNode {
+    ColumnScanNode(IndexEntry index, std::vector<std::string> paths);
+    virtual ~ColumnScanNode() {}
+
+    virtual StageType getType() const {
+        return STAGE_COLUMN_SCAN;
+    }
+
+    virtual void appendToString(str::stream* ss, int indent) const;
+
+    bool fetched() const {
+        return false;
+    }
+    bool hasField(const std::string& field) const;
+    bool sortedByDiskLoc() const {
+        return false;
+    }
+    const BSONObjSet& getSort() const {
+        return _sort;
+    }
+
+    QuerySolutionNode* clone() const;
+
+    BSONObjSet _sort;
+
+    IndexEntry index;
+
+    // The columns to read. Each reassembled document holds the values of these paths only.
+    std::vector<std::string> paths;
+};
+
 struct AndHashNode : public QuerySolutionNode {
     AndHashNode();
     virtual ~AndHashNode();
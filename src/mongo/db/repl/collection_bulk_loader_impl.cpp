@@ -64,7 +64,8 @@ CollectionBulkLoaderImpl::CollectionBulkLoaderImpl(ServiceContext::UniqueClient&
       _nss{_autoColl->getCollection()->ns()},
       _idIndexBlock(std::make_unique<MultiIndexBlock>()),
       _secondaryIndexesBlock(std::make_unique<MultiIndexBlock>()),
-      _idIndexSpec(idIndexSpec.getOwned()) {
+      _idIndexSpec(idIndexSpec.getOwned()),
+      _deferSecondaryIndexBuilds(initialSyncDeferSecondaryIndexBuilds.load()) {
 
     invariant(_opCtx);
     invariant(_collection);
@@ -215,96 +216,47 @@ Status CollectionBulkLoaderImpl::commit() {
         LOG(2) << "Creating indexes for ns: " << _nss.ns();
         UnreplicatedWritesBlock uwb(_opCtx.get());
 
-        // Commit before deleting dups, so the dups will be removed from secondary indexes when
-        // deleted.
-        if (_secondaryIndexesBlock) {
-            auto status = _secondaryIndexesBlock->dumpInsertsFromBulk(_opCtx.get());
-            if (!status.isOK()) {
-                return status;
-            }
-
-            // This should always return Status::OK() as secondary index builds ignore duplicate key
-            // constraints causing them to not be recorded.
-            invariant(_secondaryIndexesBlock->checkConstraints(_opCtx.get()));
-
-            status = writeConflictRetry(
-                _opCtx.get(), "CollectionBulkLoaderImpl::commit", _nss.ns(), [this] {
-                    WriteUnitOfWork wunit(_opCtx.get());
-                    auto status =
-                        _secondaryIndexesBlock->commit(_opCtx.get(),
-                                                       _collection,
-                                                       MultiIndexBlock::kNoopOnCreateEachFn,
-                                                       MultiIndexBlock::kNoopOnCommitFn);
-                    if (!status.isOK()) {
-                        return status;
-                    }
-                    wunit.commit();
-                    return Status::OK();
-                });
-            if (!status.isOK()) {
-                return status;
-            }
-        }
-
-        if (_idIndexBlock) {
-            // Gather RecordIds for uninserted duplicate keys to delete.
-            std::set<RecordId> dups;
-            // Do not do inside a WriteUnitOfWork (required by dumpInsertsFromBulk).
-            auto status = _idIndexBlock->dumpInsertsFromBulk(_opCtx.get(), &dups);
-            if (!status.isOK()) {
-                return status;
+        if (_deferSecondaryIndexBuilds) {
+            // Duplicate _id values are removed before any key is added to the secondary indexes,
+            // so they never need to be unindexed from them.
+            if (_idIndexBlock) {
+                auto status = _commitIdIndex();
+                if (!status.isOK()) {
+                    return status;
+                }
             }
 
-            // If we were to delete the documents after committing the index build, it's possible
-            // that the storage engine unindexes a different record with the same key, but different
-            // RecordId. By deleting documents before committing the index build, the index removal
-            // code uses 'dupsAllowed', which forces the storage engine to only unindex records that
-            // match the same key and RecordId.
-            for (auto&& it : dups) {
-                writeConflictRetry(
-                    _opCtx.get(), "CollectionBulkLoaderImpl::commit", _nss.ns(), [this, &it] {
-                        WriteUnitOfWork wunit(_opCtx.get());
-                        _autoColl->getCollection()->deleteDocument(_opCtx.get(),
-                                                                   kUninitializedStmtId,
-                                                                   it,
-                                                                   nullptr /** OpDebug **/,
-                                                                   false /* fromMigrate */,
-                                                                   true /* noWarn */);
-                        wunit.commit();
-                    });
-            }
+            if (_secondaryIndexesBlock) {
+                auto status = _addAllDocumentsToSecondaryIndexesBlock();
+                if (!status.isOK()) {
+                    return status;
+                }
 
-            status = _idIndexBlock->drainBackgroundWrites(
-                _opCtx.get(),
-                RecoveryUnit::ReadSource::kUnset,
-                _nss.isSystemDotViews() ? IndexBuildInterceptor::DrainYieldPolicy::kNoYield
-                                        : IndexBuildInterceptor::DrainYieldPolicy::kYield);
-            if (!status.isOK()) {
-                return status;
+                status = _commitSecondaryIndexes();
+                if (!status.isOK()) {
+                    return status;
+                }
             }
+        } else {
+            // Commit before deleting dups, so the dups will be removed from secondary indexes when
+            // deleted.
+            if (_secondaryIndexesBlock) {
+                auto status = _secondaryIndexesBlock->dumpInsertsFromBulk(_opCtx.get());
+                if (!status.isOK()) {
+                    return status;
+                }
 
-            status = _idIndexBlock->checkConstraints(_opCtx.get());
-            if (!status.isOK()) {
-                return status;
+                status = _commitSecondaryIndexes();
+                if (!status.isOK()) {
+                    return status;
+                }
             }
 
-            // Commit the _id index, there won't be any documents with duplicate _ids as they were
-            // deleted prior to this.
-            status = writeConflictRetry(
-                _opCtx.get(), "CollectionBulkLoaderImpl::commit", _nss.ns(), [this] {
-                    WriteUnitOfWork wunit(_opCtx.get());
-                    auto status = _idIndexBlock->commit(_opCtx.get(),
-                                                        _collection,
-                                                        MultiIndexBlock::kNoopOnCreateEachFn,
-                                                        MultiIndexBlock::kNoopOnCommitFn);
-                    if (!status.isOK()) {
-                        return status;
-                    }
-                    wunit.commit();
-                    return Status::OK();
-                });
-            if (!status.isOK()) {
-                return status;
+            if (_idIndexBlock) {
+                auto status = _commitIdIndex();
+                if (!status.isOK()) {
+                    return status;
+                }
             }
         }
 
@@ -316,6 +268,95 @@ Status CollectionBulkLoaderImpl::commit() {
     });
 }
 
+Status CollectionBulkLoaderImpl::_addAllDocumentsToSecondaryIndexesBlock() {
+    invariant(_secondaryIndexesBlock);
+
+    // Scans the record store once, feeding every document to the external sorters of all the
+    // secondary indexes, and then dumps the sorted keys into the indexes. The scan takes care of
+    // the lifetime of its cursor across the units of work it inserts in.
+    return _secondaryIndexesBlock->insertAllDocumentsInCollection(_opCtx.get(), _collection);
+}
+
+Status CollectionBulkLoaderImpl::_commitSecondaryIndexes() {
+    invariant(_secondaryIndexesBlock);
+
+    // This should always return Status::OK() as secondary index builds ignore duplicate key
+    // constraints causing them to not be recorded.
+    invariant(_secondaryIndexesBlock->checkConstraints(_opCtx.get()));
+
+    return writeConflictRetry(_opCtx.get(), "CollectionBulkLoaderImpl::commit", _nss.ns(), [this] {
+        WriteUnitOfWork wunit(_opCtx.get());
+        auto status = _secondaryIndexesBlock->commit(_opCtx.get(),
+                                                     _collection,
+                                                     MultiIndexBlock::kNoopOnCreateEachFn,
+                                                     MultiIndexBlock::kNoopOnCommitFn);
+        if (!status.isOK()) {
+            return status;
+        }
+        wunit.commit();
+        return Status::OK();
+    });
+}
+
+Status CollectionBulkLoaderImpl::_commitIdIndex() {
+    invariant(_idIndexBlock);
+    // Gather RecordIds for uninserted duplicate keys to delete.
+    std::set<RecordId> dups;
+    // Do not do inside a WriteUnitOfWork (required by dumpInsertsFromBulk).
+    auto status = _idIndexBlock->dumpInsertsFromBulk(_opCtx.get(), &dups);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    // If we were to delete the documents after committing the index build, it's possible
+    // that the storage engine unindexes a different record with the same key, but different
+    // RecordId. By deleting documents before committing the index build, the index removal
+    // code uses 'dupsAllowed', which forces the storage engine to only unindex records that
+    // match the same key and RecordId.
+    for (auto&& it : dups) {
+        writeConflictRetry(
+            _opCtx.get(), "CollectionBulkLoaderImpl::commit", _nss.ns(), [this, &it] {
+                WriteUnitOfWork wunit(_opCtx.get());
+                _autoColl->getCollection()->deleteDocument(_opCtx.get(),
+                                                           kUninitializedStmtId,
+                                                           it,
+                                                           nullptr /** OpDebug **/,
+                                                           false /* fromMigrate */,
+                                                           true /* noWarn */);
+                wunit.commit();
+            });
+    }
+
+    status = _idIndexBlock->drainBackgroundWrites(
+        _opCtx.get(),
+        RecoveryUnit::ReadSource::kUnset,
+        _nss.isSystemDotViews() ? IndexBuildInterceptor::DrainYieldPolicy::kNoYield
+                                : IndexBuildInterceptor::DrainYieldPolicy::kYield);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    status = _idIndexBlock->checkConstraints(_opCtx.get());
+    if (!status.isOK()) {
+        return status;
+    }
+
+    // Commit the _id index, there won't be any documents with duplicate _ids as they were
+    // deleted prior to this.
+    return writeConflictRetry(_opCtx.get(), "CollectionBulkLoaderImpl::commit", _nss.ns(), [this] {
+        WriteUnitOfWork wunit(_opCtx.get());
+        auto status = _idIndexBlock->commit(_opCtx.get(),
+                                            _collection,
+                                            MultiIndexBlock::kNoopOnCreateEachFn,
+                                            MultiIndexBlock::kNoopOnCommitFn);
+        if (!status.isOK()) {
+            return status;
+        }
+        wunit.commit();
+        return Status::OK();
+    });
+}
+
 void CollectionBulkLoaderImpl::_releaseResources() {
     invariant(&cc() == _opCtx->getClient());
     if (_secondaryIndexesBlock) {
@@ -358,7 +399,7 @@ Status CollectionBulkLoaderImpl::_addDocumentToIndexBlocks(const BSONObj& doc,
         }
     }
 
-    if (_secondaryIndexesBlock) {
+    if (_secondaryIndexesBlock && !_deferSecondaryIndexBuilds) {
         auto status = _secondaryIndexesBlock->insert(_opCtx.get(), doc, loc);
         if (!status.isOK()) {
             return status.withContext("failed to add document to secondary indexes");
@@ -102,6 +102,23 @@ private:
      */
     Status _addDocumentToIndexBlocks(const BSONObj& doc, const RecordId& loc);
 
+    /**
+     * Adds the keys of every document in the record store to the secondary index builders and
+     * dumps them into the indexes, when their build was deferred until all documents were
+     * inserted.
+     */
+    Status _addAllDocumentsToSecondaryIndexesBlock();
+
+    /**
+     * Commits the secondary indexes, once their keys have been dumped from the external sorters.
+     */
+    Status _commitSecondaryIndexes();
+
+    /**
+     * Removes documents with duplicate _id values and commits the _id index.
+     */
+    Status _commitIdIndex();
+
     ServiceContext::UniqueClient _client;
     ServiceContext::UniqueOperationContext _opCtx;
     std::unique_ptr<AutoGetCollection> _autoColl;
@@ -110,6 +127,9 @@ private:
     std::unique_ptr<MultiIndexBlock> _idIndexBlock;
     std::unique_ptr<MultiIndexBlock> _secondaryIndexesBlock;
     BSONObj _idIndexSpec;
+    // Whether keys for the secondary indexes are generated in commit() rather than as documents are
+    // inserted.
+    const bool _deferSecondaryIndexBuilds;
     Stats _stats;
 };
 
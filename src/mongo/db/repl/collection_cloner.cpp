@@ -32,11 +32,15 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/string_data.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/repl/collection_bulk_loader.h"
 #include "mongo/db/repl/collection_cloner.h"
 #include "mongo/db/repl/database_cloner_gen.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/replication_auth.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 
@@ -88,6 +92,14 @@ CollectionCloner::CollectionCloner(const NamespaceString& sourceNss,
           };
           _dbWorkTaskRunner.schedule(std::move(task));
           return executor::TaskExecutor::CallbackHandle();
+      }),
+      _createClientFn([this] {
+          auto client = std::make_unique<DBClientConnection>();
+          uassertStatusOK(client->connect(getSource(), StringData()));
+          uassert(ErrorCodes::AuthenticationFailed,
+                  str::stream() << "Failed to authenticate to " << getSource(),
+                  replAuthenticate(client.get()));
+          return client;
       }) {
     invariant(sourceNss.isValid());
     invariant(collectionOptions.uuid);
@@ -167,13 +179,12 @@ BaseCloner::AfterStageBehavior CollectionCloner::createCollectionStage() {
 }
 
 BaseCloner::AfterStageBehavior CollectionCloner::queryStage() {
-    getClient()->query([this](DBClientCursorBatchIterator& iter) { handleNextBatch(iter); },
-                       _sourceDbAndUuid,
-                       QUERY("query" << BSONObj() << "$readOnce" << true),
-                       nullptr /* fieldsToReturn */,
-                       QueryOption_NoCursorTimeout | QueryOption_SlaveOk |
-                           (collectionClonerUsesExhaust ? QueryOption_Exhaust : 0),
-                       _collectionClonerBatchSize);
+    auto splitKeys = fetchSplitKeys();
+    if (splitKeys.empty()) {
+        runQuery(getClient(), boost::none);
+    } else {
+        runRangeQueries(splitKeys);
+    }
     _dbWorkTaskRunner.join();
     // We want to free the _collLoader regardless of whether the commit succeeds.
     std::unique_ptr<CollectionBulkLoader> loader = std::move(_collLoader);
@@ -181,7 +192,152 @@ BaseCloner::AfterStageBehavior CollectionCloner::queryStage() {
     return kContinueNormally;
 }
 
-void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
+std::vector<BSONObj> CollectionCloner::fetchSplitKeys() {
+    if (collectionClonerPartitions <= 1 || _collectionOptions.capped || _idIndexSpec.isEmpty()) {
+        return {};
+    }
+
+    long long documentsToCopy;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        documentsToCopy = _stats.documentToCopy;
+    }
+    if (documentsToCopy < collectionClonerPartitionMinDocuments) {
+        return {};
+    }
+
+    // The split points are only an optimization, so if we cannot get them we clone the collection
+    // with a single query.
+    std::vector<BSONObj> splitKeys;
+    try {
+        BSONObj collStatsResponse;
+        getClient()->runCommand(_sourceNss.db().toString(),
+                                BSON("collStats" << _sourceNss.coll()),
+                                collStatsResponse,
+                                QueryOption_SlaveOk);
+        uassertStatusOK(getStatusFromCommandResult(collStatsResponse));
+        const long long dataSize = collStatsResponse["size"].safeNumberLong();
+
+        // Ask for ranges of equal document counts. splitVector only returns split points when
+        // the collection holds at least 'maxChunkSizeBytes', so we pass the size of the whole
+        // collection and let 'maxChunkObjects' determine the size of the ranges.
+        const long long documentsPerRange =
+            (documentsToCopy + collectionClonerPartitions - 1) / collectionClonerPartitions;
+        BSONObj splitVectorResponse;
+        getClient()->runCommand(_sourceNss.db().toString(),
+                                BSON("splitVector" << _sourceNss.ns() << "keyPattern"
+                                                   << BSON("_id" << 1) << "maxChunkSizeBytes"
+                                                   << std::max(dataSize, 1LL) << "maxChunkObjects"
+                                                   << documentsPerRange << "maxSplitPoints"
+                                                   << collectionClonerPartitions - 1),
+                                splitVectorResponse,
+                                QueryOption_SlaveOk);
+        uassertStatusOK(getStatusFromCommandResult(splitVectorResponse));
+        for (auto&& splitKey : splitVectorResponse["splitKeys"].Obj()) {
+            splitKeys.push_back(splitKey.Obj().getOwned());
+        }
+    } catch (const DBException& ex) {
+        warning() << "Failed to get split points for collection " << _sourceNss
+                  << ", cloning it over a single connection: " << redact(ex);
+        return {};
+    }
+
+    if (!splitKeys.empty()) {
+        log() << "Cloning collection " << _sourceNss << " in " << splitKeys.size() + 1
+              << " _id ranges";
+    }
+    return splitKeys;
+}
+
+void CollectionCloner::runRangeQueries(const std::vector<BSONObj>& splitKeys) {
+    const size_t numRanges = splitKeys.size() + 1;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (size_t i = 0; i < numRanges; ++i) {
+            RangeStats range;
+            range.min = i > 0 ? splitKeys[i - 1] : BSONObj();
+            range.max = i < splitKeys.size() ? splitKeys[i] : BSONObj();
+            _stats.ranges.push_back(std::move(range));
+        }
+    }
+
+    std::vector<Status> statuses(numRanges, Status::OK());
+    auto cloneRange = [&](DBClientConnection* client, size_t rangeIndex) {
+        try {
+            runQuery(client, rangeIndex);
+        } catch (const DBException& ex) {
+            // Make the clones of the other ranges stop as well.
+            statuses[rangeIndex] = ex.toStatus();
+            setInitialSyncFailedStatus(statuses[rangeIndex]);
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    for (size_t i = 1; i < numRanges; ++i) {
+        threads.emplace_back([&, i] {
+            Client::initThread(str::stream() << "CollectionClonerRange-" << i);
+            std::unique_ptr<DBClientConnection> client;
+            try {
+                client = _createClientFn();
+            } catch (const DBException& ex) {
+                statuses[i] = ex.toStatus();
+                setInitialSyncFailedStatus(statuses[i]);
+                return;
+            }
+            cloneRange(client.get(), i);
+        });
+    }
+    cloneRange(getClient(), 0);
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    for (auto&& status : statuses) {
+        uassertStatusOK(status);
+    }
+}
+
+void CollectionCloner::runQuery(DBClientConnection* client, boost::optional<size_t> rangeIndex) {
+    BSONObjBuilder queryBuilder;
+    queryBuilder.append("query", BSONObj());
+    queryBuilder.append("$readOnce", true);
+    if (rangeIndex) {
+        // Use index bounds rather than a predicate on _id, so that the ranges also partition
+        // _id values of different types.
+        BSONObj min, max;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            min = _stats.ranges[*rangeIndex].min;
+            max = _stats.ranges[*rangeIndex].max;
+        }
+        queryBuilder.append("$hint", BSON("_id" << 1));
+        if (!min.isEmpty()) {
+            queryBuilder.append("$min", min);
+        }
+        if (!max.isEmpty()) {
+            queryBuilder.append("$max", max);
+        }
+    }
+
+    client->query(
+        [this, rangeIndex](DBClientCursorBatchIterator& iter) {
+            handleNextBatch(iter, rangeIndex);
+        },
+        _sourceDbAndUuid,
+        Query(queryBuilder.obj()),
+        nullptr /* fieldsToReturn */,
+        QueryOption_NoCursorTimeout | QueryOption_SlaveOk |
+            (collectionClonerUsesExhaust ? QueryOption_Exhaust : 0),
+        _collectionClonerBatchSize);
+
+    if (rangeIndex) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _stats.ranges[*rangeIndex].finished = true;
+    }
+}
+
+void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter,
+                                       boost::optional<size_t> rangeIndex) {
     {
         stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
         if (!getSharedData()->getInitialSyncStatus(lk).isOK()) {
@@ -196,8 +352,15 @@ void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
     {
         stdx::lock_guard<Latch> lk(_mutex);
         _stats.receivedBatches++;
+        size_t numDocuments = 0;
         while (iter.moreInCurrentBatch()) {
             _documentsToInsert.emplace_back(iter.nextSafe());
+            ++numDocuments;
+        }
+        if (rangeIndex) {
+            auto& range = _stats.ranges[*rangeIndex];
+            range.receivedBatches++;
+            range.documentsReceived += numDocuments;
         }
     }
 
@@ -301,6 +464,26 @@ void CollectionCloner::Stats::append(BSONObjBuilder* builder) const {
         }
     }
     builder->appendNumber("receivedBatches", receivedBatches);
+    if (!ranges.empty()) {
+        BSONArrayBuilder rangesBuilder(builder->subarrayStart("ranges"));
+        for (auto&& range : ranges) {
+            rangesBuilder.append(range.toBSON());
+        }
+    }
+}
+
+BSONObj CollectionCloner::RangeStats::toBSON() const {
+    BSONObjBuilder bob;
+    if (!min.isEmpty()) {
+        bob.append("min", min);
+    }
+    if (!max.isEmpty()) {
+        bob.append("max", max);
+    }
+    bob.appendNumber("documentsReceived", documentsReceived);
+    bob.appendNumber("receivedBatches", receivedBatches);
+    bob.append("finished", finished);
+    return bob.obj();
 }
 
 }  // namespace repl
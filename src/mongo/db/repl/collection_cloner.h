@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -46,6 +47,20 @@ const int kProgressMeterCheckInterval = 128;
 
 class CollectionCloner final : public BaseCloner {
 public:
+    /**
+     * Progress of the clone of one _id range of a collection which is cloned over several
+     * connections.
+     */
+    struct RangeStats {
+        BSONObj min;  // Inclusive {_id: <value>} bound. Empty for the first range.
+        BSONObj max;  // Exclusive {_id: <value>} bound. Empty for the last range.
+        size_t documentsReceived{0};
+        size_t receivedBatches{0};
+        bool finished{false};
+
+        BSONObj toBSON() const;
+    };
+
     struct Stats {
         static constexpr StringData kDocumentsToCopyFieldName = "documentsToCopy"_sd;
         static constexpr StringData kDocumentsCopiedFieldName = "documentsCopied"_sd;
@@ -58,6 +73,7 @@ public:
         size_t indexes{0};
         size_t fetchedBatches{0};  // This is actually inserted batches.
         size_t receivedBatches{0};
+        std::vector<RangeStats> ranges;  // Empty unless the collection is cloned in ranges.
 
         std::string toString() const;
         BSONObj toBSON() const;
@@ -72,6 +88,12 @@ public:
     using ScheduleDbWorkFn = unique_function<StatusWith<executor::TaskExecutor::CallbackHandle>(
         executor::TaskExecutor::CallbackFn)>;
 
+    /**
+     * Type of function to create and connect the additional clients used to clone a collection in
+     * several _id ranges.
+     */
+    using CreateClientFn = std::function<std::unique_ptr<DBClientConnection>()>;
+
     CollectionCloner(const NamespaceString& ns,
                      const CollectionOptions& collectionOptions,
                      InitialSyncSharedData* sharedData,
@@ -104,6 +126,15 @@ public:
         _collectionClonerBatchSize = batchSize;
     }
 
+    /**
+     * Overrides how the clients used to clone _id ranges are created.
+     *
+     * Used for testing only.
+     */
+    void setCreateClientFn_forTest(CreateClientFn createClientFn) {
+        _createClientFn = std::move(createClientFn);
+    }
+
 protected:
     ClonerStages getStages() final;
 
@@ -149,11 +180,31 @@ private:
      */
     AfterStageBehavior queryStage();
 
+    /**
+     * Asks the sync source for the _id values at which to split the collection so that it can be
+     * cloned over several connections. Returns an empty vector if the collection should be cloned
+     * with a single query.
+     */
+    std::vector<BSONObj> fetchSplitKeys();
+
+    /**
+     * Clones the ranges of _id values delimited by 'splitKeys', each one over its own connection
+     * to the sync source. The first range is cloned on this thread using the cloner's client.
+     */
+    void runRangeQueries(const std::vector<BSONObj>& splitKeys);
+
+    /**
+     * Queries the sync source for the documents of the collection using 'client', passing each
+     * batch to handleNextBatch(). If 'rangeIndex' is set, only the documents of that _id range
+     * are retrieved.
+     */
+    void runQuery(DBClientConnection* client, boost::optional<size_t> rangeIndex);
+
     /**
      * Put all results from a query batch into a buffer to be inserted, and schedule
      * it to be inserted.
      */
-    void handleNextBatch(DBClientCursorBatchIterator& iter);
+    void handleNextBatch(DBClientCursorBatchIterator& iter, boost::optional<size_t> rangeIndex);
 
     /**
      * Called whenever there is a new batch of documents ready from the DBClientConnection.
@@ -189,6 +240,8 @@ private:
     TaskRunner _dbWorkTaskRunner;                       // (R)
     //  Function for scheduling database work using the executor.
     ScheduleDbWorkFn _scheduleDbWorkFn;  // (R)
+    // Function for creating the clients used to clone _id ranges.
+    CreateClientFn _createClientFn;  // (R)
     // Documents read from source to insert.
     std::vector<BSONObj> _documentsToInsert;  // (M)
     Stats _stats;                             // (M)
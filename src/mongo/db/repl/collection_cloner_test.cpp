@@ -29,17 +29,20 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/db/repl/cloner_test_fixture.h"
 #include "mongo/db/repl/collection_cloner.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/dbtests/mock/mock_dbclient_connection.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
@@ -257,5 +260,115 @@ TEST_F(CollectionClonerTest, InsertDocumentsMultipleBatches) {
     ASSERT_EQUALS(2u, stats.receivedBatches);
 }
 
+TEST_F(CollectionClonerTest, InsertDocumentsInIdRanges) {
+    const auto originalPartitions = collectionClonerPartitions;
+    const auto originalMinDocuments = collectionClonerPartitionMinDocuments;
+    ON_BLOCK_EXIT([&] {
+        collectionClonerPartitions = originalPartitions;
+        collectionClonerPartitionMinDocuments = originalMinDocuments;
+    });
+    collectionClonerPartitions = 3;
+    collectionClonerPartitionMinDocuments = 1;
+
+    // Set up data for preliminary stages
+    auto idIndexSpec = BSON("v" << 1 << "key" << BSON("_id" << 1) << "name"
+                                << "_id_");
+    _mockServer->setCommandReply("count", createCountResponse(3));
+    _mockServer->setCommandReply("listIndexes",
+                                 createCursorResponse(_nss.ns(), BSON_ARRAY(idIndexSpec)));
+    _mockServer->setCommandReply("collStats", BSON("size" << 300 << "ok" << 1));
+    _mockServer->setCommandReply(
+        "splitVector", BSON("splitKeys" << BSON_ARRAY(BSON("_id" << 2) << BSON("_id" << 3)) << "ok"
+                                        << 1));
+
+    // Set up documents to be returned from upstream node.
+    _mockServer->insert(_nss.ns(), BSON("_id" << 1));
+    _mockServer->insert(_nss.ns(), BSON("_id" << 2));
+    _mockServer->insert(_nss.ns(), BSON("_id" << 3));
+
+    // Record the _id of every document handed to the loader. The ranges insert one batch at a
+    // time, so no synchronization is needed.
+    std::vector<int> insertedIds;
+    auto createCollectionForBulk = _storageInterface.createCollectionForBulkFn;
+    _storageInterface.createCollectionForBulkFn = [&](const NamespaceString& nss,
+                                                      const CollectionOptions& options,
+                                                      const BSONObj idIndexSpec,
+                                                      const std::vector<BSONObj>& nonIdIndexSpecs)
+        -> StatusWith<std::unique_ptr<CollectionBulkLoader>> {
+        auto loader = createCollectionForBulk(nss, options, idIndexSpec, nonIdIndexSpecs);
+        if (!loader.isOK()) {
+            return loader;
+        }
+        _loader->insertDocsFn = [&](const std::vector<BSONObj>::const_iterator begin,
+                                    const std::vector<BSONObj>::const_iterator end) {
+            for (auto it = begin; it != end; ++it) {
+                insertedIds.push_back((*it)["_id"].numberInt());
+            }
+            return Status::OK();
+        };
+        return loader;
+    };
+
+    auto cloner = makeCollectionCloner();
+    cloner->setCreateClientFn_forTest(
+        [this] { return std::make_unique<MockDBClientConnection>(_mockServer.get()); });
+    ASSERT_OK(cloner->run());
+
+    auto stats = cloner->getStats();
+    ASSERT_EQUALS(3u, stats.ranges.size());
+    ASSERT_BSONOBJ_EQ(BSONObj(), stats.ranges[0].min);
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 2), stats.ranges[0].max);
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 2), stats.ranges[1].min);
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 3), stats.ranges[1].max);
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 3), stats.ranges[2].min);
+    ASSERT_BSONOBJ_EQ(BSONObj(), stats.ranges[2].max);
+
+    // The ranges partition the collection: each document is cloned exactly once.
+    for (auto&& range : stats.ranges) {
+        ASSERT_TRUE(range.finished);
+        ASSERT_EQUALS(1u, range.receivedBatches);
+        ASSERT_EQUALS(1u, range.documentsReceived);
+    }
+    ASSERT_EQUALS(3u, stats.receivedBatches);
+    ASSERT_EQUALS(3, _collectionStats->insertCount);
+    std::sort(insertedIds.begin(), insertedIds.end());
+    ASSERT(insertedIds == std::vector<int>({1, 2, 3}));
+    ASSERT_TRUE(_collectionStats->commitCalled);
+}
+
+TEST_F(CollectionClonerTest, InsertDocumentsWithSingleQueryIfSplitVectorFails) {
+    const auto originalPartitions = collectionClonerPartitions;
+    const auto originalMinDocuments = collectionClonerPartitionMinDocuments;
+    ON_BLOCK_EXIT([&] {
+        collectionClonerPartitions = originalPartitions;
+        collectionClonerPartitionMinDocuments = originalMinDocuments;
+    });
+    collectionClonerPartitions = 3;
+    collectionClonerPartitionMinDocuments = 1;
+
+    // Set up data for preliminary stages
+    auto idIndexSpec = BSON("v" << 1 << "key" << BSON("_id" << 1) << "name"
+                                << "_id_");
+    _mockServer->setCommandReply("count", createCountResponse(2));
+    _mockServer->setCommandReply("listIndexes",
+                                 createCursorResponse(_nss.ns(), BSON_ARRAY(idIndexSpec)));
+    _mockServer->setCommandReply("collStats", BSON("size" << 200 << "ok" << 1));
+    _mockServer->setCommandReply("splitVector",
+                                 Status(ErrorCodes::Unauthorized, "not allowed to split"));
+
+    // Set up documents to be returned from upstream node.
+    _mockServer->insert(_nss.ns(), BSON("_id" << 1));
+    _mockServer->insert(_nss.ns(), BSON("_id" << 2));
+
+    auto cloner = makeCollectionCloner();
+    ASSERT_OK(cloner->run());
+
+    auto stats = cloner->getStats();
+    ASSERT_TRUE(stats.ranges.empty());
+    ASSERT_EQUALS(1u, stats.receivedBatches);
+    ASSERT_EQUALS(2, _collectionStats->insertCount);
+    ASSERT_TRUE(_collectionStats->commitCalled);
+}
+
 }  // namespace repl
 }  // namespace mongo
@@ -48,6 +48,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_applier_impl_test_fixture.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/storage_interface_impl.h"
 #include "mongo/db/service_context_d_test_fixture.h"
@@ -56,6 +57,7 @@
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace {
@@ -580,6 +582,89 @@ TEST_F(StorageInterfaceImplTest, CreateCollectionWithIDIndexCommits) {
     ASSERT_EQ(count, 2LL);
 }
 
+TEST_F(StorageInterfaceImplTest, CreateCollectionWithDeferredSecondaryIndexBuildsCommits) {
+    const auto originalDefer = initialSyncDeferSecondaryIndexBuilds.load();
+    ON_BLOCK_EXIT([&] { initialSyncDeferSecondaryIndexBuilds.store(originalDefer); });
+    initialSyncDeferSecondaryIndexBuilds.store(true);
+
+    auto opCtx = getOperationContext();
+    StorageInterfaceImpl storage;
+    auto nss = makeNamespace(_agent);
+    CollectionOptions opts = generateOptionsWithUuid();
+    std::vector<BSONObj> indexes = {BSON("v" << 1 << "key" << BSON("x" << 1) << "name"
+                                             << "x_1")};
+    auto loaderStatus =
+        storage.createCollectionForBulkLoading(nss, opts, makeIdIndexSpec(nss), indexes);
+    ASSERT_OK(loaderStatus.getStatus());
+    auto loader = std::move(loaderStatus.getValue());
+    std::vector<BSONObj> docs = {
+        BSON("_id" << 1 << "x" << 1), BSON("_id" << 1 << "x" << 2), BSON("_id" << 2 << "x" << 3)};
+    ASSERT_OK(loader->insertDocuments(docs.begin(), docs.end()));
+    ASSERT_OK(loader->commit());
+
+    AutoGetCollectionForReadCommand autoColl(opCtx, nss);
+    auto coll = autoColl.getCollection();
+    ASSERT(coll);
+    ASSERT_EQ(coll->getRecordStore()->numRecords(opCtx), 2LL);
+
+    // The document with the duplicate _id was removed before the secondary index was built, so
+    // both indexes have one key per remaining document.
+    auto collIdxCat = coll->getIndexCatalog();
+    auto idIdxDesc = collIdxCat->findIdIndex(opCtx);
+    ASSERT_EQ(getIndexKeyCount(opCtx, collIdxCat, idIdxDesc), 2LL);
+    auto xIdxDesc = collIdxCat->findIndexByName(opCtx, "x_1");
+    ASSERT(xIdxDesc);
+    ASSERT_EQ(getIndexKeyCount(opCtx, collIdxCat, xIdxDesc), 2LL);
+}
+
+TEST_F(StorageInterfaceImplTest,
+       CreateCollectionWithDeferredSecondaryIndexBuildsCommitsDocumentsFromManyBatches) {
+    const auto originalDefer = initialSyncDeferSecondaryIndexBuilds.load();
+    ON_BLOCK_EXIT([&] { initialSyncDeferSecondaryIndexBuilds.store(originalDefer); });
+    initialSyncDeferSecondaryIndexBuilds.store(true);
+
+    // Insert every document in its own storage transaction, so the secondary index build has to
+    // scan records written by many of them.
+    const auto originalBatchSize = collectionBulkLoaderBatchSizeInBytes;
+    ON_BLOCK_EXIT([&] { collectionBulkLoaderBatchSizeInBytes = originalBatchSize; });
+    collectionBulkLoaderBatchSizeInBytes = 1;
+
+    auto opCtx = getOperationContext();
+    StorageInterfaceImpl storage;
+    auto nss = makeNamespace(_agent);
+    CollectionOptions opts = generateOptionsWithUuid();
+    std::vector<BSONObj> indexes = {BSON("v" << 1 << "key" << BSON("x" << 1) << "name"
+                                             << "x_1")};
+    auto loaderStatus =
+        storage.createCollectionForBulkLoading(nss, opts, makeIdIndexSpec(nss), indexes);
+    ASSERT_OK(loaderStatus.getStatus());
+    auto loader = std::move(loaderStatus.getValue());
+
+    const int numDocs = 100;
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < numDocs; ++i) {
+        docs.push_back(BSON("_id" << i << "x" << i));
+    }
+    // The first batch repeats the _id of the last document, so a duplicate is removed too.
+    std::vector<BSONObj> firstBatch = {BSON("_id" << numDocs - 1 << "x" << -1)};
+    ASSERT_OK(loader->insertDocuments(firstBatch.begin(), firstBatch.end()));
+    ASSERT_OK(loader->insertDocuments(docs.begin(), docs.begin() + numDocs / 2));
+    ASSERT_OK(loader->insertDocuments(docs.begin() + numDocs / 2, docs.end()));
+    ASSERT_OK(loader->commit());
+
+    AutoGetCollectionForReadCommand autoColl(opCtx, nss);
+    auto coll = autoColl.getCollection();
+    ASSERT(coll);
+    ASSERT_EQ(coll->getRecordStore()->numRecords(opCtx), numDocs);
+
+    auto collIdxCat = coll->getIndexCatalog();
+    auto idIdxDesc = collIdxCat->findIdIndex(opCtx);
+    ASSERT_EQ(getIndexKeyCount(opCtx, collIdxCat, idIdxDesc), numDocs);
+    auto xIdxDesc = collIdxCat->findIndexByName(opCtx, "x_1");
+    ASSERT(xIdxDesc);
+    ASSERT_EQ(getIndexKeyCount(opCtx, collIdxCat, xIdxDesc), numDocs);
+}
+
 void _testDestroyUncommitedCollectionBulkLoader(
     OperationContext* opCtx,
     const NamespaceString& nss,
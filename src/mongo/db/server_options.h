@@ -103,6 +103,8 @@ struct ServerGlobalParams {
     bool logRenameOnRotate = true;  // True if logging should rename log files on rotate
     bool logWithSyslog = false;     // True if logging to syslog; must not be set if logpath is set.
     bool logV2 = false;  // True if logV1 logging statements should get plumbed through to logV2
+    bool logAsync = false;                // True if logV2 output is written by a background thread.
+    bool logAsyncDropOnOverflow = false;  // True if async logging drops lines instead of blocking.
     int syslogFacility;  // Facility used when appending messages to the syslog.
 
 #ifndef _WIN32
@@ -396,6 +396,27 @@ Status storeBaseOptions(const moe::Environment& params) {
         }
     }
 
+    if (params.count("systemLog.asyncLogging") &&
+        params["systemLog.asyncLogging"].as<bool>() == true) {
+        if (!serverGlobalParams.logV2)
+            return Status(ErrorCodes::BadValue,
+                          "Can only use systemLog.asyncLogging if logv2 is enabled.");
+        serverGlobalParams.logAsync = true;
+    }
+
+    if (params.count("systemLog.asyncLoggingOverflowPolicy")) {
+        std::string policyStr = params["systemLog.asyncLoggingOverflowPolicy"].as<string>();
+        if (policyStr == "block") {
+            serverGlobalParams.logAsyncDropOnOverflow = false;
+        } else if (policyStr == "drop") {
+            serverGlobalParams.logAsyncDropOnOverflow = true;
+        } else {
+            return Status(ErrorCodes::BadValue,
+                          "Unsupported value for asyncLoggingOverflowPolicy: " + policyStr +
+                              ". Valid values are: block or drop");
+        }
+    }
+
     if (params.count("systemLog.logAppend") && params["systemLog.logAppend"].as<bool>() == true) {
         serverGlobalParams.logAppend = true;
     }
@@ -478,28 +478,25 @@ StatusWith<RecordData> EphemeralForTestRecordStore::updateWithDamages(
     stdx::lock_guard<stdx::recursive_mutex> lock(_data->recordsMutex);
 
     EphemeralForTestRecord* oldRecord = recordFor(lock, loc);
-    const int len = oldRecord->size;
+    const int oldLen = oldRecord->size;
+
+    const std::string newData =
+        mutablebson::applyDamages(oldRecord->data.get(), oldLen, damageSource, damages);
+    const int len = newData.size();
+
+    // Documents in capped collections cannot change size. We check that above the storage layer.
+    invariant(!_isCapped || len == oldLen);
 
     EphemeralForTestRecord newRecord(len);
-    memcpy(newRecord.data.get(), oldRecord->data.get(), len);
+    memcpy(newRecord.data.get(), newData.data(), len);
 
     opCtx->recoveryUnit()->registerChange(
         std::make_unique<RemoveChange>(opCtx, _data, loc, *oldRecord));
+    _data->dataSize += len - oldLen;
     *oldRecord = newRecord;
 
     cappedDeleteAsNeeded(lock, opCtx);
 
-    char* root = newRecord.data.get();
-    mutablebson::DamageVector::const_iterator where = damages.begin();
-    const mutablebson::DamageVector::const_iterator end = damages.end();
-    for (; where != end; ++where) {
-        const char* sourcePtr = damageSource + where->sourceOffset;
-        char* targetPtr = root + where->targetOffset;
-        std::memcpy(targetPtr, sourcePtr, where->size);
-    }
-
-    *oldRecord = newRecord;
-
     return newRecord.toRecordData();
 }
 
@@ -342,6 +342,9 @@ public:
      * 'damages' vector describes contiguous ranges of 'damageSource' from which to copy and apply
      * byte-level changes to the data. Behavior is undefined for calling this on a non-existant loc.
      *
+     * The damages may insert or remove bytes, changing the size of the record, except in a
+     * capped collection.
+     *
      * @return the updated version of the record. If unowned data is returned, then it is valid
      * until the next modification of this Record or the lock on the collection has been released.
      */
@@ -84,12 +84,15 @@ TEST(RecordStoreTestHarness, UpdateWithDamages) {
             dv[0].sourceOffset = 5;
             dv[0].targetOffset = 0;
             dv[0].size = 2;
+            dv[0].targetSize = 2;
             dv[1].sourceOffset = 3;
             dv[1].targetOffset = 2;
             dv[1].size = 3;
+            dv[1].targetSize = 3;
             dv[2].sourceOffset = 0;
             dv[2].targetOffset = 5;
             dv[2].size = 3;
+            dv[2].targetSize = 3;
 
             WriteUnitOfWork uow(opCtx.get());
             auto newRecStatus = rs->updateWithDamages(opCtx.get(), loc, rec, data.c_str(), dv);
@@ -150,9 +153,11 @@ TEST(RecordStoreTestHarness, UpdateWithOverlappingDamageEvents) {
             dv[0].sourceOffset = 3;
             dv[0].targetOffset = 0;
             dv[0].size = 5;
+            dv[0].targetSize = 5;
             dv[1].sourceOffset = 0;
             dv[1].targetOffset = 3;
             dv[1].size = 5;
+            dv[1].targetSize = 5;
 
             WriteUnitOfWork uow(opCtx.get());
             auto newRecStatus = rs->updateWithDamages(opCtx.get(), loc, rec, data.c_str(), dv);
@@ -214,9 +219,11 @@ TEST(RecordStoreTestHarness, UpdateWithOverlappingDamageEventsReversed) {
             dv[0].sourceOffset = 0;
             dv[0].targetOffset = 3;
             dv[0].size = 5;
+            dv[0].targetSize = 5;
             dv[1].sourceOffset = 3;
             dv[1].targetOffset = 0;
             dv[1].size = 5;
+            dv[1].targetSize = 5;
 
             WriteUnitOfWork uow(opCtx.get());
             auto newRecStatus = rs->updateWithDamages(opCtx.get(), loc, rec, data.c_str(), dv);
@@ -235,6 +242,71 @@ TEST(RecordStoreTestHarness, UpdateWithOverlappingDamageEventsReversed) {
     }
 }
 
+// Insert a record and try to perform an update on it with a DamageVector containing DamageEvents
+// which insert and remove bytes, changing the size of the record.
+TEST(RecordStoreTestHarness, UpdateWithDamagesChangingSize) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    if (!rs->updateWithDamagesSupported())
+        return;
+
+    string data = "00010111";
+    RecordId loc;
+    const RecordData rec(data.c_str(), data.size() + 1);
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), rec.data(), rec.size(), Timestamp());
+            ASSERT_OK(res.getStatus());
+            loc = res.getValue();
+            uow.commit();
+        }
+    }
+
+    long long dataSizeBefore;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        dataSizeBefore = rs->dataSize(opCtx.get());
+    }
+
+    // Replace "000" with "abcde", then remove the last "1". The target offset of the second
+    // DamageEvent accounts for the two bytes inserted by the first.
+    string modifiedData = "abcde1011";
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            const char* damageSource = "abcde";
+            mutablebson::DamageVector dv(2);
+            dv[0].sourceOffset = 0;
+            dv[0].targetOffset = 0;
+            dv[0].size = 5;
+            dv[0].targetSize = 3;
+            dv[1].sourceOffset = 0;
+            dv[1].targetOffset = 9;
+            dv[1].size = 0;
+            dv[1].targetSize = 1;
+
+            WriteUnitOfWork uow(opCtx.get());
+            auto newRecStatus = rs->updateWithDamages(opCtx.get(), loc, rec, damageSource, dv);
+            ASSERT_OK(newRecStatus.getStatus());
+            ASSERT_EQUALS(modifiedData, newRecStatus.getValue().data());
+            ASSERT_EQUALS(static_cast<int>(modifiedData.size() + 1),
+                          newRecStatus.getValue().size());
+            uow.commit();
+        }
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        RecordData record = rs->dataFor(opCtx.get(), loc);
+        ASSERT_EQUALS(modifiedData, record.data());
+        ASSERT_EQUALS(dataSizeBefore + 1, rs->dataSize(opCtx.get()));
+    }
+}
+
 // Insert a record and try to call updateWithDamages() with an empty DamageVector.
 TEST(RecordStoreTestHarness, UpdateWithNoDamages) {
     const auto harnessHelper(newRecordStoreHarnessHelper());
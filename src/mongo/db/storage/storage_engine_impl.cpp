@@ -184,6 +184,10 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx) {
         }
     }
 
+    // Register every collection in a single catalog snapshot, instead of copying the whole catalog
+    // once per collection.
+    CollectionCatalog::BatchedPublish batchedPublish(CollectionCatalog::get(opCtx));
+
     KVPrefix maxSeenPrefix = KVPrefix::kNotPrefixed;
     for (const auto& nss : collectionsKnownToCatalog) {
         std::string dbName = nss.db().toString();
@@ -1459,16 +1459,9 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
     const RecordData& oldRec,
     const char* damageSource,
     const mutablebson::DamageVector& damages) {
-
-    const int nentries = damages.size();
-    mutablebson::DamageVector::const_iterator where = damages.begin();
-    const mutablebson::DamageVector::const_iterator end = damages.cend();
-    std::vector<WT_MODIFY> entries(nentries);
-    for (u_int i = 0; where != end; ++i, ++where) {
-        entries[i].data.data = damageSource + where->sourceOffset;
-        entries[i].data.size = where->size;
-        entries[i].offset = where->targetOffset;
-        entries[i].size = where->size;
+    const bool changesSize = mutablebson::damagesChangeSize(damages);
+    if (_oplogStones && changesSize) {
+        return {ErrorCodes::IllegalOperation, "Cannot change the size of a document in the oplog"};
     }
 
     WiredTigerCursor curwrap(_uri, _tableId, true, opCtx);
@@ -1477,15 +1470,45 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
     invariant(c);
     setKey(c, id);
 
-    // The test harness calls us with empty damage vectors which WiredTiger doesn't allow.
-    if (nentries == 0)
+    if (changesSize && _isLogged) {
+        // Damages which shift the rest of the record are not idempotent. As in updateRecord(),
+        // don't trust WiredTiger's recovery with them for logged tables, and write the whole
+        // record instead.
+        std::string newData =
+            mutablebson::applyDamages(oldRec.data(), oldRec.size(), damageSource, damages);
+        WiredTigerItem newValue(newData.data(), newData.size());
+        c->set_value(c, newValue.Get());
+        invariantWTOK(WT_OP_CHECK(c->insert(c)));
         invariantWTOK(WT_OP_CHECK(c->search(c)));
-    else
-        invariantWTOK(WT_OP_CHECK(c->modify(c, entries.data(), nentries)));
+    } else {
+        const int nentries = damages.size();
+        mutablebson::DamageVector::const_iterator where = damages.begin();
+        const mutablebson::DamageVector::const_iterator end = damages.cend();
+        std::vector<WT_MODIFY> entries(nentries);
+        for (u_int i = 0; where != end; ++i, ++where) {
+            entries[i].data.data = damageSource + where->sourceOffset;
+            entries[i].data.size = where->size;
+            entries[i].offset = where->targetOffset;
+            entries[i].size = where->targetSize;
+        }
+
+        // The test harness calls us with empty damage vectors which WiredTiger doesn't allow.
+        if (nentries == 0)
+            invariantWTOK(WT_OP_CHECK(c->search(c)));
+        else
+            invariantWTOK(WT_OP_CHECK(c->modify(c, entries.data(), nentries)));
+    }
 
     WT_ITEM value;
     invariantWTOK(c->get_value(c, &value));
 
+    if (changesSize) {
+        _increaseDataSize(opCtx, static_cast<int64_t>(value.size) - oldRec.size());
+        if (!_oplogStones) {
+            _cappedDeleteAsNeeded(opCtx, id);
+        }
+    }
+
     return RecordData(static_cast<const char*>(value.data), value.size).getOwned();
 }
 
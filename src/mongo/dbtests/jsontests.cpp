@@ -264,6 +264,59 @@ TEST(JsonStringTest, Symbol) {
     ASSERT_EQUALS("{ \"a\" : \"b\" }", b.done().jsonString(Strict));
 }
 
+TEST(JsonStringTest, ExtendedCanonical) {
+    OID oid = OID("0123456789abcdef01234567");
+    const BSONObj obj = B().append("i", 5)
+                            .append("l", 12321312312LL)
+                            .append("d", 0.1)
+                            .append("w", 2.0)
+                            .append("inf", std::numeric_limits<double>::infinity())
+                            .appendDate("date", Date_t::fromMillisSinceEpoch(-123))
+                            .appendBinData("bin", 3, BinDataGeneral, "abc")
+                            .appendRegex("re", "a\"b", "smi")
+                            .appendSymbol("sym", "foo")
+                            .appendCode("code", "function(){}")
+                            .appendDBRef("ptr", "db.coll", oid)
+                            .obj();
+    ASSERT_EQUALS(obj.jsonString(ExtendedCanonical),
+                  R"({ "i" : { "$numberInt" : "5" }, )"
+                  R"("l" : { "$numberLong" : "12321312312" }, )"
+                  R"("d" : { "$numberDouble" : "0.1" }, )"
+                  R"("w" : { "$numberDouble" : "2.0" }, )"
+                  R"("inf" : { "$numberDouble" : "Infinity" }, )"
+                  R"("date" : { "$date" : { "$numberLong" : "-123" } }, )"
+                  R"("bin" : { "$binary" : { "base64" : "YWJj", "subType" : "00" } }, )"
+                  R"("re" : { "$regularExpression" : { "pattern" : "a\"b", "options" : "ims" } }, )"
+                  R"("sym" : { "$symbol" : "foo" }, )"
+                  R"("code" : { "$code" : "function(){}" }, )"
+                  R"("ptr" : { "$dbPointer" : { "$ref" : "db.coll", )"
+                  R"("$id" : { "$oid" : "0123456789abcdef01234567" } } } })");
+}
+
+TEST(JsonStringTest, ExtendedRelaxed) {
+    const BSONObj obj = B().append("i", 5)
+                            .append("l", 12321312312LL)
+                            .append("d", 0.1)
+                            .append("w", 2.0)
+                            .append("nan", std::numeric_limits<double>::quiet_NaN())
+                            .appendDate("date", Date_t::fromMillisSinceEpoch(1'500'000'000'123))
+                            .appendDate("early", Date_t::fromMillisSinceEpoch(-1))
+                            .obj();
+    ASSERT_EQUALS(obj.jsonString(ExtendedRelaxed),
+                  R"({ "i" : 5, "l" : 12321312312, "d" : 0.1, "w" : 2.0, )"
+                  R"("nan" : { "$numberDouble" : "NaN" }, )"
+                  R"("date" : { "$date" : "2017-07-14T02:40:00.123Z" }, )"
+                  R"("early" : { "$date" : { "$numberLong" : "-1" } } })");
+}
+
+TEST(JsonStringTest, ExtendedDoublesRoundTrip) {
+    for (double d : {0.1, 1.0 / 3, 1e300, -2.5e-300, 123456789.12345678, 9007199254740993.0}) {
+        const BSONObj obj = B().append("d", d).obj();
+        ASSERT_EQUALS(d, fromjson(obj.jsonString(ExtendedCanonical))["d"].Double());
+        ASSERT_EQUALS(d, fromjson(obj.jsonString(ExtendedRelaxed))["d"].Double());
+    }
+}
+
 #ifdef _WIN32
 char tzEnvString[] = "TZ=EST+5EDT";
 #else
@@ -470,6 +523,9 @@ void checkEquivalence(const std::string& json, const BSONObj& bson) {
     assertEquals(json, bson, fromjson(tojson(bson)), "mode: <default>");
     assertEquals(json, bson, fromjson(tojson(bson, Strict)), "mode: strict");
     assertEquals(json, bson, fromjson(tojson(bson, TenGen)), "mode: tengen");
+    assertEquals(
+        json, bson, fromjson(tojson(bson, ExtendedCanonical)), "mode: extended canonical");
+    assertEquals(json, bson, fromjson(tojson(bson, ExtendedRelaxed)), "mode: extended relaxed");
 }
 
 void checkRejection(const std::string& json) {
@@ -1021,6 +1077,36 @@ TEST(FromJsonTest, StringContainingNull) {
     checkRejection(R"({ x\u0000y : "a" })");  // NullFieldUnquoted
 }
 
+TEST(FromJsonTest, ExtendedJsonV2) {
+    checkEquivalenceEach({
+        {R"({ "a" : { "$numberInt" : "-7" } })", B().append("a", -7).obj()},
+        {R"({ "a" : { "$numberDouble" : "1.5" } })", B().append("a", 1.5).obj()},
+        {R"({ "a" : { "$numberDouble" : "-Infinity" } })",
+         B().append("a", -std::numeric_limits<double>::infinity()).obj()},
+        {R"({ "a" : { "$binary" : { "base64" : "YWJj", "subType" : "5" } } })",
+         B().appendBinData("a", 3, MD5Type, "abc").obj()},
+        {R"({ "a" : { "$regularExpression" : { "pattern" : "^b", "options" : "ix" } } })",
+         B().appendRegex("a", "^b", "ix").obj()},
+        {R"({ "a" : { "$symbol" : "s" } })", B().appendSymbol("a", "s").obj()},
+        {R"({ "a" : { "$code" : "f()" } })", B().appendCode("a", "f()").obj()},
+        {R"({ "a" : { "$code" : "f()", "$scope" : { "x" : 1 } } })",
+         B().appendCodeWScope("a", "f()", BSON("x" << 1)).obj()},
+        {R"({ "a" : { "$dbPointer" : { "$ref" : "c", )"
+         R"("$id" : { "$oid" : "0123456789abcdef01234567" } } } })",
+         B().appendDBRef("a", "c", OID("0123456789abcdef01234567")).obj()},
+    });
+    checkRejectionEach({
+        R"({ "a" : { "$numberInt" : "1.5" } })",
+        R"({ "a" : { "$numberInt" : 1 } })",
+        R"({ "a" : { "$numberDouble" : "x" } })",
+        R"({ "a" : { "$binary" : { "subType" : "00", "base64" : "YWJj" } } })",
+        R"({ "a" : { "$regularExpression" : { "pattern" : "b" } } })",
+        R"({ "a" : { "$regularExpression" : { "pattern" : "b", "options" : "q" } } })",
+        R"({ "a" : { "$dbPointer" : { "$ref" : "c", "$id" : "0123456789abcdef01234567" } } })",
+        R"({ "$numberInt" : "1" })",
+    });
+}
+
 TEST(FromJsonTest, MinMaxKey) {
     checkEquivalenceEach({
         {R"({ "a" : { "$minKey" : 1 } })", B().appendMinKey("a").obj()},  // MinKey
@@ -193,11 +193,33 @@ mongo::BSONArray MockRemoteDBServer::query(MockRemoteDBServer::InstanceID id,
     scoped_spinlock sLock(_lock);
     _queryCount++;
 
+    // The filter is ignored, but the $min/$max bounds on the hinted index are honored, with the
+    // same inclusive lower and exclusive upper bound as on a real server.
+    const auto keyPattern = query.getHint();
+    const auto min = query.obj["$min"];
+    const auto max = query.obj["$max"];
+    auto inBounds = [&](const BSONObj& doc) {
+        if (keyPattern.isEmpty()) {
+            return true;
+        }
+        const bool considerFieldName = false;
+        auto key = doc.extractFieldsUnDotted(keyPattern);
+        if (min.isABSONObj() && key.woCompare(min.Obj(), keyPattern, considerFieldName) < 0) {
+            return false;
+        }
+        if (max.isABSONObj() && key.woCompare(max.Obj(), keyPattern, considerFieldName) >= 0) {
+            return false;
+        }
+        return true;
+    };
+
     auto ns = nsOrUuid.uuid() ? _uuidToNs[*nsOrUuid.uuid()] : nsOrUuid.nss()->ns();
     const vector<BSONObj>& coll = _dataMgr[ns];
     BSONArrayBuilder result;
     for (vector<BSONObj>::const_iterator iter = coll.begin(); iter != coll.end(); ++iter) {
-        result.append(iter->copy());
+        if (inBounds(*iter)) {
+            result.append(iter->copy());
+        }
     }
 
     return BSONArray(result.obj());
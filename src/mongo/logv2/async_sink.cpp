@@ -0,0 +1,356 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/logv2/async_sink.h"
+
+#include <algorithm>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/utility/formatting_ostream.hpp>
+#include <limits>
+
+#include "mongo/logv2/attributes.h"
+#include "mongo/logv2/log_severity.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+namespace logv2 {
+namespace {
+
+// How long the writer sleeps when no producer has woken it up.
+constexpr auto kWriterIdleInterval = Milliseconds(10);
+
+AtomicWord<uint64_t> nextSinkId{0};
+
+// Marks a ring whose producer is not between taking a sequence number and pushing its line.
+constexpr uint64_t kNoPendingSequence = std::numeric_limits<uint64_t>::max();
+
+}  // namespace
+
+struct AsyncSinkLine {
+    uint64_t sequence = 0;
+    std::string line;
+};
+
+/**
+ * Bounded single-producer, single-consumer queue of formatted lines. The producer is the thread
+ * that owns the ring and the consumer is the writer thread of the sink.
+ */
+class AsyncSinkRing {
+public:
+    explicit AsyncSinkRing(size_t capacity) : _slots(capacity) {}
+
+    /**
+     * Moves 'entry' into the ring, unless the ring is full. Producer only.
+     */
+    bool tryPush(AsyncSinkLine& entry) {
+        auto tail = _tail.loadRelaxed();
+        if (tail - _head.load() == _slots.size()) {
+            return false;
+        }
+        _slots[tail % _slots.size()] = std::move(entry);
+        _tail.store(tail + 1);
+        return true;
+    }
+
+    /**
+     * Appends every buffered line to 'out'. Consumer only.
+     */
+    void drainInto(std::vector<AsyncSinkLine>* out) {
+        auto head = _head.loadRelaxed();
+        auto tail = _tail.load();
+        for (; head != tail; ++head) {
+            out->push_back(std::move(_slots[head % _slots.size()]));
+        }
+        _head.store(head);
+    }
+
+    size_t size() const {
+        return _tail.load() - _head.load();
+    }
+
+    size_t capacity() const {
+        return _slots.size();
+    }
+
+    // Set when the producer thread exits; the writer forgets the ring once it is empty.
+    AtomicWord<bool> producerExited{false};
+
+    // Set when the sink is destroyed; the producer forgets the ring on its next lookup.
+    AtomicWord<bool> sinkClosed{false};
+
+    // Lower bound of the sequence number the producer is about to push, or kNoPendingSequence.
+    AtomicWord<uint64_t> pendingSequence{kNoPendingSequence};
+
+    // Producer-side copy of the sink's formatter.
+    boost::log::formatter formatter;
+    uint64_t formatterVersion = 0;
+
+private:
+    std::vector<AsyncSinkLine> _slots;
+    AtomicWord<uint64_t> _head{0};
+    AtomicWord<uint64_t> _tail{0};
+};
+
+namespace {
+
+/**
+ * The rings owned by the current thread, one per AsyncSink it has logged to.
+ */
+struct ProducerRings {
+    ~ProducerRings() {
+        for (auto& entry : rings) {
+            entry.second->producerExited.store(true);
+        }
+    }
+
+    std::vector<std::pair<uint64_t, std::shared_ptr<AsyncSinkRing>>> rings;
+};
+
+thread_local ProducerRings producerRings;
+
+}  // namespace
+
+AsyncSink::AsyncSink(boost::log::filter filter,
+                     size_t bufferCapacity,
+                     OverflowPolicy overflowPolicy,
+                     WriteFunction write)
+    : boost::log::sinks::sink(false),
+      _id(nextSinkId.fetchAndAdd(1)),
+      _filter(std::move(filter)),
+      _bufferCapacity(std::max<size_t>(bufferCapacity, 1)),
+      _overflowPolicy(overflowPolicy),
+      _write(std::move(write)) {
+    _writer = stdx::thread([this] {
+        setThreadName("AsyncLogWriter");
+        _writerLoop();
+    });
+}
+
+AsyncSink::~AsyncSink() {
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _shutdown = true;
+        _writerCondition.notify_one();
+    }
+    _writer.join();
+
+    for (auto& ring : _rings) {
+        ring->sinkClosed.store(true);
+    }
+}
+
+void AsyncSink::set_formatter(boost::log::formatter formatter) {
+    stdx::lock_guard<Latch> lk(_formatterMutex);
+    _formatter = std::move(formatter);
+    _formatterVersion.fetchAndAdd(1);
+}
+
+bool AsyncSink::will_consume(boost::log::attribute_value_set const& attributes) {
+    return _filter(attributes);
+}
+
+AsyncSinkRing* AsyncSink::_localRing() {
+    auto& rings = producerRings.rings;
+    for (auto it = rings.begin(); it != rings.end();) {
+        if (it->first == _id) {
+            return it->second.get();
+        }
+        if (it->second->sinkClosed.load()) {
+            it = rings.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    auto ring = std::make_shared<AsyncSinkRing>(_bufferCapacity);
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _rings.push_back(ring);
+    }
+    rings.emplace_back(_id, ring);
+    return ring.get();
+}
+
+void AsyncSink::consume(boost::log::record_view const& rec) {
+    auto ring = _localRing();
+
+    auto formatterVersion = _formatterVersion.load();
+    if (ring->formatterVersion != formatterVersion) {
+        stdx::lock_guard<Latch> lk(_formatterMutex);
+        ring->formatter = _formatter;
+        ring->formatterVersion = _formatterVersion.load();
+    }
+
+    AsyncSinkLine entry;
+    {
+        boost::log::formatting_ostream strm(entry.line);
+        ring->formatter(rec, strm);
+        strm.flush();
+    }
+
+    // Publish a lower bound of the sequence number before taking it, so the writer keeps back any
+    // later line until this one is in the ring.
+    ring->pendingSequence.store(_nextSequence.load());
+    entry.sequence = _nextSequence.fetchAndAdd(1);
+
+    bool blocked = false;
+    while (!ring->tryPush(entry)) {
+        if (_overflowPolicy == OverflowPolicy::kDrop) {
+            ring->pendingSequence.store(kNoPendingSequence);
+            _dropped.fetchAndAdd(1);
+            return;
+        }
+        if (!blocked) {
+            _blocked.fetchAndAdd(1);
+            blocked = true;
+        }
+        stdx::unique_lock<Latch> lk(_mutex);
+        _writerCondition.notify_one();
+        _spaceAvailable.wait_for(lk, Milliseconds(1).toSystemDuration());
+    }
+    ring->pendingSequence.store(kNoPendingSequence);
+
+    auto severity = boost::log::extract<LogSeverity>(attributes::severity(), rec);
+    if (severity && severity.get() >= LogSeverity::Error()) {
+        flush();
+    } else if (ring->size() * 2 >= ring->capacity()) {
+        // Wake the writer early rather than letting the ring fill up.
+        _writerCondition.notify_one();
+    }
+}
+
+void AsyncSink::flush() {
+    auto target = _nextSequence.load();
+    stdx::unique_lock<Latch> lk(_mutex);
+    _flushTarget = std::max(_flushTarget, target);
+    _writerCondition.notify_one();
+    _flushCondition.wait(lk, [&] { return _writtenBelow >= target || _shutdown; });
+}
+
+AsyncSinkStats AsyncSink::stats() const {
+    AsyncSinkStats stats;
+    stats.written = _written.load();
+    stats.dropped = _dropped.load();
+    stats.blocked = _blocked.load();
+    stats.queued = _held.load();
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (auto& ring : _rings) {
+        stats.queued += ring->size();
+    }
+    return stats;
+}
+
+size_t AsyncSink::_drain(bool all, uint64_t* writtenBelow) {
+    // Every line with a sequence number below the watermark is in a ring already: its producer
+    // either pushed it or published a pending sequence number that is read below. Both reads must
+    // happen before the rings are drained.
+    auto watermark = _nextSequence.load();
+
+    std::vector<std::shared_ptr<AsyncSinkRing>> rings;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        // A ring whose producer has exited cannot receive any more lines.
+        _rings.erase(std::remove_if(_rings.begin(),
+                                    _rings.end(),
+                                    [](const auto& ring) {
+                                        return ring->producerExited.load() && ring->size() == 0;
+                                    }),
+                     _rings.end());
+        rings = _rings;
+    }
+
+    for (auto& ring : rings) {
+        watermark = std::min(watermark, ring->pendingSequence.load());
+    }
+    if (all) {
+        watermark = kNoPendingSequence;
+    }
+
+    auto drainedFrom = _heldLines.size();
+    for (auto& ring : rings) {
+        ring->drainInto(&_heldLines);
+    }
+    if (_heldLines.size() > drainedFrom) {
+        _spaceAvailable.notify_all();
+    }
+
+    std::sort(_heldLines.begin(), _heldLines.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.sequence < rhs.sequence;
+    });
+    auto end = std::find_if(_heldLines.begin(), _heldLines.end(), [&](const auto& entry) {
+        return entry.sequence >= watermark;
+    });
+    size_t written = end - _heldLines.begin();
+
+    if (written > 0) {
+        stdx::lock_guard<Latch> lk(_writeMutex);
+        for (auto it = _heldLines.begin(); it != end; ++it) {
+            _write(it->line);
+        }
+    }
+    _heldLines.erase(_heldLines.begin(), end);
+
+    _held.store(_heldLines.size());
+    _written.fetchAndAdd(written);
+    *writtenBelow = watermark;
+    return written;
+}
+
+void AsyncSink::_writerLoop() {
+    stdx::unique_lock<Latch> lk(_mutex);
+    while (true) {
+        auto shutdown = _shutdown;
+
+        lk.unlock();
+        uint64_t writtenBelow;
+        auto written = _drain(shutdown, &writtenBelow);
+        lk.lock();
+
+        if (_writtenBelow < writtenBelow) {
+            _writtenBelow = writtenBelow;
+            _flushCondition.notify_all();
+        }
+        if (shutdown) {
+            break;
+        }
+        if (written == 0 && !_shutdown) {
+            // A pending flush only waits for producers that are about to push their line.
+            auto interval = _flushTarget > _writtenBelow ? Milliseconds(1) : kWriterIdleInterval;
+            _writerCondition.wait_for(lk, interval.toSystemDuration());
+        }
+    }
+    _flushCondition.notify_all();
+}
+
+}  // namespace logv2
+}  // namespace mongo
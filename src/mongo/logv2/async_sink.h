@@ -0,0 +1,166 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/expressions/filter.hpp>
+#include <boost/log/expressions/formatter.hpp>
+#include <boost/log/sinks/sink.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+
+namespace mongo {
+namespace logv2 {
+
+class AsyncSinkRing;
+struct AsyncSinkLine;
+
+/**
+ * Counters describing the activity of an AsyncSink.
+ */
+struct AsyncSinkStats {
+    long long written = 0;  // Lines handed to the write function.
+    long long dropped = 0;  // Lines discarded because the producer's buffer was full.
+    long long blocked = 0;  // Records whose producer had to wait for the writer.
+    long long queued = 0;   // Lines currently buffered and not yet written.
+};
+
+/**
+ * Sink frontend that moves the writing of log lines off the logging thread.
+ *
+ * Records are formatted on the calling thread, because the attributes of a logv2 record refer to
+ * data on the caller's stack. The formatted line is then pushed into a single-producer ring owned
+ * by the calling thread, which does not take any lock. A background thread drains every ring,
+ * restores the order in which the lines were logged and passes them to the write function.
+ *
+ * Every line takes a sequence number before it is pushed. A line drained while a producer still
+ * holds a lower sequence number is kept back until that producer's line has been drained too, so
+ * the order holds across drains and not only within one.
+ *
+ * When a thread's ring is full the line is either dropped or the caller waits for the writer to
+ * make room, depending on the overflow policy. Records of severity Error and above are always
+ * flushed before consume() returns so they are not lost if the process terminates.
+ */
+class AsyncSink : public boost::log::sinks::sink {
+public:
+    enum class OverflowPolicy { kDrop, kBlock };
+
+    using WriteFunction = std::function<void(const std::string&)>;
+
+    AsyncSink(boost::log::filter filter,
+              size_t bufferCapacity,
+              OverflowPolicy overflowPolicy,
+              WriteFunction write);
+    ~AsyncSink();
+
+    void set_formatter(boost::log::formatter formatter);
+
+    bool will_consume(boost::log::attribute_value_set const& attributes) override;
+    void consume(boost::log::record_view const& rec) override;
+
+    /**
+     * Waits until every line consumed before the call has been written.
+     */
+    void flush() override;
+
+    /**
+     * Runs 'fn' while no line is being written, e.g. to rotate the underlying file.
+     */
+    template <typename Fn>
+    void withWriteLock(Fn&& fn) {
+        stdx::lock_guard<Latch> lk(_writeMutex);
+        fn();
+    }
+
+    AsyncSinkStats stats() const;
+
+private:
+    AsyncSinkRing* _localRing();
+    void _writerLoop();
+
+    /**
+     * Moves the lines buffered in the rings to the write function, in sequence order. Lines that
+     * may still be preceded by a line not yet pushed are kept back for the next drain, unless
+     * 'all' is set. Returns the number of lines written and sets '*writtenBelow' to a sequence
+     * number below which every line has been written.
+     */
+    size_t _drain(bool all, uint64_t* writtenBelow);
+
+    const uint64_t _id;
+    const boost::log::filter _filter;
+    const size_t _bufferCapacity;
+    const OverflowPolicy _overflowPolicy;
+    const WriteFunction _write;
+
+    // Protects '_formatter'. Producers keep a copy of the formatter in their ring and only take
+    // this lock when '_formatterVersion' changes.
+    Mutex _formatterMutex = MONGO_MAKE_LATCH("AsyncSink::_formatterMutex");
+    boost::log::formatter _formatter;
+    AtomicWord<uint64_t> _formatterVersion{0};
+
+    // Orders lines across producer threads.
+    AtomicWord<uint64_t> _nextSequence{0};
+
+    // Lines drained but kept back behind a line that was not pushed yet. Writer thread only.
+    std::vector<AsyncSinkLine> _heldLines;
+    AtomicWord<long long> _held{0};
+
+    // Serializes calls to the write function with withWriteLock().
+    Mutex _writeMutex = MONGO_MAKE_LATCH("AsyncSink::_writeMutex");
+
+    // Protects the members below.
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("AsyncSink::_mutex");
+    std::vector<std::shared_ptr<AsyncSinkRing>> _rings;
+    stdx::condition_variable _writerCondition;
+    stdx::condition_variable _spaceAvailable;
+    stdx::condition_variable _flushCondition;
+    // Every line with a sequence number below '_flushTarget' must be written before the pending
+    // flushes return. Every line below '_writtenBelow' has been written.
+    uint64_t _flushTarget = 0;
+    uint64_t _writtenBelow = 0;
+    bool _shutdown = false;
+
+    AtomicWord<long long> _written{0};
+    AtomicWord<long long> _dropped{0};
+    AtomicWord<long long> _blocked{0};
+
+    stdx::thread _writer;
+};
+
+}  // namespace logv2
+}  // namespace mongo
@@ -29,6 +29,7 @@
 
 #include "log_domain_global.h"
 
+#include "mongo/logv2/async_sink.h"
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/console.h"
 #include "mongo/logv2/json_formatter.h"
@@ -36,11 +37,13 @@
 #include "mongo/logv2/ramlog_sink.h"
 #include "mongo/logv2/tagged_severity_filter.h"
 #include "mongo/logv2/text_formatter.h"
+#include "mongo/platform/mutex.h"
 
 #include <boost/core/null_deleter.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/log/core.hpp>
 #include <boost/log/sinks.hpp>
+#include <vector>
 
 namespace mongo {
 namespace logv2 {
@@ -91,11 +94,27 @@ struct LogDomainGlobal::Impl {
     Impl(LogDomainGlobal& parent);
     Status configure(LogDomainGlobal::ConfigurationOptions const& options);
     Status rotate();
+    boost::shared_ptr<AsyncSink> makeAsyncSink(
+        LogDomainGlobal::ConfigurationOptions const& options,
+        AsyncSink::WriteFunction write);
+
+    /**
+     * Returns the asynchronous sinks that are currently configured.
+     */
+    std::vector<boost::shared_ptr<AsyncSink>> asyncSinks();
 
     LogDomainGlobal& _parent;
     LogComponentSettings _settings;
+    boost::shared_ptr<boost::log::sinks::text_ostream_backend> _consoleStream;
     boost::shared_ptr<ConsoleBackend> _consoleBackend;
+
+    // Protects the asynchronous sinks and '_fileBackend', which configure() replaces while
+    // flush(), rotate() and serverStatus may be using them.
+    Mutex _asyncSinksMutex = MONGO_MAKE_LATCH("LogDomainGlobal::Impl::_asyncSinksMutex");
+    boost::shared_ptr<AsyncSink> _asyncConsoleBackend;
+    boost::shared_ptr<boost::log::sinks::text_file_backend> _fileBackend;
     boost::shared_ptr<RotatableFileBackend> _rotatableFileBackend;
+    boost::shared_ptr<AsyncSink> _asyncFileBackend;
     boost::shared_ptr<RamLogBackend> _globalLogCacheBackend;
     boost::shared_ptr<RamLogBackend> _startupWarningsBackend;
 #ifndef _WIN32
@@ -104,14 +123,13 @@ struct LogDomainGlobal::Impl {
 };
 
 LogDomainGlobal::Impl::Impl(LogDomainGlobal& parent) : _parent(parent) {
-    _consoleBackend = boost::make_shared<ConsoleBackend>();
-    _consoleBackend->set_filter(ComponentSettingsFilter(_parent, _settings));
-
-
-    _consoleBackend->locked_backend()->add_stream(
+    _consoleStream = boost::make_shared<boost::log::sinks::text_ostream_backend>();
+    _consoleStream->add_stream(
         boost::shared_ptr<std::ostream>(&Console::out(), boost::null_deleter()));
+    _consoleStream->auto_flush();
 
-    _consoleBackend->locked_backend()->auto_flush();
+    _consoleBackend = boost::make_shared<ConsoleBackend>(_consoleStream);
+    _consoleBackend->set_filter(ComponentSettingsFilter(_parent, _settings));
 
     _globalLogCacheBackend = RamLogSink::create(RamLog::get("global"));
     _globalLogCacheBackend->set_filter(ComponentSettingsFilter(_parent, _settings));
@@ -157,36 +175,73 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
     }
 #endif
 
-    if (options._consoleEnabled && _consoleBackend.use_count() == 1) {
+    stdx::lock_guard<Latch> lk(_asyncSinksMutex);
+
+    // The console stream is written either by the synchronous frontend or by an asynchronous one,
+    // never by both.
+    bool syncConsole = options._consoleEnabled && !options._asyncEnabled;
+    if (syncConsole && _consoleBackend.use_count() == 1) {
         boost::log::core::get()->add_sink(_consoleBackend);
     }
 
-    if (!options._consoleEnabled && _consoleBackend.use_count() > 1) {
+    if (!syncConsole && _consoleBackend.use_count() > 1) {
         boost::log::core::get()->remove_sink(_consoleBackend);
     }
 
+    if (_asyncConsoleBackend) {
+        boost::log::core::get()->remove_sink(_asyncConsoleBackend);
+        _asyncConsoleBackend.reset();
+    }
+
+    if (options._consoleEnabled && options._asyncEnabled) {
+        _asyncConsoleBackend =
+            makeAsyncSink(options, [stream = _consoleStream](const std::string& line) {
+                stream->consume(boost::log::record_view(), line);
+            });
+        boost::log::core::get()->add_sink(_asyncConsoleBackend);
+    }
+
+    if (_rotatableFileBackend) {
+        boost::log::core::get()->remove_sink(_rotatableFileBackend);
+        _rotatableFileBackend.reset();
+    }
+    if (_asyncFileBackend) {
+        boost::log::core::get()->remove_sink(_asyncFileBackend);
+        _asyncFileBackend.reset();
+    }
+    _fileBackend.reset();
+
     if (options._fileEnabled) {
-        auto backend = boost::make_shared<boost::log::sinks::text_file_backend>(
+        _fileBackend = boost::make_shared<boost::log::sinks::text_file_backend>(
             boost::log::keywords::file_name = options._filePath);
-        backend->auto_flush(true);
+        _fileBackend->auto_flush(true);
 
-        backend->set_file_collector(boost::make_shared<RotateCollector>(options));
+        _fileBackend->set_file_collector(boost::make_shared<RotateCollector>(options));
 
-        _rotatableFileBackend = boost::make_shared<RotatableFileBackend>(backend);
-        _rotatableFileBackend->set_filter(ComponentSettingsFilter(_parent, _settings));
+        if (options._asyncEnabled) {
+            _asyncFileBackend =
+                makeAsyncSink(options, [file = _fileBackend](const std::string& line) {
+                    file->consume(boost::log::record_view(), line);
+                });
+            boost::log::core::get()->add_sink(_asyncFileBackend);
+        } else {
+            _rotatableFileBackend = boost::make_shared<RotatableFileBackend>(_fileBackend);
+            _rotatableFileBackend->set_filter(ComponentSettingsFilter(_parent, _settings));
 
-        boost::log::core::get()->add_sink(_rotatableFileBackend);
-    } else if (_rotatableFileBackend) {
-        boost::log::core::get()->remove_sink(_rotatableFileBackend);
-        _rotatableFileBackend.reset();
+            boost::log::core::get()->add_sink(_rotatableFileBackend);
+        }
     }
 
     auto setFormatters = [this](auto&& mkFmt) {
         _consoleBackend->set_formatter(mkFmt());
         _globalLogCacheBackend->set_formatter(mkFmt());
         _startupWarningsBackend->set_formatter(mkFmt());
+        if (_asyncConsoleBackend)
+            _asyncConsoleBackend->set_formatter(mkFmt());
         if (_rotatableFileBackend)
             _rotatableFileBackend->set_formatter(mkFmt());
+        if (_asyncFileBackend)
+            _asyncFileBackend->set_formatter(mkFmt());
 #ifndef _WIN32
         if (_syslogBackend)
             _syslogBackend->set_formatter(mkFmt());
@@ -206,11 +261,39 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
     return Status::OK();
 }
 
+boost::shared_ptr<AsyncSink> LogDomainGlobal::Impl::makeAsyncSink(
+    LogDomainGlobal::ConfigurationOptions const& options, AsyncSink::WriteFunction write) {
+    auto policy = options._asyncOverflowPolicy ==
+            LogDomainGlobal::ConfigurationOptions::AsyncOverflowPolicy::kDrop
+        ? AsyncSink::OverflowPolicy::kDrop
+        : AsyncSink::OverflowPolicy::kBlock;
+    return boost::make_shared<AsyncSink>(ComponentSettingsFilter(_parent, _settings),
+                                         options._asyncBufferCapacity,
+                                         policy,
+                                         std::move(write));
+}
+
+std::vector<boost::shared_ptr<AsyncSink>> LogDomainGlobal::Impl::asyncSinks() {
+    std::vector<boost::shared_ptr<AsyncSink>> sinks;
+    stdx::lock_guard<Latch> lk(_asyncSinksMutex);
+    if (_asyncConsoleBackend)
+        sinks.push_back(_asyncConsoleBackend);
+    if (_asyncFileBackend)
+        sinks.push_back(_asyncFileBackend);
+    return sinks;
+}
+
 Status LogDomainGlobal::Impl::rotate() {
+    stdx::lock_guard<Latch> lk(_asyncSinksMutex);
     if (_rotatableFileBackend) {
         auto backend = _rotatableFileBackend->locked_backend();
         backend->rotate_file();
     }
+    if (_asyncFileBackend) {
+        // Lines logged before the rotation belong in the old file.
+        _asyncFileBackend->flush();
+        _asyncFileBackend->withWriteLock([&] { _fileBackend->rotate_file(); });
+    }
     return Status::OK();
 }
 
@@ -235,6 +318,28 @@ Status LogDomainGlobal::rotate() {
     return _impl->rotate();
 }
 
+void LogDomainGlobal::flush() {
+    for (auto&& sink : _impl->asyncSinks()) {
+        sink->flush();
+    }
+}
+
+bool LogDomainGlobal::asyncEnabled() const {
+    return !_impl->asyncSinks().empty();
+}
+
+AsyncSinkStats LogDomainGlobal::asyncStats() const {
+    AsyncSinkStats total;
+    for (auto&& sink : _impl->asyncSinks()) {
+        auto stats = sink->stats();
+        total.written += stats.written;
+        total.dropped += stats.dropped;
+        total.blocked += stats.blocked;
+        total.queued += stats.queued;
+    }
+    return total;
+}
+
 LogComponentSettings& LogDomainGlobal::settings() {
     return _impl->_settings;
 }
@@ -34,11 +34,14 @@
 
 namespace mongo {
 namespace logv2 {
+struct AsyncSinkStats;
+
 class LogDomainGlobal : public LogDomain::Internal {
 public:
     struct ConfigurationOptions {
         enum class RotationMode { kRename, kReopen };
         enum class OpenMode { kTruncate, kAppend };
+        enum class AsyncOverflowPolicy { kDrop, kBlock };
 
         bool _consoleEnabled{true};
         bool _fileEnabled{false};
@@ -48,6 +51,10 @@ public:
         bool _syslogEnabled{false};
         int _syslogFacility{-1};  // invalid facility by default, must be set
         LogFormat _format{LogFormat::kDefault};
+        // Write console and file output from a background thread.
+        bool _asyncEnabled{false};
+        std::size_t _asyncBufferCapacity{1024};  // Buffered lines per logging thread.
+        AsyncOverflowPolicy _asyncOverflowPolicy{AsyncOverflowPolicy::kBlock};
 
         void makeDisabled();
     };
@@ -60,6 +67,14 @@ public:
     Status configure(ConfigurationOptions const& options);
     Status rotate();
 
+    /**
+     * Waits until every record logged so far has been written by the asynchronous sinks.
+     */
+    void flush();
+
+    bool asyncEnabled() const;
+    AsyncSinkStats asyncStats() const;
+
     LogComponentSettings& settings();
 
 private:
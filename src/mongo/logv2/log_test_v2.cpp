@@ -38,6 +38,7 @@
 #include <vector>
 
 #include "mongo/bson/json.h"
+#include "mongo/logv2/async_sink.h"
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/formatter_base.h"
 #include "mongo/logv2/json_formatter.h"
@@ -47,6 +48,7 @@
 #include "mongo/logv2/text_formatter.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
+#include "mongo/util/concurrency/notification.h"
 
 #include <boost/log/attributes/constant.hpp>
 
@@ -318,6 +320,78 @@ TEST_F(LogTestV2, Threads) {
     ASSERT(linesJson.size() == threads.size() * kNumPerThread);
 }
 
+TEST_F(LogTestV2, AsyncThreads) {
+    std::vector<std::string> lines;
+    auto sink = boost::make_shared<AsyncSink>(
+        ComponentSettingsFilter(LogManager::global().getGlobalDomain(),
+                                LogManager::global().getGlobalSettings()),
+        16,
+        AsyncSink::OverflowPolicy::kBlock,
+        [&](const std::string& line) { lines.push_back(line); });
+    sink->set_formatter(PlainFormatter());
+    attach(sink);
+
+    constexpr int kNumThreads = 4;
+    constexpr int kNumPerThread = 1000;
+    std::vector<stdx::thread> threads;
+    for (int t = 0; t < kNumThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < kNumPerThread; ++i)
+                LOGV2("{} {}", "thread"_attr = t, "i"_attr = i);
+        });
+    }
+
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    sink->flush();
+
+    ASSERT_EQ(lines.size(), static_cast<size_t>(kNumThreads * kNumPerThread));
+
+    // The lines of every thread are written in the order they were logged.
+    std::vector<int> next(kNumThreads, 0);
+    for (auto&& line : lines) {
+        int t, i;
+        ASSERT_EQ(sscanf(line.c_str(), "%d %d", &t, &i), 2);
+        ASSERT_EQ(i, next[t]++);
+    }
+
+    auto stats = sink->stats();
+    ASSERT_EQ(stats.written, kNumThreads * kNumPerThread);
+    ASSERT_EQ(stats.dropped, 0);
+    ASSERT_EQ(stats.queued, 0);
+}
+
+TEST_F(LogTestV2, AsyncDropsWhenFull) {
+    Notification<void> unblockWriter;
+    std::vector<std::string> lines;
+    auto sink = boost::make_shared<AsyncSink>(
+        ComponentSettingsFilter(LogManager::global().getGlobalDomain(),
+                                LogManager::global().getGlobalSettings()),
+        1,
+        AsyncSink::OverflowPolicy::kDrop,
+        [&](const std::string& line) {
+            unblockWriter.get();
+            lines.push_back(line);
+        });
+    sink->set_formatter(PlainFormatter());
+    attach(sink);
+
+    // At most one line is being written and one is buffered while the writer is blocked.
+    constexpr int kNumLines = 10;
+    for (int i = 0; i < kNumLines; ++i)
+        LOGV2("line");
+
+    ASSERT_GTE(sink->stats().dropped, kNumLines - 2);
+
+    unblockWriter.set();
+    sink->flush();
+
+    auto stats = sink->stats();
+    ASSERT_EQ(stats.written + stats.dropped, kNumLines);
+    ASSERT_EQ(lines.size(), static_cast<size_t>(stats.written));
+}
+
 TEST_F(LogTestV2, Ramlog) {
     RamLog* ramlog = RamLog::get("test_ramlog");
 
@@ -33,6 +33,7 @@
 #include "mongo/logger/console_appender.h"
 #include "mongo/logger/logger.h"
 #include "mongo/logger/message_event_utf8_encoder.h"
+#include "mongo/logv2/async_sink.h"
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/log.h"
 #include "mongo/logv2/log_domain_global.h"
@@ -118,10 +119,10 @@ private:
 // RAII style helper class for init/deinit new log system
 class ScopedLogV2Bench {
 public:
-    ScopedLogV2Bench(benchmark::State& state) {
+    ScopedLogV2Bench(benchmark::State& state, bool async = false) {
         _shouldInit = state.thread_index == 0;
         if (_shouldInit) {
-            setupAppender();
+            setupAppender(async);
         }
     }
 
@@ -132,7 +133,7 @@ public:
     }
 
 private:
-    void setupAppender() {
+    void setupAppender(bool async) {
         logv2::LogDomainGlobal::ConfigurationOptions config;
         config.makeDisabled();
         invariant(logv2::LogManager::global().getGlobalDomainInternal().configure(config).isOK());
@@ -141,22 +142,36 @@ private:
         backend->add_stream(makeNullStream());
         backend->auto_flush(true);
 
-        _sink = boost::make_shared<
-            boost::log::sinks::synchronous_sink<boost::log::sinks::text_ostream_backend>>(backend);
-        _sink->set_filter(
-            logv2::ComponentSettingsFilter(logv2::LogManager::global().getGlobalDomain(),
-                                           logv2::LogManager::global().getGlobalSettings()));
-        _sink->set_formatter(logv2::TextFormatter());
+        logv2::ComponentSettingsFilter filter(logv2::LogManager::global().getGlobalDomain(),
+                                              logv2::LogManager::global().getGlobalSettings());
+        if (async) {
+            auto sink = boost::make_shared<logv2::AsyncSink>(
+                filter,
+                1024,
+                logv2::AsyncSink::OverflowPolicy::kBlock,
+                [backend](const std::string& line) {
+                    backend->consume(boost::log::record_view(), line);
+                });
+            sink->set_formatter(logv2::TextFormatter());
+            _sink = sink;
+        } else {
+            auto sink = boost::make_shared<
+                boost::log::sinks::synchronous_sink<boost::log::sinks::text_ostream_backend>>(
+                backend);
+            sink->set_filter(filter);
+            sink->set_formatter(logv2::TextFormatter());
+            _sink = sink;
+        }
         boost::log::core::get()->add_sink(_sink);
     }
 
     void tearDownAppender() {
         boost::log::core::get()->remove_sink(_sink);
+        _sink->flush();
         invariant(logv2::LogManager::global().getGlobalDomainInternal().configure({}).isOK());
     }
 
-    boost::shared_ptr<boost::log::sinks::synchronous_sink<boost::log::sinks::text_ostream_backend>>
-        _sink;
+    boost::shared_ptr<boost::log::sinks::sink> _sink;
     bool _shouldInit;
 };
 
@@ -252,12 +267,44 @@ void BM_EnabledLogV2ManySmallArg(benchmark::State& state) {
     }
 }
 
+void BM_EnabledLogV2Async(benchmark::State& state) {
+    ScopedLogV2Bench init(state, true);
+
+    for (auto _ : state)
+        LOGV2("enabled log");
+}
+
+void BM_EnabledLogV2AsyncManySmallArg(benchmark::State& state) {
+    ScopedLogV2Bench init(state, true);
+
+    for (auto _ : state) {
+        LOGV2("enabled log {}{}{}{}{}{}{}{}{}{}",
+              "1"_attr = 1,
+              "2"_attr = 2,
+              "3"_attr = "3",
+              "4"_attr = 4.0,
+              "5"_attr = "5",
+              "6"_attr = "6"_sd,
+              "7"_attr = 7,
+              "8"_attr = 8,
+              "9"_attr = "9",
+              "10"_attr = "10"_sd);
+    }
+}
+
 void ThreadCounts(benchmark::internal::Benchmark* b) {
     int tc[] = {1, 2, 4, 8};
     for (int t : tc)
         b->Threads(t);
 }
 
+// Thread counts beyond the usual ones, where contention on the synchronous sink's lock dominates.
+void ContendedThreadCounts(benchmark::internal::Benchmark* b) {
+    int tc[] = {16, 32};
+    for (int t : tc)
+        b->Threads(t);
+}
+
 BENCHMARK(BM_NoopLog)->Apply(ThreadCounts);
 BENCHMARK(BM_NoopLogV2)->Apply(ThreadCounts);
 
@@ -273,5 +320,11 @@ BENCHMARK(BM_EnabledLogV2ExpensiveArg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogManySmallArg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ManySmallArg)->Apply(ThreadCounts);
 
+BENCHMARK(BM_EnabledLogV2Async)->Apply(ThreadCounts);
+BENCHMARK(BM_EnabledLogV2AsyncManySmallArg)->Apply(ThreadCounts);
+
+BENCHMARK(BM_EnabledLogV2ManySmallArg)->Apply(ContendedThreadCounts);
+BENCHMARK(BM_EnabledLogV2AsyncManySmallArg)->Apply(ContendedThreadCounts);
+
 }  // namespace
 }  // namespace mongo
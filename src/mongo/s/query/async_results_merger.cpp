@@ -39,6 +39,7 @@
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/killcursors_request.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/util/assert_util.h"
@@ -93,7 +94,10 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       _params(std::move(params)),
       _mergeQueue(MergingComparator(
           _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
-      _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
+      _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))),
+      _smallestSortKeys(SortKeyComparator(_params.getSort().value_or(BSONObj()))) {
+    invariant(!_params.getLimit() || (_params.getSort() && !_params.getCompareWholeSortKey()));
+
     if (params.getTxnNumber()) {
         invariant(params.getSessionId());
     }
@@ -356,7 +360,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
     return {};
 }
 
-Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
+Status AsyncResultsMerger::_askForNextBatch(WithLock lk, size_t remoteIndex) {
     invariant(_opCtx, "Cannot schedule a getMore without an OperationContext");
     auto& remote = _remotes[remoteIndex];
 
@@ -371,12 +375,25 @@ Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
         adjustedBatchSize = *_params.getBatchSize() - remote.fetchedCount;
     }
 
+    // Let the remote stop producing results which can no longer make it into the merged result.
+    // Shards which predate the threshold reject it as an unknown field, so it is only sent when
+    // enabled.
+    boost::optional<GetMoreRequest::SortKeyThreshold> sortKeyThreshold;
+    boost::optional<BSONObj> thresholdKey;
+    if (internalQueryPushSortKeyThresholdToShards.load()) {
+        thresholdKey = _getSortKeyThreshold(lk);
+    }
+    if (thresholdKey) {
+        sortKeyThreshold = GetMoreRequest::SortKeyThreshold{*thresholdKey, *_params.getSort()};
+    }
+
     BSONObj cmdObj = GetMoreRequest(remote.cursorNss,
                                     remote.cursorId,
                                     adjustedBatchSize,
                                     _awaitDataTimeout,
                                     boost::none,
-                                    boost::none)
+                                    boost::none,
+                                    std::move(sortKeyThreshold))
                          .toBSON();
 
     if (_params.getSessionId()) {
@@ -660,6 +677,25 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
             }
         }
 
+        if (_params.getLimit()) {
+            auto sortKey = extractSortKey(obj, false);
+            auto threshold = _getSortKeyThreshold(lk);
+            if (threshold && compareSortKeys(sortKey, *threshold, *_params.getSort()) > 0) {
+                // The remote returns its results in sort order, so neither this result nor any of
+                // the ones after it can be returned. Stop reading from the remote altogether.
+                if (!remote.exhausted()) {
+                    _scheduleKillCursor(lk, _opCtx, remote);
+                    remote.cursorId = 0;
+                }
+                break;
+            }
+
+            _smallestSortKeys.push(sortKey.getOwned());
+            if (_smallestSortKeys.size() > static_cast<size_t>(*_params.getLimit())) {
+                _smallestSortKeys.pop();
+            }
+        }
+
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
         ++remote.fetchedCount;
@@ -667,7 +703,7 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
 
     // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
     // queue.
-    if (_params.getSort() && !response.getBatch().empty()) {
+    if (_params.getSort() && remote.hasNext()) {
         _mergeQueue.push(remoteIndex);
     }
     return true;
@@ -692,20 +728,34 @@ bool AsyncResultsMerger::_haveOutstandingBatchRequests(WithLock) {
     return false;
 }
 
-void AsyncResultsMerger::_scheduleKillCursors(WithLock, OperationContext* opCtx) {
+void AsyncResultsMerger::_scheduleKillCursors(WithLock lk, OperationContext* opCtx) {
     invariant(_killCompleteEvent.isValid());
 
     for (const auto& remote : _remotes) {
         if (remote.status.isOK() && remote.cursorId && !remote.exhausted()) {
-            BSONObj cmdObj = KillCursorsRequest(_params.getNss(), {remote.cursorId}).toBSON();
+            _scheduleKillCursor(lk, opCtx, remote);
+        }
+    }
+}
 
-            executor::RemoteCommandRequest request(
-                remote.getTargetHost(), _params.getNss().db().toString(), cmdObj, opCtx);
+void AsyncResultsMerger::_scheduleKillCursor(WithLock,
+                                             OperationContext* opCtx,
+                                             const RemoteCursorData& remote) {
+    BSONObj cmdObj = KillCursorsRequest(_params.getNss(), {remote.cursorId}).toBSON();
 
-            // Send kill request; discard callback handle, if any, or failure report, if not.
-            _executor->scheduleRemoteCommand(request, [](auto const&) {}).getStatus().ignore();
-        }
+    executor::RemoteCommandRequest request(
+        remote.getTargetHost(), _params.getNss().db().toString(), cmdObj, opCtx);
+
+    // Send kill request; discard callback handle, if any, or failure report, if not.
+    _executor->scheduleRemoteCommand(request, [](auto const&) {}).getStatus().ignore();
+}
+
+boost::optional<BSONObj> AsyncResultsMerger::_getSortKeyThreshold(WithLock) const {
+    if (!_params.getLimit() ||
+        _smallestSortKeys.size() < static_cast<size_t>(*_params.getLimit())) {
+        return boost::none;
     }
+    return _smallestSortKeys.top();
 }
 
 executor::TaskExecutor::EventHandle AsyncResultsMerger::kill(OperationContext* opCtx) {
@@ -788,6 +838,11 @@ bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const
                            _sort) > 0;
 }
 
+bool AsyncResultsMerger::SortKeyComparator::operator()(const BSONObj& lhs,
+                                                        const BSONObj& rhs) const {
+    return compareSortKeys(lhs, rhs, _sort) < 0;
+}
+
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
     const MinSortKeyRemoteIdPair& lhs, const MinSortKeyRemoteIdPair& rhs) const {
     auto sortKeyComp = compareSortKeys(lhs.first, rhs.first, _sort);
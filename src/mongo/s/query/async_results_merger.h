@@ -336,6 +336,16 @@ private:
         BSONObj _sort;
     };
 
+    class SortKeyComparator {
+    public:
+        SortKeyComparator(BSONObj sort) : _sort(std::move(sort)) {}
+
+        bool operator()(const BSONObj& lhs, const BSONObj& rhs) const;
+
+    private:
+        BSONObj _sort;
+    };
+
     enum LifecycleState { kAlive, kKillStarted, kKillComplete };
 
     /**
@@ -440,6 +450,18 @@ private:
      */
     void _scheduleKillCursors(WithLock, OperationContext* opCtx);
 
+    /**
+     * Schedules a killCursors command for the open cursor of 'remote', without waiting for it.
+     */
+    void _scheduleKillCursor(WithLock, OperationContext* opCtx, const RemoteCursorData& remote);
+
+    /**
+     * When merging the sorted results of a query with a limit of k, returns the sort key of the
+     * k-th smallest result received so far, or boost::none if fewer than k results have been
+     * received. Results which sort after this key can never be returned.
+     */
+    boost::optional<BSONObj> _getSortKeyThreshold(WithLock) const;
+
     /**
      * Updates the given remote's metadata (e.g. the cursor id) based on information in 'response'.
      */
@@ -481,6 +503,10 @@ private:
     // For sorted tailable cursors, records the current high-water-mark sort key. Empty otherwise.
     BSONObj _highWaterMark;
 
+    // For sorted merges with a limit, the sort keys of the 'limit' smallest results received so far
+    // from all remotes. The largest of these is on top.
+    std::priority_queue<BSONObj, std::vector<BSONObj>, SortKeyComparator> _smallestSortKeys;
+
     //
     // Killing
     //
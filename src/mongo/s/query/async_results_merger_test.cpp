@@ -38,12 +38,14 @@
 #include "mongo/db/pipeline/resume_token.h"
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_request.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/query/results_merger_test_fixture.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -291,6 +293,93 @@ TEST_F(AsyncResultsMergerTest, MultiShardSorted) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, SortedMergeWithLimitPushesSortKeyThresholdToShards) {
+    internalQueryPushSortKeyThresholdToShards.store(true);
+    ON_BLOCK_EXIT([] { internalQueryPushSortKeyThresholdToShards.store(false); });
+
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: {'': 1}}"),
+                                   fromjson("{$sortKey: {'': 2}}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, batch1)));
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: {'': 3}}"),
+                                   fromjson("{$sortKey: {'': 4}}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, batch2)));
+    auto params = makeARMParamsFromExistingCursors(std::move(cursors), findCmd);
+    params.setLimit(2);
+    auto arm =
+        std::make_unique<AsyncResultsMerger>(operationContext(), executor(), std::move(params));
+
+    // The first shard already produced the two smallest results, so everything from the second
+    // shard is discarded and its cursor is killed.
+    assertKillCusorsCmdHasCursorId(getNthPendingRequest(0u).cmdObj, 6);
+    scheduleNetworkResponseObjs({BSON("ok" << 1)});
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 2}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_FALSE(arm->ready());
+
+    // The getMore sent to the first shard carries the sort key of the last result which can still
+    // be returned.
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    BSONObj getMoreCmd = getNthPendingRequest(0u).cmdObj;
+    ASSERT_EQ(getMoreCmd["getMore"].numberLong(), 5);
+    ASSERT_BSONOBJ_EQ(getMoreCmd["$_sortKeyThreshold"].Obj(),
+                      fromjson("{key: {'': 2}, pattern: {_id: 1}}"));
+
+    scheduleNetworkResponse(CursorResponse(kTestNss, CursorId(0), {}));
+    executor()->waitForEvent(readyEvent);
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, SortedMergeWithLimitOmitsSortKeyThresholdUnlessEnabled) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: {'': 1}}"),
+                                   fromjson("{$sortKey: {'': 2}}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, batch1)));
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: {'': 3}}"),
+                                   fromjson("{$sortKey: {'': 4}}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, batch2)));
+    auto params = makeARMParamsFromExistingCursors(std::move(cursors), findCmd);
+    params.setLimit(2);
+    auto arm =
+        std::make_unique<AsyncResultsMerger>(operationContext(), executor(), std::move(params));
+
+    // The first shard already produced the two smallest results, so everything from the second
+    // shard is discarded and its cursor is killed.
+    assertKillCusorsCmdHasCursorId(getNthPendingRequest(0u).cmdObj, 6);
+    scheduleNetworkResponseObjs({BSON("ok" << 1)});
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 2}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_FALSE(arm->ready());
+
+    // Shards may not understand the threshold, so it is not sent unless enabled.
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    BSONObj getMoreCmd = getNthPendingRequest(0u).cmdObj;
+    ASSERT_EQ(getMoreCmd["getMore"].numberLong(), 5);
+    ASSERT_FALSE(getMoreCmd.hasField("$_sortKeyThreshold"));
+
+    scheduleNetworkResponse(CursorResponse(kTestNss, CursorId(0), {}));
+    executor()->waitForEvent(readyEvent);
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, MultiShardMultipleGets) {
     std::vector<RemoteCursor> cursors;
     cursors.push_back(
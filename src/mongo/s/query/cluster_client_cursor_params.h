@@ -85,6 +85,11 @@ struct ClusterClientCursorParams {
         armParams.setRemotes(std::move(remotes));
         armParams.setTailableMode(tailableMode);
         armParams.setBatchSize(batchSize);
+        if (!sort.isEmpty() && !compareWholeSortKey && limit &&
+            tailableMode == TailableModeEnum::kNormal) {
+            // The merge never consumes more than 'skip' + 'limit' results.
+            armParams.setLimit(*limit + skip.value_or(0));
+        }
         armParams.setNss(nsString);
         armParams.setAllowPartialResults(isAllowPartialResults);
 
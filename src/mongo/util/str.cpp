@@ -182,45 +182,75 @@ int versionCmp(const StringData rhs, const StringData lhs) {
     return LexNumCmp::cmp(rhs, lhs, false);
 }
 
-std::string escape(StringData sd, bool escape_slash) {
-    StringBuilder ret;
-    ret.reset(sd.size());
-    for (const auto& c : sd) {
+namespace {
+
+/**
+ * Calls 'append' with the pieces of 'sd' escaped as by escape(). Runs of characters which need no
+ * escaping, usually all of 'sd', are passed on as a whole.
+ */
+template <typename Append>
+void escapeImpl(StringData sd, bool escape_slash, Append&& append) {
+    const char* runStart = sd.rawData();
+    const char* const end = sd.rawData() + sd.size();
+    for (const char* p = runStart; p != end; ++p) {
+        const char c = *p;
+        if (c != '"' && c != '\\' && (c != '/' || !escape_slash) && !(c >= 0 && c <= 0x1f)) {
+            continue;
+        }
+
+        if (p != runStart) {
+            append(StringData(runStart, p - runStart));
+        }
+        runStart = p + 1;
         switch (c) {
             case '"':
-                ret << "\\\"";
+                append("\\\"");
                 break;
             case '\\':
-                ret << "\\\\";
+                append("\\\\");
                 break;
             case '/':
-                ret << (escape_slash ? "\\/" : "/");
+                append("\\/");
                 break;
             case '\b':
-                ret << "\\b";
+                append("\\b");
                 break;
             case '\f':
-                ret << "\\f";
+                append("\\f");
                 break;
             case '\n':
-                ret << "\\n";
+                append("\\n");
                 break;
             case '\r':
-                ret << "\\r";
+                append("\\r");
                 break;
             case '\t':
-                ret << "\\t";
+                append("\\t");
                 break;
             default:
-                if (c >= 0 && c <= 0x1f) {
-                    // For c < 0x7f, ASCII value == Unicode code point.
-                    ret << "\\u00" << toHexLower(&c, 1);
-                } else {
-                    ret << c;
-                }
+                // For c < 0x7f, ASCII value == Unicode code point.
+                append("\\u00");
+                append(toHexLower(&c, 1));
         }
     }
-    return ret.str();
+    if (end != runStart) {
+        append(StringData(runStart, end - runStart));
+    }
+}
+
+}  // namespace
+
+std::string escape(StringData sd, bool escape_slash) {
+    std::string ret;
+    ret.reserve(sd.size());
+    escapeImpl(
+        sd, escape_slash, [&](StringData piece) { ret.append(piece.rawData(), piece.size()); });
+    return ret;
+}
+
+void escape(std::ostream& out, StringData sd, bool escape_slash) {
+    escapeImpl(
+        sd, escape_slash, [&](StringData piece) { out.write(piece.rawData(), piece.size()); });
 }
 
 boost::optional<size_t> parseUnsignedBase10Integer(StringData fieldName) {
@@ -337,6 +337,11 @@ int versionCmp(StringData rhs, StringData lhs);
  */
 std::string escape(StringData s, bool escape_slash = false);
 
+/**
+ * Writes 's' to 'out', escaped as by escape(), without building the escaped string first.
+ */
+void escape(std::ostream& out, StringData s, bool escape_slash = false);
+
 /**
  * Converts 'integer' from a base-10 string to a size_t value or returns boost::none if 'integer'
  * is not a valid base-10 string. A valid string is not allowed to have anything but decimal